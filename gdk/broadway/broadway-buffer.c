@@ -38,6 +38,8 @@ struct entry {
 struct _BroadwayBuffer {
   guint8 *data;
   struct entry *table;
+  guint32 *tile_hashes;
+  guint8 *row_churn;
   int width, height, stride;
   int encoded;
   int block_stride, length, block_count, shift;
@@ -57,6 +59,12 @@ static const guint32 end_vprime = 0xcdb99001;	/* vprime^block_size */
 static const guint32 step = 0x0ac93019;
 static const int block_size = 32, block_mask = 31;
 
+/* Number of consecutive frames a tile strip has to change before we
+ * consider it high-churn (video, animations) and stop looking for
+ * scroll matches in it.
+ */
+#define CHURN_ROW_THRESHOLD 3
+
 static gboolean
 verify_block_match (BroadwayBuffer *buffer, int x, int y,
                     BroadwayBuffer *prev, struct entry *entry)
@@ -117,6 +125,7 @@ insert_block (BroadwayBuffer *buffer, guint32 h, int x, int y)
   entry->x = x;
   entry->y = y;
   entry->index = (buffer->block_stride * y + x) / block_size;
+  buffer->tile_hashes[entry->index] = h;
 
   if (collision > G_N_ELEMENTS (buffer->stats) - 1)
     collision = G_N_ELEMENTS (buffer->stats) - 1;
@@ -264,6 +273,25 @@ encoder_flush (struct encoder *encoder)
   encode_run (encoder);
 }
 
+/* Emit @count pixels known to be unchanged from the previous frame
+ * without going through the per-pixel state machine.
+ */
+static void
+encode_unchanged (struct encoder *encoder, guint32 count)
+{
+  encode_run (encoder);
+  encoder->color_run = 0;
+  encoder->delta_run = 0;
+
+  while (count > 0)
+    {
+      guint32 chunk = MIN (count, 0xFFFFF);
+
+      emit (encoder, 0x00100000 | chunk);
+      count -= chunk;
+    }
+}
+
 
 static void
 encode_block (struct encoder *encoder, struct entry *entry, int x, int y)
@@ -283,6 +311,8 @@ broadway_buffer_destroy (BroadwayBuffer *buffer)
 {
   g_free (buffer->data);
   g_free (buffer->table);
+  g_free (buffer->tile_hashes);
+  g_free (buffer->row_churn);
   g_free (buffer);
 }
 
@@ -346,6 +376,8 @@ broadway_buffer_create (int width, int height, guint8 *data, int stride)
   buffer->length = 1 << bits_required;
 
   buffer->table = g_malloc0 (buffer->length * sizeof buffer->table[0]);
+  buffer->tile_hashes = g_malloc0 (buffer->block_count * sizeof buffer->tile_hashes[0]);
+  buffer->row_churn = g_malloc0 ((buffer->block_count / buffer->block_stride) * sizeof buffer->row_churn[0]);
 
   memset (buffer->stats, 0, sizeof buffer->stats);
   buffer->clashes = 0;
@@ -362,7 +394,7 @@ void
 broadway_buffer_encode (BroadwayBuffer *buffer, BroadwayBuffer *prev, GString *dest)
 {
   struct entry *entry;
-  int i, j, k;
+  int i, j, k, r;
   int x0, x1, y0, y1;
   guint32 *block_hashes;
   guint32 hash, bottom_hash, h, *line, *bottom, *prev_line;
@@ -370,6 +402,7 @@ broadway_buffer_encode (BroadwayBuffer *buffer, BroadwayBuffer *prev, GString *d
   struct encoder encoder = { 0 };
   int *skyline, skyline_pixels;
   int matches;
+  gboolean rebuild_hashes;
 
   width = buffer->width;
   height = buffer->height;
@@ -384,35 +417,120 @@ broadway_buffer_encode (BroadwayBuffer *buffer, BroadwayBuffer *prev, GString *d
 
   matches = 0;
   encoder.dest = dest;
+  rebuild_hashes = TRUE;
 
-  // Calculate the block hashes for the first row
-  for (i = y0; i < MIN(y1, y0 + block_size); i++)
+  i = y0;
+  while (i < y1)
     {
-      line = (guint32 *)(buffer->data + i * buffer->stride);
-      hash = 0;
-      for (j = x0; j < MIN(x1, x0 + block_size); j++)
-        hash = hash * prime + line[j];
-      for (; j < x0 + block_size; j++)
-        hash = hash * prime;
+      /* At a tile-grid boundary, compare the whole strip against the
+       * previous frame first; unchanged strips are the common case on
+       * mostly-static screens, and a memcmp is much cheaper than
+       * running the rolling hashes over every pixel. The tile hashes
+       * of a skipped strip are carried over from the previous frame so
+       * its blocks stay available as match sources.
+       */
+      if ((i & block_mask) == 0 &&
+          prev && prev->encoded &&
+          prev->width == width && prev->height == height &&
+          i + block_size <= height)
+        {
+          int block_row = i / block_size;
 
-      for (j = x0; j < x1; j++)
+          if (memcmp (buffer->data + i * buffer->stride,
+                      prev->data + i * prev->stride,
+                      block_size * buffer->stride) == 0)
+            {
+              if (!buffer->encoded)
+                {
+                  for (j = 0; j < buffer->block_stride; j++)
+                    insert_block (buffer,
+                                  prev->tile_hashes[block_row * buffer->block_stride + j],
+                                  j * block_size, i);
+                }
+
+              encode_unchanged (&encoder, block_size * width);
+              i += block_size;
+              rebuild_hashes = TRUE;
+              continue;
+            }
+
+          buffer->row_churn[block_row] =
+            MIN (prev->row_churn[block_row] + 1, G_MAXUINT8);
+
+          /* Strips that change on every frame (embedded video,
+           * animations) never pay off in the scroll-match search --
+           * their blocks don't recur -- but still make us run the
+           * rolling hashes over every pixel. Once a strip has churned
+           * for a few consecutive frames, drop to plain per-pixel
+           * deltas so encoding cost stays bounded on video-heavy
+           * surfaces.
+           */
+          if (buffer->row_churn[block_row] >= CHURN_ROW_THRESHOLD)
+            {
+              for (r = i; r < i + block_size; r++)
+                {
+                  line = (guint32 *) (buffer->data + r * buffer->stride);
+                  prev_line = (guint32 *) (prev->data + r * prev->stride);
+
+                  /* memcmp runs on the platform's vector units; use it
+                   * to dispose of all-unchanged rows wholesale before
+                   * falling back to the per-pixel delta machinery.
+                   * Delta-0 is right in both regimes: under the
+                   * skyline the canvas already holds the block-copied
+                   * content, elsewhere it holds the previous frame.
+                   */
+                  if (memcmp (line, prev_line, width * 4) == 0)
+                    {
+                      encode_unchanged (&encoder, width);
+                      continue;
+                    }
+
+                  for (j = x0; j < x1; j++)
+                    {
+                      if (r < skyline[j])
+                        encode_pixel (&encoder, line[j], line[j]);
+                      else
+                        encode_pixel (&encoder, line[j], prev_line[j]);
+                    }
+                }
+
+              i += block_size;
+              rebuild_hashes = TRUE;
+              continue;
+            }
+        }
+
+      if (rebuild_hashes)
         {
-          block_hashes[j] = block_hashes[j] * vprime + hash;
+          // Calculate the block hashes for the first row to scan
+          memset (block_hashes, 0, width * sizeof block_hashes[0]);
+          for (r = i; r < MIN(y1, i + block_size); r++)
+            {
+              line = (guint32 *)(buffer->data + r * buffer->stride);
+              hash = 0;
+              for (j = x0; j < MIN(x1, x0 + block_size); j++)
+                hash = hash * prime + line[j];
+              for (; j < x0 + block_size; j++)
+                hash = hash * prime;
+
+              for (j = x0; j < x1; j++)
+                {
+                  block_hashes[j] = block_hashes[j] * vprime + hash;
 
-          hash = hash * prime - line[j] * end_prime;
-          if (j + block_size < width)
-            hash += line[j + block_size];
+                  hash = hash * prime - line[j] * end_prime;
+                  if (j + block_size < width)
+                    hash += line[j + block_size];
+                }
+            }
+          // Do the last rows if they extend past the bottom
+          for (; r < i + block_size; r++)
+            {
+              for (j = x0; j < x1; j++)
+                block_hashes[j] = block_hashes[j] * vprime;
+            }
+          rebuild_hashes = FALSE;
         }
-    }
-  // Do the last rows if height < block_size
-  for (; i < y0 + block_size; i++)
-    {
-      for (j = x0; j < x1; j++)
-        block_hashes[j] = block_hashes[j] * vprime;
-    }
 
-  for (i = y0; i < y1; i++)
-    {
       line = (guint32 *) (buffer->data + i * buffer->stride);
       bottom = (guint32 *) (buffer->data + (i + block_size) * buffer->stride);
       bottom_hash = 0;
@@ -502,6 +620,8 @@ broadway_buffer_encode (BroadwayBuffer *buffer, BroadwayBuffer *prev, GString *d
           if  (j + block_size < width)
             hash += line[j + block_size] ;
         }
+
+      i++;
     }
 
   encoder_flush (&encoder);
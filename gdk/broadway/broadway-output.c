@@ -16,6 +16,7 @@ struct BroadwayOutput {
   GString *buf;
   int error;
   guint32 serial;
+  GZlibCompressor *compressor;
 };
 
 static void
@@ -71,6 +72,18 @@ broadway_output_flush (BroadwayOutput *output)
 
 }
 
+/* Appends the not-yet-flushed operations of @source to the pending
+ * buffer of @output. Used to fan the encoded stream out to mirror
+ * clients without re-encoding it.
+ */
+void
+broadway_output_copy_pending (BroadwayOutput *output,
+			      BroadwayOutput *source)
+{
+  if (source->buf->len > 0)
+    g_string_append_len (output->buf, source->buf->str, source->buf->len);
+}
+
 BroadwayOutput *
 broadway_output_new (GOutputStream *out, guint32 serial)
 {
@@ -81,6 +94,7 @@ broadway_output_new (GOutputStream *out, guint32 serial)
   output->out = g_object_ref (out);
   output->buf = g_string_new ("");
   output->serial = serial;
+  output->compressor = g_zlib_compressor_new (G_ZLIB_COMPRESSOR_FORMAT_RAW, -1);
 
   return output;
 }
@@ -89,6 +103,7 @@ void
 broadway_output_free (BroadwayOutput *output)
 {
   g_object_unref (output->out);
+  g_object_unref (output->compressor);
   free (output);
 }
 
@@ -276,6 +291,12 @@ broadway_output_move_resize_surface (BroadwayOutput *output,
     }
 }
 
+gsize
+broadway_output_get_buffer_size (BroadwayOutput *output)
+{
+  return output->buf->len;
+}
+
 void
 broadway_output_set_transient_for (BroadwayOutput *output,
 				   int             id,
@@ -294,7 +315,6 @@ broadway_output_put_buffer (BroadwayOutput *output,
 {
   gsize len;
   int w, h;
-  GZlibCompressor *compressor;
   GOutputStream *out, *out_mem;
   GString *encoded;
 
@@ -310,10 +330,13 @@ broadway_output_put_buffer (BroadwayOutput *output,
   encoded = g_string_new ("");
   broadway_buffer_encode (buffer, prev_buffer, encoded);
 
-  compressor = g_zlib_compressor_new (G_ZLIB_COMPRESSOR_FORMAT_RAW, -1);
+  /* Each put-buffer is an independent deflate stream, since the
+   * client inflates them one at a time; the compressor object and its
+   * internal zlib state are reused across buffers.
+   */
+  g_converter_reset (G_CONVERTER (output->compressor));
   out_mem = g_memory_output_stream_new_resizable ();
-  out = g_converter_output_stream_new (out_mem, G_CONVERTER (compressor));
-  g_object_unref (compressor);
+  out = g_converter_output_stream_new (out_mem, G_CONVERTER (output->compressor));
 
   if (!g_output_stream_write_all (out, encoded->str, encoded->len,
                                   NULL, NULL, NULL) ||
@@ -330,3 +353,58 @@ broadway_output_put_buffer (BroadwayOutput *output,
   g_object_unref (out);
   g_object_unref (out_mem);
 }
+
+/* Like broadway_output_put_buffer() with no previous buffer, but keeps
+ * the compressed payload around so that repeated resyncs of an
+ * unchanged buffer (client reconnects, mirrors joining) skip the
+ * full-frame encode and recompression. Pass the GString returned by
+ * the previous call, or NULL the first time; the returned string is
+ * the payload the caller should cache until the buffer changes.
+ */
+GString *
+broadway_output_put_buffer_cached (BroadwayOutput *output,
+                                   int             id,
+                                   BroadwayBuffer *buffer,
+                                   GString        *cached)
+{
+  gsize len;
+  int w, h;
+  GOutputStream *out, *out_mem;
+  GString *encoded;
+
+  write_header (output, BROADWAY_OP_PUT_BUFFER);
+
+  w = broadway_buffer_get_width (buffer);
+  h = broadway_buffer_get_height (buffer);
+
+  append_uint16 (output, id);
+  append_uint16 (output, w);
+  append_uint16 (output, h);
+
+  if (cached == NULL)
+    {
+      encoded = g_string_new ("");
+      broadway_buffer_encode (buffer, NULL, encoded);
+
+      g_converter_reset (G_CONVERTER (output->compressor));
+      out_mem = g_memory_output_stream_new_resizable ();
+      out = g_converter_output_stream_new (out_mem, G_CONVERTER (output->compressor));
+
+      if (!g_output_stream_write_all (out, encoded->str, encoded->len,
+                                      NULL, NULL, NULL) ||
+          !g_output_stream_close (out, NULL, NULL))
+        g_warning ("compression failed\n");
+
+      len = g_memory_output_stream_get_data_size (G_MEMORY_OUTPUT_STREAM (out_mem));
+      cached = g_string_new_len (g_memory_output_stream_get_data (G_MEMORY_OUTPUT_STREAM (out_mem)), len);
+
+      g_string_free (encoded, TRUE);
+      g_object_unref (out);
+      g_object_unref (out_mem);
+    }
+
+  append_uint32 (output, cached->len);
+  g_string_append_len (output->buf, cached->str, cached->len);
+
+  return cached;
+}
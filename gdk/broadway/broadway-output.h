@@ -21,6 +21,8 @@ BroadwayOutput *broadway_output_new             (GOutputStream  *out,
 						 guint32         serial);
 void            broadway_output_free            (BroadwayOutput *output);
 int             broadway_output_flush           (BroadwayOutput *output);
+void            broadway_output_copy_pending    (BroadwayOutput *output,
+						 BroadwayOutput *source);
 int             broadway_output_has_error       (BroadwayOutput *output);
 void            broadway_output_set_next_serial (BroadwayOutput *output,
 						 guint32         serial);
@@ -51,6 +53,7 @@ void            broadway_output_move_resize_surface (BroadwayOutput *output,
 						     gboolean        has_size,
 						     int             w,
 						     int             h);
+gsize           broadway_output_get_buffer_size (BroadwayOutput *output);
 void            broadway_output_set_transient_for (BroadwayOutput *output,
 						   int             id,
 						   int             parent_id);
@@ -58,6 +61,10 @@ void            broadway_output_put_buffer      (BroadwayOutput *output,
 						 int             id,
                                                  BroadwayBuffer *prev_buffer,
                                                  BroadwayBuffer *buffer);
+GString        *broadway_output_put_buffer_cached (BroadwayOutput *output,
+						   int             id,
+						   BroadwayBuffer *buffer,
+						   GString        *cached);
 void            broadway_output_grab_pointer    (BroadwayOutput *output,
 						 int id,
 						 gboolean owner_event);
@@ -50,6 +50,7 @@ struct _BroadwayServer {
   guint32 saved_serial;
   guint64 last_seen_time;
   BroadwayInput *input;
+  GList *mirror_inputs;
   GList *input_messages;
   guint process_input_idle;
 
@@ -102,6 +103,7 @@ struct BroadwayInput {
   gboolean seen_time;
   gint64 time_base;
   gboolean active;
+  gboolean is_mirror;
 };
 
 struct BroadwayWindow {
@@ -116,12 +118,21 @@ struct BroadwayWindow {
 
   BroadwayBuffer *buffer;
   gboolean buffer_synced;
+  GString *cached_full_frame;
+
+  /* Per-window traffic statistics, reported on /stats */
+  guint32 update_count;
+  guint64 sent_bytes;
+  guint64 encode_us;
 
   char *cached_surface_name;
   cairo_surface_t *cached_surface;
 };
 
 static void broadway_server_resync_windows (BroadwayServer *server);
+static void broadway_server_resync_windows_to (BroadwayServer *server,
+					       BroadwayOutput *output,
+					       gboolean update_synced);
 
 static GType broadway_server_get_type (void);
 
@@ -173,6 +184,7 @@ broadway_server_class_init (BroadwayServerClass * class)
 }
 
 static void start (BroadwayInput *input);
+static void start_mirror (BroadwayInput *input);
 
 static void
 http_request_free (HttpRequest *request)
@@ -427,6 +439,12 @@ parse_input_message (BroadwayInput *input, const unsigned char *message)
   guint32 *p;
   gint64 time_;
 
+  /* Mirror clients only watch; whatever events their page generates
+   * must not act on the session.
+   */
+  if (input->is_mirror)
+    return;
+
   memset (&msg, 0, sizeof (msg));
 
   p = (guint32 *) message;
@@ -516,6 +534,23 @@ parse_input_message (BroadwayInput *input, const unsigned char *message)
     break;
   }
 
+  /* Motion compression: on high-latency links pointer moves arrive in
+   * bursts, and only the final position of a run of queued moves
+   * matters. Overwrite a pending move in place instead of growing the
+   * queue, keeping the newest coordinates, state and timestamp.
+   */
+  if (msg.base.type == BROADWAY_EVENT_POINTER_MOVE)
+    {
+      GList *last = g_list_last (server->input_messages);
+
+      if (last != NULL &&
+	  ((BroadwayInputMsg *)last->data)->base.type == BROADWAY_EVENT_POINTER_MOVE)
+	{
+	  memcpy (last->data, &msg, sizeof (msg));
+	  return;
+	}
+    }
+
   server->input_messages = g_list_append (server->input_messages, g_memdup (&msg, sizeof (msg)));
 
 }
@@ -688,6 +723,12 @@ broadway_server_read_all_input_nonblocking (BroadwayInput *input)
 
       if (input->server->input == input)
 	input->server->input = NULL;
+      if (input->is_mirror)
+	{
+	  input->server->mirror_inputs =
+	    g_list_remove (input->server->mirror_inputs, input);
+	  broadway_output_free (input->output);
+	}
       broadway_input_free (input);
       if (res < 0)
 	{
@@ -752,6 +793,29 @@ broadway_server_get_screen_size (BroadwayServer   *server,
 void
 broadway_server_flush (BroadwayServer *server)
 {
+  GList *l, *next;
+
+  /* Hand each mirror a copy of the pending operations before the
+   * primary buffer is drained; the encoding work is thus shared by
+   * all viewers.
+   */
+  for (l = server->mirror_inputs; l != NULL; l = next)
+    {
+      BroadwayInput *input = l->data;
+
+      next = l->next;
+
+      if (server->output)
+	broadway_output_copy_pending (input->output, server->output);
+
+      if (!broadway_output_flush (input->output))
+	{
+	  server->mirror_inputs = g_list_remove (server->mirror_inputs, input);
+	  broadway_output_free (input->output);
+	  broadway_input_free (input);
+	}
+    }
+
   if (server->output &&
       !broadway_output_flush (server->output))
     {
@@ -820,6 +884,13 @@ broadway_server_block_for_input (BroadwayServer *server, char op,
 }
 #endif
 
+/* Window content from local clients is never serialized over the
+ * client socket: the GDK side allocates its surfaces in named shared
+ * memory (see gdkbroadway-server.c) and only passes the name here,
+ * which we map read-only and keep cached per window until the name
+ * changes. The websocket leg to the browser is the only place pixels
+ * get encoded.
+ */
 static void *
 map_named_shm (char *name, gsize size)
 {
@@ -967,7 +1038,8 @@ generate_handshake_response_wsietf_v7 (const gchar *key)
 }
 
 static void
-start_input (HttpRequest *request)
+start_input (HttpRequest *request,
+	     gboolean is_mirror)
 {
   char **lines;
   char *p;
@@ -1046,6 +1118,7 @@ start_input (HttpRequest *request)
   input = g_new0 (BroadwayInput, 1);
   input->server = request->server;
   input->connection = g_object_ref (request->connection);
+  input->is_mirror = is_mirror;
 
   data_buffer = g_buffered_input_stream_peek_buffer (G_BUFFERED_INPUT_STREAM (request->data), &data_buffer_size);
   input->buffer = g_byte_array_sized_new (data_buffer_size);
@@ -1063,7 +1136,10 @@ start_input (HttpRequest *request)
   g_source_set_callback (input->source, (GSourceFunc)input_data_cb, input, NULL);
   g_source_attach (input->source, NULL);
 
-  start (input);
+  if (input->is_mirror)
+    start_mirror (input);
+  else
+    start (input);
 
   /* Process any data in the pipe already */
   parse_input (input);
@@ -1114,6 +1190,28 @@ start (BroadwayInput *input)
   process_input_messages (server);
 }
 
+static void
+start_mirror (BroadwayInput *input)
+{
+  BroadwayServer *server;
+
+  input->active = TRUE;
+
+  server = BROADWAY_SERVER (input->server);
+
+  /* Push out anything still queued for the existing clients first;
+   * those operations reflect state that is already in the window
+   * buffers we're about to replay.
+   */
+  broadway_server_flush (server);
+
+  server->mirror_inputs = g_list_prepend (server->mirror_inputs, input);
+
+  broadway_server_resync_windows_to (server, input->output, FALSE);
+
+  broadway_output_flush (input->output);
+}
+
 static void
 send_data (HttpRequest *request,
 	     const char *mimetype,
@@ -1139,6 +1237,38 @@ send_data (HttpRequest *request,
 #include "clienthtml.h"
 #include "broadwayjs.h"
 
+static void
+send_stats (HttpRequest *request)
+{
+  BroadwayServer *server = request->server;
+  GString *stats;
+  GList *l;
+
+  stats = g_string_new ("id\tgeometry\tvisible\tupdates\tbytes\tencode-ms\n");
+
+  for (l = server->toplevels; l != NULL; l = l->next)
+    {
+      BroadwayWindow *window = l->data;
+
+      if (window->id == 0)
+	continue; /* Skip root */
+
+      g_string_append_printf (stats,
+			      "%d\t%dx%d+%d+%d\t%d\t%u\t%"G_GUINT64_FORMAT"\t%.1f\n",
+			      window->id,
+			      window->width, window->height,
+			      window->x, window->y,
+			      window->visible,
+			      window->update_count,
+			      window->sent_bytes,
+			      window->encode_us / 1000.0);
+    }
+
+  send_data (request, "text/plain", stats->str, stats->len);
+
+  g_string_free (stats, TRUE);
+}
+
 static void
 got_request (HttpRequest *request)
 {
@@ -1178,7 +1308,11 @@ got_request (HttpRequest *request)
   else if (strcmp (escaped, "/broadway.js") == 0)
     send_data (request, "text/javascript", broadway_js, G_N_ELEMENTS(broadway_js) - 1);
   else if (strcmp (escaped, "/socket") == 0)
-    start_input (request);
+    start_input (request, FALSE);
+  else if (strcmp (escaped, "/mirror") == 0)
+    start_input (request, TRUE);
+  else if (strcmp (escaped, "/stats") == 0)
+    send_stats (request);
   else
     send_error (request, 404, "File not found");
 
@@ -1460,6 +1594,8 @@ broadway_server_destroy_window (BroadwayServer *server,
       g_free (window->cached_surface_name);
       if (window->cached_surface != NULL)
 	cairo_surface_destroy (window->cached_surface);
+      if (window->cached_full_frame != NULL)
+	g_string_free (window->cached_full_frame, TRUE);
 
       g_free (window);
     }
@@ -1619,15 +1755,30 @@ broadway_server_window_update (BroadwayServer *server,
 
   if (server->output != NULL)
     {
+      gsize buf_size;
+      gint64 enc_start;
+
       window->buffer_synced = TRUE;
+      buf_size = broadway_output_get_buffer_size (server->output);
+      enc_start = g_get_monotonic_time ();
       broadway_output_put_buffer (server->output, window->id,
                                   window->buffer, buffer);
+      window->encode_us += g_get_monotonic_time () - enc_start;
+      window->sent_bytes +=
+        broadway_output_get_buffer_size (server->output) - buf_size;
+      window->update_count++;
     }
 
   if (window->buffer)
     broadway_buffer_destroy (window->buffer);
 
   window->buffer = buffer;
+
+  if (window->cached_full_frame)
+    {
+      g_string_free (window->cached_full_frame, TRUE);
+      window->cached_full_frame = NULL;
+    }
 }
 
 gboolean
@@ -1872,13 +2023,12 @@ broadway_server_new_window (BroadwayServer *server,
 }
 
 static void
-broadway_server_resync_windows (BroadwayServer *server)
+broadway_server_resync_windows_to (BroadwayServer *server,
+				   BroadwayOutput *output,
+				   gboolean update_synced)
 {
   GList *l;
 
-  if (server->output == NULL)
-    return;
-
   /* First create all windows */
   for (l = server->toplevels; l != NULL; l = l->next)
     {
@@ -1887,8 +2037,9 @@ broadway_server_resync_windows (BroadwayServer *server)
       if (window->id == 0)
 	continue; /* Skip root */
 
-      window->buffer_synced = FALSE;
-      broadway_output_new_surface (server->output,
+      if (update_synced)
+	window->buffer_synced = FALSE;
+      broadway_output_new_surface (output,
 				   window->id,
 				   window->x,
 				   window->y,
@@ -1906,22 +2057,37 @@ broadway_server_resync_windows (BroadwayServer *server)
 	continue; /* Skip root */
 
       if (window->transient_for != -1)
-	broadway_output_set_transient_for (server->output, window->id, window->transient_for);
+	broadway_output_set_transient_for (output, window->id, window->transient_for);
       if (window->visible)
 	{
-	  broadway_output_show_surface (server->output, window->id);
+	  broadway_output_show_surface (output, window->id);
 
 	  if (window->buffer != NULL)
 	    {
-	      window->buffer_synced = TRUE;
-              broadway_output_put_buffer (server->output, window->id,
-                                          NULL, window->buffer);
+	      if (update_synced)
+		window->buffer_synced = TRUE;
+              /* A resync always pushes the whole frame; keep the
+               * compressed payload so reconnects over flaky links
+               * don't re-encode unchanged windows every time. */
+              window->cached_full_frame =
+                broadway_output_put_buffer_cached (output, window->id,
+                                                   window->buffer,
+                                                   window->cached_full_frame);
 	    }
 	}
     }
 
   if (server->show_keyboard)
-    broadway_output_set_show_keyboard (server->output, TRUE);
+    broadway_output_set_show_keyboard (output, TRUE);
+}
+
+static void
+broadway_server_resync_windows (BroadwayServer *server)
+{
+  if (server->output == NULL)
+    return;
+
+  broadway_server_resync_windows_to (server, server->output, TRUE);
 
   broadway_server_flush (server);
 }
@@ -382,6 +382,12 @@ function markRect(src, srcX, srcY, dest, destX, destY, width, height, r, g, b)
     }
 }
 
+var littleEndian = (function() {
+    var buf = new ArrayBuffer(4);
+    new Uint32Array(buf)[0] = 1;
+    return new Uint8Array(buf)[0] == 1;
+})();
+
 function decodeBuffer(context, oldData, w, h, data, debug)
 {
     var i, j;
@@ -465,11 +471,21 @@ function decodeBuffer(context, oldData, w, h, data, debug)
 
                 start = dest;
 
-                for (i = 0; i < len; i++) {
-                    imageData.data[dest++] = r;
-                    imageData.data[dest++] = g;
-                    imageData.data[dest++] = b;
-                    imageData.data[dest++] = alpha;
+                if (littleEndian) {
+                    // One 32-bit store per pixel instead of four byte stores
+                    var pixels32 = new Uint32Array(imageData.data.buffer);
+                    var pixel = (alpha << 24 | b << 16 | g << 8 | r) >>> 0;
+                    var dest32 = dest >> 2;
+                    for (i = 0; i < len; i++)
+                        pixels32[dest32++] = pixel;
+                    dest += len * 4;
+                } else {
+                    for (i = 0; i < len; i++) {
+                        imageData.data[dest++] = r;
+                        imageData.data[dest++] = g;
+                        imageData.data[dest++] = b;
+                        imageData.data[dest++] = alpha;
+                    }
                 }
 
                 if (debug) // Color runs are blue
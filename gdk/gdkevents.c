@@ -133,11 +133,65 @@ _gdk_event_queue_prepend (GdkDisplay *display,
   return display->queued_events;
 }
 
+/* High-rate pointing devices can queue events much faster than we
+ * process them, one frame per event. If the event being appended makes
+ * the event at the tail of the queue redundant, drop the tail event
+ * right away instead of letting the queue grow: a newer motion event
+ * replaces an older one wholesale, and consecutive smooth scroll
+ * deltas are summed into the new event.
+ */
+static void
+gdk_event_queue_compress_tail (GdkDisplay *display,
+                               GdkEvent   *event)
+{
+  GdkEventPrivate *tail;
+  GList *node;
+
+  node = display->queued_tail;
+  if (node == NULL)
+    return;
+
+  tail = node->data;
+
+  if (tail->flags & (GDK_EVENT_PENDING | GDK_EVENT_FLUSHED))
+    return;
+
+  if (event->type == GDK_MOTION_NOTIFY)
+    {
+      if (tail->event.type != GDK_MOTION_NOTIFY ||
+          tail->event.motion.window != event->motion.window ||
+          tail->event.motion.device != event->motion.device ||
+          event->motion.window == NULL ||
+          !event->motion.window->event_compression)
+        return;
+    }
+  else if (event->type == GDK_SCROLL &&
+           event->scroll.direction == GDK_SCROLL_SMOOTH)
+    {
+      if (tail->event.type != GDK_SCROLL ||
+          tail->event.scroll.direction != GDK_SCROLL_SMOOTH ||
+          tail->event.scroll.window != event->scroll.window ||
+          tail->event.scroll.device != event->scroll.device ||
+          event->scroll.window == NULL ||
+          !event->scroll.window->event_compression)
+        return;
+
+      event->scroll.delta_x += tail->event.scroll.delta_x;
+      event->scroll.delta_y += tail->event.scroll.delta_y;
+    }
+  else
+    return;
+
+  _gdk_event_queue_remove_link (display, node);
+  g_list_free_1 (node);
+  gdk_event_free ((GdkEvent *) tail);
+}
+
 /**
  * _gdk_event_queue_append:
  * @display: a #GdkDisplay
  * @event: Event to append.
- * 
+ *
  * Appends an event onto the tail of the event queue.
  *
  * Returns: the newly appended list node.
@@ -146,6 +200,8 @@ GList *
 _gdk_event_queue_append (GdkDisplay *display,
 			 GdkEvent   *event)
 {
+  gdk_event_queue_compress_tail (display, event);
+
   display->queued_tail = g_list_append (display->queued_tail, event);
   
   if (!display->queued_events)
@@ -42,6 +42,7 @@ struct _GdkFrameClockIdlePrivate
   gint64 timer_base;
   gint64 frame_time;
   gint64 min_next_frame_time;
+  gint64 min_frame_interval; /* 0 means run at full refresh rate */
   gint64 sleep_serial;
 
   guint flush_idle_id;
@@ -204,6 +205,27 @@ gdk_frame_clock_idle_get_frame_time (GdkFrameClock *clock)
   return priv->frame_time;
 }
 
+/* Timeout sources only have millisecond granularity, which beats
+ * against refresh rates that are not a whole number of milliseconds
+ * (e.g. 59.97Hz) and shows up as periodic stutter. Give the source an
+ * exact ready time so it wakes up on the microsecond deadline; the
+ * millisecond interval (rounded up) stays as an upper bound.
+ */
+static void
+source_set_ready_time (guint              source_id,
+                       GdkFrameClockIdle *clock_idle)
+{
+  GdkFrameClockIdlePrivate *priv = clock_idle->priv;
+  GSource *source;
+
+  if (priv->min_next_frame_time == 0)
+    return;
+
+  source = g_main_context_find_source_by_id (NULL, source_id);
+  if (source)
+    g_source_set_ready_time (source, priv->min_next_frame_time - priv->timer_base);
+}
+
 #define RUN_FLUSH_IDLE(priv)                                            \
   ((priv)->freeze_count == 0 &&                                         \
    ((priv)->requested & GDK_FRAME_CLOCK_PHASE_FLUSH_EVENTS) != 0)
@@ -231,7 +253,7 @@ maybe_start_idle (GdkFrameClockIdle *clock_idle)
         {
           gint64 now = compute_frame_time (clock_idle);
           gint64 min_interval_us = MAX (priv->min_next_frame_time, now) - now;
-          min_interval = (min_interval_us + 500) / 1000;
+          min_interval = (min_interval_us + 999) / 1000;
         }
 
       if (priv->flush_idle_id == 0 && RUN_FLUSH_IDLE (priv))
@@ -242,6 +264,7 @@ maybe_start_idle (GdkFrameClockIdle *clock_idle)
                                                               g_object_ref (clock_idle),
                                                               (GDestroyNotify) g_object_unref);
           g_source_set_name_by_id (priv->flush_idle_id, "[gtk+] gdk_frame_clock_flush_idle");
+          source_set_ready_time (priv->flush_idle_id, clock_idle);
         }
 
       if (!priv->in_paint_idle &&
@@ -253,6 +276,7 @@ maybe_start_idle (GdkFrameClockIdle *clock_idle)
                                                               g_object_ref (clock_idle),
                                                               (GDestroyNotify) g_object_unref);
           g_source_set_name_by_id (priv->paint_idle_id, "[gtk+] gdk_frame_clock_paint_idle");
+          source_set_ready_time (priv->paint_idle_id, clock_idle);
         }
     }
 }
@@ -279,17 +303,29 @@ static gint64
 compute_min_next_frame_time (GdkFrameClockIdle *clock_idle,
                              gint64             last_frame_time)
 {
+  GdkFrameClockIdlePrivate *priv = clock_idle->priv;
   gint64 presentation_time;
   gint64 refresh_interval;
+  gint64 next_frame_time;
 
   gdk_frame_clock_get_refresh_info (GDK_FRAME_CLOCK (clock_idle),
                                     last_frame_time,
                                     &refresh_interval, &presentation_time);
 
   if (presentation_time == 0)
-    return last_frame_time + refresh_interval;
+    next_frame_time = last_frame_time + refresh_interval;
   else
-    return presentation_time + refresh_interval / 2;
+    next_frame_time = presentation_time + refresh_interval / 2;
+
+  /* Throttled clocks wait out their interval on top of the
+   * regular scheduling so that animation timing stays aligned
+   * with the compositor when unthrottled.
+   */
+  if (priv->min_frame_interval != 0)
+    next_frame_time = MAX (next_frame_time,
+                           last_frame_time + priv->min_frame_interval);
+
+  return next_frame_time;
 }
 
 static gboolean
@@ -376,8 +412,13 @@ gdk_frame_clock_paint_idle (void *data)
               if ((priv->requested & GDK_FRAME_CLOCK_PHASE_UPDATE) != 0 ||
                   priv->updating_count > 0)
                 {
+                  gint64 phase_start = g_get_monotonic_time ();
+
                   priv->requested &= ~GDK_FRAME_CLOCK_PHASE_UPDATE;
                   g_signal_emit_by_name (G_OBJECT (clock), "update");
+
+                  if (timings)
+                    timings->update_duration += g_get_monotonic_time () - phase_start;
                 }
             }
           /* fallthrough */
@@ -404,8 +445,13 @@ gdk_frame_clock_paint_idle (void *data)
               while ((priv->requested & GDK_FRAME_CLOCK_PHASE_LAYOUT) &&
 		     priv->freeze_count == 0 && iter++ < 4)
                 {
+                  gint64 phase_start = g_get_monotonic_time ();
+
                   priv->requested &= ~GDK_FRAME_CLOCK_PHASE_LAYOUT;
                   g_signal_emit_by_name (G_OBJECT (clock), "layout");
+
+                  if (timings)
+                    timings->layout_duration += g_get_monotonic_time () - phase_start;
                 }
 	      if (iter == 5)
 		g_warning ("gdk-frame-clock: layout continuously requested, giving up after 4 tries");
@@ -426,8 +472,13 @@ gdk_frame_clock_paint_idle (void *data)
               priv->phase = GDK_FRAME_CLOCK_PHASE_PAINT;
               if (priv->requested & GDK_FRAME_CLOCK_PHASE_PAINT)
                 {
+                  gint64 phase_start = g_get_monotonic_time ();
+
                   priv->requested &= ~GDK_FRAME_CLOCK_PHASE_PAINT;
                   g_signal_emit_by_name (G_OBJECT (clock), "paint");
+
+                  if (timings)
+                    timings->paint_duration += g_get_monotonic_time () - phase_start;
                 }
             }
           /* fallthrough */
@@ -595,3 +646,12 @@ _gdk_frame_clock_idle_new (void)
 
   return GDK_FRAME_CLOCK (clock);
 }
+
+void
+_gdk_frame_clock_idle_set_min_frame_interval (GdkFrameClockIdle *clock_idle,
+                                              gint64             min_interval)
+{
+  GdkFrameClockIdlePrivate *priv = clock_idle->priv;
+
+  priv->min_frame_interval = min_interval;
+}
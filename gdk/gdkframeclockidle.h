@@ -61,6 +61,9 @@ GType           gdk_frame_clock_idle_get_type       (void) G_GNUC_CONST;
 GdkFrameClock *_gdk_frame_clock_idle_new            (void);
 void           _gdk_frame_clock_idle_freeze_updates (GdkFrameClockIdle *clock_idle);
 void           _gdk_frame_clock_idle_thaw_updates   (GdkFrameClockIdle *clock_idle);
+void           _gdk_frame_clock_idle_set_min_frame_interval
+                                                    (GdkFrameClockIdle *clock_idle,
+                                                     gint64             min_interval);
 
 G_END_DECLS
 
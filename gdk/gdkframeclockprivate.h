@@ -94,6 +94,12 @@ struct _GdkFrameTimings
   gint64 refresh_interval;
   gint64 predicted_presentation_time;
 
+  /* Wall-clock time spent emitting each of the phase signals,
+   * accumulated across freeze/thaw */
+  gint64 update_duration;
+  gint64 layout_duration;
+  gint64 paint_duration;
+
 #ifdef G_ENABLE_DEBUG
   gint64 layout_start_time;
   gint64 paint_start_time;
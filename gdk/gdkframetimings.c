@@ -197,6 +197,66 @@ gdk_frame_timings_get_predicted_presentation_time (GdkFrameTimings *timings)
   return timings->predicted_presentation_time;
 }
 
+/**
+ * gdk_frame_timings_get_update_duration:
+ * @timings: a #GdkFrameTimings
+ *
+ * Gets the time that was spent in the #GdkFrameClock::update phase
+ * of the frame. Together with gdk_frame_timings_get_layout_duration()
+ * and gdk_frame_timings_get_paint_duration() this can be used to
+ * find out which phase of frame processing caused a frame to miss
+ * its deadline.
+ *
+ * Returns: the time spent emitting #GdkFrameClock::update for this
+ *  frame, in microseconds, or 0 if the phase did not run
+ * Since: 3.18
+ */
+gint64
+gdk_frame_timings_get_update_duration (GdkFrameTimings *timings)
+{
+  g_return_val_if_fail (timings != NULL, 0);
+
+  return timings->update_duration;
+}
+
+/**
+ * gdk_frame_timings_get_layout_duration:
+ * @timings: a #GdkFrameTimings
+ *
+ * Gets the time that was spent in the #GdkFrameClock::layout phase
+ * of the frame. See gdk_frame_timings_get_update_duration().
+ *
+ * Returns: the time spent emitting #GdkFrameClock::layout for this
+ *  frame, in microseconds, or 0 if the phase did not run
+ * Since: 3.18
+ */
+gint64
+gdk_frame_timings_get_layout_duration (GdkFrameTimings *timings)
+{
+  g_return_val_if_fail (timings != NULL, 0);
+
+  return timings->layout_duration;
+}
+
+/**
+ * gdk_frame_timings_get_paint_duration:
+ * @timings: a #GdkFrameTimings
+ *
+ * Gets the time that was spent in the #GdkFrameClock::paint phase
+ * of the frame. See gdk_frame_timings_get_update_duration().
+ *
+ * Returns: the time spent emitting #GdkFrameClock::paint for this
+ *  frame, in microseconds, or 0 if the phase did not run
+ * Since: 3.18
+ */
+gint64
+gdk_frame_timings_get_paint_duration (GdkFrameTimings *timings)
+{
+  g_return_val_if_fail (timings != NULL, 0);
+
+  return timings->paint_duration;
+}
+
 /**
  * gdk_frame_timings_get_refresh_interval:
  * @timings: a #GdkFrameTimings
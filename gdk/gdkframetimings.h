@@ -47,6 +47,12 @@ GDK_AVAILABLE_IN_3_8
 gint64           gdk_frame_timings_get_presentation_time (GdkFrameTimings *timings);
 GDK_AVAILABLE_IN_3_8
 gint64           gdk_frame_timings_get_refresh_interval  (GdkFrameTimings *timings);
+GDK_AVAILABLE_IN_3_18
+gint64           gdk_frame_timings_get_update_duration    (GdkFrameTimings *timings);
+GDK_AVAILABLE_IN_3_18
+gint64           gdk_frame_timings_get_layout_duration    (GdkFrameTimings *timings);
+GDK_AVAILABLE_IN_3_18
+gint64           gdk_frame_timings_get_paint_duration     (GdkFrameTimings *timings);
 
 GDK_AVAILABLE_IN_3_8
 gint64           gdk_frame_timings_get_predicted_presentation_time (GdkFrameTimings *timings);
@@ -305,8 +305,9 @@ gdk_gl_texture_quads (GdkGLContext *paint_context,
  * no special effects applied to @cr it will however use a more efficient
  * approach.
  *
- * For #GL_RENDERBUFFER the code will always fall back to software for buffers
- * with alpha components, so make sure you use #GL_TEXTURE if using alpha.
+ * For #GL_RENDERBUFFER sources with alpha components the buffer is first
+ * blitted into a temporary texture, so prefer #GL_TEXTURE if using alpha
+ * to avoid the extra copy.
  *
  * Calling this may change the current GL context.
  *
@@ -331,6 +332,7 @@ gdk_cairo_draw_from_gl (cairo_t              *cr,
   cairo_surface_t *group_target;
   GdkWindow *direct_window, *impl_window;
   guint framebuffer;
+  guint tmp_texture = 0;
   int alpha_size = 0;
   cairo_region_t *clip_region;
   GdkGLContextPaintData *paint_data;
@@ -385,6 +387,48 @@ gdk_cairo_draw_from_gl (cairo_t              *cr,
     matrix.xx == 1.0 && matrix.xy == 0.0 &&
     matrix.yx == 0.0 && matrix.yy == 1.0;
 
+  /* An alpha renderbuffer can't use the bitblit path below, since a
+     blit ignores the OVER semantics, and it can't be textured from
+     directly either. Rather than reading the pixels back, blit it
+     into a temporary texture and let the textured quad path composite
+     that, which keeps the frame on the GPU. */
+  if ((_gdk_gl_flags & GDK_GL_SOFTWARE_DRAW_GL) == 0 &&
+      source_type == GL_RENDERBUFFER &&
+      alpha_size != 0 &&
+      direct_window != NULL &&
+      direct_window->current_paint.use_gl &&
+      trivial_transform &&
+      clip_region != NULL &&
+      gdk_gl_context_has_framebuffer_blit (paint_context))
+    {
+      glGenTextures (1, &tmp_texture);
+      glBindTexture (GL_TEXTURE_2D, tmp_texture);
+      glTexImage2D (GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0,
+                    GL_BGRA, GL_UNSIGNED_INT_8_8_8_8_REV, NULL);
+
+      if (paint_data->tmp_framebuffer2 == 0)
+        glGenFramebuffersEXT (1, &paint_data->tmp_framebuffer2);
+
+      glBindFramebufferEXT (GL_READ_FRAMEBUFFER_EXT, paint_data->tmp_framebuffer);
+      glFramebufferRenderbufferEXT (GL_READ_FRAMEBUFFER_EXT, GL_COLOR_ATTACHMENT0_EXT,
+                                    GL_RENDERBUFFER_EXT, source);
+      glBindFramebufferEXT (GL_DRAW_FRAMEBUFFER_EXT, paint_data->tmp_framebuffer2);
+      glFramebufferTexture2DEXT (GL_DRAW_FRAMEBUFFER_EXT, GL_COLOR_ATTACHMENT0_EXT,
+                                 GL_TEXTURE_2D, tmp_texture, 0);
+
+      glBlitFramebufferEXT (x, y, x + width, y + height,
+                            0, 0, width, height,
+                            GL_COLOR_BUFFER_BIT, GL_NEAREST);
+
+      glBindFramebufferEXT (GL_FRAMEBUFFER_EXT, 0);
+
+      /* From here on we draw the texture copy instead */
+      source = tmp_texture;
+      source_type = GL_TEXTURE;
+      x = 0;
+      y = 0;
+    }
+
   /* For direct paint of non-alpha renderbuffer, we can
      just do a bitblit */
   if ((_gdk_gl_flags & GDK_GL_SOFTWARE_DRAW_GL) == 0 &&
@@ -640,11 +684,76 @@ gdk_cairo_draw_from_gl (cairo_t              *cr,
       cairo_surface_destroy (image);
     }
 
+  if (tmp_texture != 0)
+    glDeleteTextures (1, &tmp_texture);
+
   if (clip_region)
     cairo_region_destroy (clip_region);
 
 }
 
+#define GDK_GL_ATLAS_SIZE          1024
+#define GDK_GL_ATLAS_MAX_ITEM_SIZE 256
+
+/* A trivial shelf allocator for the per-context atlas texture that
+ * small surface uploads are packed into, so that icon-sized draws
+ * share one texture instead of each creating, binding and deleting
+ * their own. The atlas is treated as a ring: when it runs out of
+ * rows, allocation restarts from the top and @wrapped is set, at
+ * which point the caller must draw any quads that still reference
+ * the old contents before uploading into the returned slot.
+ */
+static gboolean
+gdk_gl_atlas_allocate (GdkGLContextPaintData *paint_data,
+                       int                    width,
+                       int                    height,
+                       int                   *x,
+                       int                   *y,
+                       gboolean              *wrapped)
+{
+  *wrapped = FALSE;
+
+  if (width > GDK_GL_ATLAS_MAX_ITEM_SIZE || height > GDK_GL_ATLAS_MAX_ITEM_SIZE)
+    return FALSE;
+
+  if (paint_data->atlas_texture == 0)
+    {
+      glGenTextures (1, &paint_data->atlas_texture);
+      glBindTexture (GL_TEXTURE_2D, paint_data->atlas_texture);
+      glTexParameteri (GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+      glTexParameteri (GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+      glTexParameteri (GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+      glTexParameteri (GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+      glTexImage2D (GL_TEXTURE_2D, 0, GL_RGBA,
+                    GDK_GL_ATLAS_SIZE, GDK_GL_ATLAS_SIZE, 0,
+                    GL_BGRA, GL_UNSIGNED_INT_8_8_8_8_REV, NULL);
+    }
+
+  if (paint_data->atlas_x + width > GDK_GL_ATLAS_SIZE)
+    {
+      paint_data->atlas_x = 0;
+      paint_data->atlas_y += paint_data->atlas_row_height;
+      paint_data->atlas_row_height = 0;
+    }
+
+  if (paint_data->atlas_y + height > GDK_GL_ATLAS_SIZE)
+    {
+      paint_data->atlas_x = 0;
+      paint_data->atlas_y = 0;
+      paint_data->atlas_row_height = 0;
+      *wrapped = TRUE;
+    }
+
+  *x = paint_data->atlas_x;
+  *y = paint_data->atlas_y;
+
+  paint_data->atlas_x += width;
+  if (height > paint_data->atlas_row_height)
+    paint_data->atlas_row_height = height;
+
+  return TRUE;
+}
+
 /* This is always called with the paint context current */
 void
 gdk_gl_texture_from_surface (cairo_surface_t *surface,
@@ -663,6 +772,13 @@ gdk_gl_texture_from_surface (cairo_surface_t *surface,
   float umax, vmax;
   gboolean use_texture_rectangle;
   guint target;
+  GdkGLContextPaintData *paint_data;
+  GdkTexturedQuad *atlas_quads;
+  int n_atlas_quads;
+  int atlas_x, atlas_y;
+  gboolean wrapped;
+  cairo_rectangle_int_t extents;
+
   paint_context = gdk_gl_context_get_current ();
   if ((_gdk_gl_flags & GDK_GL_SOFTWARE_DRAW_SURFACE) == 0 &&
       paint_context &&
@@ -683,21 +799,21 @@ gdk_gl_texture_from_surface (cairo_surface_t *surface,
   cairo_surface_get_device_offset (surface,
                                    &device_x_offset, &device_y_offset);
 
-  glGenTextures (1, &texture_id);
+  paint_data = gdk_gl_context_get_paint_data (paint_context);
+
+  texture_id = 0;
   if (use_texture_rectangle)
     target = GL_TEXTURE_RECTANGLE_ARB;
   else
     target = GL_TEXTURE_2D;
 
-  glBindTexture (target, texture_id);
   glEnable (GL_SCISSOR_TEST);
 
-  glTexParameteri (target, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-  glTexParameteri (target, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-  glTexParameteri (target, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-  glTexParameteri (target, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-
   n_rects = cairo_region_num_rectangles (region);
+  cairo_region_get_extents (region, &extents);
+
+  atlas_quads = g_new (GdkTexturedQuad, n_rects);
+  n_atlas_quads = 0;
 
 #define FLIP_Y(_y) (unscaled_window_height - (_y))
 
@@ -705,9 +821,6 @@ gdk_gl_texture_from_surface (cairo_surface_t *surface,
     {
       cairo_region_get_rectangle (region, i, &rect);
 
-      glScissor (rect.x * window_scale, FLIP_Y ((rect.y + rect.height) * window_scale),
-                 rect.width * window_scale, rect.height * window_scale);
-
       e = rect;
       e.x *= sx;
       e.y *= sy;
@@ -717,37 +830,104 @@ gdk_gl_texture_from_surface (cairo_surface_t *surface,
       e.height *= sy;
       image = cairo_surface_map_to_image (surface, &e);
 
-      gdk_gl_context_upload_texture (paint_context, image, e.width, e.height, target);
+      if (!use_texture_rectangle &&
+          gdk_gl_atlas_allocate (paint_data, e.width, e.height,
+                                 &atlas_x, &atlas_y, &wrapped))
+        {
+          GdkTexturedQuad quad = {
+            rect.x * window_scale, FLIP_Y(rect.y * window_scale),
+            (rect.x + rect.width) * window_scale, FLIP_Y((rect.y + rect.height) * window_scale),
+            atlas_x / (float) GDK_GL_ATLAS_SIZE, atlas_y / (float) GDK_GL_ATLAS_SIZE,
+            (atlas_x + e.width) / (float) GDK_GL_ATLAS_SIZE, (atlas_y + e.height) / (float) GDK_GL_ATLAS_SIZE,
+          };
+
+          /* The allocator wrapped around, so draw the pending quads
+           * before the upload below overwrites their pixels
+           */
+          if (wrapped && n_atlas_quads > 0)
+            {
+              glScissor (extents.x * window_scale, FLIP_Y ((extents.y + extents.height) * window_scale),
+                         extents.width * window_scale, extents.height * window_scale);
+              glBindTexture (GL_TEXTURE_2D, paint_data->atlas_texture);
+              gdk_gl_texture_quads (paint_context, GL_TEXTURE_2D, n_atlas_quads, atlas_quads);
+              n_atlas_quads = 0;
+            }
 
-      cairo_surface_unmap_image (surface, image);
+          glBindTexture (GL_TEXTURE_2D, paint_data->atlas_texture);
+          glPixelStorei (GL_UNPACK_ALIGNMENT, 4);
+          glPixelStorei (GL_UNPACK_ROW_LENGTH, cairo_image_surface_get_stride (image) / 4);
+          glTexSubImage2D (GL_TEXTURE_2D, 0, atlas_x, atlas_y, e.width, e.height,
+                           GL_BGRA, GL_UNSIGNED_INT_8_8_8_8_REV,
+                           cairo_image_surface_get_data (image));
+          glPixelStorei (GL_UNPACK_ROW_LENGTH, 0);
 
-      if (use_texture_rectangle)
-        {
-          umax = rect.width * sx;
-          vmax = rect.height * sy;
+          atlas_quads[n_atlas_quads++] = quad;
         }
       else
         {
-          umax = 1.0;
-          vmax = 1.0;
+          if (texture_id == 0)
+            {
+              glGenTextures (1, &texture_id);
+              glBindTexture (target, texture_id);
+              glTexParameteri (target, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+              glTexParameteri (target, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+              glTexParameteri (target, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+              glTexParameteri (target, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+            }
+          else
+            glBindTexture (target, texture_id);
+
+          gdk_gl_context_upload_texture (paint_context, image, e.width, e.height, target);
+
+          if (use_texture_rectangle)
+            {
+              umax = rect.width * sx;
+              vmax = rect.height * sy;
+            }
+          else
+            {
+              umax = 1.0;
+              vmax = 1.0;
+            }
+
+          {
+            GdkTexturedQuad quad = {
+              rect.x * window_scale, FLIP_Y(rect.y * window_scale),
+              (rect.x + rect.width) * window_scale, FLIP_Y((rect.y + rect.height) * window_scale),
+              0, 0,
+              umax, vmax,
+            };
+
+            glScissor (rect.x * window_scale, FLIP_Y ((rect.y + rect.height) * window_scale),
+                       rect.width * window_scale, rect.height * window_scale);
+
+            /* We don't want to combine these quads with the rest, because they
+             * have their own textures, and we don't want to upload the unused
+             * source areas to make it one texture. */
+            gdk_gl_texture_quads (paint_context, target, 1, &quad);
+          }
         }
 
-      {
-        GdkTexturedQuad quad = {
-          rect.x * window_scale, FLIP_Y(rect.y * window_scale),
-          (rect.x + rect.width) * window_scale, FLIP_Y((rect.y + rect.height) * window_scale),
-          0, 0,
-          umax, vmax,
-        };
-
-        /* We don't want to combine the quads here, because they have different textures.
-         * And we don't want to upload the unused source areas to make it one texture. */
-        gdk_gl_texture_quads (paint_context, target, 1, &quad);
-      }
+      cairo_surface_unmap_image (surface, image);
     }
 
+  if (n_atlas_quads > 0)
+    {
+      /* Each quad exactly covers one region rectangle, so scissoring
+       * to the region extents is enough for the whole batch
+       */
+      glScissor (extents.x * window_scale, FLIP_Y ((extents.y + extents.height) * window_scale),
+                 extents.width * window_scale, extents.height * window_scale);
+
+      glBindTexture (GL_TEXTURE_2D, paint_data->atlas_texture);
+      gdk_gl_texture_quads (paint_context, GL_TEXTURE_2D, n_atlas_quads, atlas_quads);
+    }
+
+  g_free (atlas_quads);
+
 #undef FLIP_Y
 
   glDisable (GL_SCISSOR_TEST);
-  glDeleteTextures (1, &texture_id);
+  if (texture_id != 0)
+    glDeleteTextures (1, &texture_id);
 }
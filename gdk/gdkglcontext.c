@@ -74,6 +74,24 @@
  * You can check which #GdkGLContext is the current one by using
  * gdk_gl_context_get_current(); you can also unset any #GdkGLContext
  * that is currently set by calling gdk_gl_context_clear_current().
+ *
+ * ## Using a GdkGLContext from another thread ##
+ *
+ * All the #GdkGLContexts created for a #GdkWindow belong to the same
+ * share group, so textures and buffer objects created in one of them
+ * are visible to the others. A context is current per-thread, which
+ * means an additional context created with gdk_window_create_gl_context()
+ * can be made current on a worker thread and used for long-running
+ * work, like uploading textures, without stalling the context used
+ * for painting.
+ *
+ * Sharing makes the objects visible, but it does not order the
+ * commands operating on them. After the worker thread has issued its
+ * GL commands, call gdk_gl_context_insert_fence() on the worker
+ * context and hand the returned fence over to the thread doing the
+ * painting, which passes it to gdk_gl_context_wait_fence() before
+ * using the shared objects. The wait happens on the GPU and does not
+ * block the painting thread.
  */
 
 #include "config.h"
@@ -98,6 +116,7 @@ typedef struct {
 
   guint realized : 1;
   guint use_texture_rectangle : 1;
+  guint has_sync : 1;
   guint has_gl_framebuffer_blit : 1;
   guint has_frame_terminator : 1;
   guint extensions_checked : 1;
@@ -602,6 +621,7 @@ gdk_gl_context_check_extensions (GdkGLContext *context)
 
   priv->has_gl_framebuffer_blit = epoxy_has_gl_extension ("GL_EXT_framebuffer_blit");
   priv->has_frame_terminator = epoxy_has_gl_extension ("GL_GREMEDY_frame_terminator");
+  priv->has_sync = priv->gl_version >= 32 || epoxy_has_gl_extension ("GL_ARB_sync");
 
   if (G_UNLIKELY (_gdk_gl_flags & GDK_GL_TEXTURE_RECTANGLE))
     priv->use_texture_rectangle = TRUE;
@@ -619,12 +639,14 @@ gdk_gl_context_check_extensions (GdkGLContext *context)
                      " - GL_ARB_texture_rectangle: %s\n"
                      " - GL_EXT_framebuffer_blit: %s\n"
                      " - GL_GREMEDY_frame_terminator: %s\n"
+                     " - GL_ARB_sync: %s\n"
                      "Using texture rectangle: %s\n",
                      priv->gl_version / 10, priv->gl_version % 10,
                      has_npot ? "yes" : "no",
                      has_texture_rectangle ? "yes" : "no",
                      priv->has_gl_framebuffer_blit ? "yes" : "no",
                      priv->has_frame_terminator ? "yes" : "no",
+                     priv->has_sync ? "yes" : "no",
                      priv->use_texture_rectangle ? "yes" : "no"));
 
   priv->extensions_checked = TRUE;
@@ -803,6 +825,86 @@ gdk_gl_context_get_current (void)
   return current;
 }
 
+/**
+ * gdk_gl_context_insert_fence:
+ * @context: a #GdkGLContext
+ *
+ * Inserts a fence into the GL command stream of @context and
+ * flushes the stream, so that the fence will eventually be
+ * signalled.
+ *
+ * The @context must be the current one. The returned fence can be
+ * passed to gdk_gl_context_wait_fence() on any #GdkGLContext in the
+ * same share group; the typical use is to make the paint context
+ * wait for texture uploads performed on a worker thread before
+ * sampling from the shared textures.
+ *
+ * If the GL implementation does not support sync objects, this
+ * function falls back to glFinish() and returns %NULL, which
+ * gdk_gl_context_wait_fence() accepts as an already signalled
+ * fence.
+ *
+ * Returns: (transfer full) (nullable): a fence, to be consumed
+ *   by gdk_gl_context_wait_fence()
+ *
+ * Since: 3.18
+ */
+gpointer
+gdk_gl_context_insert_fence (GdkGLContext *context)
+{
+  GdkGLContextPrivate *priv;
+  GLsync sync;
+
+  g_return_val_if_fail (GDK_IS_GL_CONTEXT (context), NULL);
+  g_return_val_if_fail (gdk_gl_context_get_current () == context, NULL);
+
+  priv = gdk_gl_context_get_instance_private (context);
+
+  if (!priv->has_sync)
+    {
+      glFinish ();
+      return NULL;
+    }
+
+  sync = glFenceSync (GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+  /* flush, so the fence becomes visible to the other
+   * contexts in the share group
+   */
+  glFlush ();
+
+  return sync;
+}
+
+/**
+ * gdk_gl_context_wait_fence:
+ * @context: a #GdkGLContext
+ * @fence: (transfer full) (nullable): a fence created with
+ *   gdk_gl_context_insert_fence()
+ *
+ * Makes the GPU wait until the given @fence is signalled before
+ * executing further commands issued on @context, then deletes
+ * the fence.
+ *
+ * The @context must be the current one. The wait is performed
+ * server-side; this function does not block.
+ *
+ * Since: 3.18
+ */
+void
+gdk_gl_context_wait_fence (GdkGLContext *context,
+                           gpointer      fence)
+{
+  g_return_if_fail (GDK_IS_GL_CONTEXT (context));
+  g_return_if_fail (gdk_gl_context_get_current () == context);
+
+  if (fence == NULL)
+    return;
+
+  glWaitSync (fence, 0, GL_TIMEOUT_IGNORED);
+  glDeleteSync (fence);
+}
+
 /**
  * gdk_gl_get_flags:
  *
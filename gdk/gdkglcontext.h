@@ -82,6 +82,12 @@ GdkGLContext *          gdk_gl_context_get_current              (void);
 GDK_AVAILABLE_IN_3_16
 void                    gdk_gl_context_clear_current            (void);
 
+GDK_AVAILABLE_IN_3_18
+gpointer                gdk_gl_context_insert_fence             (GdkGLContext  *context);
+GDK_AVAILABLE_IN_3_18
+void                    gdk_gl_context_wait_fence               (GdkGLContext  *context,
+                                                                 gpointer       fence);
+
 G_END_DECLS
 
 #endif /* __GDK_GL_CONTEXT_H__ */
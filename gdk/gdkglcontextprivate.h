@@ -61,12 +61,21 @@ typedef struct {
 typedef struct {
   guint vertex_array_object;
   guint tmp_framebuffer;
+  guint tmp_framebuffer2;
   guint tmp_vertex_buffer;
 
   GdkGLContextProgram texture_2d_quad_program;
   GdkGLContextProgram texture_rect_quad_program;
 
   GdkGLContextProgram *current_program;
+
+  /* Atlas texture that small surface uploads get packed into,
+   * with the state of its shelf allocator; see gdkgl.c
+   */
+  guint atlas_texture;
+  int atlas_x;
+  int atlas_y;
+  int atlas_row_height;
 } GdkGLContextPaintData;
 
 void                    gdk_gl_context_upload_texture           (GdkGLContext    *context,
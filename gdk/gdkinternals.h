@@ -299,14 +299,34 @@ struct _GdkWindow
   } current_paint;
   GdkGLContext *gl_paint_context;
 
+  /* The backing-store surface of the last finished paint, kept around
+   * so the next paint can recycle it instead of allocating a new one */
+  struct {
+    cairo_surface_t *surface;
+    cairo_content_t content;
+    int width;
+    int height;
+    int scale;
+  } paint_cache;
+
   cairo_region_t *update_area;
   guint update_freeze_count;
   /* This is the update_area that was in effect when the current expose
      started. It may be smaller than the expose area if we'e painting
      more than we have to, but it represents the "true" damage. */
   cairo_region_t *active_update_area;
-  /* We store the old expose areas to support buffer-age optimizations */
-  cairo_region_t *old_updated_area[2];
+  /* We store the old expose areas to support buffer-age optimizations;
+     one entry per frame the backbuffer may lag behind, so a buffer
+     age of up to G_N_ELEMENTS + 1 still allows a partial repaint */
+  cairo_region_t *old_updated_area[4];
+  /* Total number of pixels exposed since creation, for update profiling */
+  guint64 updated_area_pixels;
+
+  /* Title waiting to be sent to the backend on the next frame */
+  gchar *pending_title;
+
+  /* Maximum frame rate for this window's clock, 0 for unlimited */
+  guint max_frame_rate;
 
   GdkWindowState state;
 
@@ -362,6 +362,8 @@ gdk_offscreen_window_move_resize_internal (GdkWindow *window,
                                            gboolean   send_expose_events)
 {
   GdkOffscreenWindow *offscreen;
+  gboolean moved, contents_kept;
+  gint old_width, old_height;
 
   offscreen = GDK_OFFSCREEN_WINDOW (window->impl);
 
@@ -373,6 +375,11 @@ gdk_offscreen_window_move_resize_internal (GdkWindow *window,
   if (window->destroyed)
     return;
 
+  moved = window->x != x || window->y != y;
+  old_width = window->width;
+  old_height = window->height;
+  contents_kept = FALSE;
+
   window->x = x;
   window->y = y;
 
@@ -398,13 +405,38 @@ gdk_offscreen_window_move_resize_internal (GdkWindow *window,
           cairo_destroy (cr);
 
           cairo_surface_destroy (old_surface);
+          contents_kept = TRUE;
         }
     }
 
   if (GDK_WINDOW_IS_MAPPED (window))
     {
-      /* TODO: Only invalidate new area, i.e. for larger windows */
-      gdk_window_invalidate_rect (window, NULL, TRUE);
+      if (contents_kept && !moved)
+        {
+          GdkRectangle rect;
+
+          /* The old contents were copied over above, so only the
+           * newly exposed strips need to be redrawn */
+          if (window->width > old_width)
+            {
+              rect.x = old_width;
+              rect.y = 0;
+              rect.width = window->width - old_width;
+              rect.height = window->height;
+              gdk_window_invalidate_rect (window, &rect, TRUE);
+            }
+          if (window->height > old_height)
+            {
+              rect.x = 0;
+              rect.y = old_height;
+              rect.width = window->width;
+              rect.height = window->height - old_height;
+              gdk_window_invalidate_rect (window, &rect, TRUE);
+            }
+        }
+      else
+        gdk_window_invalidate_rect (window, NULL, TRUE);
+
       _gdk_synthesize_crossing_events_for_geometry_change (window);
     }
 }
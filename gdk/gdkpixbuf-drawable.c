@@ -208,6 +208,114 @@ convert_no_alpha (guchar *dest_data,
   }
 }
 
+typedef struct {
+  guchar   *dest_data;
+  int       dest_stride;
+  guchar   *src_data;
+  int       src_stride;
+  int       src_x;
+  int       src_y;
+  int       width;
+  int       height;
+  gboolean  alpha;
+} ConvertBand;
+
+static void
+convert_band (ConvertBand *band)
+{
+  if (band->alpha)
+    convert_alpha (band->dest_data, band->dest_stride,
+                   band->src_data, band->src_stride,
+                   band->src_x, band->src_y,
+                   band->width, band->height);
+  else
+    convert_no_alpha (band->dest_data, band->dest_stride,
+                      band->src_data, band->src_stride,
+                      band->src_x, band->src_y,
+                      band->width, band->height);
+}
+
+static gpointer
+convert_band_thread (gpointer data)
+{
+  convert_band (data);
+
+  return NULL;
+}
+
+/* Don't bother spawning threads for images where the per-band
+ * work wouldn't clearly dominate the thread startup cost.
+ */
+#define MIN_BAND_HEIGHT 256
+
+static void
+convert_surface_data (guchar   *dest_data,
+                      int       dest_stride,
+                      guchar   *src_data,
+                      int       src_stride,
+                      int       src_x,
+                      int       src_y,
+                      int       width,
+                      int       height,
+                      gboolean  alpha)
+{
+  GThread **threads;
+  ConvertBand *bands;
+  int n_bands, band_height;
+  int i;
+
+  n_bands = MIN (g_get_num_processors (), height / MIN_BAND_HEIGHT);
+
+  if (n_bands <= 1)
+    {
+      ConvertBand band = { dest_data, dest_stride,
+                           src_data, src_stride,
+                           src_x, src_y,
+                           width, height,
+                           alpha };
+
+      convert_band (&band);
+      return;
+    }
+
+  /* Rows are independent, so slice the image into horizontal bands
+   * and convert them in parallel; the last band runs on this thread
+   * and picks up the remainder rows.
+   */
+  band_height = height / n_bands;
+  bands = g_newa (ConvertBand, n_bands);
+  threads = g_newa (GThread *, n_bands);
+
+  for (i = 0; i < n_bands; i++)
+    {
+      bands[i].dest_data = dest_data + (gsize) i * band_height * dest_stride;
+      bands[i].dest_stride = dest_stride;
+      bands[i].src_data = src_data;
+      bands[i].src_stride = src_stride;
+      bands[i].src_x = src_x;
+      bands[i].src_y = src_y + i * band_height;
+      bands[i].width = width;
+      bands[i].height = (i == n_bands - 1) ? height - i * band_height
+                                           : band_height;
+      bands[i].alpha = alpha;
+
+      if (i < n_bands - 1)
+        threads[i] = g_thread_try_new ("gdk-pixbuf-convert",
+                                       convert_band_thread,
+                                       &bands[i], NULL);
+      else
+        threads[i] = NULL;
+    }
+
+  for (i = 0; i < n_bands; i++)
+    {
+      if (threads[i])
+        g_thread_join (threads[i]);
+      else
+        convert_band (&bands[i]);
+    }
+}
+
 /**
  * gdk_pixbuf_get_from_surface:
  * @surface: surface to copy from
@@ -265,20 +373,13 @@ gdk_pixbuf_get_from_surface  (cairo_surface_t *surface,
       return NULL;
     }
 
-  if (gdk_pixbuf_get_has_alpha (dest))
-    convert_alpha (gdk_pixbuf_get_pixels (dest),
-                   gdk_pixbuf_get_rowstride (dest),
-                   cairo_image_surface_get_data (surface),
-                   cairo_image_surface_get_stride (surface),
-                   src_x, src_y,
-                   width, height);
-  else
-    convert_no_alpha (gdk_pixbuf_get_pixels (dest),
-                      gdk_pixbuf_get_rowstride (dest),
-                      cairo_image_surface_get_data (surface),
-                      cairo_image_surface_get_stride (surface),
-                      src_x, src_y,
-                      width, height);
+  convert_surface_data (gdk_pixbuf_get_pixels (dest),
+                        gdk_pixbuf_get_rowstride (dest),
+                        cairo_image_surface_get_data (surface),
+                        cairo_image_surface_get_stride (surface),
+                        src_x, src_y,
+                        width, height,
+                        gdk_pixbuf_get_has_alpha (dest));
 
   cairo_surface_destroy (surface);
   return dest;
@@ -132,43 +132,59 @@ parse_rgb_value (const gchar  *str,
   return TRUE;
 }
 
-/**
- * gdk_rgba_parse:
- * @rgba: the #GdkRGBA to fill in
- * @spec: the string specifying the color
- *
- * Parses a textual representation of a color, filling in
- * the @red, @green, @blue and @alpha fields of the @rgba #GdkRGBA.
- *
- * The string can be either one of:
- * - A standard name (Taken from the X11 rgb.txt file).
- * - A hexadecimal value in the form “\#rgb”, “\#rrggbb”,
- *   “\#rrrgggbbb” or ”\#rrrrggggbbbb”
- * - A RGB color in the form “rgb(r,g,b)” (In this case the color will
- *   have full opacity)
- * - A RGBA color in the form “rgba(r,g,b,a)”
- *
- * Where “r”, “g”, “b” and “a” are respectively the red, green, blue and
- * alpha color values. In the last two cases, r g and b are either integers
- * in the range 0 to 255 or precentage values in the range 0% to 100%, and
- * a is a floating point value in the range 0 to 1.
- *
- * Returns: %TRUE if the parsing succeeded
- *
- * Since: 3.0
+/* Parses the hex digits after a '#'; we accept the same forms that
+ * pango_color_parse() does: 3, 6, 9 or 12 digits. Doing it here
+ * avoids the round trip through Pango for the most common color
+ * syntax in CSS and builder files.
  */
-gboolean
-gdk_rgba_parse (GdkRGBA     *rgba,
-                const gchar *spec)
+static gboolean
+parse_hex_color (const gchar *str,
+                 GdkRGBA     *rgba)
+{
+  gdouble channels[3];
+  gsize len, digits;
+  gsize i, j;
+
+  len = strlen (str);
+  if (len != 3 && len != 6 && len != 9 && len != 12)
+    return FALSE;
+
+  digits = len / 3;
+
+  for (i = 0; i < 3; i++)
+    {
+      guint value = 0;
+
+      for (j = 0; j < digits; j++)
+        {
+          gint hex = g_ascii_xdigit_value (str[i * digits + j]);
+
+          if (hex < 0)
+            return FALSE;
+
+          value = (value << 4) | hex;
+        }
+
+      channels[i] = value / (gdouble) ((1 << (4 * digits)) - 1);
+    }
+
+  rgba->red = channels[0];
+  rgba->green = channels[1];
+  rgba->blue = channels[2];
+  rgba->alpha = 1;
+
+  return TRUE;
+}
+
+static gboolean
+parse_rgba_spec (GdkRGBA     *rgba,
+                 const gchar *spec)
 {
   gboolean has_alpha;
   gdouble r, g, b, a;
   gchar *str = (gchar *) spec;
   gchar *p;
 
-  g_return_val_if_fail (spec != NULL, FALSE);
-
-
   if (strncmp (str, "rgba", 4) == 0)
     {
       has_alpha = TRUE;
@@ -180,13 +196,15 @@ gdk_rgba_parse (GdkRGBA     *rgba,
       a = 1;
       str += 3;
     }
+  else if (*str == '#')
+    {
+      return parse_hex_color (str + 1, rgba);
+    }
   else
     {
       PangoColor pango_color;
 
-      /* Resort on PangoColor for rgb.txt color
-       * map and '#' prefixed colors
-       */
+      /* Resort on PangoColor for rgb.txt color map */
       if (pango_color_parse (&pango_color, str))
         {
           if (rgba)
@@ -277,6 +295,84 @@ gdk_rgba_parse (GdkRGBA     *rgba,
 
 #undef SKIP_WHITESPACES
 
+/* A small direct-mapped cache of recently parsed specifications;
+ * CSS and builder loading tend to parse the same few color strings
+ * over and over again.
+ */
+#define RGBA_CACHE_SIZE 64
+
+typedef struct {
+  gchar *spec;
+  GdkRGBA rgba;
+} RgbaCacheEntry;
+
+static RgbaCacheEntry rgba_cache[RGBA_CACHE_SIZE];
+G_LOCK_DEFINE_STATIC (rgba_cache);
+
+/**
+ * gdk_rgba_parse:
+ * @rgba: the #GdkRGBA to fill in
+ * @spec: the string specifying the color
+ *
+ * Parses a textual representation of a color, filling in
+ * the @red, @green, @blue and @alpha fields of the @rgba #GdkRGBA.
+ *
+ * The string can be either one of:
+ * - A standard name (Taken from the X11 rgb.txt file).
+ * - A hexadecimal value in the form “\#rgb”, “\#rrggbb”,
+ *   “\#rrrgggbbb” or ”\#rrrrggggbbbb”
+ * - A RGB color in the form “rgb(r,g,b)” (In this case the color will
+ *   have full opacity)
+ * - A RGBA color in the form “rgba(r,g,b,a)”
+ *
+ * Where “r”, “g”, “b” and “a” are respectively the red, green, blue and
+ * alpha color values. In the last two cases, r g and b are either integers
+ * in the range 0 to 255 or precentage values in the range 0% to 100%, and
+ * a is a floating point value in the range 0 to 1.
+ *
+ * Returns: %TRUE if the parsing succeeded
+ *
+ * Since: 3.0
+ */
+gboolean
+gdk_rgba_parse (GdkRGBA     *rgba,
+                const gchar *spec)
+{
+  RgbaCacheEntry *entry;
+  GdkRGBA parsed;
+
+  g_return_val_if_fail (spec != NULL, FALSE);
+
+  entry = &rgba_cache[g_str_hash (spec) % RGBA_CACHE_SIZE];
+
+  G_LOCK (rgba_cache);
+  if (entry->spec != NULL && strcmp (entry->spec, spec) == 0)
+    {
+      parsed = entry->rgba;
+      G_UNLOCK (rgba_cache);
+
+      if (rgba)
+        *rgba = parsed;
+
+      return TRUE;
+    }
+  G_UNLOCK (rgba_cache);
+
+  if (!parse_rgba_spec (&parsed, spec))
+    return FALSE;
+
+  G_LOCK (rgba_cache);
+  g_free (entry->spec);
+  entry->spec = g_strdup (spec);
+  entry->rgba = parsed;
+  G_UNLOCK (rgba_cache);
+
+  if (rgba)
+    *rgba = parsed;
+
+  return TRUE;
+}
+
 /**
  * gdk_rgba_hash:
  * @p: (type GdkRGBA): a #GdkRGBA pointer
@@ -187,6 +187,9 @@ static void gdk_window_invalidate_rect_full (GdkWindow          *window,
 					     gboolean            invalidate_children);
 static cairo_surface_t *gdk_window_ref_impl_surface (GdkWindow *window);
 
+static void gdk_window_flush_pending_title (GdkWindow *window);
+static void gdk_window_apply_frame_rate_limit (GdkWindow *window);
+
 static void gdk_window_set_frame_clock (GdkWindow      *window,
                                         GdkFrameClock  *clock);
 
@@ -487,6 +490,8 @@ gdk_window_finalize (GObject *object)
       window->impl_window = NULL;
     }
 
+  g_free (window->pending_title);
+
   if (window->shape)
     cairo_region_destroy (window->shape);
 
@@ -885,6 +890,7 @@ recompute_visible_regions_internal (GdkWindow *private,
   GList *l;
   GdkWindow *child;
   cairo_region_t *new_clip;
+  cairo_region_t *old_clip = NULL;
   gboolean clip_region_changed;
   gboolean abs_pos_changed;
   int old_abs_x, old_abs_y;
@@ -941,8 +947,7 @@ recompute_visible_regions_internal (GdkWindow *private,
 	  !cairo_region_equal (private->clip_region, new_clip))
 	clip_region_changed = TRUE;
 
-      if (private->clip_region)
-	cairo_region_destroy (private->clip_region);
+      old_clip = private->clip_region;
       private->clip_region = new_clip;
     }
 
@@ -986,9 +991,35 @@ recompute_visible_regions_internal (GdkWindow *private,
   if ((abs_pos_changed || clip_region_changed || recalculate_children) &&
       private->window_type != GDK_WINDOW_ROOT)
     {
+      cairo_region_t *clip_diff = NULL;
+
+      /* If only the clip changed, the clip of a child whose bounds
+       * don't overlap the area where the old and new clip differ
+       * can't have changed, so it (and its whole subtree) can be
+       * skipped. With many children this turns a full-tree walk into
+       * one over the windows actually affected.
+       */
+      if (clip_region_changed && !abs_pos_changed && !recalculate_children &&
+	  old_clip != NULL)
+	{
+	  clip_diff = cairo_region_copy (old_clip);
+	  cairo_region_xor (clip_diff, private->clip_region);
+	}
+
       for (l = private->children; l; l = l->next)
 	{
 	  child = l->data;
+
+	  if (clip_diff != NULL)
+	    {
+	      r.x = child->x;
+	      r.y = child->y;
+	      r.width = child->width;
+	      r.height = child->height;
+	      if (cairo_region_contains_rectangle (clip_diff, &r) == CAIRO_REGION_OVERLAP_OUT)
+		continue;
+	    }
+
 	  /* Only recalculate clip if the the clip region changed, otherwise
 	   * there is no way the child clip region could change (its has not e.g. moved)
 	   * Except if recalculate_children is set to force child updates
@@ -997,7 +1028,13 @@ recompute_visible_regions_internal (GdkWindow *private,
 					      recalculate_clip && (clip_region_changed || recalculate_children),
 					      FALSE);
 	}
+
+      if (clip_diff)
+	cairo_region_destroy (clip_diff);
     }
+
+  if (old_clip)
+    cairo_region_destroy (old_clip);
 }
 
 /* Call this when private has changed in one or more of these ways:
@@ -1034,7 +1071,7 @@ gdk_window_clear_old_updated_area (GdkWindow *window)
 {
   int i;
 
-  for (i = 0; i < 2; i++)
+  for (i = 0; i < G_N_ELEMENTS (window->old_updated_area); i++)
     {
       if (window->old_updated_area[i])
         {
@@ -1048,9 +1085,12 @@ static void
 gdk_window_append_old_updated_area (GdkWindow *window,
                                     cairo_region_t *region)
 {
-  if (window->old_updated_area[1])
-    cairo_region_destroy (window->old_updated_area[1]);
-  window->old_updated_area[1] = window->old_updated_area[0];
+  int i;
+
+  if (window->old_updated_area[G_N_ELEMENTS (window->old_updated_area) - 1])
+    cairo_region_destroy (window->old_updated_area[G_N_ELEMENTS (window->old_updated_area) - 1]);
+  for (i = G_N_ELEMENTS (window->old_updated_area) - 1; i > 0; i--)
+    window->old_updated_area[i] = window->old_updated_area[i - 1];
   window->old_updated_area[0] = cairo_region_reference (region);
 }
 
@@ -1872,9 +1912,28 @@ window_remove_from_pointer_info (GdkWindow  *window,
                                      window);
 }
 
+static void
+gdk_window_drop_paint_cache (GdkWindow *window)
+{
+  if (window->paint_cache.surface)
+    {
+      cairo_surface_destroy (window->paint_cache.surface);
+      window->paint_cache.surface = NULL;
+    }
+}
+
 static void
 gdk_window_free_current_paint (GdkWindow *window)
 {
+  /* Keep the backing store around for the next paint. Recording
+   * surfaces are not recycled, they would keep accumulating the
+   * drawing commands of every frame. */
+  if (window->current_paint.surface_needs_composite &&
+      window->paint_cache.surface == NULL &&
+      cairo_surface_get_type (window->current_paint.surface) != CAIRO_SURFACE_TYPE_RECORDING &&
+      cairo_surface_status (window->current_paint.surface) == CAIRO_STATUS_SUCCESS)
+    window->paint_cache.surface = cairo_surface_reference (window->current_paint.surface);
+
   cairo_surface_destroy (window->current_paint.surface);
   window->current_paint.surface = NULL;
 
@@ -2003,6 +2062,7 @@ _gdk_window_destroy_hierarchy (GdkWindow *window,
             }
 
           gdk_window_free_current_paint (window);
+          gdk_window_drop_paint_cache (window);
 
           if (window->background)
             {
@@ -2942,10 +3002,37 @@ gdk_window_begin_paint_region (GdkWindow       *window,
 
   if (needs_surface)
     {
-      window->current_paint.surface = gdk_window_create_similar_surface (window,
-                                                                         surface_content,
-                                                                         MAX (clip_box.width, 1),
-                                                                         MAX (clip_box.height, 1));
+      int width = MAX (clip_box.width, 1);
+      int height = MAX (clip_box.height, 1);
+      int scale = gdk_window_get_scale_factor (window);
+
+      /* Only recycle the old backing store if it fits the paint and
+       * isn't wildly oversized for it */
+      if (window->paint_cache.surface != NULL &&
+          (window->paint_cache.content != surface_content ||
+           window->paint_cache.scale != scale ||
+           window->paint_cache.width < width ||
+           window->paint_cache.height < height ||
+           window->paint_cache.width > 2 * width ||
+           window->paint_cache.height > 2 * height))
+        gdk_window_drop_paint_cache (window);
+
+      if (window->paint_cache.surface != NULL)
+        {
+          window->current_paint.surface = window->paint_cache.surface;
+          window->paint_cache.surface = NULL;
+        }
+      else
+        {
+          window->current_paint.surface = gdk_window_create_similar_surface (window,
+                                                                             surface_content,
+                                                                             width,
+                                                                             height);
+          window->paint_cache.content = surface_content;
+          window->paint_cache.width = width;
+          window->paint_cache.height = height;
+          window->paint_cache.scale = scale;
+        }
       sx = sy = 1;
       cairo_surface_get_device_scale (window->current_paint.surface, &sx, &sy);
       cairo_surface_set_device_offset (window->current_paint.surface, -clip_box.x*sx, -clip_box.y*sy);
@@ -3606,6 +3693,23 @@ gdk_window_update_native_shapes (GdkWindow *window)
     }
 }
 
+static guint64
+region_area (const cairo_region_t *region)
+{
+  cairo_rectangle_int_t rect;
+  guint64 area = 0;
+  int i, n;
+
+  n = cairo_region_num_rectangles (region);
+  for (i = 0; i < n; i++)
+    {
+      cairo_region_get_rectangle (region, i, &rect);
+      area += (guint64) rect.width * rect.height;
+    }
+
+  return area;
+}
+
 /* Process and remove any invalid area on the native window by creating
  * expose events for the window and all non-native descendants.
  */
@@ -3656,6 +3760,8 @@ gdk_window_process_updates_internal (GdkWindow *window)
 	  /* Clip to part visible in impl window */
 	  cairo_region_intersect (expose_region, window->clip_region);
 
+	  window->updated_area_pixels += region_area (expose_region);
+
 	  if (gdk_display_get_debug_updates (display))
 	    {
               cairo_region_t *swap_region = cairo_region_copy (expose_region);
@@ -4240,6 +4346,28 @@ _gdk_window_invalidate_for_expose (GdkWindow       *window,
 }
 
 
+/**
+ * gdk_window_get_updated_area_pixels:
+ * @window: a #GdkWindow
+ *
+ * Returns the total number of pixels that have been repainted on
+ * @window since it was created, i.e. the summed area of all regions
+ * handed to the update process. Comparing the counter across frames
+ * tells you how much repainting your invalidations actually caused,
+ * which makes it useful for profiling redraw behavior.
+ *
+ * Returns: cumulative repainted area of @window, in pixels
+ *
+ * Since: 3.18
+ **/
+guint64
+gdk_window_get_updated_area_pixels (GdkWindow *window)
+{
+  g_return_val_if_fail (GDK_IS_WINDOW (window), 0);
+
+  return gdk_window_get_impl_window (window)->updated_area_pixels;
+}
+
 /**
  * gdk_window_get_update_area:
  * @window: a #GdkWindow
@@ -4951,6 +5079,7 @@ gdk_window_show_internal (GdkWindow *window, gboolean raise)
      Also show if not done by gdk_window_update_viewable. */
   if (gdk_window_has_impl (window) && (was_viewable || !did_show))
     {
+      gdk_window_flush_pending_title (window);
       impl_class = GDK_WINDOW_IMPL_GET_CLASS (window->impl);
       impl_class->show (window, !did_show ? was_mapped : TRUE);
     }
@@ -9990,6 +10119,28 @@ void
 gdk_window_set_title (GdkWindow   *window,
 		      const gchar *title)
 {
+  GdkFrameClock *frame_clock;
+
+  /* Setting the title is a synchronous-ish protocol write on most
+   * backends. Apps that update titles at high frequency only need the
+   * last one per frame to ever reach the screen, so batch the update
+   * up until the next flush-events phase when a frame clock is
+   * running. */
+  frame_clock = gdk_window_get_frame_clock (window);
+  if (frame_clock != NULL && GDK_WINDOW_IS_MAPPED (window))
+    {
+      if (g_strcmp0 (window->pending_title, title) != 0)
+        {
+          g_free (window->pending_title);
+          window->pending_title = g_strdup (title);
+          gdk_frame_clock_request_phase (frame_clock,
+                                         GDK_FRAME_CLOCK_PHASE_FLUSH_EVENTS);
+        }
+      return;
+    }
+
+  g_free (window->pending_title);
+  window->pending_title = NULL;
   GDK_WINDOW_IMPL_GET_CLASS (window->impl)->set_title (window, title);
 }
 
@@ -11166,6 +11317,20 @@ gdk_property_delete (GdkWindow *window,
   GDK_WINDOW_IMPL_GET_CLASS (window->impl)->delete_property (window, property);
 }
 
+static void
+gdk_window_flush_pending_title (GdkWindow *window)
+{
+  gchar *title;
+
+  if (window->pending_title == NULL || GDK_WINDOW_DESTROYED (window))
+    return;
+
+  title = window->pending_title;
+  window->pending_title = NULL;
+  GDK_WINDOW_IMPL_GET_CLASS (window->impl)->set_title (window, title);
+  g_free (title);
+}
+
 static void
 gdk_window_flush_events (GdkFrameClock *clock,
                          void          *data)
@@ -11174,6 +11339,7 @@ gdk_window_flush_events (GdkFrameClock *clock,
   GdkDisplay *display;
 
   window = GDK_WINDOW (data);
+  gdk_window_flush_pending_title (window);
 
   display = gdk_window_get_display (window);
   _gdk_event_queue_flush (display);
@@ -11258,6 +11424,69 @@ gdk_window_set_frame_clock (GdkWindow     *window,
     }
 
   window->frame_clock = clock;
+
+  gdk_window_apply_frame_rate_limit (window);
+}
+
+static void
+gdk_window_apply_frame_rate_limit (GdkWindow *window)
+{
+  if (window->frame_clock != NULL &&
+      GDK_IS_FRAME_CLOCK_IDLE (window->frame_clock))
+    _gdk_frame_clock_idle_set_min_frame_interval (GDK_FRAME_CLOCK_IDLE (window->frame_clock),
+                                                  window->max_frame_rate == 0 ? 0 :
+                                                  G_USEC_PER_SEC / window->max_frame_rate);
+}
+
+/**
+ * gdk_window_set_frame_rate_limit:
+ * @window: a toplevel #GdkWindow
+ * @max_frame_rate: maximum number of frames per second, or 0 to run
+ *     at the full refresh rate again
+ *
+ * Limits how often the frame clock driving @window ticks. Animations
+ * and repaints on the window then run at most @max_frame_rate times
+ * per second instead of at the display's refresh rate.
+ *
+ * This is useful for windows the user isn't paying attention to, such
+ * as unfocused windows showing background status, where a reduced
+ * update rate goes unnoticed but saves considerable CPU time.
+ *
+ * Since: 3.18
+ */
+void
+gdk_window_set_frame_rate_limit (GdkWindow *window,
+                                 guint      max_frame_rate)
+{
+  g_return_if_fail (GDK_IS_WINDOW (window));
+
+  window = gdk_window_get_toplevel (window);
+
+  if (window->max_frame_rate == max_frame_rate)
+    return;
+
+  window->max_frame_rate = max_frame_rate;
+  gdk_window_apply_frame_rate_limit (window);
+}
+
+/**
+ * gdk_window_get_frame_rate_limit:
+ * @window: a toplevel #GdkWindow
+ *
+ * Returns the frame rate limit set with
+ * gdk_window_set_frame_rate_limit().
+ *
+ * Returns: the maximum number of frames per second, or 0 if the
+ *     window runs at the full refresh rate
+ *
+ * Since: 3.18
+ */
+guint
+gdk_window_get_frame_rate_limit (GdkWindow *window)
+{
+  g_return_val_if_fail (GDK_IS_WINDOW (window), 0);
+
+  return gdk_window_get_toplevel (window)->max_frame_rate;
 }
 
 /**
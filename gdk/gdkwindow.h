@@ -70,7 +70,11 @@ typedef enum
  *  [Offscreen Windows][OFFSCREEN-WINDOWS]). Since 2.18
  * @GDK_WINDOW_SUBSURFACE: subsurface-based window; This window is visually
  *  tied to a toplevel, and is moved/stacked with it. Currently this window
- *  type is only implemented in Wayland. Since 3.14
+ *  type is only implemented in Wayland. A subsurface window is created
+ *  with the root window as parent and positioned relative to the toplevel
+ *  set with gdk_window_set_transient_for(). It has its own backing buffer
+ *  and frame clock, so frequently repainted overlay content does not
+ *  force the toplevel to redraw or re-upload its buffer. Since 3.14
  *
  * Describes the kind of window.
  */
@@ -1124,6 +1128,14 @@ GDK_AVAILABLE_IN_3_16
 GdkGLContext * gdk_window_create_gl_context    (GdkWindow      *window,
                                                 GError        **error);
 
+GDK_AVAILABLE_IN_3_18
+guint64    gdk_window_get_updated_area_pixels  (GdkWindow      *window);
+GDK_AVAILABLE_IN_3_18
+void       gdk_window_set_frame_rate_limit     (GdkWindow      *window,
+                                                guint           max_frame_rate);
+GDK_AVAILABLE_IN_3_18
+guint      gdk_window_get_frame_rate_limit     (GdkWindow      *window);
+
 G_END_DECLS
 
 #endif /* __GDK_WINDOW_H__ */
@@ -45,7 +45,9 @@ struct _GdkWaylandTouchData
   gdouble y;
   GdkWindow *window;
   uint32_t touch_down_serial;
+  uint32_t last_motion_time;
   guint initial_touch : 1;
+  guint has_pending_motion : 1;
 };
 
 struct _GdkWaylandDeviceData
@@ -1118,7 +1120,8 @@ keyboard_handle_keymap (void               *data,
 {
   GdkWaylandDeviceData *device = data;
 
-  _gdk_wayland_keymap_update_from_fd (device->keymap, format, fd, size);
+  if (!_gdk_wayland_keymap_update_from_fd (device->keymap, format, fd, size))
+    return;
 
   g_signal_emit_by_name (device->keymap, "keys-changed");
   g_signal_emit_by_name (device->keymap, "state-changed");
@@ -1607,6 +1610,12 @@ touch_handle_up (void            *data,
   _gdk_wayland_display_update_serial (display, serial);
 
   touch = gdk_wayland_device_get_touch (device, id);
+
+  /* The end event carries the final coordinates, so any motion still
+   * pending for this sequence is superseded.
+   */
+  touch->has_pending_motion = FALSE;
+
   event = _create_touch_event (device, touch, GDK_TOUCH_END, time);
 
   GDK_NOTE (EVENTS,
@@ -1626,24 +1635,44 @@ touch_handle_motion (void            *data,
 {
   GdkWaylandDeviceData *device = data;
   GdkWaylandTouchData *touch;
-  GdkEvent *event;
 
+  /* Motion events within the same frame belong to a single logical
+   * state change; only record them here and deliver one update per
+   * sequence when the frame event closes the group.
+   */
   touch = gdk_wayland_device_get_touch (device, id);
   touch->x = wl_fixed_to_double (x);
   touch->y = wl_fixed_to_double (y);
-
-  event = _create_touch_event (device, touch, GDK_TOUCH_UPDATE, time);
-
-  GDK_NOTE (EVENTS,
-            g_message ("touch update %f %f", event->touch.x, event->touch.y));
-
-  _gdk_wayland_display_deliver_event (device->display, event);
+  touch->last_motion_time = time;
+  touch->has_pending_motion = TRUE;
 }
 
 static void
 touch_handle_frame (void            *data,
                     struct wl_touch *wl_touch)
 {
+  GdkWaylandDeviceData *device = data;
+  GdkWaylandTouchData *touch;
+  GHashTableIter iter;
+  GdkEvent *event;
+
+  g_hash_table_iter_init (&iter, device->touches);
+
+  while (g_hash_table_iter_next (&iter, NULL, (gpointer *) &touch))
+    {
+      if (!touch->has_pending_motion)
+        continue;
+
+      touch->has_pending_motion = FALSE;
+
+      event = _create_touch_event (device, touch, GDK_TOUCH_UPDATE,
+                                   touch->last_motion_time);
+
+      GDK_NOTE (EVENTS,
+                g_message ("touch update %f %f", event->touch.x, event->touch.y));
+
+      _gdk_wayland_display_deliver_event (device->display, event);
+    }
 }
 
 static void
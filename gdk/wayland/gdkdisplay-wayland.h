@@ -107,6 +107,7 @@ struct _GdkWaylandDisplay
   guint have_egl_buffer_age : 1;
   guint have_egl_swap_buffers_with_damage : 1;
   guint have_egl_surfaceless_context : 1;
+  guint have_egl_image_dma_buf_import : 1;
 };
 
 struct _GdkWaylandDisplayClass
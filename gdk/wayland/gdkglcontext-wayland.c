@@ -33,6 +33,8 @@
 
 #include "gdkintl.h"
 
+#include <epoxy/gl.h>
+
 G_DEFINE_TYPE (GdkWaylandGLContext, gdk_wayland_gl_context, GDK_TYPE_GL_CONTEXT)
 
 static void gdk_x11_gl_context_dispose (GObject *gobject);
@@ -67,23 +69,25 @@ gdk_wayland_window_invalidate_for_new_frame (GdkWindow      *window,
     }
 
   invalidate_all = FALSE;
-  if (buffer_age == 0 || buffer_age >= 4)
+  if (buffer_age == 0 ||
+      buffer_age > (int) G_N_ELEMENTS (window->old_updated_area) + 1)
     invalidate_all = TRUE;
   else
     {
-      if (buffer_age >= 2)
-        {
-          if (window->old_updated_area[0])
-            cairo_region_union (update_area, window->old_updated_area[0]);
-          else
-            invalidate_all = TRUE;
-        }
-      if (buffer_age >= 3)
+      int i;
+
+      /* A buffer of age N contains the frame N swaps ago, so we need
+       * to redraw what changed in each of the N - 1 frames since then
+       */
+      for (i = 0; i + 2 <= buffer_age; i++)
         {
-          if (window->old_updated_area[1])
-            cairo_region_union (update_area, window->old_updated_area[1]);
+          if (window->old_updated_area[i])
+            cairo_region_union (update_area, window->old_updated_area[i]);
           else
-            invalidate_all = TRUE;
+            {
+              invalidate_all = TRUE;
+              break;
+            }
         }
     }
 
@@ -259,6 +263,10 @@ gdk_wayland_display_init_gl (GdkDisplay *display)
   display_wayland->have_egl_surfaceless_context =
     epoxy_has_egl_extension (dpy, "EGL_KHR_surfaceless_context");
 
+  display_wayland->have_egl_image_dma_buf_import =
+    epoxy_has_egl_extension (dpy, "EGL_KHR_image_base") &&
+    epoxy_has_egl_extension (dpy, "EGL_EXT_image_dma_buf_import");
+
   GDK_NOTE (OPENGL,
             g_print ("EGL API version %d.%d found\n"
                      " - Vendor: %s\n"
@@ -458,3 +466,105 @@ gdk_wayland_display_make_gl_context_current (GdkDisplay   *display,
 
   return TRUE;
 }
+
+/**
+ * gdk_wayland_gl_context_import_dmabuf:
+ * @context: a Wayland #GdkGLContext
+ * @fd: a dma-buf file descriptor for the buffer to import
+ * @width: the width of the buffer, in pixels
+ * @height: the height of the buffer, in pixels
+ * @format: the DRM fourcc code describing the pixel format
+ * @offset: the offset of the first pixel, in bytes
+ * @stride: the distance between rows, in bytes
+ * @error: return location for a #GError
+ *
+ * Imports a dma-buf, such as a frame produced by a hardware video
+ * decoder, as a GL texture in @context without copying the pixel
+ * data through the CPU.
+ *
+ * The buffer must describe a single plane; planar YUV content needs
+ * to be imported one plane at a time. The file descriptor remains
+ * owned by the caller and can be closed once this function returns.
+ *
+ * The returned texture name belongs to @context and should be
+ * deleted with glDeleteTextures() when it is no longer needed.
+ *
+ * Returns: a GL texture name, or 0 on error
+ *
+ * Since: 3.18
+ */
+guint
+gdk_wayland_gl_context_import_dmabuf (GdkGLContext *context,
+                                      int           fd,
+                                      guint         width,
+                                      guint         height,
+                                      guint32       format,
+                                      guint         offset,
+                                      guint         stride,
+                                      GError      **error)
+{
+  GdkDisplay *display;
+  GdkWaylandDisplay *display_wayland;
+  EGLImageKHR image;
+  EGLint attribs[13];
+  guint texture;
+  int i;
+
+  g_return_val_if_fail (GDK_WAYLAND_IS_GL_CONTEXT (context), 0);
+  g_return_val_if_fail (fd >= 0, 0);
+  g_return_val_if_fail (width > 0 && height > 0, 0);
+
+  display = gdk_window_get_display (gdk_gl_context_get_window (context));
+  display_wayland = GDK_WAYLAND_DISPLAY (display);
+
+  if (!display_wayland->have_egl_image_dma_buf_import)
+    {
+      g_set_error_literal (error, GDK_GL_ERROR,
+                           GDK_GL_ERROR_NOT_AVAILABLE,
+                           _("dma-buf import is not supported"));
+      return 0;
+    }
+
+  i = 0;
+  attribs[i++] = EGL_WIDTH;
+  attribs[i++] = width;
+  attribs[i++] = EGL_HEIGHT;
+  attribs[i++] = height;
+  attribs[i++] = EGL_LINUX_DRM_FOURCC_EXT;
+  attribs[i++] = format;
+  attribs[i++] = EGL_DMA_BUF_PLANE0_FD_EXT;
+  attribs[i++] = fd;
+  attribs[i++] = EGL_DMA_BUF_PLANE0_OFFSET_EXT;
+  attribs[i++] = offset;
+  attribs[i++] = EGL_DMA_BUF_PLANE0_PITCH_EXT;
+  attribs[i++] = stride;
+  attribs[i++] = EGL_NONE;
+
+  image = eglCreateImageKHR (display_wayland->egl_display,
+                             EGL_NO_CONTEXT,
+                             EGL_LINUX_DMA_BUF_EXT,
+                             (EGLClientBuffer) NULL,
+                             attribs);
+  if (image == EGL_NO_IMAGE_KHR)
+    {
+      g_set_error_literal (error, GDK_GL_ERROR,
+                           GDK_GL_ERROR_UNSUPPORTED_FORMAT,
+                           _("Unable to import the dma-buf"));
+      return 0;
+    }
+
+  gdk_gl_context_make_current (context);
+
+  glGenTextures (1, &texture);
+  glBindTexture (GL_TEXTURE_2D, texture);
+  glTexParameteri (GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+  glTexParameteri (GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+  glEGLImageTargetTexture2DOES (GL_TEXTURE_2D, image);
+
+  /* The texture keeps the underlying buffer alive; the EGLImage
+   * itself is no longer needed once it has a texture sibling.
+   */
+  eglDestroyImageKHR (display_wayland->egl_display, image);
+
+  return texture;
+}
@@ -51,6 +51,13 @@ struct _GdkWaylandKeymap
   struct xkb_keymap *xkb_keymap;
   struct xkb_state *xkb_state;
 
+  /* Identifies the serialized form the current map was compiled from,
+   * so a compositor resending the same map does not trigger a
+   * recompile.
+   */
+  uint32_t keymap_size;
+  guint keymap_hash;
+
   PangoDirection *direction;
   gboolean bidi;
 };
@@ -489,7 +496,7 @@ _gdk_wayland_keymap_new (void)
   return GDK_KEYMAP (keymap);
 }
 
-void
+gboolean
 _gdk_wayland_keymap_update_from_fd (GdkKeymap *keymap,
                                     uint32_t   format,
                                     uint32_t   fd,
@@ -499,16 +506,31 @@ _gdk_wayland_keymap_update_from_fd (GdkKeymap *keymap,
   struct xkb_context *context;
   struct xkb_keymap *xkb_keymap;
   char *map_str;
-
-  context = xkb_context_new (0);
+  guint hash;
 
   map_str = mmap (NULL, size, PROT_READ, MAP_SHARED, fd, 0);
   if (map_str == MAP_FAILED)
     {
       close(fd);
-      return;
+      return FALSE;
+    }
+
+  /* Compositors resend the keymap on every seat reconfiguration, and
+   * most of the time it has not actually changed; compiling a keymap
+   * is expensive enough to be worth detecting that.
+   */
+  hash = g_str_hash (map_str);
+  if (keymap_wayland->xkb_keymap &&
+      keymap_wayland->keymap_size == size &&
+      keymap_wayland->keymap_hash == hash)
+    {
+      munmap (map_str, size);
+      close (fd);
+      return FALSE;
     }
 
+  context = xkb_context_new (0);
+
   xkb_keymap = xkb_keymap_new_from_string (context, map_str, format, 0);
   munmap (map_str, size);
   close (fd);
@@ -517,9 +539,12 @@ _gdk_wayland_keymap_update_from_fd (GdkKeymap *keymap,
     {
       g_warning ("Got invalid keymap from compositor, keeping previous/default one");
       xkb_context_unref (context);
-      return;
+      return FALSE;
     }
 
+  keymap_wayland->keymap_size = size;
+  keymap_wayland->keymap_hash = hash;
+
   xkb_keymap_unref (keymap_wayland->xkb_keymap);
   keymap_wayland->xkb_keymap = xkb_keymap;
 
@@ -529,6 +554,8 @@ _gdk_wayland_keymap_update_from_fd (GdkKeymap *keymap,
   xkb_context_unref (context);
 
   update_direction (keymap_wayland);
+
+  return TRUE;
 }
 
 struct xkb_keymap *
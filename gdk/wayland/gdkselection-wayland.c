@@ -33,6 +33,18 @@
 
 #include <string.h>
 
+/* How much we ask for per asynchronous read of the transfer pipe.
+ * Large pastes otherwise take thousands of trips through the main
+ * loop before the selection is complete.
+ */
+#define SELECTION_TRANSFER_CHUNK_SIZE 65536
+
+/* Size we try to bump the transfer pipe to with F_SETPIPE_SZ, so the
+ * sending side can push big payloads with few wakeups. Failure to
+ * enlarge the pipe is harmless, transfers just take more iterations.
+ */
+#define SELECTION_TRANSFER_PIPE_SIZE (1024 * 1024)
+
 typedef struct _SelectionBuffer SelectionBuffer;
 typedef struct _StoredSelection StoredSelection;
 typedef struct _AsyncWriteData AsyncWriteData;
@@ -262,7 +274,9 @@ static void
 selection_buffer_read (SelectionBuffer *buffer)
 {
   selection_buffer_ref (buffer);
-  g_input_stream_read_bytes_async (buffer->stream, 1000, G_PRIORITY_DEFAULT,
+  g_input_stream_read_bytes_async (buffer->stream,
+                                   SELECTION_TRANSFER_CHUNK_SIZE,
+                                   G_PRIORITY_DEFAULT,
                                    buffer->cancellable, selection_buffer_read_cb,
                                    buffer);
 }
@@ -1065,6 +1079,9 @@ _gdk_wayland_display_convert_selection (GdkDisplay *display,
       else
         {
           g_unix_open_pipe (pipe_fd, FD_CLOEXEC, NULL);
+#ifdef F_SETPIPE_SZ
+          fcntl (pipe_fd[1], F_SETPIPE_SZ, SELECTION_TRANSFER_PIPE_SIZE);
+#endif
           wl_data_offer_receive (offer, mimetype, pipe_fd[1]);
           stream = g_unix_input_stream_new (pipe_fd[0], TRUE);
           close (pipe_fd[1]);
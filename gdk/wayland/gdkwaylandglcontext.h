@@ -40,6 +40,16 @@ typedef struct _GdkWaylandGLContextClass	GdkWaylandGLContextClass;
 GDK_AVAILABLE_IN_3_16
 GType gdk_wayland_gl_context_get_type (void) G_GNUC_CONST;
 
+GDK_AVAILABLE_IN_3_18
+guint gdk_wayland_gl_context_import_dmabuf (GdkGLContext *context,
+                                            int           fd,
+                                            guint         width,
+                                            guint         height,
+                                            guint32       format,
+                                            guint         offset,
+                                            guint         stride,
+                                            GError      **error);
+
 G_END_DECLS
 
 #endif /* __GDK_WAYLAND_GL_CONTEXT_H__ */
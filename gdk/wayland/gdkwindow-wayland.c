@@ -114,6 +114,19 @@ struct _GdkWindowImplWayland
 
   cairo_surface_t *cairo_surface;
 
+  /* Spare shm buffers for rotation while the attached one is still
+   * held by the compositor; together with cairo_surface they form a
+   * ring of up to three buffers.
+   */
+  cairo_surface_t *shm_spare[2];
+
+  /* Buffer kept from before the last scale change, so a window that
+   * straddles a monitor edge and flaps between scales does not
+   * reallocate its shm pool on every crossing.
+   */
+  cairo_surface_t *retained_scale_surface;
+  guint32 retained_scale;
+
   gchar *title;
 
   struct {
@@ -163,6 +176,8 @@ static void maybe_set_gtk_surface_modal (GdkWindow *window);
 
 static void gdk_window_request_transient_parent_commit (GdkWindow *window);
 
+static void gdk_wayland_window_clear_spare_buffers (GdkWindowImplWayland *impl);
+
 GType _gdk_window_impl_wayland_get_type (void);
 
 G_DEFINE_TYPE (GdkWindowImplWayland, _gdk_window_impl_wayland, GDK_TYPE_WINDOW_IMPL)
@@ -190,12 +205,41 @@ gdk_wayland_window_update_size (GdkWindow *window,
   GdkWindowImplWayland *impl = GDK_WINDOW_IMPL_WAYLAND (window->impl);
   GdkRectangle area;
   cairo_region_t *region;
+  cairo_surface_t *old_surface;
+  gboolean scale_only;
 
-  if (impl->cairo_surface)
+  scale_only = (window->width == width &&
+                window->height == height &&
+                impl->scale != scale);
+
+  old_surface = impl->cairo_surface;
+  impl->cairo_surface = NULL;
+  gdk_wayland_window_clear_spare_buffers (impl);
+
+  if (scale_only)
     {
-      cairo_surface_destroy (impl->cairo_surface);
-      impl->cairo_surface = NULL;
+      /* If we kept a buffer from when we last ran at the new scale,
+       * repaint into that instead of allocating a fresh shm pool.
+       */
+      if (impl->retained_scale_surface && impl->retained_scale == scale)
+        {
+          impl->cairo_surface = impl->retained_scale_surface;
+          impl->retained_scale_surface = NULL;
+        }
+
+      if (old_surface && _gdk_wayland_is_shm_surface (old_surface))
+        {
+          g_clear_pointer (&impl->retained_scale_surface, cairo_surface_destroy);
+          impl->retained_scale_surface = old_surface;
+          impl->retained_scale = impl->scale;
+          old_surface = NULL;
+        }
     }
+  else
+    g_clear_pointer (&impl->retained_scale_surface, cairo_surface_destroy);
+
+  if (old_surface)
+    cairo_surface_destroy (old_surface);
 
   window->width = width;
   window->height = height;
@@ -564,6 +608,85 @@ gdk_wayland_window_attach_image (GdkWindow *window)
   impl->pending_commit = TRUE;
 }
 
+static void
+gdk_wayland_window_clear_spare_buffers (GdkWindowImplWayland *impl)
+{
+  guint i;
+
+  for (i = 0; i < G_N_ELEMENTS (impl->shm_spare); i++)
+    g_clear_pointer (&impl->shm_spare[i], cairo_surface_destroy);
+}
+
+/* Called when the current shm buffer is still held by the compositor:
+ * switch to a spare buffer (creating one if the ring isn't full yet),
+ * seeded with the previous contents so that partial repaints stay
+ * valid. Returns FALSE if painting can proceed into the new buffer,
+ * TRUE if all buffers are busy and a staging surface is needed.
+ */
+static gboolean
+gdk_wayland_window_rotate_buffer (GdkWindow *window)
+{
+  GdkWindowImplWayland *impl = GDK_WINDOW_IMPL_WAYLAND (window->impl);
+  GdkWaylandDisplay *display_wayland = GDK_WAYLAND_DISPLAY (gdk_window_get_display (impl->wrapper));
+  cairo_surface_t *spare = NULL;
+  cairo_t *cr;
+  guint i;
+
+  for (i = 0; i < G_N_ELEMENTS (impl->shm_spare); i++)
+    {
+      if (impl->shm_spare[i] != NULL &&
+          !_gdk_wayland_shm_surface_get_busy (impl->shm_spare[i]))
+        {
+          spare = impl->shm_spare[i];
+          impl->shm_spare[i] = NULL;
+          break;
+        }
+    }
+
+  if (spare == NULL)
+    {
+      for (i = 0; i < G_N_ELEMENTS (impl->shm_spare); i++)
+        {
+          if (impl->shm_spare[i] == NULL)
+            break;
+        }
+
+      if (i == G_N_ELEMENTS (impl->shm_spare))
+        return TRUE;
+
+      spare = _gdk_wayland_display_create_shm_surface (display_wayland,
+                                                       impl->wrapper->width,
+                                                       impl->wrapper->height,
+                                                       impl->scale);
+    }
+
+  /* Carry over the previous frame so areas outside the upcoming paint
+   * region remain valid; the busy buffer is only read, which is safe.
+   */
+  cr = cairo_create (spare);
+  cairo_set_source_surface (cr, impl->cairo_surface, 0, 0);
+  cairo_set_operator (cr, CAIRO_OPERATOR_SOURCE);
+  cairo_paint (cr);
+  cairo_destroy (cr);
+
+  for (i = 0; i < G_N_ELEMENTS (impl->shm_spare); i++)
+    {
+      if (impl->shm_spare[i] == NULL)
+        {
+          impl->shm_spare[i] = impl->cairo_surface;
+          impl->cairo_surface = NULL;
+          break;
+        }
+    }
+
+  if (impl->cairo_surface != NULL)
+    cairo_surface_destroy (impl->cairo_surface);
+
+  impl->cairo_surface = spare;
+
+  return FALSE;
+}
+
 static void
 gdk_wayland_window_ensure_cairo_surface (GdkWindow *window)
 {
@@ -627,12 +750,20 @@ gdk_window_impl_wayland_begin_paint (GdkWindow *window)
 
   gdk_wayland_window_ensure_cairo_surface (window);
 
-  if (_gdk_wayland_is_shm_surface (impl->cairo_surface))
-    return _gdk_wayland_shm_surface_get_busy (impl->cairo_surface);
-  else
-    return FALSE;
+  if (_gdk_wayland_is_shm_surface (impl->cairo_surface) &&
+      _gdk_wayland_shm_surface_get_busy (impl->cairo_surface))
+    return gdk_wayland_window_rotate_buffer (window);
+
+  return FALSE;
 }
 
+/* Submitting one wl_surface_damage request per region rectangle floods
+ * the compositor socket when the paint region is very fragmented, and
+ * the compositor ends up merging the rectangles anyway. Past this many
+ * rectangles the bounding box is cheaper for everyone involved.
+ */
+#define MAX_DAMAGE_RECTS 32
+
 static void
 gdk_window_impl_wayland_end_paint (GdkWindow *window)
 {
@@ -645,12 +776,22 @@ gdk_window_impl_wayland_end_paint (GdkWindow *window)
       gdk_wayland_window_attach_image (window);
 
       n = cairo_region_num_rectangles (window->current_paint.region);
-      for (i = 0; i < n; i++)
+      if (n > MAX_DAMAGE_RECTS)
         {
-          cairo_region_get_rectangle (window->current_paint.region, i, &rect);
+          cairo_region_get_extents (window->current_paint.region, &rect);
           wl_surface_damage (impl->surface, rect.x, rect.y, rect.width, rect.height);
-          impl->pending_commit = TRUE;
         }
+      else
+        {
+          for (i = 0; i < n; i++)
+            {
+              cairo_region_get_rectangle (window->current_paint.region, i, &rect);
+              wl_surface_damage (impl->surface, rect.x, rect.y, rect.width, rect.height);
+            }
+        }
+
+      if (n > 0)
+        impl->pending_commit = TRUE;
     }
 }
 
@@ -672,6 +813,9 @@ gdk_window_impl_wayland_finalize (GObject *object)
   g_free (impl->application.application_object_path);
   g_free (impl->application.unique_bus_name);
 
+  gdk_wayland_window_clear_spare_buffers (impl);
+  g_clear_pointer (&impl->retained_scale_surface, cairo_surface_destroy);
+
   g_clear_pointer (&impl->opaque_region, cairo_region_destroy);
   g_clear_pointer (&impl->input_region, cairo_region_destroy);
 
@@ -59,6 +59,7 @@ typedef struct _ListChildrenState ListChildrenState;
 typedef struct _SendEventState SendEventState;
 typedef struct _SetInputFocusState SetInputFocusState;
 typedef struct _RoundtripState RoundtripState;
+typedef struct _GetPropertyState GetPropertyState;
 
 typedef enum {
   CHILD_INFO_GET_PROPERTY,
@@ -124,6 +125,22 @@ struct _RoundtripState
   gpointer data;
 };
 
+struct _GetPropertyState
+{
+  Display *dpy;
+  _XAsyncHandler async;
+  gulong get_property_req;
+  GdkDisplay *display;
+  Atom property_type;
+  gint format;
+  gulong n_items;
+  guchar *prop_data;
+  GdkPropertyReadCallback callback;
+  gpointer data;
+  gboolean is_future;
+  gboolean done;
+};
+
 static gboolean
 callback_idle (gpointer data)
 {
@@ -756,3 +773,233 @@ _gdk_x11_roundtrip_async (GdkDisplay           *display,
   UnlockDisplay(dpy);
   SyncHandle();
 }
+
+static gboolean
+get_property_callback_idle (gpointer data)
+{
+  GetPropertyState *state = (GetPropertyState *)data;
+
+  state->callback (state->display,
+		   state->property_type,
+		   state->format,
+		   state->n_items,
+		   state->prop_data,
+		   state->data);
+
+  g_free (state->prop_data);
+  g_free (state);
+
+  return FALSE;
+}
+
+static Bool
+get_property_handler (Display *dpy,
+		      xReply  *rep,
+		      char    *buf,
+		      int      len,
+		      XPointer data)
+{
+  GetPropertyState *state = (GetPropertyState *)data;
+  xGetPropertyReply replbuf;
+  xGetPropertyReply *repl;
+  guint id;
+
+  if (dpy->last_request_read != state->get_property_req)
+    return False;
+
+  if (rep->generic.type != X_Error)
+    {
+      repl = (xGetPropertyReply *)
+	_XGetAsyncReply(dpy, (char *)&replbuf, rep, buf, len,
+			(sizeof(xGetPropertyReply) - sizeof(xReply)) >> 2,
+			False);
+
+      state->property_type = repl->propertyType;
+      state->format = repl->format;
+      state->n_items = repl->nItems;
+
+      if (repl->propertyType != None && repl->format != 0)
+	{
+	  unsigned long nbytes = repl->nItems * (repl->format >> 3);
+
+	  /* Note that format 32 data arrives as packed 32-bit values
+	   * on the wire, not as longs like with XGetWindowProperty().
+	   */
+	  state->prop_data = g_malloc (nbytes + 1);
+	  state->prop_data[nbytes] = '\0';
+
+	  _XGetAsyncData(dpy, (char *)state->prop_data, buf, len,
+			 sizeof(xGetPropertyReply), nbytes,
+			 (nbytes + 3) & ~3UL);
+	}
+    }
+
+  DeqAsyncHandler(dpy, &state->async);
+
+  state->done = TRUE;
+
+  if (state->callback)
+    {
+      id = gdk_threads_add_idle (get_property_callback_idle, state);
+      g_source_set_name_by_id (id, "[gtk+] get_property_callback_idle");
+    }
+  else if (!state->is_future)
+    {
+      g_free (state->prop_data);
+      g_free (state);
+    }
+
+  return (rep->generic.type != X_Error);
+}
+
+/**
+ * _gdk_x11_get_property_async:
+ * @display: a #GdkDisplay
+ * @window: the X window to read from
+ * @property: the property to retrieve
+ * @type: the desired property type, or %AnyPropertyType
+ * @length: maximum length to retrieve, in 32-bit multiples
+ * @callback: function to call with the property contents
+ * @data: data to pass to @callback
+ *
+ * Reads a window property without blocking; the reply is picked up
+ * whenever Xlib next reads from the connection and @callback is then
+ * invoked from an idle. On error or if the property doesn't exist,
+ * the callback receives a property type of %None and %NULL data.
+ */
+static GetPropertyState *
+get_property_send (GdkDisplay             *display,
+		   Window                  window,
+		   Atom                    property,
+		   Atom                    type,
+		   gulong                  length,
+		   GdkPropertyReadCallback callback,
+		   gpointer                data,
+		   gboolean                is_future)
+{
+  Display *dpy;
+  GetPropertyState *state;
+  xGetPropertyReq *req;
+
+  dpy = GDK_DISPLAY_XDISPLAY (display);
+
+  state = g_new0 (GetPropertyState, 1);
+
+  state->display = display;
+  state->dpy = dpy;
+  state->property_type = None;
+  state->callback = callback;
+  state->data = data;
+  state->is_future = is_future;
+
+  LockDisplay(dpy);
+
+  state->async.next = dpy->async_handlers;
+  state->async.handler = get_property_handler;
+  state->async.data = (XPointer) state;
+  dpy->async_handlers = &state->async;
+
+  GetReq (GetProperty, req);
+  req->window = window;
+  req->property = property;
+  req->type = type;
+  req->delete = False;
+  req->longOffset = 0;
+  req->longLength = length;
+
+  state->get_property_req = dpy->request;
+
+  UnlockDisplay(dpy);
+  SyncHandle();
+
+  return state;
+}
+
+void
+_gdk_x11_get_property_async (GdkDisplay             *display,
+			     Window                  window,
+			     Atom                    property,
+			     Atom                    type,
+			     gulong                  length,
+			     GdkPropertyReadCallback callback,
+			     gpointer                data)
+{
+  get_property_send (display, window, property, type, length,
+		     callback, data, FALSE);
+}
+
+/**
+ * _gdk_x11_get_property_future:
+ *
+ * Issues a GetProperty request immediately but doesn't wait for the
+ * reply; use _gdk_x11_property_future_wait() to collect it. Several
+ * futures issued back to back are all answered by the server in one
+ * round trip, unlike a sequence of XGetWindowProperty() calls which
+ * serialize on each reply.
+ */
+GdkX11PropertyFuture *
+_gdk_x11_get_property_future (GdkDisplay *display,
+			      Window      window,
+			      Atom        property,
+			      Atom        type,
+			      gulong      length)
+{
+  return (GdkX11PropertyFuture *)
+    get_property_send (display, window, property, type, length,
+		       NULL, NULL, TRUE);
+}
+
+gboolean
+_gdk_x11_property_future_is_ready (GdkX11PropertyFuture *future)
+{
+  return ((GetPropertyState *) future)->done;
+}
+
+/**
+ * _gdk_x11_property_future_wait:
+ * @property_type: (out) (optional): the type of the property, %None on error
+ * @format: (out) (optional): the format of the property
+ * @n_items: (out) (optional): the number of items read
+ * @data: (out) (optional) (transfer full): the property data, or %NULL
+ *
+ * Collects the reply for a future, blocking if it hasn't arrived yet,
+ * and frees the future. Returns %FALSE if the property doesn't exist
+ * or an error occurred.
+ */
+gboolean
+_gdk_x11_property_future_wait (GdkX11PropertyFuture *future,
+			       Atom                 *property_type,
+			       gint                 *format,
+			       gulong               *n_items,
+			       guchar              **data)
+{
+  GetPropertyState *state = (GetPropertyState *) future;
+  gboolean success;
+
+  /* Forces all outstanding replies to be read, completing this (and
+   * any other pending) request through its async handler.
+   */
+  if (!state->done)
+    XSync (state->dpy, False);
+
+  success = state->done && state->property_type != None;
+
+  if (property_type)
+    *property_type = state->property_type;
+  if (format)
+    *format = state->format;
+  if (n_items)
+    *n_items = state->n_items;
+  if (data && success)
+    {
+      *data = state->prop_data;
+      state->prop_data = NULL;
+    }
+  else if (data)
+    *data = NULL;
+
+  g_free (state->prop_data);
+  g_free (state);
+
+  return success;
+}
@@ -32,6 +32,12 @@ typedef void (*GdkSendXEventCallback) (Window   window,
 typedef void (*GdkRoundTripCallback)  (GdkDisplay *display,
 				       gpointer data,
 				       gulong serial);
+typedef void (*GdkPropertyReadCallback) (GdkDisplay *display,
+					 Atom        property_type,
+					 gint        format,
+					 gulong      n_items,
+					 const guchar *data,
+					 gpointer    user_data);
 
 struct _GdkChildInfoX11
 {
@@ -64,6 +70,28 @@ void _gdk_x11_roundtrip_async           (GdkDisplay           *display,
 					 GdkRoundTripCallback callback,
 					 gpointer              data);
 
+typedef struct _GetPropertyState GdkX11PropertyFuture;
+
+void _gdk_x11_get_property_async        (GdkDisplay           *display,
+					 Window                window,
+					 Atom                  property,
+					 Atom                  type,
+					 gulong                length,
+					 GdkPropertyReadCallback callback,
+					 gpointer              data);
+
+GdkX11PropertyFuture *_gdk_x11_get_property_future (GdkDisplay *display,
+					 Window                window,
+					 Atom                  property,
+					 Atom                  type,
+					 gulong                length);
+gboolean _gdk_x11_property_future_is_ready (GdkX11PropertyFuture *future);
+gboolean _gdk_x11_property_future_wait  (GdkX11PropertyFuture *future,
+					 Atom                 *property_type,
+					 gint                 *format,
+					 gulong               *n_items,
+					 guchar              **data);
+
 G_END_DECLS
 
 #endif /* __GDK_ASYNC_H__ */
@@ -895,6 +895,65 @@ _gdk_x11_display_get_default_cursor_size (GdkDisplay *display,
 
 #endif
 
+/* The cursors most applications end up using, prefetched into the
+ * cursor cache from a low priority idle so that e.g. the first drag
+ * operation doesn't stall on loading them from the cursor theme.
+ */
+static const gchar *const prefetch_cursor_names[] = {
+  "left_ptr",
+  "text",
+  "pointer",
+  "progress",
+  "crosshair",
+  "move",
+  "col-resize",
+  "row-resize",
+  "left_ptr_watch"
+};
+
+typedef struct {
+  GdkDisplay *display;
+  guint next;
+} CursorPrefetchState;
+
+static gboolean
+prefetch_cursor_idle (gpointer data)
+{
+  CursorPrefetchState *state = data;
+  GdkCursor *cursor;
+
+  if (gdk_display_is_closed (state->display) ||
+      state->next >= G_N_ELEMENTS (prefetch_cursor_names))
+    {
+      g_object_unref (state->display);
+      g_free (state);
+      return G_SOURCE_REMOVE;
+    }
+
+  /* One cursor per iteration, to keep theme loading off of any
+   * latency-sensitive path; the cursor cache keeps its own ref.
+   */
+  cursor = _gdk_x11_display_get_cursor_for_name (state->display,
+                                                 prefetch_cursor_names[state->next++]);
+  if (cursor)
+    g_object_unref (cursor);
+
+  return G_SOURCE_CONTINUE;
+}
+
+void
+_gdk_x11_cursor_display_prefetch (GdkDisplay *display)
+{
+  CursorPrefetchState *state;
+  guint id;
+
+  state = g_new0 (CursorPrefetchState, 1);
+  state->display = g_object_ref (display);
+
+  id = gdk_threads_add_idle_full (G_PRIORITY_LOW, prefetch_cursor_idle, state, NULL);
+  g_source_set_name_by_id (id, "[gtk+] prefetch_cursor_idle");
+}
+
 void
 _gdk_x11_display_get_maximal_cursor_size (GdkDisplay *display,
                                           guint       *width,
@@ -42,6 +42,11 @@ struct _GdkX11DeviceManagerXI2
 
   GHashTable *id_table;
 
+  /* Memoized id_table lookups for the event translation fast path */
+  guint last_lookup_ids[2];
+  GdkDevice *last_lookup_devices[2];
+  guint last_lookup_serial;
+
   GList *devices;
 
   gint opcode;
@@ -455,6 +460,42 @@ create_device (GdkDeviceManager *device_manager,
   return device;
 }
 
+static void
+flush_device_cache (GdkX11DeviceManagerXI2 *device_manager)
+{
+  guint i;
+
+  for (i = 0; i < G_N_ELEMENTS (device_manager->last_lookup_devices); i++)
+    device_manager->last_lookup_devices[i] = NULL;
+}
+
+static GdkDevice *
+lookup_device (GdkX11DeviceManagerXI2 *device_manager,
+               guint                   device_id)
+{
+  GdkDevice *device;
+  guint i;
+
+  /* High-frequency valuator events alternate between the same master
+   * and source ids, so a two-entry memo catches nearly all lookups.
+   */
+  for (i = 0; i < G_N_ELEMENTS (device_manager->last_lookup_devices); i++)
+    if (device_manager->last_lookup_devices[i] != NULL &&
+        device_manager->last_lookup_ids[i] == device_id)
+      return device_manager->last_lookup_devices[i];
+
+  device = g_hash_table_lookup (device_manager->id_table,
+                                GUINT_TO_POINTER (device_id));
+  if (device)
+    {
+      i = device_manager->last_lookup_serial++ & 1;
+      device_manager->last_lookup_ids[i] = device_id;
+      device_manager->last_lookup_devices[i] = device;
+    }
+
+  return device;
+}
+
 static GdkDevice *
 add_device (GdkX11DeviceManagerXI2 *device_manager,
             XIDeviceInfo           *dev,
@@ -466,6 +507,7 @@ add_device (GdkX11DeviceManagerXI2 *device_manager,
   display = gdk_device_manager_get_display (GDK_DEVICE_MANAGER (device_manager));
   device = create_device (GDK_DEVICE_MANAGER (device_manager), display, dev);
 
+  flush_device_cache (device_manager);
   g_hash_table_replace (device_manager->id_table,
                         GINT_TO_POINTER (dev->deviceid),
                         g_object_ref (device));
@@ -511,6 +553,7 @@ remove_device (GdkX11DeviceManagerXI2 *device_manager,
 
       g_object_run_dispose (G_OBJECT (device));
 
+      flush_device_cache (device_manager);
       g_hash_table_remove (device_manager->id_table,
                            GINT_TO_POINTER (device_id));
     }
@@ -827,10 +870,8 @@ handle_device_changed (GdkX11DeviceManagerXI2 *device_manager,
   GdkDevice *device, *source_device;
 
   display = gdk_device_manager_get_display (GDK_DEVICE_MANAGER (device_manager));
-  device = g_hash_table_lookup (device_manager->id_table,
-                                GUINT_TO_POINTER (ev->deviceid));
-  source_device = g_hash_table_lookup (device_manager->id_table,
-                                       GUINT_TO_POINTER (ev->sourceid));
+  device = lookup_device (device_manager, ev->deviceid);
+  source_device = lookup_device (device_manager, ev->sourceid);
 
   if (device)
     {
@@ -1275,12 +1316,10 @@ gdk_x11_device_manager_xi2_translate_event (GdkEventTranslator *translator,
         event->key.hardware_keycode = xev->detail;
         event->key.is_modifier = gdk_x11_keymap_key_is_modifier (keymap, event->key.hardware_keycode);
 
-        device = g_hash_table_lookup (device_manager->id_table,
-                                      GUINT_TO_POINTER (xev->deviceid));
+        device = lookup_device (device_manager, xev->deviceid);
         gdk_event_set_device (event, device);
 
-        source_device = g_hash_table_lookup (device_manager->id_table,
-                                             GUINT_TO_POINTER (xev->sourceid));
+        source_device = lookup_device (device_manager, xev->sourceid);
         gdk_event_set_source_device (event, source_device);
 
         event->key.keyval = GDK_KEY_VoidSymbol;
@@ -1353,11 +1392,9 @@ gdk_x11_device_manager_xi2_translate_event (GdkEventTranslator *translator,
             event->scroll.delta_x = 0;
             event->scroll.delta_y = 0;
 
-            event->scroll.device = g_hash_table_lookup (device_manager->id_table,
-                                                        GUINT_TO_POINTER (xev->deviceid));
+            event->scroll.device = lookup_device (device_manager, xev->deviceid);
 
-            source_device = g_hash_table_lookup (device_manager->id_table,
-                                                 GUINT_TO_POINTER (xev->sourceid));
+            source_device = lookup_device (device_manager, xev->sourceid);
             gdk_event_set_source_device (event, source_device);
 
             event->scroll.state = _gdk_x11_device_xi2_translate_state (&xev->mods, &xev->buttons, &xev->group);
@@ -1378,11 +1415,9 @@ gdk_x11_device_manager_xi2_translate_event (GdkEventTranslator *translator,
             event->button.x_root = (gdouble) xev->root_x / scale;
             event->button.y_root = (gdouble) xev->root_y / scale;
 
-            event->button.device = g_hash_table_lookup (device_manager->id_table,
-                                                        GUINT_TO_POINTER (xev->deviceid));
+            event->button.device = lookup_device (device_manager, xev->deviceid);
 
-            source_device = g_hash_table_lookup (device_manager->id_table,
-                                                 GUINT_TO_POINTER (xev->sourceid));
+            source_device = lookup_device (device_manager, xev->sourceid);
             gdk_event_set_source_device (event, source_device);
 
             event->button.axes = translate_axes (event->button.device,
@@ -1431,10 +1466,8 @@ gdk_x11_device_manager_xi2_translate_event (GdkEventTranslator *translator,
         GdkDevice *source_device, *device;
         gdouble delta_x, delta_y;
 
-        source_device = g_hash_table_lookup (device_manager->id_table,
-                                             GUINT_TO_POINTER (xev->sourceid));
-        device = g_hash_table_lookup (device_manager->id_table,
-                                      GUINT_TO_POINTER (xev->deviceid));
+        source_device = lookup_device (device_manager, xev->sourceid);
+        device = lookup_device (device_manager, xev->deviceid);
 
         /* When scrolling, X might send events twice here; once with both the
          * device and the source device set to the physical device, and once
@@ -1540,11 +1573,9 @@ gdk_x11_device_manager_xi2_translate_event (GdkEventTranslator *translator,
         event->touch.x_root = (gdouble) xev->root_x / scale;
         event->touch.y_root = (gdouble) xev->root_y / scale;
 
-        event->touch.device = g_hash_table_lookup (device_manager->id_table,
-                                                   GUINT_TO_POINTER (xev->deviceid));
+        event->touch.device = lookup_device (device_manager, xev->deviceid);
 
-        source_device = g_hash_table_lookup (device_manager->id_table,
-                                             GUINT_TO_POINTER (xev->sourceid));
+        source_device = lookup_device (device_manager, xev->sourceid);
         gdk_event_set_source_device (event, source_device);
 
         event->touch.axes = translate_axes (event->touch.device,
@@ -1612,8 +1643,7 @@ gdk_x11_device_manager_xi2_translate_event (GdkEventTranslator *translator,
         event->touch.device = g_hash_table_lookup (device_manager->id_table,
                                                    GINT_TO_POINTER (xev->deviceid));
 
-        source_device = g_hash_table_lookup (device_manager->id_table,
-                                             GUINT_TO_POINTER (xev->sourceid));
+        source_device = lookup_device (device_manager, xev->sourceid);
         gdk_event_set_source_device (event, source_device);
 
         event->touch.state = _gdk_x11_device_xi2_translate_state (&xev->mods, &xev->buttons, &xev->group);
@@ -1675,8 +1705,7 @@ gdk_x11_device_manager_xi2_translate_event (GdkEventTranslator *translator,
                                       GINT_TO_POINTER (xev->deviceid));
         gdk_event_set_device (event, device);
 
-        source_device = g_hash_table_lookup (device_manager->id_table,
-                                             GUINT_TO_POINTER (xev->sourceid));
+        source_device = lookup_device (device_manager, xev->sourceid);
         gdk_event_set_source_device (event, source_device);
 
         if (ev->evtype == XI_Enter &&
@@ -1714,8 +1743,7 @@ gdk_x11_device_manager_xi2_translate_event (GdkEventTranslator *translator,
             device = g_hash_table_lookup (device_manager->id_table,
                                           GINT_TO_POINTER (xev->deviceid));
 
-            source_device = g_hash_table_lookup (device_manager->id_table,
-                                                 GUINT_TO_POINTER (xev->sourceid));
+            source_device = lookup_device (device_manager, xev->sourceid);
 
             _gdk_device_manager_core_handle_focus (window,
                                                    xev->event,
@@ -60,6 +60,10 @@
 
 #include <X11/extensions/shape.h>
 
+#ifdef HAVE_XSHM
+#include <X11/extensions/XShm.h>
+#endif
+
 #ifdef HAVE_XCOMPOSITE
 #include <X11/extensions/Xcomposite.h>
 #endif
@@ -167,7 +171,23 @@ static const char *const precache_atoms[] = {
   "_NET_VIRTUAL_ROOTS",
   "GDK_SELECTION",
   "_NET_WM_STATE_FOCUSED",
-  "GDK_VISUALS"
+  "GDK_VISUALS",
+  "_NET_SUPPORTED",
+  "_NET_SUPPORTING_WM_CHECK",
+  "_NET_WORKAREA",
+  "_NET_WM_MOVERESIZE",
+  "_NET_WM_FRAME_DRAWN",
+  "_NET_WM_FRAME_TIMINGS",
+  "_NET_WM_OPAQUE_REGION",
+  "_NET_CLIENT_LIST_STACKING",
+  "_MOTIF_WM_HINTS",
+  "_GTK_THEME_VARIANT",
+  "WM_STATE",
+  "CLIPBOARD",
+  "TARGETS",
+  "TIMESTAMP",
+  "MULTIPLE",
+  "INCR"
 };
 
 static char *gdk_sm_client_id;
@@ -1435,6 +1455,8 @@ _gdk_x11_display_open (const gchar *display_name)
 
   _gdk_x11_precache_atoms (display, precache_atoms, G_N_ELEMENTS (precache_atoms));
 
+  _gdk_x11_cursor_display_prefetch (display);
+
   /* RandR must be initialized before we initialize the screens */
   display_x11->have_randr12 = FALSE;
   display_x11->have_randr13 = FALSE;
@@ -1549,6 +1571,15 @@ _gdk_x11_display_open (const gchar *display_name)
 #endif
     }
 
+  display_x11->have_shm = FALSE;
+#ifdef HAVE_XSHM
+  /* Whether the server can actually attach our segments is only
+   * known once we try; the first failed attach clears this again.
+   */
+  if (XShmQueryExtension (GDK_DISPLAY_XDISPLAY (display)))
+    display_x11->have_shm = TRUE;
+#endif
+
   display_x11->trusted_client = TRUE;
   {
     Window root, child;
@@ -1932,6 +1963,9 @@ gdk_x11_display_finalize (GObject *object)
   GdkX11Display *display_x11 = GDK_X11_DISPLAY (object);
 
   /* Keymap */
+  if (display_x11->keymap_keys_changed_idle)
+    g_source_remove (display_x11->keymap_keys_changed_idle);
+
   if (display_x11->keymap)
     g_object_unref (display_x11->keymap);
 
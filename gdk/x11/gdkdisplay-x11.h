@@ -57,6 +57,7 @@ struct _GdkX11Display
 
   GdkKeymap *keymap;
   guint      keymap_serial;
+  guint      keymap_keys_changed_idle;
 
   gboolean have_xfixes;
   gint xfixes_event_base;
@@ -120,6 +121,8 @@ struct _GdkX11Display
   guint have_input_shapes : 1;
   gint shape_event_base;
 
+  guint have_shm : 1;
+
   /* The offscreen window that has the pointer in it (if any) */
   GdkWindow *active_offscreen_window;
 
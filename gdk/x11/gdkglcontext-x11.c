@@ -34,6 +34,7 @@
 #include <X11/Xatom.h>
 
 #include "gdkinternals.h"
+#include "gdkframeclockprivate.h"
 
 #include "gdkintl.h"
 
@@ -149,7 +150,8 @@ gdk_x11_window_invalidate_for_new_frame (GdkWindow      *window,
 
 
   invalidate_all = FALSE;
-  if (buffer_age == 0 || buffer_age >= 4)
+  if (buffer_age == 0 ||
+      buffer_age > G_N_ELEMENTS (window->old_updated_area) + 1)
     {
       cairo_rectangle_int_t whole_window = { 0, 0, gdk_window_get_width (window), gdk_window_get_height (window) };
 
@@ -163,19 +165,20 @@ gdk_x11_window_invalidate_for_new_frame (GdkWindow      *window,
     }
   else
     {
-      if (buffer_age >= 2)
-        {
-          if (window->old_updated_area[0])
-            cairo_region_union (update_area, window->old_updated_area[0]);
-          else
-            invalidate_all = TRUE;
-        }
-      if (buffer_age >= 3)
+      unsigned int i;
+
+      /* A buffer of age N contains the frame N swaps ago, so we need
+       * to redraw what changed in each of the N - 1 frames since then
+       */
+      for (i = 0; i + 2 <= buffer_age; i++)
         {
-          if (window->old_updated_area[1])
-            cairo_region_union (update_area, window->old_updated_area[1]);
+          if (window->old_updated_area[i])
+            cairo_region_union (update_area, window->old_updated_area[i]);
           else
-            invalidate_all = TRUE;
+            {
+              invalidate_all = TRUE;
+              break;
+            }
         }
     }
 
@@ -286,6 +289,35 @@ gdk_x11_gl_context_end_frame (GdkGLContext *context,
 
   if (context_x11->do_frame_sync && info != NULL && display_x11->has_glx_video_sync)
     glXGetVideoSyncSGI (&info->last_frame_counter);
+
+  /* With OML_sync_control the driver tells us when the swap actually
+   * made it to the screen; feed that back into the frame clock so
+   * paint scheduling is based on real flips rather than guesses.
+   */
+  if (display_x11->has_glx_sync_control)
+    {
+      GdkFrameClock *clock = gdk_window_get_frame_clock (window);
+      GdkFrameTimings *timings = gdk_frame_clock_get_current_timings (clock);
+
+      if (timings != NULL)
+        {
+          gint64 ust, msc, sbc;
+          gint32 numerator, denominator;
+          gint64 now = g_get_monotonic_time ();
+
+          glXGetSyncValuesOML (dpy, drawable, &ust, &msc, &sbc);
+
+          /* The UST clock isn't specified; only use it if it plausibly
+           * is CLOCK_MONOTONIC in microseconds, like current drivers.
+           */
+          if (ust != 0 && ust <= now && now - ust < G_USEC_PER_SEC)
+            timings->presentation_time = ust;
+
+          if (glXGetMscRateOML (dpy, drawable, &numerator, &denominator) &&
+              numerator > 0)
+            timings->refresh_interval = ((gint64) denominator * G_USEC_PER_SEC) / numerator;
+        }
+    }
 }
 
 typedef struct {
@@ -679,6 +679,19 @@ ensure_lock_state (GdkKeymap *keymap)
 #endif /* HAVE_XKB */
 }
 
+static gboolean
+emit_keys_changed_idle (gpointer data)
+{
+  GdkX11Display *display_x11 = data;
+
+  display_x11->keymap_keys_changed_idle = 0;
+
+  if (display_x11->keymap)
+    g_signal_emit_by_name (display_x11->keymap, "keys_changed", 0);
+
+  return G_SOURCE_REMOVE;
+}
+
 void
 _gdk_x11_keymap_keys_changed (GdkDisplay *display)
 {
@@ -686,8 +699,24 @@ _gdk_x11_keymap_keys_changed (GdkDisplay *display)
 
   ++display_x11->keymap_serial;
 
-  if (display_x11->keymap)
-    g_signal_emit_by_name (display_x11->keymap, "keys_changed", 0);
+  if (!display_x11->keymap)
+    return;
+
+  /* A layout switch arrives as a burst of map notifications; the
+   * keymap itself is rebuilt lazily against the new serial, but the
+   * ::keys-changed listeners (key hashes, accel maps, im contexts)
+   * would rebuild their caches once per notification. Coalesce the
+   * emissions so a burst only triggers one rebuild.
+   */
+  if (display_x11->keymap_keys_changed_idle == 0)
+    {
+      display_x11->keymap_keys_changed_idle =
+        gdk_threads_add_idle_full (GDK_PRIORITY_EVENTS,
+                                   emit_keys_changed_idle,
+                                   display_x11, NULL);
+      g_source_set_name_by_id (display_x11->keymap_keys_changed_idle,
+                               "[gtk+] emit_keys_changed_idle");
+    }
 }
 
 static PangoDirection
@@ -307,6 +307,7 @@ void _gdk_x11_screen_init_visuals     (GdkScreen *screen);
 
 void _gdk_x11_cursor_update_theme (GdkCursor *cursor);
 void _gdk_x11_cursor_display_finalize (GdkDisplay *display);
+void _gdk_x11_cursor_display_prefetch (GdkDisplay *display);
 
 void _gdk_x11_window_register_dnd (GdkWindow *window);
 
@@ -69,6 +69,8 @@ struct _GdkX11Screen
   GdkWindow *xsettings_manager_window;
   Atom xsettings_selection_atom;
   GHashTable *xsettings; /* string of GDK settings name => GValue */
+  guchar *xsettings_blob; /* raw _XSETTINGS_SETTINGS bytes of the last parse */
+  gulong xsettings_blob_len;
 
   /* TRUE if wmspec_check_window has changed since last
    * fetch of _NET_SUPPORTED
@@ -94,6 +96,13 @@ struct _GdkX11Screen
   GHashTable *visual_hash;
   GdkVisual *rgba_visual;
 
+  /* Best-match visuals precomputed at init time, indexed by depth
+   * and/or GdkVisualType, so the hot surface creation paths don't
+   * have to walk the visual list on every lookup */
+  GdkVisual *visual_by_depth[33];
+  GdkVisual *visual_by_type[6];
+  GdkVisual *visual_by_both[33][6];
+
   /* cache for window->translate vfunc */
   GC subwindow_gcs[32];
 
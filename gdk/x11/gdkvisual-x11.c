@@ -332,6 +332,27 @@ _gdk_x11_screen_init_visuals (GdkScreen *screen)
      as we care about glx details such as alpha/depth/stencil depth,
      stereo and double buffering */
   _gdk_x11_screen_update_visuals_for_gl (screen);
+
+  /* The visuals are sorted best-first at this point, so the first
+   * one seen for a given depth and/or type is the one the lookups
+   * below would find by walking the list; remember it
+   */
+  for (i = 0; i < nvisuals; i++)
+    {
+      gint d = visuals[i]->depth;
+      gint t = visuals[i]->type;
+
+      if (d < 0 || d >= (gint) G_N_ELEMENTS (x11_screen->visual_by_depth) ||
+          t < 0 || t >= (gint) G_N_ELEMENTS (x11_screen->visual_by_type))
+        continue;
+
+      if (x11_screen->visual_by_depth[d] == NULL)
+        x11_screen->visual_by_depth[d] = visuals[i];
+      if (x11_screen->visual_by_type[t] == NULL)
+        x11_screen->visual_by_type[t] = visuals[i];
+      if (x11_screen->visual_by_both[d][t] == NULL)
+        x11_screen->visual_by_both[d][t] = visuals[i];
+    }
 }
 
 gint
@@ -369,7 +390,10 @@ _gdk_x11_screen_visual_get_best_with_depth (GdkScreen *screen,
   GdkX11Screen *x11_screen = GDK_X11_SCREEN (screen);
   GdkVisual *return_val;
   int i;
-  
+
+  if (depth >= 0 && depth < (gint) G_N_ELEMENTS (x11_screen->visual_by_depth))
+    return x11_screen->visual_by_depth[depth];
+
   return_val = NULL;
   for (i = 0; i < x11_screen->nvisuals; i++)
     if (depth == x11_screen->visuals[i]->depth)
@@ -389,6 +413,10 @@ _gdk_x11_screen_visual_get_best_with_type (GdkScreen     *screen,
   GdkVisual *return_val;
   int i;
 
+  if (visual_type >= 0 &&
+      visual_type < (gint) G_N_ELEMENTS (x11_screen->visual_by_type))
+    return x11_screen->visual_by_type[visual_type];
+
   return_val = NULL;
   for (i = 0; i < x11_screen->nvisuals; i++)
     if (visual_type == x11_screen->visuals[i]->type)
@@ -409,6 +437,11 @@ _gdk_x11_screen_visual_get_best_with_both (GdkScreen     *screen,
   GdkVisual *return_val;
   int i;
 
+  if (depth >= 0 && depth < (gint) G_N_ELEMENTS (x11_screen->visual_by_both) &&
+      visual_type >= 0 &&
+      visual_type < (gint) G_N_ELEMENTS (x11_screen->visual_by_both[0]))
+    return x11_screen->visual_by_both[depth][visual_type];
+
   return_val = NULL;
   for (i = 0; i < x11_screen->nvisuals; i++)
     if ((depth == x11_screen->visuals[i]->depth) &&
@@ -56,6 +56,12 @@
 
 #include <X11/extensions/shape.h>
 
+#ifdef HAVE_XSHM
+#include <sys/ipc.h>
+#include <sys/shm.h>
+#include <X11/extensions/XShm.h>
+#endif
+
 #ifdef HAVE_XKB
 #include <X11/XKBlib.h>
 #endif
@@ -467,6 +473,128 @@ gdk_x11_create_cairo_surface (GdkWindowImplX11 *impl,
                                     width, height);
 }
 
+#ifdef HAVE_XSHM
+
+typedef struct {
+  GdkDisplay *display;
+  XShmSegmentInfo shminfo;
+} ShmSurfaceData;
+
+static const cairo_user_data_key_t gdk_x11_shm_surface_data_key;
+
+static void
+free_shm_surface_data (gpointer datap)
+{
+  ShmSurfaceData *data = datap;
+
+  if (!gdk_display_is_closed (data->display))
+    XShmDetach (GDK_DISPLAY_XDISPLAY (data->display), &data->shminfo);
+
+  shmdt (data->shminfo.shmaddr);
+
+  g_object_unref (data->display);
+  g_slice_free (ShmSurfaceData, data);
+}
+
+/* Create an image surface whose pixels live in a segment that is shared
+ * with the X server, so that its contents can be transferred without
+ * pushing the pixel data through the socket.
+ */
+static cairo_surface_t *
+gdk_x11_window_create_shm_image_surface (GdkDisplay     *display,
+                                         cairo_format_t  format,
+                                         int             width,
+                                         int             height)
+{
+  GdkX11Display *display_x11 = GDK_X11_DISPLAY (display);
+  ShmSurfaceData *data;
+  cairo_surface_t *surface;
+  XShmSegmentInfo shminfo;
+  int stride;
+
+  if (!display_x11->have_shm)
+    return NULL;
+
+  stride = cairo_format_stride_for_width (format, width);
+  if (stride <= 0)
+    return NULL;
+
+  shminfo.shmid = shmget (IPC_PRIVATE, stride * height, IPC_CREAT | 0600);
+  if (shminfo.shmid == -1)
+    return NULL;
+
+  shminfo.shmaddr = shmat (shminfo.shmid, NULL, 0);
+  if (shminfo.shmaddr == (char *) -1)
+    {
+      shmctl (shminfo.shmid, IPC_RMID, NULL);
+      return NULL;
+    }
+
+  shminfo.readOnly = False;
+
+  gdk_x11_display_error_trap_push (display);
+  XShmAttach (GDK_DISPLAY_XDISPLAY (display), &shminfo);
+  XSync (GDK_DISPLAY_XDISPLAY (display), False);
+
+  /* The segment is mapped on both sides now (or the attach failed),
+   * so it can be marked for removal right away.
+   */
+  shmctl (shminfo.shmid, IPC_RMID, NULL);
+
+  if (gdk_x11_display_error_trap_pop (display) != 0)
+    {
+      /* The server can't use our segments, likely because the display
+       * is remote; don't bother trying again.
+       */
+      display_x11->have_shm = FALSE;
+      shmdt (shminfo.shmaddr);
+      return NULL;
+    }
+
+  /* Fresh segments are zero-filled by the kernel, matching what
+   * gdk_window_create_similar_image_surface() promises.
+   */
+  surface = cairo_image_surface_create_for_data ((unsigned char *) shminfo.shmaddr,
+                                                 format, width, height, stride);
+  if (cairo_surface_status (surface) != CAIRO_STATUS_SUCCESS)
+    {
+      cairo_surface_destroy (surface);
+      XShmDetach (GDK_DISPLAY_XDISPLAY (display), &shminfo);
+      shmdt (shminfo.shmaddr);
+      return NULL;
+    }
+
+  data = g_slice_new (ShmSurfaceData);
+  data->display = g_object_ref (display);
+  data->shminfo = shminfo;
+
+  cairo_surface_set_user_data (surface, &gdk_x11_shm_surface_data_key,
+                               data, free_shm_surface_data);
+
+  return surface;
+}
+
+#endif /* HAVE_XSHM */
+
+static cairo_surface_t *
+gdk_x11_window_create_similar_image_surface (GdkWindow      *window,
+                                             cairo_format_t  format,
+                                             int             width,
+                                             int             height)
+{
+  cairo_surface_t *surface = NULL;
+
+#ifdef HAVE_XSHM
+  surface = gdk_x11_window_create_shm_image_surface (GDK_WINDOW_DISPLAY (window),
+                                                     format, width, height);
+#endif
+
+  if (surface == NULL)
+    surface = cairo_image_surface_create (format, width, height);
+
+  return surface;
+}
+
 static cairo_surface_t *
 gdk_x11_ref_cairo_surface (GdkWindow *window)
 {
@@ -5430,7 +5558,12 @@ gdk_x11_window_set_composited (GdkWindow *window,
   if (composited)
     {
       XCompositeRedirectWindow (dpy, xid, CompositeRedirectManual);
-      impl->damage = XDamageCreate (dpy, xid, XDamageReportBoundingBox);
+      /* Delta rectangles give us one notify per damaged rectangle
+       * instead of an ever-growing bounding box, so recompositing
+       * (e.g. of embedded plug windows) stays limited to the areas
+       * that actually changed.
+       */
+      impl->damage = XDamageCreate (dpy, xid, XDamageReportDeltaRectangles);
     }
   else
     {
@@ -5690,6 +5823,7 @@ gdk_window_impl_x11_class_init (GdkWindowImplX11Class *klass)
   object_class->finalize = gdk_window_impl_x11_finalize;
   
   impl_class->ref_cairo_surface = gdk_x11_ref_cairo_surface;
+  impl_class->create_similar_image_surface = gdk_x11_window_create_similar_image_surface;
   impl_class->show = gdk_window_x11_show;
   impl_class->hide = gdk_window_x11_hide;
   impl_class->withdraw = gdk_window_x11_withdraw;
@@ -441,12 +441,39 @@ read_settings (GdkX11Screen *x11_screen,
 	      g_warning ("Invalid format for XSETTINGS property: %d", format);
 	    }
 	  else
-	    x11_screen->xsettings = parse_settings (data, n_items);
-	  
+	    {
+	      /* Settings managers bump the serial (and thereby trigger
+	       * a PropertyNotify) even when nothing changed; if the raw
+	       * bytes are identical to what we last parsed, keep the
+	       * current settings and skip the reparse and notification.
+	       */
+	      if (x11_screen->xsettings_blob != NULL &&
+		  n_items == x11_screen->xsettings_blob_len &&
+		  memcmp (data, x11_screen->xsettings_blob, n_items) == 0)
+		{
+		  x11_screen->xsettings = old_list;
+		  XFree (data);
+		  return;
+		}
+
+	      g_free (x11_screen->xsettings_blob);
+	      x11_screen->xsettings_blob = g_memdup (data, n_items);
+	      x11_screen->xsettings_blob_len = n_items;
+
+	      x11_screen->xsettings = parse_settings (data, n_items);
+	    }
+
 	  XFree (data);
 	}
     }
 
+  if (x11_screen->xsettings == NULL)
+    {
+      g_free (x11_screen->xsettings_blob);
+      x11_screen->xsettings_blob = NULL;
+      x11_screen->xsettings_blob_len = 0;
+    }
+
   /* Since we support scaling we look at the specific Gdk/UnscaledDPI
      setting if it exists and use that instead of Xft/DPI if it is set */
   if (x11_screen->xsettings && !x11_screen->fixed_window_scale)
@@ -640,5 +667,9 @@ _gdk_x11_xsettings_finish (GdkX11Screen *x11_screen)
       g_hash_table_unref (x11_screen->xsettings);
       x11_screen->xsettings = NULL;
     }
+
+  g_free (x11_screen->xsettings_blob);
+  x11_screen->xsettings_blob = NULL;
+  x11_screen->xsettings_blob_len = 0;
 }
 
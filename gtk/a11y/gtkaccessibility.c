@@ -28,6 +28,8 @@
 
 #include <gdk/gdk.h>
 #include <gtk/gtkcombobox.h>
+#include <gtk/gtkcontainer.h>
+#include <gtk/gtkwindow.h>
 #include <gtk/gtkentry.h>
 #include <gtk/gtknotebook.h>
 #include <gtk/gtkmenuitem.h>
@@ -81,6 +83,7 @@ static guint focus_notify_handler = 0;
 static guint focus_tracker_id = 0;
 static GQuark quark_focus_object = 0;
 static int initialized = FALSE;
+static gboolean at_queried = FALSE;
 
 static AtkObject*
 get_accessible_for_widget (GtkWidget *widget,
@@ -970,6 +973,49 @@ do_window_event_initialization (void)
   g_signal_connect (root, "children-changed::remove", (GCallback) window_removed, NULL);
 }
 
+static void
+backfill_accessible_cb (GtkWidget *widget,
+                        gpointer   data)
+{
+  gtk_widget_get_accessible (widget);
+
+  if (GTK_IS_CONTAINER (widget))
+    gtk_container_forall (GTK_CONTAINER (widget), backfill_accessible_cb, NULL);
+}
+
+/* Whether an AT has queried the accessible hierarchy. Until that
+ * happens, nobody is listening on the other side and accessibles
+ * only need to exist where GTK+ itself looks at them.
+ */
+gboolean
+_gtk_accessibility_ats_present (void)
+{
+  return at_queried;
+}
+
+void
+_gtk_accessibility_note_at_query (void)
+{
+  GList *toplevels, *l;
+
+  if (at_queried)
+    return;
+
+  at_queried = TRUE;
+
+  /* An AT connected mid-session: materialize accessibles for the
+   * widgets already on screen, so the tree it is about to walk is
+   * complete and child notifications flow from here on.
+   */
+  toplevels = gtk_window_list_toplevels ();
+  g_list_foreach (toplevels, (GFunc) g_object_ref, NULL);
+
+  for (l = toplevels; l != NULL; l = l->next)
+    backfill_accessible_cb (GTK_WIDGET (l->data), NULL);
+
+  g_list_free_full (toplevels, g_object_unref);
+}
+
 void
 _gtk_accessibility_init (void)
 {
@@ -25,6 +25,9 @@ G_BEGIN_DECLS
 
 void      _gtk_accessibility_init        (void);
 
+gboolean  _gtk_accessibility_ats_present  (void);
+void      _gtk_accessibility_note_at_query (void);
+
 gboolean  _gtk_accessibility_key_snooper (GtkWidget   *widget,
                                           GdkEventKey *event);
 
@@ -19,6 +19,7 @@
 
 #include "gtkcontaineraccessible.h"
 #include "gtkcontaineraccessibleprivate.h"
+#include "gtkaccessibility.h"
 
 #include <gtk/gtk.h>
 
@@ -128,11 +129,19 @@ gtk_container_accessible_real_add_gtk (GtkContainer *container,
   gint index;
 
   atk_parent = ATK_OBJECT (data);
-  atk_child = gtk_widget_get_accessible (widget);
   accessible = GTK_CONTAINER_ACCESSIBLE (atk_parent);
 
   g_list_free (accessible->priv->children);
   accessible->priv->children = gtk_container_get_children (container);
+
+  /* Until an AT has asked for the hierarchy there is nobody listening
+   * for children-changed, so don't force the child's accessible into
+   * existence here; ref_child() creates it on first query.
+   */
+  if (!_gtk_accessibility_ats_present ())
+    return 1;
+
+  atk_child = gtk_widget_get_accessible (widget);
   index = g_list_index (accessible->priv->children, widget);
   _gtk_container_accessible_add_child (accessible, atk_child, index);
 
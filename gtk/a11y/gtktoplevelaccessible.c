@@ -17,6 +17,8 @@
 
 #include "config.h"
 
+#include "gtkaccessibility.h"
+
 #include <stdlib.h>
 #include <string.h>
 
@@ -64,6 +66,8 @@ gtk_toplevel_accessible_get_n_children (AtkObject *obj)
 {
   GtkToplevelAccessible *toplevel = GTK_TOPLEVEL_ACCESSIBLE (obj);
 
+  _gtk_accessibility_note_at_query ();
+
   return g_list_length (toplevel->priv->window_list);
 }
 
@@ -75,6 +79,8 @@ gtk_toplevel_accessible_ref_child (AtkObject *obj,
   GtkWidget *widget;
   AtkObject *atk_obj;
 
+  _gtk_accessibility_note_at_query ();
+
   toplevel = GTK_TOPLEVEL_ACCESSIBLE (obj);
   widget = g_list_nth_data (toplevel->priv->window_list, i);
   if (!widget)
@@ -90,6 +90,123 @@ size_allocate_cb (GtkWidget     *widget,
     }
 }
 
+/* State-change notifications triggered by widget property changes are
+ * coalesced per frame clock cycle: rapidly updating widgets would
+ * otherwise flood the a11y bus with intermediate values nobody can
+ * react to. Queued changes are deduplicated per (object, state) with
+ * the last value winning, and flushed after the next paint.
+ */
+typedef struct
+{
+  AtkObject *object;
+  AtkStateType state;
+  gboolean value;
+} QueuedStateChange;
+
+static GQueue state_change_queue = G_QUEUE_INIT;
+static GHashTable *state_change_index = NULL;
+static gboolean state_change_flush_scheduled = FALSE;
+
+static guint
+queued_state_change_hash (gconstpointer key)
+{
+  const QueuedStateChange *change = key;
+
+  return g_direct_hash (change->object) ^ change->state;
+}
+
+static gboolean
+queued_state_change_equal (gconstpointer a,
+                           gconstpointer b)
+{
+  const QueuedStateChange *change_a = a;
+  const QueuedStateChange *change_b = b;
+
+  return change_a->object == change_b->object &&
+         change_a->state == change_b->state;
+}
+
+static void
+state_change_flush (void)
+{
+  QueuedStateChange *change;
+
+  state_change_flush_scheduled = FALSE;
+
+  while ((change = g_queue_pop_head (&state_change_queue)))
+    {
+      g_hash_table_remove (state_change_index, change);
+      atk_object_notify_state_change (change->object, change->state, change->value);
+      g_object_unref (change->object);
+      g_slice_free (QueuedStateChange, change);
+    }
+}
+
+static void
+state_change_after_paint_cb (GdkFrameClock *clock)
+{
+  g_signal_handlers_disconnect_by_func (clock, state_change_after_paint_cb, NULL);
+  g_object_unref (clock);
+
+  state_change_flush ();
+}
+
+static gboolean
+state_change_idle_cb (gpointer data)
+{
+  state_change_flush ();
+
+  return G_SOURCE_REMOVE;
+}
+
+static void
+gtk_widget_accessible_queue_state_change (GtkWidget    *widget,
+                                          AtkObject    *object,
+                                          AtkStateType  state,
+                                          gboolean      value)
+{
+  QueuedStateChange lookup;
+  QueuedStateChange *change;
+
+  if (state_change_index == NULL)
+    state_change_index = g_hash_table_new (queued_state_change_hash,
+                                           queued_state_change_equal);
+
+  lookup.object = object;
+  lookup.state = state;
+
+  change = g_hash_table_lookup (state_change_index, &lookup);
+  if (change)
+    {
+      change->value = value;
+      return;
+    }
+
+  change = g_slice_new (QueuedStateChange);
+  change->object = g_object_ref (object);
+  change->state = state;
+  change->value = value;
+
+  g_queue_push_tail (&state_change_queue, change);
+  g_hash_table_add (state_change_index, change);
+
+  if (!state_change_flush_scheduled)
+    {
+      GdkFrameClock *clock = gtk_widget_get_frame_clock (widget);
+
+      state_change_flush_scheduled = TRUE;
+
+      if (clock)
+        {
+          g_signal_connect (g_object_ref (clock), "after-paint",
+                            G_CALLBACK (state_change_after_paint_cb), NULL);
+          gdk_frame_clock_request_phase (clock, GDK_FRAME_CLOCK_PHASE_AFTER_PAINT);
+        }
+      else
+        gdk_threads_add_idle (state_change_idle_cb, NULL);
+    }
+}
+
 /* Translate GtkWidget mapped state into AtkObject showing */
 static gint
 map_cb (GtkWidget *widget)
@@ -97,8 +214,8 @@ map_cb (GtkWidget *widget)
   AtkObject *accessible;
 
   accessible = gtk_widget_get_accessible (widget);
-  atk_object_notify_state_change (accessible, ATK_STATE_SHOWING,
-                                  gtk_widget_get_mapped (widget));
+  gtk_widget_accessible_queue_state_change (widget, accessible, ATK_STATE_SHOWING,
+                                            gtk_widget_get_mapped (widget));
   return 1;
 }
 
@@ -513,12 +630,12 @@ gtk_widget_accessible_notify_gtk (GObject    *obj,
   else
     return;
 
-  atk_object_notify_state_change (atk_obj, state, value);
+  gtk_widget_accessible_queue_state_change (widget, atk_obj, state, value);
   if (state == ATK_STATE_SENSITIVE)
-    atk_object_notify_state_change (atk_obj, ATK_STATE_ENABLED, value);
+    gtk_widget_accessible_queue_state_change (widget, atk_obj, ATK_STATE_ENABLED, value);
 
   if (state == ATK_STATE_HORIZONTAL)
-    atk_object_notify_state_change (atk_obj, ATK_STATE_VERTICAL, !value);
+    gtk_widget_accessible_queue_state_change (widget, atk_obj, ATK_STATE_VERTICAL, !value);
 }
 
 static AtkAttributeSet *
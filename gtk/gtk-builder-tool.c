@@ -726,6 +726,179 @@ do_enumerate (const gchar *filename)
   g_object_unref (builder);
 }
 
+/* Writer for the compiled format loaded by
+ * gtk_builder_add_from_compiled(); the layout is described in
+ * gtkbuilderparser.c. The XML is parsed once here, and the event
+ * stream is stored with all strings deduplicated into one table.
+ */
+
+typedef struct {
+  GString *events;
+  GString *strings;
+  GHashTable *string_offsets;
+  guint32 n_events;
+} CompileData;
+
+enum {
+  COMPILE_EVENT_START = 1,
+  COMPILE_EVENT_END   = 2,
+  COMPILE_EVENT_TEXT  = 3
+};
+
+static void
+compile_append_uint32 (GString *str,
+                       guint32  value)
+{
+  value = GUINT32_TO_LE (value);
+  g_string_append_len (str, (const gchar *)&value, 4);
+}
+
+static guint32
+compile_intern_string (CompileData *data,
+                       const gchar *string)
+{
+  gpointer stored;
+  guint32 offset;
+
+  /* Offsets are stored shifted by one so that 0 can mean "not seen" */
+  stored = g_hash_table_lookup (data->string_offsets, string);
+  if (stored != NULL)
+    return GPOINTER_TO_UINT (stored) - 1;
+
+  offset = data->strings->len;
+  g_string_append_len (data->strings, string, strlen (string) + 1);
+  g_hash_table_insert (data->string_offsets,
+                       g_strdup (string),
+                       GUINT_TO_POINTER (offset + 1));
+
+  return offset;
+}
+
+static void
+compile_start_element (GMarkupParseContext  *context,
+                       const gchar          *element_name,
+                       const gchar         **attribute_names,
+                       const gchar         **attribute_values,
+                       gpointer              user_data,
+                       GError              **error)
+{
+  CompileData *data = user_data;
+  guint32 n_attrs = g_strv_length ((gchar **)attribute_names);
+  guint32 i;
+
+  compile_append_uint32 (data->events, COMPILE_EVENT_START);
+  compile_append_uint32 (data->events, compile_intern_string (data, element_name));
+  compile_append_uint32 (data->events, n_attrs);
+  for (i = 0; i < n_attrs; i++)
+    {
+      compile_append_uint32 (data->events, compile_intern_string (data, attribute_names[i]));
+      compile_append_uint32 (data->events, compile_intern_string (data, attribute_values[i]));
+    }
+  data->n_events++;
+}
+
+static void
+compile_end_element (GMarkupParseContext  *context,
+                     const gchar          *element_name,
+                     gpointer              user_data,
+                     GError              **error)
+{
+  CompileData *data = user_data;
+
+  compile_append_uint32 (data->events, COMPILE_EVENT_END);
+  compile_append_uint32 (data->events, compile_intern_string (data, element_name));
+  data->n_events++;
+}
+
+static void
+compile_text (GMarkupParseContext  *context,
+              const gchar          *text,
+              gsize                 text_len,
+              gpointer              user_data,
+              GError              **error)
+{
+  CompileData *data = user_data;
+  gchar *copy;
+
+  copy = g_strndup (text, text_len);
+  compile_append_uint32 (data->events, COMPILE_EVENT_TEXT);
+  compile_append_uint32 (data->events, compile_intern_string (data, copy));
+  compile_append_uint32 (data->events, text_len);
+  g_free (copy);
+  data->n_events++;
+}
+
+static const GMarkupParser compile_parser = {
+  compile_start_element,
+  compile_end_element,
+  compile_text,
+  NULL,
+};
+
+static void
+do_compile (const gchar *filename,
+            const gchar *outname)
+{
+  GMarkupParseContext *context;
+  CompileData data;
+  GString *out;
+  gchar *buffer;
+  gchar *fallback_outname = NULL;
+  gsize length;
+  GError *error = NULL;
+
+  /* Make sure we only compile what would also load */
+  do_validate (filename);
+
+  if (!g_file_get_contents (filename, &buffer, &length, &error))
+    {
+      g_printerr ("%s\n", error->message);
+      exit (1);
+    }
+
+  data.events = g_string_new (NULL);
+  data.strings = g_string_new (NULL);
+  data.string_offsets = g_hash_table_new_full (g_str_hash, g_str_equal,
+                                               g_free, NULL);
+  data.n_events = 0;
+
+  context = g_markup_parse_context_new (&compile_parser,
+                                        G_MARKUP_TREAT_CDATA_AS_TEXT,
+                                        &data, NULL);
+  if (!g_markup_parse_context_parse (context, buffer, length, &error) ||
+      !g_markup_parse_context_end_parse (context, &error))
+    {
+      g_printerr ("%s\n", error->message);
+      exit (1);
+    }
+  g_markup_parse_context_free (context);
+  g_free (buffer);
+
+  out = g_string_new (NULL);
+  g_string_append_len (out, "GtkBuilderC\001", 12);
+  compile_append_uint32 (out, 1); /* version */
+  compile_append_uint32 (out, data.n_events);
+  compile_append_uint32 (out, 28 + data.events->len);
+  compile_append_uint32 (out, data.strings->len);
+  g_string_append_len (out, data.events->str, data.events->len);
+  g_string_append_len (out, data.strings->str, data.strings->len);
+
+  if (outname == NULL)
+    outname = fallback_outname = g_strconcat (filename, "c", NULL);
+
+  if (!g_file_set_contents (outname, out->str, out->len, &error))
+    {
+      g_printerr ("%s\n", error->message);
+      exit (1);
+    }
+
+  g_free (fallback_outname);
+  g_string_free (out, TRUE);
+  g_string_free (data.events, TRUE);
+  g_string_free (data.strings, TRUE);
+  g_hash_table_destroy (data.string_offsets);
+}
+
 static void
 usage (void)
 {
@@ -736,6 +909,7 @@ usage (void)
              "  validate    Validate the file\n"
              "  simplify    Simplify the file\n"
              "  enumerate   List all named objects\n"
+             "  compile     Compile the file for gtk_builder_add_from_compiled()\n"
              "\n"
              "Perform various tasks on GtkBuilder .ui files.\n"));
   exit (1);
@@ -759,6 +933,8 @@ main (int argc, char *argv[])
     do_simplify (argv[2]);
   else if (strcmp (argv[1], "enumerate") == 0)
     do_enumerate (argv[2]);
+  else if (strcmp (argv[1], "compile") == 0)
+    do_compile (argv[2], argc > 3 ? argv[3] : NULL);
   else
     usage ();
 
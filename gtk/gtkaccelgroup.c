@@ -193,6 +193,9 @@ gtk_accel_group_finalize (GObject *object)
 
   g_free (accel_group->priv->priv_accels);
 
+  if (accel_group->priv->accel_index)
+    g_hash_table_destroy (accel_group->priv->accel_index);
+
   G_OBJECT_CLASS (gtk_accel_group_parent_class)->finalize (object);
 }
 
@@ -231,6 +234,8 @@ gtk_accel_group_init (GtkAccelGroup *accel_group)
   priv->acceleratables = NULL;
   priv->n_accels = 0;
   priv->priv_accels = NULL;
+  priv->accel_index = NULL;
+  priv->accel_index_valid = FALSE;
 }
 
 /**
@@ -486,12 +491,23 @@ quick_accel_add (GtkAccelGroup   *accel_group,
   guint pos, i = accel_group->priv->n_accels++;
   GtkAccelGroupEntry key;
 
-  /* find position */
+  /* find position; the array is kept sorted, so binary search */
   key.key.accel_key = accel_key;
   key.key.accel_mods = accel_mods;
-  for (pos = 0; pos < i; pos++)
-    if (bsearch_compare_accels (&key, accel_group->priv->priv_accels + pos) < 0)
-      break;
+  {
+    guint lo = 0, hi = i;
+
+    while (lo < hi)
+      {
+        guint mid = (lo + hi) / 2;
+
+        if (bsearch_compare_accels (&key, accel_group->priv->priv_accels + mid) < 0)
+          hi = mid;
+        else
+          lo = mid + 1;
+      }
+    pos = lo;
+  }
 
   /* insert at position, ref closure */
   accel_group->priv->priv_accels = g_renew (GtkAccelGroupEntry, accel_group->priv->priv_accels, accel_group->priv->n_accels);
@@ -502,6 +518,7 @@ quick_accel_add (GtkAccelGroup   *accel_group,
   accel_group->priv->priv_accels[pos].key.accel_flags = accel_flags;
   accel_group->priv->priv_accels[pos].closure = g_closure_ref (closure);
   accel_group->priv->priv_accels[pos].accel_path_quark = path_quark;
+  accel_group->priv->accel_index_valid = FALSE;
   g_closure_sink (closure);
 
   /* handle closure invalidation and reverse lookups */
@@ -561,6 +578,7 @@ quick_accel_remove (GtkAccelGroup *accel_group,
   accel_group->priv->n_accels -= 1;
   memmove (entry, entry + 1,
            (accel_group->priv->n_accels - pos) * sizeof (accel_group->priv->priv_accels[0]));
+  accel_group->priv->accel_index_valid = FALSE;
 
   /* and notify */
   if (accel_quark)
@@ -570,35 +588,69 @@ quick_accel_remove (GtkAccelGroup *accel_group,
   g_closure_unref (closure);
 }
 
+/* Rebuild the hash index that maps each key+modifier combination
+ * to the first entry with it in the sorted entry array. The rebuild
+ * is deferred until the next lookup, so a burst of connects only
+ * pays for it once.
+ */
+static void
+quick_accel_index_rebuild (GtkAccelGroup *accel_group)
+{
+  GtkAccelGroupPrivate *priv = accel_group->priv;
+  guint i;
+
+  if (priv->accel_index == NULL)
+    priv->accel_index = g_hash_table_new_full (g_int64_hash, g_int64_equal,
+                                               g_free, NULL);
+  else
+    g_hash_table_remove_all (priv->accel_index);
+
+  for (i = 0; i < priv->n_accels; i++)
+    {
+      guint64 *index_key;
+
+      if (i > 0 &&
+          priv->priv_accels[i].key.accel_key == priv->priv_accels[i - 1].key.accel_key &&
+          priv->priv_accels[i].key.accel_mods == priv->priv_accels[i - 1].key.accel_mods)
+        continue;
+
+      index_key = g_new (guint64, 1);
+      *index_key = ((guint64) priv->priv_accels[i].key.accel_key << 32) |
+                   priv->priv_accels[i].key.accel_mods;
+      g_hash_table_insert (priv->accel_index, index_key, GUINT_TO_POINTER (i + 1));
+    }
+
+  priv->accel_index_valid = TRUE;
+}
+
 static GtkAccelGroupEntry*
 quick_accel_find (GtkAccelGroup   *accel_group,
                   guint            accel_key,
                   GdkModifierType  accel_mods,
                   guint           *count_p)
 {
+  GtkAccelGroupPrivate *priv = accel_group->priv;
   GtkAccelGroupEntry *entry;
-  GtkAccelGroupEntry key;
+  guint64 index_key;
+  guint pos;
 
   *count_p = 0;
 
-  if (!accel_group->priv->n_accels)
+  if (!priv->n_accels)
     return NULL;
 
-  key.key.accel_key = accel_key;
-  key.key.accel_mods = accel_mods;
-  entry = bsearch (&key, accel_group->priv->priv_accels, accel_group->priv->n_accels,
-                   sizeof (accel_group->priv->priv_accels[0]), bsearch_compare_accels);
+  if (!priv->accel_index_valid)
+    quick_accel_index_rebuild (accel_group);
 
-  if (!entry)
+  index_key = ((guint64) accel_key << 32) | accel_mods;
+  pos = GPOINTER_TO_UINT (g_hash_table_lookup (priv->accel_index, &index_key));
+  if (pos == 0)
     return NULL;
 
-  /* step back to the first member */
-  for (; entry > accel_group->priv->priv_accels; entry--)
-    if (entry[-1].key.accel_key != accel_key ||
-        entry[-1].key.accel_mods != accel_mods)
-      break;
+  entry = priv->priv_accels + (pos - 1);
+
   /* count equal members */
-  for (; entry + *count_p < accel_group->priv->priv_accels + accel_group->priv->n_accels; (*count_p)++)
+  for (; entry + *count_p < priv->priv_accels + priv->n_accels; (*count_p)++)
     if (entry[*count_p].key.accel_key != accel_key ||
         entry[*count_p].key.accel_mods != accel_mods)
       break;
@@ -32,6 +32,8 @@ struct _GtkAccelGroupPrivate
   GSList             *acceleratables;
   guint               n_accels;
   GtkAccelGroupEntry *priv_accels;
+  GHashTable         *accel_index;
+  guint               accel_index_valid : 1;
 };
 
 void	_gtk_accel_group_reconnect        (GtkAccelGroup *accel_group,
@@ -61,6 +61,11 @@ struct _GtkAdjustmentPrivate {
   gint64 end_time;
   guint tick_id;
   GdkFrameClock *clock;
+
+  guint deferred_id;
+
+  guint deferred_notification : 1;
+  guint deferred_pending      : 1;
 };
 
 enum
@@ -111,6 +116,8 @@ gtk_adjustment_finalize (GObject *object)
 
   if (priv->tick_id)
     g_signal_handler_disconnect (priv->clock, priv->tick_id);
+  if (priv->deferred_id)
+    g_signal_handler_disconnect (priv->clock, priv->deferred_id);
   if (priv->clock)
     g_object_unref (priv->clock);
 
@@ -343,13 +350,54 @@ emit_changed (GtkAdjustment *adjustment)
   g_signal_emit (adjustment, adjustment_signals[CHANGED], 0);
 }
 
-static inline void
-emit_value_changed (GtkAdjustment *adjustment)
+static void
+emit_value_changed_now (GtkAdjustment *adjustment)
 {
+  adjustment->priv->deferred_pending = FALSE;
+
   g_signal_emit (adjustment, adjustment_signals[VALUE_CHANGED], 0);
   g_object_notify_by_pspec (G_OBJECT (adjustment), adjustment_props[PROP_VALUE]);
 }
 
+static void
+gtk_adjustment_on_frame_clock_deferred (GdkFrameClock *clock,
+                                        GtkAdjustment *adjustment)
+{
+  GtkAdjustmentPrivate *priv = adjustment->priv;
+
+  g_signal_handler_disconnect (priv->clock, priv->deferred_id);
+  priv->deferred_id = 0;
+
+  if (priv->deferred_pending)
+    emit_value_changed_now (adjustment);
+}
+
+static void
+emit_value_changed (GtkAdjustment *adjustment)
+{
+  GtkAdjustmentPrivate *priv = adjustment->priv;
+
+  /* Animated changes already arrive from the update phase, one per
+   * frame, so deferring them again would only add a frame of lag.
+   */
+  if (priv->deferred_notification && priv->clock != NULL && priv->tick_id == 0)
+    {
+      priv->deferred_pending = TRUE;
+
+      if (priv->deferred_id == 0)
+        {
+          priv->deferred_id = g_signal_connect (priv->clock, "update",
+                                                G_CALLBACK (gtk_adjustment_on_frame_clock_deferred),
+                                                adjustment);
+          gdk_frame_clock_request_phase (priv->clock, GDK_FRAME_CLOCK_PHASE_UPDATE);
+        }
+
+      return;
+    }
+
+  emit_value_changed_now (adjustment);
+}
+
 static void
 gtk_adjustment_dispatch_properties_changed (GObject     *object,
                                             guint        n_pspecs,
@@ -987,6 +1035,75 @@ gtk_adjustment_get_minimum_increment (GtkAdjustment *adjustment)
   return minimum_increment;
 }
 
+/**
+ * gtk_adjustment_set_deferred_notification:
+ * @adjustment: a #GtkAdjustment
+ * @deferred: whether to defer ::value-changed to the frame clock
+ *
+ * Sets whether emission of #GtkAdjustment::value-changed is deferred
+ * to the update phase of the frame clock, coalescing any number of
+ * value changes made during a frame into a single emission.
+ *
+ * This is useful when several adjustments are updated in lockstep
+ * from application code, for example to scroll multiple panes
+ * synchronously: with deferred notification each pane runs its
+ * scroll-and-redraw pipeline once per frame instead of once per
+ * gtk_adjustment_set_value() call.
+ *
+ * gtk_adjustment_get_value() always returns the most recently set
+ * value; only the notification is delayed. Deferral requires a frame
+ * clock, which the adjustment learns from the scrollable widget it is
+ * attached to once that widget is realized; until one is known,
+ * emission remains immediate.
+ *
+ * Since: 3.18
+ */
+void
+gtk_adjustment_set_deferred_notification (GtkAdjustment *adjustment,
+                                          gboolean       deferred)
+{
+  GtkAdjustmentPrivate *priv;
+
+  g_return_if_fail (GTK_IS_ADJUSTMENT (adjustment));
+
+  priv = adjustment->priv;
+
+  deferred = deferred != FALSE;
+
+  if (priv->deferred_notification == deferred)
+    return;
+
+  priv->deferred_notification = deferred;
+
+  if (!deferred && priv->deferred_id)
+    {
+      g_signal_handler_disconnect (priv->clock, priv->deferred_id);
+      priv->deferred_id = 0;
+
+      if (priv->deferred_pending)
+        emit_value_changed_now (adjustment);
+    }
+}
+
+/**
+ * gtk_adjustment_get_deferred_notification:
+ * @adjustment: a #GtkAdjustment
+ *
+ * Returns whether #GtkAdjustment::value-changed emission is deferred
+ * to the frame clock. See gtk_adjustment_set_deferred_notification().
+ *
+ * Returns: %TRUE if notification is deferred
+ *
+ * Since: 3.18
+ */
+gboolean
+gtk_adjustment_get_deferred_notification (GtkAdjustment *adjustment)
+{
+  g_return_val_if_fail (GTK_IS_ADJUSTMENT (adjustment), FALSE);
+
+  return adjustment->priv->deferred_notification;
+}
+
 void
 gtk_adjustment_enable_animation (GtkAdjustment *adjustment,
                                  GdkFrameClock *clock,
@@ -1005,6 +1122,15 @@ gtk_adjustment_enable_animation (GtkAdjustment *adjustment,
           gdk_frame_clock_end_updating (priv->clock);
         }
 
+      if (priv->deferred_id)
+        {
+          g_signal_handler_disconnect (priv->clock, priv->deferred_id);
+          priv->deferred_id = 0;
+
+          if (priv->deferred_pending)
+            emit_value_changed_now (adjustment);
+        }
+
       if (priv->clock)
         g_object_unref (priv->clock);
 
@@ -133,6 +133,11 @@ void       gtk_adjustment_configure             (GtkAdjustment   *adjustment,
                                                  gdouble          page_size);
 GDK_AVAILABLE_IN_3_2
 gdouble    gtk_adjustment_get_minimum_increment (GtkAdjustment   *adjustment);
+GDK_AVAILABLE_IN_3_18
+void       gtk_adjustment_set_deferred_notification (GtkAdjustment *adjustment,
+                                                     gboolean       deferred);
+GDK_AVAILABLE_IN_3_18
+gboolean   gtk_adjustment_get_deferred_notification (GtkAdjustment *adjustment);
 
 G_END_DECLS
 
@@ -103,151 +103,219 @@ client_proxy_signal (GDBusProxy  *proxy,
     }
 }
 
+static gchar *client_id;
+
 static void
-gtk_application_impl_dbus_startup (GtkApplicationImpl *impl,
-                                   gboolean            register_session)
+gtk_application_impl_dbus_session_bus_checked (GObject      *source,
+                                               GAsyncResult *result,
+                                               gpointer      user_data)
 {
-  GtkApplicationImplDBus *dbus = (GtkApplicationImplDBus *) impl;
-  static gchar *client_id;
-  GError *error = NULL;
+  GtkApplicationImplDBus *dbus = user_data;
   GVariant *res;
-  gboolean same_bus;
+  gboolean same_bus = FALSE;
 
-  dbus->session = g_application_get_dbus_connection (G_APPLICATION (impl->application));
+  res = g_dbus_connection_call_finish (dbus->session, result, NULL);
+  if (res)
+    {
+      GValue value = G_VALUE_INIT;
+      const gchar *id;
+      const gchar *id2;
 
-  if (!dbus->session)
-    goto out;
+      g_value_init (&value, G_TYPE_STRING);
+      gdk_screen_get_setting (gdk_screen_get_default (), "gtk-session-bus-id", &value);
+      id = g_value_get_string (&value);
 
-  dbus->application_id = g_application_get_application_id (G_APPLICATION (impl->application));
-  dbus->object_path = g_application_get_dbus_object_path (G_APPLICATION (impl->application));
-  dbus->unique_name = g_dbus_connection_get_unique_name (dbus->session);
+      g_variant_get (res, "(&s)", &id2);
 
-  if (client_id == NULL)
-    {
-      const gchar *desktop_autostart_id;
+      if (g_strcmp0 (id, id2) == 0)
+        same_bus = TRUE;
 
-      desktop_autostart_id = g_getenv ("DESKTOP_AUTOSTART_ID");
-      /* Unset DESKTOP_AUTOSTART_ID in order to avoid child processes to
-       * use the same client id.
-       */
-      g_unsetenv ("DESKTOP_AUTOSTART_ID");
-      client_id = g_strdup (desktop_autostart_id ? desktop_autostart_id : "");
+      g_value_unset (&value);
+      g_variant_unref (res);
     }
 
-  g_debug ("Connecting to session manager");
+  if (!same_bus)
+    g_object_set (gtk_settings_get_default (),
+                  "gtk-shell-shows-app-menu", FALSE,
+                  "gtk-shell-shows-menubar", FALSE,
+                  NULL);
+
+  g_object_unref (dbus);
+}
+
+static void
+gtk_application_impl_dbus_client_proxy_created (GObject      *source,
+                                                GAsyncResult *result,
+                                                gpointer      user_data)
+{
+  GtkApplicationImplDBus *dbus = user_data;
+  GError *error = NULL;
 
-  dbus->sm_proxy = g_dbus_proxy_new_sync (dbus->session,
-                                          G_DBUS_PROXY_FLAGS_DO_NOT_LOAD_PROPERTIES |
-                                          G_DBUS_PROXY_FLAGS_DO_NOT_CONNECT_SIGNALS,
-                                          NULL,
-                                          "org.gnome.SessionManager",
-                                          "/org/gnome/SessionManager",
-                                          "org.gnome.SessionManager",
-                                          NULL,
-                                          &error);
+  dbus->client_proxy = g_dbus_proxy_new_finish (result, &error);
 
   if (error)
     {
-      g_warning ("Failed to get a session proxy: %s", error->message);
+      g_warning ("Failed to get client proxy: %s", error->message);
       g_error_free (error);
-      goto out;
+      g_clear_object (&dbus->sm_proxy);
+      g_free (dbus->client_path);
+      dbus->client_path = NULL;
+      g_object_unref (dbus);
+      return;
     }
 
-  /* FIXME: should we reuse the D-Bus application id here ? */
-  dbus->app_id = g_strdup (g_get_prgname ());
+  g_debug ("Registered client at '%s'", dbus->client_path);
 
-  if (!register_session)
-    goto out;
+  g_signal_connect (dbus->client_proxy, "g-signal", G_CALLBACK (client_proxy_signal), dbus);
 
-  g_debug ("Registering client '%s' '%s'", dbus->app_id, client_id);
+  g_object_unref (dbus);
+}
 
-  res = g_dbus_proxy_call_sync (dbus->sm_proxy,
-                                "RegisterClient",
-                                g_variant_new ("(ss)", dbus->app_id, client_id),
-                                G_DBUS_CALL_FLAGS_NONE,
-                                G_MAXINT,
-                                NULL,
-                                &error);
+static void
+gtk_application_impl_dbus_client_registered (GObject      *source,
+                                             GAsyncResult *result,
+                                             gpointer      user_data)
+{
+  GtkApplicationImplDBus *dbus = user_data;
+  GError *error = NULL;
+  GVariant *res;
+
+  res = g_dbus_proxy_call_finish (G_DBUS_PROXY (source), result, &error);
 
   if (error)
     {
       g_warning ("Failed to register client: %s", error->message);
       g_error_free (error);
       g_clear_object (&dbus->sm_proxy);
-      goto out;
+      g_object_unref (dbus);
+      return;
     }
 
   g_variant_get (res, "(o)", &dbus->client_path);
   g_variant_unref (res);
 
-  g_debug ("Registered client at '%s'", dbus->client_path);
+  g_dbus_proxy_new (dbus->session, 0,
+                    NULL,
+                    "org.gnome.SessionManager",
+                    dbus->client_path,
+                    "org.gnome.SessionManager.ClientPrivate",
+                    NULL,
+                    gtk_application_impl_dbus_client_proxy_created,
+                    g_object_ref (dbus));
+
+  g_object_unref (dbus);
+}
+
+static void
+gtk_application_impl_dbus_sm_proxy_created (GObject      *source,
+                                            GAsyncResult *result,
+                                            gpointer      user_data)
+{
+  GtkApplicationImplDBus *dbus = user_data;
+  GError *error = NULL;
+
+  dbus->sm_proxy = g_dbus_proxy_new_finish (result, &error);
 
-  dbus->client_proxy = g_dbus_proxy_new_sync (dbus->session, 0,
-                                              NULL,
-                                              "org.gnome.SessionManager",
-                                              dbus->client_path,
-                                              "org.gnome.SessionManager.ClientPrivate",
-                                              NULL,
-                                              &error);
   if (error)
     {
-      g_warning ("Failed to get client proxy: %s", error->message);
+      g_warning ("Failed to get a session proxy: %s", error->message);
       g_error_free (error);
-      g_clear_object (&dbus->sm_proxy);
-      g_free (dbus->client_path);
-      dbus->client_path = NULL;
-      goto out;
+      g_object_unref (dbus);
+      return;
     }
 
-  g_signal_connect (dbus->client_proxy, "g-signal", G_CALLBACK (client_proxy_signal), dbus);
+  if (dbus->register_session)
+    {
+      g_debug ("Registering client '%s' '%s'", dbus->app_id, client_id);
+
+      g_dbus_proxy_call (dbus->sm_proxy,
+                         "RegisterClient",
+                         g_variant_new ("(ss)", dbus->app_id, client_id),
+                         G_DBUS_CALL_FLAGS_NONE,
+                         G_MAXINT,
+                         NULL,
+                         gtk_application_impl_dbus_client_registered,
+                         g_object_ref (dbus));
+    }
+
+  g_object_unref (dbus);
+}
 
- out:
-  same_bus = FALSE;
+static void
+gtk_application_impl_dbus_startup (GtkApplicationImpl *impl,
+                                   gboolean            register_session)
+{
+  GtkApplicationImplDBus *dbus = (GtkApplicationImplDBus *) impl;
+  GValue value = G_VALUE_INIT;
+  const gchar *id;
 
-  if (dbus->session)
+  dbus->session = g_application_get_dbus_connection (G_APPLICATION (impl->application));
+
+  if (!dbus->session)
     {
-      const gchar *id;
-      const gchar *id2;
-      GValue value = G_VALUE_INIT;
+      g_object_set (gtk_settings_get_default (),
+                    "gtk-shell-shows-app-menu", FALSE,
+                    "gtk-shell-shows-menubar", FALSE,
+                    NULL);
+      return;
+    }
 
-      g_value_init (&value, G_TYPE_STRING);
-      gdk_screen_get_setting (gdk_screen_get_default (), "gtk-session-bus-id", &value);
-      id = g_value_get_string (&value);
+  dbus->application_id = g_application_get_application_id (G_APPLICATION (impl->application));
+  dbus->object_path = g_application_get_dbus_object_path (G_APPLICATION (impl->application));
+  dbus->unique_name = g_dbus_connection_get_unique_name (dbus->session);
+  dbus->register_session = register_session;
 
-      if (id && id[0])
-        {
-          res = g_dbus_connection_call_sync (dbus->session,
-                                             "org.freedesktop.DBus",
-                                             "/org/freedesktop/DBus",
-                                             "org.freedesktop.DBus",
-                                             "GetId",
-                                             NULL,
-                                             NULL,
-                                             G_DBUS_CALL_FLAGS_NONE,
-                                             -1,
-                                             NULL,
-                                             NULL);
-          if (res)
-            {
-              g_variant_get (res, "(&s)", &id2);
-
-              if (g_strcmp0 (id, id2) == 0)
-                same_bus = TRUE;
-
-              g_variant_unref (res);
-            }
-        }
-      else
-        same_bus = TRUE;
+  if (client_id == NULL)
+    {
+      const gchar *desktop_autostart_id;
 
-      g_value_unset (&value);
+      desktop_autostart_id = g_getenv ("DESKTOP_AUTOSTART_ID");
+      /* Unset DESKTOP_AUTOSTART_ID in order to avoid child processes to
+       * use the same client id.
+       */
+      g_unsetenv ("DESKTOP_AUTOSTART_ID");
+      client_id = g_strdup (desktop_autostart_id ? desktop_autostart_id : "");
     }
 
-  if (!same_bus)
-    g_object_set (gtk_settings_get_default (),
-                  "gtk-shell-shows-app-menu", FALSE,
-                  "gtk-shell-shows-menubar", FALSE,
-                  NULL);
+  /* FIXME: should we reuse the D-Bus application id here ? */
+  dbus->app_id = g_strdup (g_get_prgname ());
+
+  g_debug ("Connecting to session manager");
+
+  /* All the session manager traffic is asynchronous: on a congested
+   * bus the round trips would otherwise stall startup until the
+   * session manager gets around to answering.
+   */
+  g_dbus_proxy_new (dbus->session,
+                    G_DBUS_PROXY_FLAGS_DO_NOT_LOAD_PROPERTIES |
+                    G_DBUS_PROXY_FLAGS_DO_NOT_CONNECT_SIGNALS,
+                    NULL,
+                    "org.gnome.SessionManager",
+                    "/org/gnome/SessionManager",
+                    "org.gnome.SessionManager",
+                    NULL,
+                    gtk_application_impl_dbus_sm_proxy_created,
+                    g_object_ref (dbus));
+
+  g_value_init (&value, G_TYPE_STRING);
+  gdk_screen_get_setting (gdk_screen_get_default (), "gtk-session-bus-id", &value);
+  id = g_value_get_string (&value);
+
+  if (id && id[0])
+    g_dbus_connection_call (dbus->session,
+                            "org.freedesktop.DBus",
+                            "/org/freedesktop/DBus",
+                            "org.freedesktop.DBus",
+                            "GetId",
+                            NULL,
+                            NULL,
+                            G_DBUS_CALL_FLAGS_NONE,
+                            -1,
+                            NULL,
+                            gtk_application_impl_dbus_session_bus_checked,
+                            g_object_ref (dbus));
+
+  g_value_unset (&value);
 }
 
 static void
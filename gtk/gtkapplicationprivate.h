@@ -137,6 +137,7 @@ typedef struct
   GDBusProxy      *sm_proxy;
   GDBusProxy      *client_proxy;
   gchar           *client_path;
+  guint            register_session : 1;
 } GtkApplicationImplDBus;
 
 typedef struct
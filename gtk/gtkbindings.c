@@ -152,6 +152,7 @@ typedef enum {
 static GHashTable       *binding_entry_hash_table = NULL;
 static GSList           *binding_key_hashes = NULL;
 static GSList           *binding_set_list = NULL;
+static GHashTable       *binding_set_chain_cache = NULL;
 static const gchar       key_class_binding_set[] = "gtk-class-binding-set";
 static GQuark            key_id_class_binding_set = 0;
 
@@ -689,6 +690,10 @@ gtk_binding_set_new (const gchar *set_name)
 
   binding_set_list = g_slist_prepend (binding_set_list, binding_set);
 
+  /* Cached per-class chains may now be missing the new set */
+  if (binding_set_chain_cache)
+    g_hash_table_remove_all (binding_set_chain_cache);
+
   return binding_set;
 }
 
@@ -1393,6 +1398,43 @@ find_entry_with_binding (GtkBindingEntry *entry,
   return (entry->binding_set == binding_set) ? 0 : 1;
 }
 
+/* Returns the binding sets named after @class_type and its ancestors,
+ * most derived first, the order gtk_bindings_activate_list() consults
+ * them in. The chain is resolved once per type and cached; creating a
+ * new binding set flushes the cache, and binding sets are never freed,
+ * so cached chains cannot go stale.
+ */
+static GSList*
+gtk_binding_set_chain_for_type (GType class_type)
+{
+  GSList *chain;
+  GType type;
+
+  if (!binding_set_chain_cache)
+    binding_set_chain_cache = g_hash_table_new_full (NULL, NULL, NULL,
+                                                     (GDestroyNotify) g_slist_free);
+  else if (g_hash_table_lookup_extended (binding_set_chain_cache,
+                                         GSIZE_TO_POINTER (class_type),
+                                         NULL, (gpointer *) &chain))
+    return chain;
+
+  chain = NULL;
+  for (type = class_type; type; type = g_type_parent (type))
+    {
+      GtkBindingSet *binding_set;
+
+      binding_set = gtk_binding_set_find_interned (g_type_name (type));
+      if (binding_set)
+        chain = g_slist_prepend (chain, binding_set);
+    }
+  chain = g_slist_reverse (chain);
+
+  g_hash_table_insert (binding_set_chain_cache,
+                       GSIZE_TO_POINTER (class_type), chain);
+
+  return chain;
+}
+
 static gboolean
 binding_activate (GtkBindingSet *binding_set,
                   GSList        *entries,
@@ -1469,17 +1511,14 @@ gtk_bindings_activate_list (GObject  *object,
 
   if (!handled)
     {
-      GType class_type;
+      GSList *chain;
 
-      class_type = G_TYPE_FROM_INSTANCE (object);
+      chain = gtk_binding_set_chain_for_type (G_TYPE_FROM_INSTANCE (object));
 
-      while (class_type && !handled)
+      while (chain && !handled)
         {
-          binding_set = gtk_binding_set_find_interned (g_type_name (class_type));
-          class_type = g_type_parent (class_type);
-
-          if (!binding_set)
-            continue;
+          binding_set = chain->data;
+          chain = chain->next;
 
           handled = binding_activate (binding_set, entries,
                                       object, is_release,
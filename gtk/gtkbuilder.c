@@ -259,8 +259,25 @@ struct _GtkBuilderPrivate
   gchar *resource_prefix;
   GType template_type;
   GtkApplication *application;
+  GSList *lazy_buffers;
+  GHashTable *value_cache;
+  guint lazy_construction : 1;
 };
 
+typedef struct {
+  gchar *filename;
+  gchar *buffer;
+  gsize length;
+} LazyBuffer;
+
+static void
+lazy_buffer_free (LazyBuffer *lazy)
+{
+  g_free (lazy->filename);
+  g_free (lazy->buffer);
+  g_slice_free (LazyBuffer, lazy);
+}
+
 G_DEFINE_TYPE_WITH_PRIVATE (GtkBuilder, gtk_builder, G_TYPE_OBJECT)
 
 static void
@@ -324,6 +341,9 @@ gtk_builder_finalize (GObject *object)
     g_hash_table_destroy (priv->callbacks);
 
   g_slist_free_full (priv->signals, (GDestroyNotify)_free_signal_info);
+  g_slist_free_full (priv->lazy_buffers, (GDestroyNotify)lazy_buffer_free);
+  if (priv->value_cache)
+    g_hash_table_destroy (priv->value_cache);
 
   G_OBJECT_CLASS (gtk_builder_parent_class)->finalize (object);
 }
@@ -973,6 +993,67 @@ gtk_builder_new (void)
   return g_object_new (GTK_TYPE_BUILDER, NULL);
 }
 
+static void
+gtk_builder_stash_lazy_buffer (GtkBuilder  *builder,
+                               const gchar *filename,
+                               gchar       *buffer,
+                               gsize        length)
+{
+  LazyBuffer *lazy;
+
+  lazy = g_slice_new (LazyBuffer);
+  lazy->filename = g_strdup (filename);
+  lazy->buffer = buffer;
+  lazy->length = length;
+
+  builder->priv->lazy_buffers = g_slist_append (builder->priv->lazy_buffers,
+                                                lazy);
+}
+
+/* Constructs @name (or every pending object, when @name is %NULL) from
+ * the stashed buffers. Materializing one object re-parses the buffers
+ * with only that object requested, so objects referenced from it must
+ * either be its descendants or be materialized already, the same rule
+ * gtk_builder_add_objects_from_file() has always had.
+ */
+static void
+gtk_builder_materialize (GtkBuilder  *builder,
+                         const gchar *name)
+{
+  GSList *l;
+
+  for (l = builder->priv->lazy_buffers; l; l = l->next)
+    {
+      LazyBuffer *lazy = l->data;
+      gchar *requested[2] = { (gchar *)name, NULL };
+      GError *error = NULL;
+
+      g_free (builder->priv->filename);
+      builder->priv->filename = g_strdup (lazy->filename);
+
+      _gtk_builder_parser_parse_buffer (builder, lazy->filename,
+                                        lazy->buffer, lazy->length,
+                                        name ? requested : NULL,
+                                        &error);
+      if (error)
+        {
+          g_warning ("Error materializing objects from %s: %s",
+                     lazy->filename, error->message);
+          g_error_free (error);
+        }
+
+      if (name && g_hash_table_lookup (builder->priv->objects, name))
+        return;
+    }
+
+  if (name == NULL)
+    {
+      g_slist_free_full (builder->priv->lazy_buffers,
+                         (GDestroyNotify)lazy_buffer_free);
+      builder->priv->lazy_buffers = NULL;
+    }
+}
+
 /**
  * gtk_builder_add_from_file:
  * @builder: a #GtkBuilder
@@ -1025,6 +1106,12 @@ gtk_builder_add_from_file (GtkBuilder   *builder,
   builder->priv->filename = g_strdup (filename);
   builder->priv->resource_prefix = NULL;
 
+  if (builder->priv->lazy_construction)
+    {
+      gtk_builder_stash_lazy_buffer (builder, filename, buffer, length);
+      return 1;
+    }
+
   _gtk_builder_parser_parse_buffer (builder, filename,
                                     buffer, length,
                                     NULL,
@@ -1041,6 +1128,75 @@ gtk_builder_add_from_file (GtkBuilder   *builder,
   return 1;
 }
 
+/**
+ * gtk_builder_add_from_compiled:
+ * @builder: a #GtkBuilder
+ * @filename: the name of the compiled file to load
+ * @error: (allow-none): return location for an error, or %NULL
+ *
+ * Loads a compiled [GtkBuilder UI definition][BUILDER-UI], as written
+ * by `gtk-builder-tool compile`, and merges it with the current
+ * contents of @builder. The file is mapped into memory and replayed
+ * without going through the XML parser, which makes this noticeably
+ * faster than gtk_builder_add_from_file() for applications that open
+ * the same interfaces often.
+ *
+ * The compiled format is tied to the GTK+ version that wrote it and
+ * should be regenerated at build time, not shipped as a source of
+ * truth; keep the .ui file around.
+ *
+ * Upon errors 0 will be returned and @error will be assigned a
+ * #GError from the #GTK_BUILDER_ERROR or #G_FILE_ERROR domain.
+ *
+ * Returns: A positive value on success, 0 if an error occurred
+ *
+ * Since: 3.18
+ **/
+guint
+gtk_builder_add_from_compiled (GtkBuilder   *builder,
+                               const gchar  *filename,
+                               GError      **error)
+{
+  GMappedFile *mapped;
+  GError *tmp_error;
+
+  g_return_val_if_fail (GTK_IS_BUILDER (builder), 0);
+  g_return_val_if_fail (filename != NULL, 0);
+  g_return_val_if_fail (error == NULL || *error == NULL, 0);
+
+  tmp_error = NULL;
+
+  mapped = g_mapped_file_new (filename, FALSE, &tmp_error);
+  if (mapped == NULL)
+    {
+      g_propagate_error (error, tmp_error);
+      return 0;
+    }
+
+  g_free (builder->priv->filename);
+  g_free (builder->priv->resource_prefix);
+  builder->priv->filename = g_strdup (filename);
+  builder->priv->resource_prefix = NULL;
+
+  /* The mapping has to outlive the parse; element and attribute
+   * strings are handed to the builder machinery right out of it.
+   */
+  _gtk_builder_parser_parse_compiled (builder, filename,
+                                      g_mapped_file_get_contents (mapped),
+                                      g_mapped_file_get_length (mapped),
+                                      &tmp_error);
+
+  g_mapped_file_unref (mapped);
+
+  if (tmp_error != NULL)
+    {
+      g_propagate_error (error, tmp_error);
+      return 0;
+    }
+
+  return 1;
+}
+
 /**
  * gtk_builder_add_objects_from_file:
  * @builder: a #GtkBuilder
@@ -1138,10 +1294,20 @@ gtk_builder_extend_with_template (GtkBuilder   *builder,
   builder->priv->template_type = template_type;
 
   gtk_builder_expose_object (builder, g_type_name (template_type), G_OBJECT (widget));
-  _gtk_builder_parser_parse_buffer (builder, "<input>",
-                                    buffer, length,
-                                    NULL,
-                                    &tmp_error);
+
+  /* Templates may be precompiled with gtk-builder-tool at build time,
+   * in which case the first instance of the class skips XML parsing
+   * entirely.
+   */
+  if (_gtk_builder_parser_is_compiled (buffer, length))
+    _gtk_builder_parser_parse_compiled (builder, "<input>",
+                                        buffer, length,
+                                        &tmp_error);
+  else
+    _gtk_builder_parser_parse_buffer (builder, "<input>",
+                                      buffer, length,
+                                      NULL,
+                                      &tmp_error);
 
   if (tmp_error != NULL)
     {
@@ -1438,10 +1604,20 @@ GObject *
 gtk_builder_get_object (GtkBuilder  *builder,
                         const gchar *name)
 {
+  GObject *object;
+
   g_return_val_if_fail (GTK_IS_BUILDER (builder), NULL);
   g_return_val_if_fail (name != NULL, NULL);
 
-  return g_hash_table_lookup (builder->priv->objects, name);
+  object = g_hash_table_lookup (builder->priv->objects, name);
+
+  if (object == NULL && builder->priv->lazy_buffers != NULL)
+    {
+      gtk_builder_materialize (builder, name);
+      object = g_hash_table_lookup (builder->priv->objects, name);
+    }
+
+  return object;
 }
 
 static void
@@ -1522,6 +1698,62 @@ gtk_builder_get_translation_domain (GtkBuilder *builder)
   return builder->priv->domain;
 }
 
+/**
+ * gtk_builder_set_lazy_construction:
+ * @builder: a #GtkBuilder
+ * @lazy: whether to defer object construction
+ *
+ * Sets whether UI definitions added to @builder with
+ * gtk_builder_add_from_file() are constructed immediately. With lazy
+ * construction enabled, adding a file only stores its contents, and
+ * an object is constructed, together with its descendants, the first
+ * time gtk_builder_get_object() asks for it. This keeps loading cheap
+ * for interfaces where only a few of the defined objects are shown,
+ * such as one page of a many-page preferences dialog.
+ *
+ * A lazily constructed object may reference objects outside its own
+ * subtree only if those have been materialized already, the same
+ * restriction gtk_builder_add_objects_from_file() has. Parse errors
+ * in a deferred file are reported when construction actually happens.
+ * Disabling lazy construction materializes everything still pending.
+ *
+ * Since: 3.18
+ **/
+void
+gtk_builder_set_lazy_construction (GtkBuilder *builder,
+                                   gboolean    lazy)
+{
+  g_return_if_fail (GTK_IS_BUILDER (builder));
+
+  lazy = lazy != FALSE;
+
+  if (builder->priv->lazy_construction == lazy)
+    return;
+
+  builder->priv->lazy_construction = lazy;
+
+  if (!lazy && builder->priv->lazy_buffers != NULL)
+    gtk_builder_materialize (builder, NULL);
+}
+
+/**
+ * gtk_builder_get_lazy_construction:
+ * @builder: a #GtkBuilder
+ *
+ * Gets the setting set by gtk_builder_set_lazy_construction().
+ *
+ * Returns: %TRUE if object construction is deferred
+ *
+ * Since: 3.18
+ **/
+gboolean
+gtk_builder_get_lazy_construction (GtkBuilder *builder)
+{
+  g_return_val_if_fail (GTK_IS_BUILDER (builder), FALSE);
+
+  return builder->priv->lazy_construction;
+}
+
 /**
  * gtk_builder_expose_object:
  * @builder: a #GtkBuilder
@@ -1836,6 +2068,125 @@ gtk_builder_value_from_string (GtkBuilder   *builder,
  *
  * Since: 2.12
  */
+typedef struct {
+  GType type;
+  gchar *string;
+} ValueCacheKey;
+
+static guint
+value_cache_key_hash (gconstpointer data)
+{
+  const ValueCacheKey *key = data;
+
+  return g_str_hash (key->string) ^ (guint) key->type;
+}
+
+static gboolean
+value_cache_key_equal (gconstpointer a,
+                       gconstpointer b)
+{
+  const ValueCacheKey *key_a = a;
+  const ValueCacheKey *key_b = b;
+
+  return key_a->type == key_b->type &&
+         strcmp (key_a->string, key_b->string) == 0;
+}
+
+static void
+value_cache_key_free (gpointer data)
+{
+  ValueCacheKey *key = data;
+
+  g_free (key->string);
+  g_slice_free (ValueCacheKey, key);
+}
+
+static void
+value_cache_value_free (gpointer data)
+{
+  GValue *value = data;
+
+  g_value_unset (value);
+  g_slice_free (GValue, value);
+}
+
+/* Only types whose parse is a pure function of the string are
+ * memoized; strings are trivial and object/boxed parsing can touch
+ * files or depend on the builder state.
+ */
+static gboolean
+value_type_is_cacheable (GType type)
+{
+  switch (G_TYPE_FUNDAMENTAL (type))
+    {
+    case G_TYPE_BOOLEAN:
+    case G_TYPE_INT:
+    case G_TYPE_LONG:
+    case G_TYPE_INT64:
+    case G_TYPE_UINT:
+    case G_TYPE_ULONG:
+    case G_TYPE_UINT64:
+    case G_TYPE_FLOAT:
+    case G_TYPE_DOUBLE:
+    case G_TYPE_ENUM:
+    case G_TYPE_FLAGS:
+      return TRUE;
+    default:
+      return FALSE;
+    }
+}
+
+static gboolean
+value_cache_lookup (GtkBuilder  *builder,
+                    GType        type,
+                    const gchar *string,
+                    GValue      *value)
+{
+  ValueCacheKey key;
+  GValue *cached;
+
+  if (builder->priv->value_cache == NULL)
+    return FALSE;
+
+  key.type = type;
+  key.string = (gchar *)string;
+
+  cached = g_hash_table_lookup (builder->priv->value_cache, &key);
+  if (cached == NULL)
+    return FALSE;
+
+  g_value_init (value, type);
+  g_value_copy (cached, value);
+
+  return TRUE;
+}
+
+static void
+value_cache_insert (GtkBuilder   *builder,
+                    GType         type,
+                    const gchar  *string,
+                    const GValue *value)
+{
+  ValueCacheKey *key;
+  GValue *cached;
+
+  if (builder->priv->value_cache == NULL)
+    builder->priv->value_cache = g_hash_table_new_full (value_cache_key_hash,
+                                                        value_cache_key_equal,
+                                                        value_cache_key_free,
+                                                        value_cache_value_free);
+
+  key = g_slice_new (ValueCacheKey);
+  key->type = type;
+  key->string = g_strdup (string);
+
+  cached = g_slice_new0 (GValue);
+  g_value_init (cached, type);
+  g_value_copy (value, cached);
+
+  g_hash_table_insert (builder->priv->value_cache, key, cached);
+}
+
 gboolean
 gtk_builder_value_from_string_type (GtkBuilder   *builder,
                                     GType         type,
@@ -1849,6 +2200,10 @@ gtk_builder_value_from_string_type (GtkBuilder   *builder,
   g_return_val_if_fail (string != NULL, FALSE);
   g_return_val_if_fail (error == NULL || *error == NULL, FALSE);
 
+  if (value_type_is_cacheable (type) &&
+      value_cache_lookup (builder, type, string, value))
+    return TRUE;
+
   g_value_init (value, type);
 
   switch (G_TYPE_FUNDAMENTAL (type))
@@ -2113,6 +2468,9 @@ G_GNUC_END_IGNORE_DEPRECATIONS
                  GTK_BUILDER_ERROR_INVALID_VALUE,
                  "Unsupported GType `%s'", g_type_name (type));
 
+  if (ret && value_type_is_cacheable (type))
+    value_cache_insert (builder, type, string, value);
+
   return ret;
 }
 
@@ -124,6 +124,10 @@ GDK_AVAILABLE_IN_ALL
 guint        gtk_builder_add_from_file           (GtkBuilder    *builder,
                                                   const gchar   *filename,
                                                   GError       **error);
+GDK_AVAILABLE_IN_3_18
+guint        gtk_builder_add_from_compiled       (GtkBuilder    *builder,
+                                                  const gchar   *filename,
+                                                  GError       **error);
 GDK_AVAILABLE_IN_ALL
 guint        gtk_builder_add_from_resource       (GtkBuilder    *builder,
                                                   const gchar   *resource_path,
@@ -170,6 +174,11 @@ void         gtk_builder_set_translation_domain  (GtkBuilder   	*builder,
                                                   const gchar  	*domain);
 GDK_AVAILABLE_IN_ALL
 const gchar* gtk_builder_get_translation_domain  (GtkBuilder   	*builder);
+GDK_AVAILABLE_IN_3_18
+void         gtk_builder_set_lazy_construction   (GtkBuilder    *builder,
+                                                  gboolean       lazy);
+GDK_AVAILABLE_IN_3_18
+gboolean     gtk_builder_get_lazy_construction   (GtkBuilder    *builder);
 GDK_AVAILABLE_IN_ALL
 GType        gtk_builder_get_type_from_name      (GtkBuilder   	*builder,
                                                   const char   	*type_name);
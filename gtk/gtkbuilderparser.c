@@ -1223,7 +1223,7 @@ text (GMarkupParseContext *context,
   info = state_peek_info (data, CommonInfo);
   g_assert (info != NULL);
 
-  if (strcmp (g_markup_parse_context_get_element (context), "property") == 0)
+  if (strcmp (info->tag.name, "property") == 0)
     {
       PropertyInfo *prop_info = (PropertyInfo*)info;
 
@@ -1258,24 +1258,13 @@ static const GMarkupParser parser = {
   NULL,
 };
 
-void
-_gtk_builder_parser_parse_buffer (GtkBuilder   *builder,
-                                  const gchar  *filename,
-                                  const gchar  *buffer,
-                                  gsize         length,
-                                  gchar       **requested_objs,
-                                  GError      **error)
+static ParserData *
+parser_data_new (GtkBuilder   *builder,
+                 const gchar  *filename,
+                 gchar       **requested_objs,
+                 const gchar  *domain)
 {
-  const gchar* domain;
   ParserData *data;
-  GSList *l;
-
-  /* Store the original domain so that interface domain attribute can be
-   * applied for the builder and the original domain can be restored after
-   * parsing has finished. This allows subparsers to translate elements with
-   * gtk_builder_get_translation_domain() without breaking the ABI or API
-   */
-  domain = gtk_builder_get_translation_domain (builder);
 
   data = g_new0 (ParserData, 1);
   data->builder = builder;
@@ -1306,12 +1295,19 @@ _gtk_builder_parser_parse_buffer (GtkBuilder   *builder,
                                           G_MARKUP_TREAT_CDATA_AS_TEXT,
                                           data, NULL);
 
-  if (!g_markup_parse_context_parse (data->ctx, buffer, length, error))
-    goto out;
+  return data;
+}
+
+static void
+parser_finish (ParserData  *data,
+               GError     **error)
+{
+  GtkBuilder *builder = data->builder;
+  GSList *l;
 
   _gtk_builder_finish (builder);
   if (_gtk_builder_lookup_failed (builder, error))
-    goto out;
+    return;
 
   /* Custom parser_finished */
   data->custom_finalizers = g_slist_reverse (data->custom_finalizers);
@@ -1325,7 +1321,7 @@ _gtk_builder_parser_parse_buffer (GtkBuilder   *builder,
                                      sub->tagname,
                                      sub->data);
       if (_gtk_builder_lookup_failed (builder, error))
-        goto out;
+        return;
     }
 
   /* Common parser_finished, for all created objects */
@@ -1336,11 +1332,13 @@ _gtk_builder_parser_parse_buffer (GtkBuilder   *builder,
 
       gtk_buildable_parser_finished (GTK_BUILDABLE (buildable), builder);
       if (_gtk_builder_lookup_failed (builder, error))
-        goto out;
+        return;
     }
+}
 
- out:
-
+static void
+parser_data_free (ParserData *data)
+{
   g_slist_free_full (data->stack, (GDestroyNotify)free_info);
   g_slist_free_full (data->custom_finalizers, (GDestroyNotify)free_subparser);
   g_slist_free (data->finalizers);
@@ -1349,7 +1347,243 @@ _gtk_builder_parser_parse_buffer (GtkBuilder   *builder,
   g_hash_table_destroy (data->object_ids);
   g_markup_parse_context_free (data->ctx);
   g_free (data);
+}
+
+void
+_gtk_builder_parser_parse_buffer (GtkBuilder   *builder,
+                                  const gchar  *filename,
+                                  const gchar  *buffer,
+                                  gsize         length,
+                                  gchar       **requested_objs,
+                                  GError      **error)
+{
+  const gchar* domain;
+  ParserData *data;
+
+  /* Store the original domain so that interface domain attribute can be
+   * applied for the builder and the original domain can be restored after
+   * parsing has finished. This allows subparsers to translate elements with
+   * gtk_builder_get_translation_domain() without breaking the ABI or API
+   */
+  domain = gtk_builder_get_translation_domain (builder);
+
+  data = parser_data_new (builder, filename, requested_objs, domain);
+
+  if (g_markup_parse_context_parse (data->ctx, buffer, length, error))
+    parser_finish (data, error);
+
+  parser_data_free (data);
 
   /* restore the original domain */
   gtk_builder_set_translation_domain (builder, domain);
 }
+
+/*
+ * The compiled format written by "gtk-builder-tool compile" stores the
+ * markup event stream of a UI file, with all strings deduplicated into
+ * one table, so loading replays the events straight into the builder
+ * machinery without going through GMarkup. Layout, all guint32 fields
+ * little-endian:
+ *
+ *   bytes  0..11  magic
+ *   bytes 12..15  format version
+ *   bytes 16..19  number of events
+ *   bytes 20..23  offset of the string table from the start of the file
+ *   bytes 24..27  size of the string table
+ *   bytes 28..    events, followed by the string table
+ *
+ * An event is a type word followed by string-table offsets:
+ * start-element carries the element name, the attribute count and one
+ * name/value offset pair per attribute; end-element carries the element
+ * name; text carries the text offset and its length. Strings are
+ * nul-terminated.
+ */
+
+#define COMPILED_HEADER_SIZE 28
+#define COMPILED_VERSION 1
+
+typedef enum {
+  COMPILED_EVENT_START = 1,
+  COMPILED_EVENT_END   = 2,
+  COMPILED_EVENT_TEXT  = 3
+} CompiledEventType;
+
+static const gchar compiled_magic[12] = "GtkBuilderC\001";
+
+gboolean
+_gtk_builder_parser_is_compiled (const gchar *buffer,
+                                 gsize        length)
+{
+  return length >= sizeof (compiled_magic) &&
+         memcmp (buffer, compiled_magic, sizeof (compiled_magic)) == 0;
+}
+
+static guint32
+compiled_uint32 (const guchar *p)
+{
+  guint32 v;
+
+  memcpy (&v, p, 4);
+  return GUINT32_FROM_LE (v);
+}
+
+static void
+compiled_format_error (const gchar  *filename,
+                       GError      **error)
+{
+  g_set_error (error,
+               GTK_BUILDER_ERROR,
+               GTK_BUILDER_ERROR_INVALID_VALUE,
+               "%s: not a valid compiled GtkBuilder file",
+               filename);
+}
+
+void
+_gtk_builder_parser_parse_compiled (GtkBuilder   *builder,
+                                    const gchar  *filename,
+                                    const gchar  *buffer,
+                                    gsize         length,
+                                    GError      **error)
+{
+  const guchar *bytes = (const guchar *)buffer;
+  const gchar *domain;
+  const gchar *strings;
+  ParserData *data;
+  guint32 n_events, strings_offset, strings_size;
+  guint32 i, pos;
+  GError *tmp_error = NULL;
+
+  if (length < COMPILED_HEADER_SIZE ||
+      memcmp (buffer, compiled_magic, sizeof (compiled_magic)) != 0 ||
+      compiled_uint32 (bytes + 12) != COMPILED_VERSION)
+    {
+      compiled_format_error (filename, error);
+      return;
+    }
+
+  n_events = compiled_uint32 (bytes + 16);
+  strings_offset = compiled_uint32 (bytes + 20);
+  strings_size = compiled_uint32 (bytes + 24);
+
+  /* The string table must close the file and end in a nul, so that
+   * any in-bounds offset yields a terminated string.
+   */
+  if (strings_offset < COMPILED_HEADER_SIZE ||
+      strings_offset > length ||
+      strings_size != length - strings_offset ||
+      (strings_size > 0 && buffer[length - 1] != '\0'))
+    {
+      compiled_format_error (filename, error);
+      return;
+    }
+
+  strings = buffer + strings_offset;
+
+#define GET_UINT32(var) G_STMT_START { \
+    if (pos + 4 > strings_offset) \
+      goto corrupt; \
+    (var) = compiled_uint32 (bytes + pos); \
+    pos += 4; \
+  } G_STMT_END
+#define GET_STRING(var) G_STMT_START { \
+    guint32 __off; \
+    GET_UINT32 (__off); \
+    if (__off >= strings_size) \
+      goto corrupt; \
+    (var) = strings + __off; \
+  } G_STMT_END
+
+  domain = gtk_builder_get_translation_domain (builder);
+
+  data = parser_data_new (builder, filename, NULL, domain);
+
+  pos = COMPILED_HEADER_SIZE;
+
+  for (i = 0; i < n_events && tmp_error == NULL; i++)
+    {
+      guint32 event_type;
+
+      GET_UINT32 (event_type);
+
+      switch (event_type)
+        {
+        case COMPILED_EVENT_START:
+          {
+            const gchar *element_name;
+            const gchar **names;
+            const gchar **values;
+            guint32 n_attrs, j;
+
+            GET_STRING (element_name);
+            GET_UINT32 (n_attrs);
+
+            if (n_attrs > (strings_offset - pos) / 8)
+              goto corrupt;
+
+            names = g_newa (const gchar *, n_attrs + 1);
+            values = g_newa (const gchar *, n_attrs + 1);
+
+            for (j = 0; j < n_attrs; j++)
+              {
+                GET_STRING (names[j]);
+                GET_STRING (values[j]);
+              }
+            names[n_attrs] = NULL;
+            values[n_attrs] = NULL;
+
+            start_element (data->ctx, element_name, names, values,
+                           data, &tmp_error);
+          }
+          break;
+
+        case COMPILED_EVENT_END:
+          {
+            const gchar *element_name;
+
+            GET_STRING (element_name);
+
+            end_element (data->ctx, element_name, data, &tmp_error);
+          }
+          break;
+
+        case COMPILED_EVENT_TEXT:
+          {
+            const gchar *event_text;
+            guint32 text_len;
+
+            GET_STRING (event_text);
+            GET_UINT32 (text_len);
+
+            if (text_len != strlen (event_text))
+              goto corrupt;
+
+            text (data->ctx, event_text, text_len, data, &tmp_error);
+          }
+          break;
+
+        default:
+          goto corrupt;
+        }
+    }
+
+  if (tmp_error == NULL)
+    parser_finish (data, &tmp_error);
+
+  if (tmp_error != NULL)
+    g_propagate_error (error, tmp_error);
+
+  parser_data_free (data);
+
+  gtk_builder_set_translation_domain (builder, domain);
+
+  return;
+
+ corrupt:
+  g_clear_error (&tmp_error);
+  compiled_format_error (filename, error);
+  parser_data_free (data);
+  gtk_builder_set_translation_domain (builder, domain);
+
+#undef GET_UINT32
+#undef GET_STRING
+}
@@ -137,6 +137,13 @@ void _gtk_builder_parser_parse_buffer (GtkBuilder *builder,
                                        gsize length,
                                        gchar **requested_objs,
                                        GError **error);
+void _gtk_builder_parser_parse_compiled (GtkBuilder *builder,
+                                         const gchar *filename,
+                                         const gchar *buffer,
+                                         gsize length,
+                                         GError **error);
+gboolean _gtk_builder_parser_is_compiled (const gchar *buffer,
+                                          gsize length);
 GObject * _gtk_builder_construct (GtkBuilder *builder,
                                   ObjectInfo *info,
 				  GError    **error);
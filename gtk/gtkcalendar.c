@@ -243,6 +243,12 @@ struct _GtkCalendarPrivate
   gint detail_height_rows;
   gint detail_width_chars;
   gint detail_overflow[6];
+
+  /* Cached per-cell rendering of the detail text, so that a full
+   * grid redraw only re-renders cells whose detail changed. */
+  gchar           *detail_cache_text[6][7];
+  cairo_surface_t *detail_cache_surface[6][7];
+  GtkStateFlags    detail_cache_state[6][7];
 };
 
 static void gtk_calendar_finalize     (GObject      *calendar);
@@ -856,6 +862,20 @@ gtk_calendar_init (GtkCalendar *calendar)
  *          Utility Functions           *
  ****************************************/
 
+static void
+calendar_drop_detail_cache (GtkCalendar *calendar)
+{
+  GtkCalendarPrivate *priv = calendar->priv;
+  gint row, col;
+
+  for (row = 0; row < 6; row++)
+    for (col = 0; col < 7; col++)
+      {
+        g_clear_pointer (&priv->detail_cache_text[row][col], g_free);
+        g_clear_pointer (&priv->detail_cache_surface[row][col], cairo_surface_destroy);
+      }
+}
+
 static void
 calendar_queue_refresh (GtkCalendar *calendar)
 {
@@ -1342,6 +1362,8 @@ calendar_set_month_prev (GtkCalendar *calendar)
 static void
 gtk_calendar_finalize (GObject *object)
 {
+  calendar_drop_detail_cache (GTK_CALENDAR (object));
+
   G_OBJECT_CLASS (gtk_calendar_parent_class)->finalize (object);
 }
 
@@ -1675,6 +1697,7 @@ gtk_calendar_unrealize (GtkWidget *widget)
   GtkCalendarPrivate *priv = GTK_CALENDAR (widget)->priv;
 
   calendar_unrealize_arrows (GTK_CALENDAR (widget));
+  calendar_drop_detail_cache (GTK_CALENDAR (widget));
 
   if (priv->main_win)
     {
@@ -2087,8 +2110,15 @@ gtk_calendar_size_allocate (GtkWidget     *widget,
   guint i;
   gint inner_border = calendar_get_inner_border (calendar);
   gint calendar_xsep = calendar_get_xsep (calendar);
+  GtkAllocation old_allocation;
 
   get_component_paddings (calendar, &padding, NULL, NULL, NULL);
+
+  gtk_widget_get_allocation (widget, &old_allocation);
+  if (old_allocation.width != allocation->width ||
+      old_allocation.height != allocation->height)
+    calendar_drop_detail_cache (calendar);
+
   gtk_widget_set_allocation (widget, allocation);
 
   if (priv->display_flags & GTK_CALENDAR_SHOW_WEEK_NUMBERS)
@@ -2610,35 +2640,70 @@ calendar_paint_day (GtkCalendar *calendar,
 
   if (detail && show_details)
     {
-      gchar *markup = g_strconcat ("<small>", detail, "</small>", NULL);
-      pango_layout_set_markup (layout, markup, -1);
-      g_free (markup);
+      cairo_surface_t *detail_surface;
+      gint dy = day_rect.height - (y_loc - day_rect.y);
+
+      /* Rendering the detail means a markup parse and a fresh layout,
+       * so cache the result per cell: a full grid redraw then only
+       * pays for cells whose detail actually changed.
+       */
+      detail_surface = priv->detail_cache_surface[row][col];
 
-      if (day == priv->selected_day)
+      if (detail_surface == NULL ||
+          priv->detail_cache_state[row][col] != state ||
+          g_strcmp0 (priv->detail_cache_text[row][col], detail) != 0)
         {
-          /* Stripping colors as they conflict with selection marking. */
+          gchar *markup = g_strconcat ("<small>", detail, "</small>", NULL);
+          cairo_t *detail_cr;
+
+          pango_layout_set_markup (layout, markup, -1);
+          g_free (markup);
 
-          PangoAttrList *attrs = pango_layout_get_attributes (layout);
-          PangoAttrList *colors = NULL;
+          if (day == priv->selected_day)
+            {
+              /* Stripping colors as they conflict with selection marking. */
 
-          if (attrs)
-            colors = pango_attr_list_filter (attrs, is_color_attribute, NULL);
-          if (colors)
-            pango_attr_list_unref (colors);
-        }
+              PangoAttrList *attrs = pango_layout_get_attributes (layout);
+              PangoAttrList *colors = NULL;
 
-      pango_layout_set_wrap (layout, PANGO_WRAP_WORD_CHAR);
-      pango_layout_set_width (layout, PANGO_SCALE * day_rect.width);
+              if (attrs)
+                colors = pango_attr_list_filter (attrs, is_color_attribute, NULL);
+              if (colors)
+                pango_attr_list_unref (colors);
+            }
 
-      if (priv->detail_height_rows)
-        {
-          gint dy = day_rect.height - (y_loc - day_rect.y);
-          pango_layout_set_height (layout, PANGO_SCALE * dy);
-          pango_layout_set_ellipsize (layout, PANGO_ELLIPSIZE_END);
+          pango_layout_set_wrap (layout, PANGO_WRAP_WORD_CHAR);
+          pango_layout_set_width (layout, PANGO_SCALE * day_rect.width);
+
+          if (priv->detail_height_rows)
+            {
+              pango_layout_set_height (layout, PANGO_SCALE * dy);
+              pango_layout_set_ellipsize (layout, PANGO_ELLIPSIZE_END);
+            }
+
+          pango_layout_get_pixel_extents (layout, NULL, &logical_rect);
+
+          detail_surface =
+            gdk_window_create_similar_surface (gtk_widget_get_window (widget),
+                                               CAIRO_CONTENT_COLOR_ALPHA,
+                                               day_rect.width,
+                                               MAX (MAX (dy, logical_rect.height), 1));
+          detail_cr = cairo_create (detail_surface);
+          pango_cairo_show_layout (detail_cr, layout);
+          cairo_destroy (detail_cr);
+
+          g_free (priv->detail_cache_text[row][col]);
+          priv->detail_cache_text[row][col] = g_strdup (detail);
+          if (priv->detail_cache_surface[row][col])
+            cairo_surface_destroy (priv->detail_cache_surface[row][col]);
+          priv->detail_cache_surface[row][col] = detail_surface;
+          priv->detail_cache_state[row][col] = state;
         }
 
-      cairo_move_to (cr, day_rect.x, y_loc);
-      pango_cairo_show_layout (cr, layout);
+      cairo_save (cr);
+      cairo_set_source_surface (cr, detail_surface, day_rect.x, y_loc);
+      cairo_paint (cr);
+      cairo_restore (cr);
     }
 
   if (gtk_widget_has_visible_focus (widget) &&
@@ -3712,11 +3777,14 @@ gtk_calendar_clear_marks (GtkCalendar *calendar)
 
   for (day = 0; day < 31; day++)
     {
-      priv->marked_date[day] = FALSE;
+      if (priv->marked_date[day])
+        {
+          priv->marked_date[day] = FALSE;
+          calendar_invalidate_day_num (calendar, day + 1);
+        }
     }
 
   priv->num_marked_dates = 0;
-  calendar_queue_refresh (calendar);
 }
 
 /**
@@ -3869,6 +3937,8 @@ gtk_calendar_set_detail_func (GtkCalendar           *calendar,
   priv->detail_func_user_data = data;
   priv->detail_func_destroy = destroy;
 
+  calendar_drop_detail_cache (calendar);
+
   gtk_widget_set_has_tooltip (GTK_WIDGET (calendar),
                               NULL != priv->detail_func);
   gtk_widget_queue_resize (GTK_WIDGET (calendar));
@@ -73,6 +73,11 @@ struct _GtkCellAreaBoxContextPrivate
   GHashTable *widths;
   GHashTable *heights;
 
+  /* Memoized _gtk_cell_area_box_context_sum() results per for_size,
+   * invalidated whenever the corresponding group sizes are pushed */
+  GHashTable *width_sums;
+  GHashTable *height_sums;
+
   /* Whether each group expands */
   gboolean  *expand;
 
@@ -177,6 +182,11 @@ _gtk_cell_area_box_context_init (GtkCellAreaBoxContext *box_context)
                                               NULL, (GDestroyNotify)free_cache_array);
   priv->heights      = g_hash_table_new_full (g_direct_hash, g_direct_equal,
                                               NULL, (GDestroyNotify)free_cache_array);
+
+  priv->width_sums   = g_hash_table_new_full (g_direct_hash, g_direct_equal,
+                                              NULL, g_free);
+  priv->height_sums  = g_hash_table_new_full (g_direct_hash, g_direct_equal,
+                                              NULL, g_free);
 }
 
 static void 
@@ -206,6 +216,8 @@ _gtk_cell_area_box_context_finalize (GObject *object)
   g_array_free (priv->base_heights, TRUE);
   g_hash_table_destroy (priv->widths);
   g_hash_table_destroy (priv->heights);
+  g_hash_table_destroy (priv->width_sums);
+  g_hash_table_destroy (priv->height_sums);
 
   g_free (priv->expand);
   g_free (priv->align);
@@ -240,6 +252,8 @@ _gtk_cell_area_box_context_reset (GtkCellAreaContext *context)
   /* Reset context sizes as well */
   g_hash_table_remove_all (priv->widths);
   g_hash_table_remove_all (priv->heights);
+  g_hash_table_remove_all (priv->width_sums);
+  g_hash_table_remove_all (priv->height_sums);
 
   GTK_CELL_AREA_CONTEXT_CLASS
     (_gtk_cell_area_box_context_parent_class)->reset (context);
@@ -259,6 +273,30 @@ _gtk_cell_area_box_context_sum (GtkCellAreaBoxContext *context,
   gint            spacing, i, last_aligned_group_idx;
   gint            min_size = 0, nat_size = 0;
 
+  GHashTable     *sums;
+  CachedSize     *sum;
+
+  /* The for_size > 0 requests are pure aggregations which the callers
+   * repeat for every row; memoize them so that only rows whose pushed
+   * sizes actually changed cause the groups to be walked again.
+   */
+  sums = NULL;
+  if (for_size >= 0)
+    {
+      sums = orientation == GTK_ORIENTATION_HORIZONTAL ?
+        priv->width_sums : priv->height_sums;
+
+      sum = g_hash_table_lookup (sums, GINT_TO_POINTER (for_size));
+      if (sum)
+        {
+          if (minimum_size)
+            *minimum_size = sum->min_size;
+          if (natural_size)
+            *natural_size = sum->nat_size;
+          return;
+        }
+    }
+
   area            = (GtkCellAreaBox *)gtk_cell_area_context_get_area (GTK_CELL_AREA_CONTEXT (context));
   spacing         = gtk_cell_area_box_get_spacing (area);
   box_orientation = gtk_orientable_get_orientation (GTK_ORIENTABLE (area));
@@ -310,6 +348,13 @@ _gtk_cell_area_box_context_sum (GtkCellAreaBoxContext *context,
       else
         gtk_cell_area_context_push_preferred_height (GTK_CELL_AREA_CONTEXT (context), min_size, nat_size);
     }
+  else
+    {
+      sum = g_new (CachedSize, 1);
+      sum->min_size = min_size;
+      sum->nat_size = nat_size;
+      g_hash_table_insert (sums, GINT_TO_POINTER (for_size), sum);
+    }
 
   if (minimum_size)
     *minimum_size = min_size;
@@ -482,8 +527,13 @@ _gtk_cell_area_box_context_push_group_height_for_width  (GtkCellAreaBoxContext *
     }
 
   size = &g_array_index (group_array, CachedSize, group_idx);
-  size->min_size = MAX (size->min_size, minimum_height);
-  size->nat_size = MAX (size->nat_size, natural_height);
+  if (minimum_height > size->min_size || natural_height > size->nat_size)
+    {
+      size->min_size = MAX (size->min_size, minimum_height);
+      size->nat_size = MAX (size->nat_size, natural_height);
+
+      g_hash_table_remove (priv->height_sums, GINT_TO_POINTER (for_width));
+    }
 }
 
 void
@@ -541,8 +591,13 @@ _gtk_cell_area_box_context_push_group_width_for_height (GtkCellAreaBoxContext *b
     }
 
   size = &g_array_index (group_array, CachedSize, group_idx);
-  size->min_size = MAX (size->min_size, minimum_width);
-  size->nat_size = MAX (size->nat_size, natural_width);
+  if (minimum_width > size->min_size || natural_width > size->nat_size)
+    {
+      size->min_size = MAX (size->min_size, minimum_width);
+      size->nat_size = MAX (size->nat_size, natural_width);
+
+      g_hash_table_remove (priv->width_sums, GINT_TO_POINTER (for_height));
+    }
 }
 
 void
@@ -88,6 +88,8 @@ enum {
 struct _GtkCellRendererPixbufPrivate
 {
   GtkIconHelper *icon_helper;
+  GtkIconHelper *icon_helper_expander_open;
+  GtkIconHelper *icon_helper_expander_closed;
   GtkIconSize    icon_size;
 
   GdkPixbuf *pixbuf_expander_open;
@@ -121,6 +123,8 @@ gtk_cell_renderer_pixbuf_finalize (GObject *object)
   GtkCellRendererPixbufPrivate *priv = cellpixbuf->priv;
 
   g_clear_object (&priv->icon_helper);
+  g_clear_object (&priv->icon_helper_expander_open);
+  g_clear_object (&priv->icon_helper_expander_closed);
 
   if (priv->pixbuf_expander_open)
     g_object_unref (priv->pixbuf_expander_open);
@@ -370,11 +374,13 @@ gtk_cell_renderer_pixbuf_set_property (GObject      *object,
       if (priv->pixbuf_expander_open)
         g_object_unref (priv->pixbuf_expander_open);
       priv->pixbuf_expander_open = (GdkPixbuf*) g_value_dup_object (value);
+      g_clear_object (&priv->icon_helper_expander_open);
       break;
     case PROP_PIXBUF_EXPANDER_CLOSED:
       if (priv->pixbuf_expander_closed)
         g_object_unref (priv->pixbuf_expander_closed);
       priv->pixbuf_expander_closed = (GdkPixbuf*) g_value_dup_object (value);
+      g_clear_object (&priv->icon_helper_expander_closed);
       break;
     case PROP_SURFACE:
       notify_old_storage_type (cellpixbuf, GTK_IMAGE_SURFACE, old_storage_type);
@@ -549,15 +555,28 @@ gtk_cell_renderer_pixbuf_render (GtkCellRenderer      *cell,
 
       g_object_get (cell, "is-expanded", &is_expanded, NULL);
 
+      /* The expander helpers are kept around between draws so their
+       * rendered surface survives from one expose to the next.
+       */
       if (is_expanded && priv->pixbuf_expander_open != NULL)
         {
-          icon_helper = _gtk_icon_helper_new ();
-          _gtk_icon_helper_set_pixbuf (icon_helper, priv->pixbuf_expander_open);
+          if (priv->icon_helper_expander_open == NULL)
+            {
+              priv->icon_helper_expander_open = _gtk_icon_helper_new ();
+              _gtk_icon_helper_set_pixbuf (priv->icon_helper_expander_open,
+                                           priv->pixbuf_expander_open);
+            }
+          icon_helper = g_object_ref (priv->icon_helper_expander_open);
         }
       else if (!is_expanded && priv->pixbuf_expander_closed != NULL)
         {
-          icon_helper = _gtk_icon_helper_new ();
-          _gtk_icon_helper_set_pixbuf (icon_helper, priv->pixbuf_expander_closed);
+          if (priv->icon_helper_expander_closed == NULL)
+            {
+              priv->icon_helper_expander_closed = _gtk_icon_helper_new ();
+              _gtk_icon_helper_set_pixbuf (priv->icon_helper_expander_closed,
+                                           priv->pixbuf_expander_closed);
+            }
+          icon_helper = g_object_ref (priv->icon_helper_expander_closed);
         }
     }
 
@@ -20,12 +20,14 @@
 #include "gtkcellrenderertext.h"
 
 #include <stdlib.h>
+#include <string.h>
 
 #include "gtkeditable.h"
 #include "gtkentry.h"
 #include "gtksizerequest.h"
 #include "gtkmarshalers.h"
 #include "gtkintl.h"
+#include "gtkpango.h"
 #include "gtkprivate.h"
 #include "gtktreeprivate.h"
 #include "a11y/gtktextcellaccessible.h"
@@ -177,6 +179,13 @@ struct _GtkCellRendererTextPrivate
   gchar *text;
   gchar *placeholder_text;
 
+  /* Single-slot layout cache; see get_layout() */
+  PangoLayout *cached_layout;
+  PangoFontDescription *cached_layout_font;
+  GtkWidget *cached_layout_widget;
+  gint cached_layout_width;
+  GtkCellRendererState cached_layout_flags;
+
   gdouble font_scale;
 
   gint rise;
@@ -693,12 +702,30 @@ G_GNUC_END_IGNORE_DEPRECATIONS
   gtk_cell_renderer_class_set_accessible_type (cell_class, GTK_TYPE_TEXT_CELL_ACCESSIBLE);
 }
 
+static void
+gtk_cell_renderer_text_clear_cached_layout (GtkCellRendererText *celltext)
+{
+  GtkCellRendererTextPrivate *priv = celltext->priv;
+
+  g_clear_object (&priv->cached_layout);
+
+  if (priv->cached_layout_font)
+    {
+      pango_font_description_free (priv->cached_layout_font);
+      priv->cached_layout_font = NULL;
+    }
+
+  priv->cached_layout_widget = NULL;
+}
+
 static void
 gtk_cell_renderer_text_finalize (GObject *object)
 {
   GtkCellRendererText *celltext = GTK_CELL_RENDERER_TEXT (object);
   GtkCellRendererTextPrivate *priv = celltext->priv;
 
+  gtk_cell_renderer_text_clear_cached_layout (celltext);
+
   pango_font_description_free (priv->font);
 
   g_free (priv->text);
@@ -1118,6 +1145,14 @@ gtk_cell_renderer_text_set_property (GObject      *object,
   GtkCellRendererText *celltext = GTK_CELL_RENDERER_TEXT (object);
   GtkCellRendererTextPrivate *priv = celltext->priv;
 
+  /* Any property change can affect the cached layout, except setting
+   * the text to the very string it already shows -- the common case
+   * when one renderer draws many rows with repeated strings.
+   */
+  if (!(param_id == PROP_TEXT &&
+        g_strcmp0 (priv->text, g_value_get_string (value)) == 0))
+    gtk_cell_renderer_text_clear_cached_layout (celltext);
+
   switch (param_id)
     {
     case PROP_TEXT:
@@ -1547,6 +1582,45 @@ add_attr (PangoAttrList  *attr_list,
   pango_attr_list_insert (attr_list, attr);
 }
 
+/* Sets the width and wrap mode the way a freshly built layout has
+ * them. Also used to restore a cached layout on a cache hit, since
+ * callers may override the width on the layout we hand out (the
+ * render and height-for-width paths do).
+ */
+static void
+apply_layout_width (GtkCellRendererText *celltext,
+                    PangoLayout         *layout,
+                    const GdkRectangle  *cell_area,
+                    gint                 xpad)
+{
+  GtkCellRendererTextPrivate *priv = celltext->priv;
+
+  if (priv->wrap_width != -1)
+    {
+      PangoRectangle rect;
+      gint           width, text_width;
+
+      pango_layout_set_width (layout, -1);
+      pango_layout_get_extents (layout, NULL, &rect);
+      text_width = rect.width;
+
+      if (cell_area)
+	width = (cell_area->width - xpad * 2) * PANGO_SCALE;
+      else
+	width = priv->wrap_width * PANGO_SCALE;
+
+      width = MIN (width, text_width);
+
+      pango_layout_set_width (layout, width);
+      pango_layout_set_wrap (layout, priv->wrap_mode);
+    }
+  else
+    {
+      pango_layout_set_width (layout, -1);
+      pango_layout_set_wrap (layout, PANGO_WRAP_CHAR);
+    }
+}
+
 static PangoLayout*
 get_layout (GtkCellRendererText *celltext,
             GtkWidget           *widget,
@@ -1559,6 +1633,34 @@ get_layout (GtkCellRendererText *celltext,
   PangoUnderline uline;
   gint xpad;
   gboolean placeholder_layout = show_placeholder_text (celltext);
+  gint cache_width = cell_area ? cell_area->width : -1;
+  GtkCellRendererState cache_flags =
+    flags & (GTK_CELL_RENDERER_SELECTED | GTK_CELL_RENDERER_PRELIT);
+
+  /* The layout only depends on the renderer's properties, the widget's
+   * pango context, the cell width and the selected/prelit flag bits.
+   * Property changes invalidate the cache (see set_property()); a new
+   * widget means a different context object, and in-place context
+   * updates (font changes from ::style-updated) are caught by
+   * comparing the font description.
+   */
+  if (!placeholder_layout &&
+      priv->cached_layout != NULL &&
+      priv->cached_layout_widget == widget &&
+      priv->cached_layout_width == cache_width &&
+      priv->cached_layout_flags == cache_flags &&
+      pango_layout_get_context (priv->cached_layout) ==
+        gtk_widget_get_pango_context (widget) &&
+      pango_font_description_equal (priv->cached_layout_font,
+                                    pango_context_get_font_description (gtk_widget_get_pango_context (widget))))
+    {
+      layout = g_object_ref (priv->cached_layout);
+
+      gtk_cell_renderer_get_padding (GTK_CELL_RENDERER (celltext), &xpad, NULL);
+      apply_layout_width (celltext, layout, cell_area, xpad);
+
+      return layout;
+    }
 
   layout = gtk_widget_create_pango_layout (widget, placeholder_layout ?
                                            priv->placeholder_text : priv->text);
@@ -1668,29 +1770,7 @@ get_layout (GtkCellRendererText *celltext,
   else
     pango_layout_set_ellipsize (layout, PANGO_ELLIPSIZE_NONE);
 
-  if (priv->wrap_width != -1)
-    {
-      PangoRectangle rect;
-      gint           width, text_width;
-
-      pango_layout_get_extents (layout, NULL, &rect);
-      text_width = rect.width;
-
-      if (cell_area)
-	width = (cell_area->width - xpad * 2) * PANGO_SCALE;
-      else
-	width = priv->wrap_width * PANGO_SCALE;
-
-      width = MIN (width, text_width);
-
-      pango_layout_set_width (layout, width);
-      pango_layout_set_wrap (layout, priv->wrap_mode);
-    }
-  else
-    {
-      pango_layout_set_width (layout, -1);
-      pango_layout_set_wrap (layout, PANGO_WRAP_CHAR);
-    }
+  apply_layout_width (celltext, layout, cell_area, xpad);
 
   if (priv->align_set)
     pango_layout_set_alignment (layout, priv->align);
@@ -1705,7 +1785,18 @@ get_layout (GtkCellRendererText *celltext,
 
       pango_layout_set_alignment (layout, align);
     }
-  
+
+  if (!placeholder_layout)
+    {
+      gtk_cell_renderer_text_clear_cached_layout (celltext);
+      priv->cached_layout = g_object_ref (layout);
+      priv->cached_layout_font =
+        pango_font_description_copy (pango_context_get_font_description (pango_layout_get_context (layout)));
+      priv->cached_layout_widget = widget;
+      priv->cached_layout_width = cache_width;
+      priv->cached_layout_flags = cache_flags;
+    }
+
   return layout;
 }
 
@@ -2095,6 +2186,143 @@ gtk_cell_renderer_text_set_fixed_height_from_font (GtkCellRendererText *renderer
     }
 }
 
+#define TEXT_WIDTH_CACHE_MAX_ENTRIES 16384
+
+/* Shaping cost grows with the string length; past this many bytes the
+ * unwrapped width is estimated from the average character width instead.
+ */
+#define TEXT_WIDTH_APPROXIMATE_LENGTH 4096
+
+typedef struct
+{
+  guint       serial;    /* pango_context_get_serial () when populated */
+  guint       n_entries;
+  GHashTable *fonts;     /* PangoFontDescription -> (text -> PangoRectangle) */
+} TextWidthCache;
+
+static void
+text_width_cache_free (gpointer data)
+{
+  TextWidthCache *cache = data;
+
+  g_hash_table_unref (cache->fonts);
+  g_slice_free (TextWidthCache, cache);
+}
+
+static TextWidthCache *
+text_width_cache_get (PangoContext *context)
+{
+  static GQuark quark = 0;
+  TextWidthCache *cache;
+
+  if (G_UNLIKELY (quark == 0))
+    quark = g_quark_from_static_string ("gtk-cell-renderer-text-width-cache");
+
+  cache = g_object_get_qdata (G_OBJECT (context), quark);
+
+  if (cache == NULL)
+    {
+      cache = g_slice_new (TextWidthCache);
+      cache->serial = pango_context_get_serial (context);
+      cache->n_entries = 0;
+      cache->fonts = g_hash_table_new_full ((GHashFunc) pango_font_description_hash,
+                                            (GEqualFunc) pango_font_description_equal,
+                                            (GDestroyNotify) pango_font_description_free,
+                                            (GDestroyNotify) g_hash_table_unref);
+      g_object_set_qdata_full (G_OBJECT (context), quark, cache,
+                               text_width_cache_free);
+    }
+  else if (cache->serial != pango_context_get_serial (context))
+    {
+      g_hash_table_remove_all (cache->fonts);
+      cache->serial = pango_context_get_serial (context);
+      cache->n_entries = 0;
+    }
+
+  return cache;
+}
+
+/* Whether the unwrapped extents depend on renderer properties beyond
+ * the text and the font description, in which case they cannot be
+ * shared through the per-context cache.
+ */
+static gboolean
+text_width_cacheable (GtkCellRendererText *celltext)
+{
+  GtkCellRendererTextPrivate *priv = celltext->priv;
+
+  return priv->text != NULL &&
+         priv->font != NULL &&
+         priv->extra_attrs == NULL &&
+         !priv->language_set &&
+         !priv->rise_set &&
+         (!priv->scale_set || priv->font_scale == 1.0) &&
+         !show_placeholder_text (celltext) &&
+         strchr (priv->text, '\n') == NULL;
+}
+
+static gboolean
+text_width_cache_lookup (GtkCellRendererText *celltext,
+                         PangoContext        *context,
+                         PangoRectangle      *rect)
+{
+  GtkCellRendererTextPrivate *priv = celltext->priv;
+  TextWidthCache *cache;
+  GHashTable *widths;
+  PangoRectangle *cached;
+
+  if (!text_width_cacheable (celltext))
+    return FALSE;
+
+  cache = text_width_cache_get (context);
+  widths = g_hash_table_lookup (cache->fonts, priv->font);
+  if (widths == NULL)
+    return FALSE;
+
+  cached = g_hash_table_lookup (widths, priv->text);
+  if (cached == NULL)
+    return FALSE;
+
+  *rect = *cached;
+  return TRUE;
+}
+
+static void
+text_width_cache_store (GtkCellRendererText  *celltext,
+                        PangoContext         *context,
+                        const PangoRectangle *rect)
+{
+  GtkCellRendererTextPrivate *priv = celltext->priv;
+  TextWidthCache *cache;
+  GHashTable *widths;
+
+  if (!text_width_cacheable (celltext))
+    return;
+
+  cache = text_width_cache_get (context);
+
+  if (cache->n_entries >= TEXT_WIDTH_CACHE_MAX_ENTRIES)
+    {
+      g_hash_table_remove_all (cache->fonts);
+      cache->n_entries = 0;
+    }
+
+  widths = g_hash_table_lookup (cache->fonts, priv->font);
+  if (widths == NULL)
+    {
+      widths = g_hash_table_new_full (g_str_hash, g_str_equal,
+                                      g_free, g_free);
+      g_hash_table_insert (cache->fonts,
+                           pango_font_description_copy (priv->font),
+                           widths);
+    }
+
+  g_hash_table_insert (widths,
+                       g_strdup (priv->text),
+                       g_memdup (rect, sizeof (PangoRectangle)));
+  cache->n_entries++;
+}
+
 static void
 gtk_cell_renderer_text_get_preferred_width (GtkCellRenderer *cell,
                                             GtkWidget       *widget,
@@ -2124,23 +2352,52 @@ gtk_cell_renderer_text_get_preferred_width (GtkCellRenderer *cell,
 
   gtk_cell_renderer_get_padding (cell, &xpad, NULL);
 
-  layout = get_layout (celltext, widget, NULL, 0);
-
-  /* Fetch the length of the complete unwrapped text */
-  pango_layout_set_width (layout, -1);
-  pango_layout_get_extents (layout, NULL, &rect);
-  text_width = rect.width;
+  context = gtk_widget_get_pango_context (widget);
 
   /* Fetch the average size of a charachter */
-  context = pango_layout_get_context (layout);
-  metrics = pango_context_get_metrics (context,
-                                       pango_context_get_font_description (context),
-                                       pango_context_get_language (context));
+  metrics = _gtk_pango_get_metrics (context);
 
   char_width = pango_font_metrics_get_approximate_char_width (metrics);
 
   pango_font_metrics_unref (metrics);
-  g_object_unref (layout);
+
+  /* Fetch the length of the complete unwrapped text, preferably from
+   * the per-context width cache: column autosizing measures row after
+   * row through the same renderer, and repeated strings then skip the
+   * layout and shaping entirely.
+   */
+  if (!text_width_cache_lookup (celltext, context, &rect))
+    {
+      if (text_width_cacheable (celltext) &&
+          strlen (priv->text) > TEXT_WIDTH_APPROXIMATE_LENGTH)
+        {
+          PangoFontMetrics *font_metrics;
+
+          /* Shaping huge cell text just to learn that it is far wider
+           * than any column can be is wasted work; estimate from the
+           * average character width of the renderer's font.
+           */
+          font_metrics = pango_context_get_metrics (context, priv->font,
+                                                    pango_context_get_language (context));
+          rect.x = 0;
+          rect.y = 0;
+          rect.width = pango_font_metrics_get_approximate_char_width (font_metrics) *
+                       g_utf8_strlen (priv->text, -1);
+          rect.height = 0;
+          pango_font_metrics_unref (font_metrics);
+        }
+      else
+        {
+          layout = get_layout (celltext, widget, NULL, 0);
+          pango_layout_set_width (layout, -1);
+          pango_layout_get_extents (layout, NULL, &rect);
+          g_object_unref (layout);
+
+          text_width_cache_store (celltext, context, &rect);
+        }
+    }
+
+  text_width = rect.width;
 
   /* enforce minimum width for ellipsized labels at ~3 chars */
   if (priv->ellipsize_set && priv->ellipsize != PANGO_ELLIPSIZE_NONE)
@@ -30,6 +30,7 @@
 #include "gtklabel.h"
 
 #include "gtkintl.h"
+#include "gtkpango.h"
 #include "gtkprivate.h"
 #include "gtkrender.h"
 #include "gtkwidgetprivate.h"
@@ -493,9 +494,7 @@ gtk_check_button_size_allocate (GtkWidget     *widget,
 	}
 
       pango_context = gtk_widget_get_pango_context (widget);
-      metrics = pango_context_get_metrics (pango_context,
-					   pango_context_get_font_description (pango_context),
-					   pango_context_get_language (pango_context));
+      metrics = _gtk_pango_get_metrics (pango_context);
       button->priv->baseline_align =
 	(double)pango_font_metrics_get_ascent (metrics) /
 	(pango_font_metrics_get_ascent (metrics) + pango_font_metrics_get_descent (metrics));
@@ -1057,6 +1057,15 @@ request_text_received_func (GtkClipboard     *clipboard,
 	  return;
 	}
     }
+  else if (gdk_display_supports_selection_notification (clipboard->display))
+    {
+      /* Remember which target worked, so the next request for this
+       * owner can skip the negotiation round trips. The cache is
+       * reset on owner change, which we are notified about.
+       */
+      clipboard->preferred_text_target =
+        gtk_selection_data_get_target (selection_data);
+    }
 
   info->callback (clipboard, result, info->user_data);
   g_free (info);
@@ -1085,7 +1094,8 @@ gtk_clipboard_request_text (GtkClipboard                *clipboard,
 			    gpointer                     user_data)
 {
   RequestTextInfo *info;
-  
+  GdkAtom target;
+
   g_return_if_fail (clipboard != NULL);
   g_return_if_fail (callback != NULL);
   
@@ -1093,7 +1103,12 @@ gtk_clipboard_request_text (GtkClipboard                *clipboard,
   info->callback = callback;
   info->user_data = user_data;
 
-  gtk_clipboard_request_contents (clipboard, gdk_atom_intern_static_string ("UTF8_STRING"),
+  if (clipboard->preferred_text_target != GDK_NONE)
+    target = clipboard->preferred_text_target;
+  else
+    target = gdk_atom_intern_static_string ("UTF8_STRING");
+
+  gtk_clipboard_request_contents (clipboard, target,
 				  request_text_received_func,
 				  info);
 }
@@ -1939,6 +1954,7 @@ clipboard_peek (GdkDisplay *display,
       clipboard->selection = selection;
       clipboard->display = display;
       clipboard->n_cached_targets = -1;
+      clipboard->preferred_text_target = GDK_NONE;
       clipboard->n_storable_targets = -1;
       clipboards = g_slist_prepend (clipboards, clipboard);
       g_object_set_data (G_OBJECT (display), I_("gtk-clipboard-list"), clipboards);
@@ -1960,6 +1976,8 @@ gtk_clipboard_owner_change (GtkClipboard        *clipboard,
       clipboard->cached_targets = NULL;
       clipboard->n_cached_targets = -1;
     }
+
+  clipboard->preferred_text_target = GDK_NONE;
 }
 
 /**
@@ -49,6 +49,8 @@ struct _GtkClipboard
   GdkAtom *cached_targets;
   gint     n_cached_targets;
 
+  GdkAtom  preferred_text_target;
+
   gulong     notify_signal_id;
   gboolean   storing_selection;
   GMainLoop *store_loop;
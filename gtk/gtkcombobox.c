@@ -51,6 +51,7 @@
 
 #include "gtkmarshalers.h"
 #include "gtkintl.h"
+#include "gtkpango.h"
 
 #include "gtkentryprivate.h"
 #include "gtktreeprivate.h"
@@ -4129,16 +4130,43 @@ void
 gtk_combo_box_set_model (GtkComboBox  *combo_box,
                          GtkTreeModel *model)
 {
+  GtkComboBoxPrivate *priv;
+
   g_return_if_fail (GTK_IS_COMBO_BOX (combo_box));
   g_return_if_fail (model == NULL || GTK_IS_TREE_MODEL (model));
 
-  if (model == combo_box->priv->model)
-    return;
+  priv = combo_box->priv;
 
-  gtk_combo_box_unset_model (combo_box);
+  if (model == priv->model)
+    return;
 
   if (model == NULL)
-    goto out;
+    {
+      gtk_combo_box_unset_model (combo_box);
+      goto out;
+    }
+
+  /* Swap the models directly instead of unsetting the old one first:
+   * routing the views through an intermediate empty state would make
+   * each of them rebuild twice, which is visible as flicker when the
+   * model is refreshed while the popup is up.
+   */
+  if (priv->model)
+    {
+      g_signal_handler_disconnect (priv->model, priv->inserted_id);
+      g_signal_handler_disconnect (priv->model, priv->deleted_id);
+      g_signal_handler_disconnect (priv->model, priv->reordered_id);
+      g_signal_handler_disconnect (priv->model, priv->changed_id);
+
+      if (priv->active_row)
+        {
+          gtk_tree_row_reference_free (priv->active_row);
+          priv->active_row = NULL;
+        }
+
+      g_object_unref (priv->model);
+      priv->model = NULL;
+    }
 
   combo_box->priv->model = model;
   g_object_ref (combo_box->priv->model);
@@ -5197,9 +5225,7 @@ gtk_combo_box_get_preferred_width (GtkWidget *widget,
   get_widget_padding_and_border (widget, &padding);
 
   context = gtk_widget_get_pango_context (GTK_WIDGET (widget));
-  metrics = pango_context_get_metrics (context,
-                                       pango_context_get_font_description (context),
-                                       pango_context_get_language (context));
+  metrics = _gtk_pango_get_metrics (context);
   font_size = PANGO_PIXELS (pango_font_metrics_get_ascent (metrics) +
                             pango_font_metrics_get_descent (metrics));
   pango_font_metrics_unref (metrics);
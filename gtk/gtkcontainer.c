@@ -38,6 +38,7 @@
 #include "gtkbuildable.h"
 #include "gtkbuilderprivate.h"
 #include "gtktypebuiltins.h"
+#include "gtkdebug.h"
 #include "gtkprivate.h"
 #include "gtkmain.h"
 #include "gtkmarshalers.h"
@@ -49,6 +50,7 @@
 #include "gtkintl.h"
 #include "gtkstylecontextprivate.h"
 #include "gtkwidgetpath.h"
+#include "gtklayoutstatsprivate.h"
 #include "a11y/gtkcontaineraccessible.h"
 #include "a11y/gtkcontaineraccessibleprivate.h"
 #include "gtkpopovermenu.h"
@@ -1894,6 +1896,8 @@ static void
 gtk_container_idle_sizer (GdkFrameClock *clock,
 			  GtkContainer  *container)
 {
+  _gtk_layout_stats_frame_begin ();
+
   /* We validate the style contexts in a single loop before even trying
    * to handle resizes instead of doing validations inline.
    * This is mostly necessary for compatibility reasons with old code,
@@ -1922,6 +1926,8 @@ gtk_container_idle_sizer (GdkFrameClock *clock,
       gtk_container_check_resize (container);
     }
 
+  _gtk_layout_stats_frame_end ();
+
   if (!container->priv->restyle_pending && !container->priv->resize_pending)
     {
       _gtk_container_stop_idle_sizer (container);
@@ -3667,6 +3673,47 @@ gtk_container_should_propagate_draw (GtkContainer   *container,
 }
 
 
+#ifdef G_ENABLE_DEBUG
+/* PAINT_COST debugging: tint each child by how long its draw handler
+ * took, so expensive widgets stand out on screen.  A widget eating the
+ * whole 60Hz frame budget is fully tinted; cheap widgets are left
+ * alone.
+ */
+#define PAINT_COST_BUDGET 16000 /* 60Hz frame budget, in us */
+#define PAINT_COST_MIN      100 /* don't annotate cheaper widgets, in us */
+
+static void
+gtk_container_draw_paint_cost (GtkWidget *child,
+                               cairo_t   *cr,
+                               gint64     elapsed)
+{
+  GtkAllocation allocation;
+  gdouble alpha;
+  gchar *text;
+
+  if (elapsed < PAINT_COST_MIN)
+    return;
+
+  gtk_widget_get_allocation (child, &allocation);
+
+  alpha = MIN ((gdouble) elapsed / PAINT_COST_BUDGET, 1.0);
+
+  cairo_save (cr);
+
+  cairo_rectangle (cr, 0, 0, allocation.width, allocation.height);
+  cairo_set_source_rgba (cr, 1, 0, 0, 0.1 + 0.4 * alpha);
+  cairo_fill (cr);
+
+  text = g_strdup_printf ("%.1f ms", elapsed / 1000.0);
+  cairo_set_source_rgb (cr, 1, 1, 1);
+  cairo_move_to (cr, 2, 12);
+  cairo_show_text (cr, text);
+  g_free (text);
+
+  cairo_restore (cr);
+}
+#endif /* G_ENABLE_DEBUG */
+
 /**
  * gtk_container_propagate_draw:
  * @container: a #GtkContainer
@@ -3749,7 +3796,19 @@ gtk_container_propagate_draw (GtkContainer   *container,
 
   cairo_translate (cr, x, y);
 
-  _gtk_widget_draw (child, cr);
+#ifdef G_ENABLE_DEBUG
+  if (G_UNLIKELY (gtk_get_debug_flags () & GTK_DEBUG_PAINT_COST))
+    {
+      gint64 before = g_get_monotonic_time ();
+
+      _gtk_widget_draw (child, cr);
+
+      gtk_container_draw_paint_cost (child, cr,
+                                     g_get_monotonic_time () - before);
+    }
+  else
+#endif
+    _gtk_widget_draw (child, cr);
 
   cairo_restore (cr);
 }
@@ -429,6 +429,12 @@ gtk_css_animated_style_new (GtkCssStyle             *base_style,
   if (timestamp == 0)
     return g_object_ref (base_style);
 
+  /* Fast path for the vast majority of nodes that have no animation
+   * or transition properties set at all */
+  if (GTK_IS_CSS_STATIC_STYLE (base_style) &&
+      !gtk_css_static_style_needs_animations (GTK_CSS_STATIC_STYLE (base_style)))
+    return g_object_ref (base_style);
+
   animations = NULL;
 
   if (previous_style != NULL)
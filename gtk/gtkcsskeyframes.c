@@ -34,8 +34,29 @@ struct _GtkCssKeyframes {
   int n_properties;             /* number of properties used by keyframes */
   guint *property_ids;          /* ordered array of n_properties property ids */
   GtkCssValue **values;         /* 2D array: n_keyframes * n_properties of (value or NULL) for all the keyframes */
+
+  /* cache of the last _gtk_css_keyframes_compute() result, so that
+   * restarting an animation on an unchanged style doesn't recompute
+   * all the property tables */
+  GtkStyleProviderPrivate *last_provider;  /* owned */
+  GtkCssStyle *last_style;                 /* owned */
+  GtkCssStyle *last_parent_style;          /* owned or NULL */
+  GtkCssKeyframes *last_resolved;          /* owned */
 };
 
+static void
+gtk_css_keyframes_clear_resolved_cache (GtkCssKeyframes *keyframes)
+{
+  g_clear_object (&keyframes->last_provider);
+  g_clear_object (&keyframes->last_style);
+  g_clear_object (&keyframes->last_parent_style);
+  if (keyframes->last_resolved)
+    {
+      _gtk_css_keyframes_unref (keyframes->last_resolved);
+      keyframes->last_resolved = NULL;
+    }
+}
+
 #define KEYFRAMES_VALUE(keyframes, k, p) ((keyframes)->values[(k) * (keyframes)->n_properties + (p)])
 
 GtkCssKeyframes *
@@ -59,6 +80,8 @@ _gtk_css_keyframes_unref (GtkCssKeyframes *keyframes)
   if (keyframes->ref_count > 0)
     return;
 
+  gtk_css_keyframes_clear_resolved_cache (keyframes);
+
   g_free (keyframes->keyframe_progress);
   g_free (keyframes->property_ids);
 
@@ -448,6 +471,12 @@ _gtk_css_keyframes_compute (GtkCssKeyframes         *keyframes,
   g_return_val_if_fail (GTK_IS_CSS_STYLE (style), NULL);
   g_return_val_if_fail (parent_style == NULL || GTK_IS_CSS_STYLE (parent_style), NULL);
 
+  if (keyframes->last_resolved &&
+      keyframes->last_provider == provider &&
+      keyframes->last_style == style &&
+      keyframes->last_parent_style == parent_style)
+    return _gtk_css_keyframes_ref (keyframes->last_resolved);
+
   resolved = gtk_css_keyframes_alloc ();
   resolved->n_keyframes = keyframes->n_keyframes;
   resolved->keyframe_progress = g_memdup (keyframes->keyframe_progress, keyframes->n_keyframes * sizeof (double));
@@ -470,6 +499,12 @@ _gtk_css_keyframes_compute (GtkCssKeyframes         *keyframes,
         }
     }
 
+  gtk_css_keyframes_clear_resolved_cache (keyframes);
+  keyframes->last_provider = g_object_ref (provider);
+  keyframes->last_style = g_object_ref (style);
+  keyframes->last_parent_style = parent_style ? g_object_ref (parent_style) : NULL;
+  keyframes->last_resolved = _gtk_css_keyframes_ref (resolved);
+
   return resolved;
 }
 
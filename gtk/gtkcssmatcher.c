@@ -211,6 +211,55 @@ gtk_css_matcher_widget_path_has_position (const GtkCssMatcher *matcher,
   return x / a >= 0;
 }
 
+static void
+gtk_css_matcher_widget_path_add_hashes (const GtkCssMatcher *matcher,
+                                        guint32             *hashes)
+{
+  const GtkWidgetPath *siblings, *path;
+  guint index;
+  const char *name;
+  GSList *classes, *s;
+  GType type;
+
+  siblings = gtk_widget_path_iter_get_siblings (matcher->path.path, matcher->path.index);
+  if (siblings && matcher->path.sibling_index != gtk_widget_path_iter_get_sibling_index (matcher->path.path, matcher->path.index))
+    {
+      path = siblings;
+      index = matcher->path.sibling_index;
+    }
+  else
+    {
+      path = matcher->path.path;
+      index = matcher->path.index;
+    }
+
+  /* Name selectors match supertypes, so the whole ancestry
+   * needs to be in the filter */
+  for (type = gtk_widget_path_iter_get_object_type (path, index);
+       type != G_TYPE_INVALID;
+       type = g_type_parent (type))
+    *hashes |= _gtk_css_matcher_hash_name (g_type_name (type));
+
+  name = gtk_widget_path_iter_get_name (path, index);
+  if (name)
+    *hashes |= _gtk_css_matcher_hash_name (name);
+
+  classes = gtk_widget_path_iter_list_classes (path, index);
+  for (s = classes; s; s = s->next)
+    *hashes |= _gtk_css_matcher_hash_name (s->data);
+  g_slist_free (classes);
+
+  if (matcher->path.decl)
+    {
+      GList *list, *l;
+
+      list = gtk_css_node_declaration_list_classes (matcher->path.decl);
+      for (l = list; l; l = l->next)
+        *hashes |= _gtk_css_matcher_hash_name (g_quark_to_string (GPOINTER_TO_UINT (l->data)));
+      g_list_free (list);
+    }
+}
+
 static const GtkCssMatcherClass GTK_CSS_MATCHER_WIDGET_PATH = {
   gtk_css_matcher_widget_path_get_parent,
   gtk_css_matcher_widget_path_get_previous,
@@ -221,6 +270,7 @@ static const GtkCssMatcherClass GTK_CSS_MATCHER_WIDGET_PATH = {
   gtk_css_matcher_widget_path_has_regions,
   gtk_css_matcher_widget_path_has_region,
   gtk_css_matcher_widget_path_has_position,
+  gtk_css_matcher_widget_path_add_hashes,
   FALSE
 };
 
@@ -396,6 +446,30 @@ gtk_css_matcher_node_has_position (const GtkCssMatcher *matcher,
                                          a, b);
 }
 
+static void
+gtk_css_matcher_node_add_hashes (const GtkCssMatcher *matcher,
+                                 guint32             *hashes)
+{
+  GtkCssNode *node = matcher->node.node;
+  const char *id;
+  GList *classes, *l;
+  GType type;
+
+  for (type = gtk_css_node_get_widget_type (node);
+       type != G_TYPE_INVALID;
+       type = g_type_parent (type))
+    *hashes |= _gtk_css_matcher_hash_name (g_type_name (type));
+
+  id = gtk_css_node_get_id (node);
+  if (id)
+    *hashes |= _gtk_css_matcher_hash_name (id);
+
+  classes = gtk_css_node_list_classes (node);
+  for (l = classes; l; l = l->next)
+    *hashes |= _gtk_css_matcher_hash_name (g_quark_to_string (GPOINTER_TO_UINT (l->data)));
+  g_list_free (classes);
+}
+
 static const GtkCssMatcherClass GTK_CSS_MATCHER_NODE = {
   gtk_css_matcher_node_get_parent,
   gtk_css_matcher_node_get_previous,
@@ -406,6 +480,7 @@ static const GtkCssMatcherClass GTK_CSS_MATCHER_NODE = {
   gtk_css_matcher_node_has_regions,
   gtk_css_matcher_node_has_region,
   gtk_css_matcher_node_has_position,
+  gtk_css_matcher_node_add_hashes,
   FALSE
 };
 
@@ -492,6 +567,14 @@ gtk_css_matcher_any_has_position (const GtkCssMatcher *matcher,
   return TRUE;
 }
 
+static void
+gtk_css_matcher_any_add_hashes (const GtkCssMatcher *matcher,
+                                guint32             *hashes)
+{
+  /* This matcher matches anything, so no subtree may be rejected */
+  *hashes = ~0u;
+}
+
 static const GtkCssMatcherClass GTK_CSS_MATCHER_ANY = {
   gtk_css_matcher_any_get_parent,
   gtk_css_matcher_any_get_previous,
@@ -502,6 +585,7 @@ static const GtkCssMatcherClass GTK_CSS_MATCHER_ANY = {
   gtk_css_matcher_any_has_regions,
   gtk_css_matcher_any_has_region,
   gtk_css_matcher_any_has_position,
+  gtk_css_matcher_any_add_hashes,
   TRUE
 };
 
@@ -612,6 +696,15 @@ gtk_css_matcher_superset_has_position (const GtkCssMatcher *matcher,
     return TRUE;
 }
 
+static void
+gtk_css_matcher_superset_add_hashes (const GtkCssMatcher *matcher,
+                                     guint32             *hashes)
+{
+  /* The superset matcher may match more names, classes and ids
+   * than its subset, so it cannot reject any subtree */
+  *hashes = ~0u;
+}
+
 static const GtkCssMatcherClass GTK_CSS_MATCHER_SUPERSET = {
   gtk_css_matcher_superset_get_parent,
   gtk_css_matcher_superset_get_previous,
@@ -622,6 +715,7 @@ static const GtkCssMatcherClass GTK_CSS_MATCHER_SUPERSET = {
   gtk_css_matcher_superset_has_regions,
   gtk_css_matcher_superset_has_region,
   gtk_css_matcher_superset_has_position,
+  gtk_css_matcher_superset_add_hashes,
   FALSE
 };
 
@@ -50,6 +50,8 @@ struct _GtkCssMatcherClass {
                                                    gboolean               forward,
                                                    int                    a,
                                                    int                    b);
+  void            (* add_hashes)                  (const GtkCssMatcher   *matcher,
+                                                   guint32               *hashes);
   gboolean is_any;
 };
 
@@ -155,6 +157,23 @@ _gtk_css_matcher_has_position (const GtkCssMatcher *matcher,
   return matcher->klass->has_position (matcher, forward, a, b);
 }
 
+/* Computes the bloom filter bit for an interned name, style class
+ * or id, used to quickly reject selector tree subtrees that cannot
+ * match the element a matcher refers to.
+ */
+static inline guint32
+_gtk_css_matcher_hash_name (const char *name)
+{
+  return 1u << (g_str_hash (name) & 31);
+}
+
+static inline void
+_gtk_css_matcher_add_hashes (const GtkCssMatcher *matcher,
+                             guint32             *hashes)
+{
+  matcher->klass->add_hashes (matcher, hashes);
+}
+
 static inline gboolean
 _gtk_css_matcher_matches_any (const GtkCssMatcher *matcher)
 {
@@ -24,6 +24,7 @@
 #include "gtkintl.h"
 #include "gtkmarshalers.h"
 #include "gtksettingsprivate.h"
+#include "gtkstyleproviderprivate.h"
 #include "gtktypebuiltins.h"
 
 /* When these change we do a full restyling. Otherwise we try to figure out
@@ -1108,13 +1109,26 @@ gtk_css_node_get_classes (GtkCssNode *cssnode)
   return (char **) g_ptr_array_free (result, FALSE);
 }
 
+/* Toggling a class that no rule in the node's style providers checks
+ * for cannot change any style in the tree, so we don't need to queue
+ * a revalidation for it. Applications like to use marker classes on
+ * their rows, which otherwise invalidate the whole subtree. */
+static void
+gtk_css_node_invalidate_for_class (GtkCssNode *cssnode,
+                                   GQuark      style_class)
+{
+  if (_gtk_style_provider_private_references_class (gtk_css_node_get_style_provider (cssnode),
+                                                    style_class))
+    gtk_css_node_invalidate (cssnode, GTK_CSS_CHANGE_CLASS);
+}
+
 void
 gtk_css_node_add_class (GtkCssNode *cssnode,
                         GQuark      style_class)
 {
   if (gtk_css_node_declaration_add_class (&cssnode->decl, style_class))
     {
-      gtk_css_node_invalidate (cssnode, GTK_CSS_CHANGE_CLASS);
+      gtk_css_node_invalidate_for_class (cssnode, style_class);
       g_object_notify_by_pspec (G_OBJECT (cssnode), cssnode_properties[PROP_CLASSES]);
     }
 }
@@ -1125,7 +1139,7 @@ gtk_css_node_remove_class (GtkCssNode *cssnode,
 {
   if (gtk_css_node_declaration_remove_class (&cssnode->decl, style_class))
     {
-      gtk_css_node_invalidate (cssnode, GTK_CSS_CHANGE_CLASS);
+      gtk_css_node_invalidate_for_class (cssnode, style_class);
       g_object_notify_by_pspec (G_OBJECT (cssnode), cssnode_properties[PROP_CLASSES]);
     }
 }
@@ -1284,7 +1298,14 @@ gtk_css_node_validate_internal (GtkCssNode *cssnode,
        child;
        child = gtk_css_node_get_next_sibling (child))
     {
-      if (child->visible)
+      /* Sibling subtrees are independent once this node's style is
+       * computed, so only descend into the ones that actually contain
+       * invalid nodes. With the css cache debugging flag set we need
+       * to visit everything, as the recursion is what marks all nodes
+       * as changed in that mode. */
+      if (child->visible &&
+          (child->invalid ||
+           G_UNLIKELY (gtk_get_debug_flags () & GTK_DEBUG_NO_CSS_CACHE)))
         gtk_css_node_validate_internal (child, timestamp);
     }
 }
@@ -36,6 +36,7 @@
 #include "gtkcssstylefuncsprivate.h"
 #include "gtksettingsprivate.h"
 #include "gtkstyleprovider.h"
+#include "gtktraceprivate.h"
 #include "gtkstylecontextprivate.h"
 #include "gtkstylepropertyprivate.h"
 #include "gtkstyleproviderprivate.h"
@@ -1199,6 +1200,12 @@ struct _GtkCssProviderPrivate
   GArray *rulesets;
   GtkCssSelectorTree *tree;
   GResource *resource;
+
+  char *loaded_uri;
+  char *loaded_etag;
+  guint had_import : 1;
+
+  GHashTable *class_refs; /* set of class quarks used in selectors, built lazily */
 };
 
 enum {
@@ -1841,12 +1848,37 @@ gtk_css_style_provider_lookup (GtkStyleProviderPrivate *provider,
     }
 }
 
+static gboolean
+gtk_css_style_provider_references_class (GtkStyleProviderPrivate *provider,
+                                         GQuark                   class_quark)
+{
+  GtkCssProvider *css_provider = GTK_CSS_PROVIDER (provider);
+  GtkCssProviderPrivate *priv = css_provider->priv;
+
+  if (priv->class_refs == NULL)
+    {
+      guint i;
+
+      priv->class_refs = g_hash_table_new (NULL, NULL);
+
+      for (i = 0; i < priv->rulesets->len; i++)
+        {
+          GtkCssRuleset *ruleset = &g_array_index (priv->rulesets, GtkCssRuleset, i);
+
+          _gtk_css_selector_add_class_references (ruleset->selector, priv->class_refs);
+        }
+    }
+
+  return g_hash_table_contains (priv->class_refs, GUINT_TO_POINTER (class_quark));
+}
+
 static void
 gtk_css_style_provider_private_iface_init (GtkStyleProviderPrivateInterface *iface)
 {
   iface->get_color = gtk_css_style_provider_get_color;
   iface->get_keyframes = gtk_css_style_provider_get_keyframes;
   iface->lookup = gtk_css_style_provider_lookup;
+  iface->references_class = gtk_css_style_provider_references_class;
 }
 
 static void
@@ -1875,6 +1907,12 @@ gtk_css_provider_finalize (GObject *object)
       priv->resource = NULL;
     }
 
+  g_free (priv->loaded_uri);
+  g_free (priv->loaded_etag);
+
+  if (priv->class_refs)
+    g_hash_table_destroy (priv->class_refs);
+
   G_OBJECT_CLASS (gtk_css_provider_parent_class)->finalize (object);
 }
 
@@ -2004,6 +2042,17 @@ gtk_css_provider_reset (GtkCssProvider *css_provider)
   _gtk_css_selector_tree_free (priv->tree);
   priv->tree = NULL;
 
+  g_free (priv->loaded_uri);
+  priv->loaded_uri = NULL;
+  g_free (priv->loaded_etag);
+  priv->loaded_etag = NULL;
+  priv->had_import = FALSE;
+
+  if (priv->class_refs)
+    {
+      g_hash_table_destroy (priv->class_refs);
+      priv->class_refs = NULL;
+    }
 }
 
 static void
@@ -2088,6 +2137,11 @@ parse_import (GtkCssScanner *scanner)
     }
   else
     {
+      /* Imported files are not covered by the etag check in
+       * gtk_css_provider_load_from_file(), so remember that we
+       * can't take the unchanged-file fast path next time. */
+      scanner->provider->priv->had_import = TRUE;
+
       gtk_css_provider_load_internal (scanner->provider,
                                       scanner,
                                       file,
@@ -2741,8 +2795,18 @@ gtk_css_provider_load_internal (GtkCssProvider *css_provider,
                                      file,
                                      text);
 
+      if (_gtk_trace_is_enabled ())
+        {
+          gchar *path = file ? g_file_get_path (file) : NULL;
+
+          _gtk_trace_begin ("css parse", path);
+          g_free (path);
+        }
+
       parse_stylesheet (scanner);
 
+      _gtk_trace_end ("css parse");
+
       gtk_css_scanner_destroy (scanner);
 
       if (parent == NULL)
@@ -2836,15 +2900,55 @@ gtk_css_provider_load_from_file (GtkCssProvider  *css_provider,
                                  GFile           *file,
                                  GError         **error)
 {
+  GtkCssProviderPrivate *priv;
+  GFileInfo *info;
+  char *uri, *etag;
   gboolean success;
 
   g_return_val_if_fail (GTK_IS_CSS_PROVIDER (css_provider), FALSE);
   g_return_val_if_fail (G_IS_FILE (file), FALSE);
 
+  priv = css_provider->priv;
+
+  uri = g_file_get_uri (file);
+  etag = NULL;
+  info = g_file_query_info (file, G_FILE_ATTRIBUTE_ETAG_VALUE, 0, NULL, NULL);
+  if (info)
+    {
+      etag = g_strdup (g_file_info_get_etag (info));
+      g_object_unref (info);
+    }
+
+  /* Reparsing the stylesheet we already contain would just recreate
+   * the exact same rules, so skip the whole tokenize/parse/postprocess
+   * machinery when the file is unchanged. Settings changes like to
+   * retrigger theme loading, which makes this a common case. */
+  if (etag != NULL &&
+      priv->loaded_uri != NULL &&
+      !priv->had_import &&
+      g_str_equal (priv->loaded_uri, uri) &&
+      g_strcmp0 (priv->loaded_etag, etag) == 0)
+    {
+      g_free (uri);
+      g_free (etag);
+      return TRUE;
+    }
+
   gtk_css_provider_reset (css_provider);
 
   success = gtk_css_provider_load_internal (css_provider, NULL, file, NULL, error);
 
+  if (success && (error == NULL || *error == NULL))
+    {
+      priv->loaded_uri = uri;
+      priv->loaded_etag = etag;
+    }
+  else
+    {
+      g_free (uri);
+      g_free (etag);
+    }
+
   _gtk_style_provider_private_changed (GTK_STYLE_PROVIDER_PRIVATE (css_provider));
 
   return success;
@@ -108,10 +108,22 @@ static const GtkCssValueClass GTK_CSS_VALUE_RGBA = {
 GtkCssValue *
 _gtk_css_rgba_value_new_from_rgba (const GdkRGBA *rgba)
 {
+  static GtkCssValue rgba_singletons[] = {
+    /* transparent */ { &GTK_CSS_VALUE_RGBA, 1, { 0, 0, 0, 0 } },
+    /* black */       { &GTK_CSS_VALUE_RGBA, 1, { 0, 0, 0, 1 } },
+    /* white */       { &GTK_CSS_VALUE_RGBA, 1, { 1, 1, 1, 1 } },
+  };
   GtkCssValue *value;
+  guint i;
 
   g_return_val_if_fail (rgba != NULL, NULL);
 
+  for (i = 0; i < G_N_ELEMENTS (rgba_singletons); i++)
+    {
+      if (gdk_rgba_equal (rgba, &rgba_singletons[i].rgba))
+        return _gtk_css_value_ref (&rgba_singletons[i]);
+    }
+
   value = _gtk_css_value_new (GtkCssValue, &GTK_CSS_VALUE_RGBA);
   value->rgba = *rgba;
 
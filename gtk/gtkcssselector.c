@@ -114,6 +114,8 @@ struct _GtkCssSelectorTree
   gint32 previous_offset;
   gint32 sibling_offset;
   gint32 matches_offset; /* pointers that we return as matches if selector matches */
+  guint32 filter; /* bloom filter bits an element must have for this subtree to match it */
+  GtkCssChange collected_change; /* change of this selector and everything below, precomputed */
 };
 
 static gboolean
@@ -1636,6 +1638,21 @@ _gtk_css_selector_compare (const GtkCssSelector *a,
   return a_elements - b_elements;
 }
 
+/* Adds the quarks of all style classes that @selector checks for,
+ * in positive or negated form, to @classes. Used by providers to
+ * answer _gtk_style_provider_private_references_class(). */
+void
+_gtk_css_selector_add_class_references (const GtkCssSelector *selector,
+                                        GHashTable           *classes)
+{
+  for (; selector; selector = gtk_css_selector_previous (selector))
+    {
+      if (selector->class == &GTK_CSS_SELECTOR_CLASS ||
+          selector->class == &GTK_CSS_SELECTOR_NOT_CLASS)
+        g_hash_table_add (classes, GUINT_TO_POINTER (selector->style_class.style_class));
+    }
+}
+
 GtkCssChange
 _gtk_css_selector_get_change (const GtkCssSelector *selector)
 {
@@ -1756,14 +1773,27 @@ _gtk_css_selector_tree_match_all (const GtkCssSelectorTree *tree,
   GPtrArray *array;
   GHashTableIter iter;
   gpointer key;
+  guint32 hashes;
 
   update_type_references ();
 
+  /* Collect the bloom filter of the element's names, classes and ids
+   * so we can reject subtrees that require something the element
+   * doesn't have without walking them. See WebKit's fast rejection
+   * filter for the same idea. */
+  hashes = 0;
+  _gtk_css_matcher_add_hashes (matcher, &hashes);
+
   res = g_hash_table_new (g_direct_hash, g_direct_equal);
 
   for (; tree != NULL;
        tree = gtk_css_selector_tree_get_sibling (tree))
-    gtk_css_selector_foreach (&tree->selector, matcher, gtk_css_selector_tree_match_foreach, res);
+    {
+      if ((tree->filter & hashes) != tree->filter)
+        continue;
+
+      gtk_css_selector_foreach (&tree->selector, matcher, gtk_css_selector_tree_match_foreach, res);
+    }
 
   array = g_ptr_array_sized_new (g_hash_table_size (res));
 
@@ -1789,22 +1819,6 @@ _gtk_css_selector_tree_match_all (const GtkCssSelectorTree *tree,
    that change != 0 on any match. */
 #define GTK_CSS_CHANGE_GOT_MATCH GTK_CSS_CHANGE_RESERVED_BIT
 
-static GtkCssChange
-gtk_css_selector_tree_collect_change (const GtkCssSelectorTree *tree)
-{
-  GtkCssChange change = 0;
-  const GtkCssSelectorTree *prev;
-
-  for (prev = gtk_css_selector_tree_get_previous (tree);
-       prev != NULL;
-       prev = gtk_css_selector_tree_get_sibling (prev))
-    change |= gtk_css_selector_tree_collect_change (prev);
-
-  change = tree->selector.class->get_change (&tree->selector, change);
-
-  return change;
-}
-
 static GtkCssChange
 gtk_css_selector_tree_get_change (const GtkCssSelectorTree *tree,
 				  const GtkCssMatcher      *matcher)
@@ -1816,7 +1830,7 @@ gtk_css_selector_tree_get_change (const GtkCssSelectorTree *tree,
     return 0;
 
   if (!tree->selector.class->is_simple)
-    return gtk_css_selector_tree_collect_change (tree) | GTK_CSS_CHANGE_GOT_MATCH;
+    return tree->collected_change | GTK_CSS_CHANGE_GOT_MATCH;
 
   for (prev = gtk_css_selector_tree_get_previous (tree);
        prev != NULL;
@@ -2103,6 +2117,88 @@ fixup_offsets (GtkCssSelectorTree *tree, guint8 *data)
     }
 }
 
+static guint32
+gtk_css_selector_tree_get_hash (const GtkCssSelectorTree *tree)
+{
+  const GtkCssSelector *selector = &tree->selector;
+
+  if (selector->class == &GTK_CSS_SELECTOR_NAME)
+    return _gtk_css_matcher_hash_name (selector->name.reference->name);
+  if (selector->class == &GTK_CSS_SELECTOR_CLASS)
+    return _gtk_css_matcher_hash_name (g_quark_to_string (selector->style_class.style_class));
+  if (selector->class == &GTK_CSS_SELECTOR_ID)
+    return _gtk_css_matcher_hash_name (selector->id.name);
+
+  return 0;
+}
+
+/* Compute for every tree node the change mask of the node's selector
+ * combined with everything below it, so that
+ * _gtk_css_selector_tree_get_change_all() doesn't have to walk the
+ * subtree again on every state flip. */
+static void
+compute_tree_changes (GtkCssSelectorTree *tree)
+{
+  GtkCssChange change;
+  GtkCssSelectorTree *prev;
+
+  for (; tree != NULL;
+       tree = (GtkCssSelectorTree *) gtk_css_selector_tree_get_sibling (tree))
+    {
+      compute_tree_changes ((GtkCssSelectorTree *) gtk_css_selector_tree_get_previous (tree));
+
+      change = 0;
+      for (prev = (GtkCssSelectorTree *) gtk_css_selector_tree_get_previous (tree);
+           prev != NULL;
+           prev = (GtkCssSelectorTree *) gtk_css_selector_tree_get_sibling (prev))
+        change |= prev->collected_change;
+
+      tree->collected_change = tree->selector.class->get_change (&tree->selector, change);
+    }
+}
+
+/* Compute for every tree node the bloom filter bits an element must
+ * have for the subtree rooted there to possibly match it. Bits are
+ * only collected from simple name/class/id selectors and only along
+ * the initial run of simple selectors, ie while the tree still checks
+ * the element itself and not one of its ancestors or siblings. Bits
+ * from alternative subtrees are intersected, as a match may come from
+ * any one of them. */
+static void
+compute_tree_filters (GtkCssSelectorTree *tree)
+{
+  GtkCssSelectorTree *prev;
+
+  for (; tree != NULL;
+       tree = (GtkCssSelectorTree *) gtk_css_selector_tree_get_sibling (tree))
+    {
+      compute_tree_filters ((GtkCssSelectorTree *) gtk_css_selector_tree_get_previous (tree));
+
+      if (!tree->selector.class->is_simple)
+        {
+          /* Everything below matches ancestors or siblings, which the
+           * filter knows nothing about */
+          tree->filter = 0;
+          continue;
+        }
+
+      tree->filter = gtk_css_selector_tree_get_hash (tree);
+
+      prev = (GtkCssSelectorTree *) gtk_css_selector_tree_get_previous (tree);
+      if (prev != NULL &&
+          gtk_css_selector_tree_get_matches (tree) == NULL)
+        {
+          guint32 common = ~0u;
+
+          for (; prev != NULL;
+               prev = (GtkCssSelectorTree *) gtk_css_selector_tree_get_sibling (prev))
+            common &= prev->filter;
+
+          tree->filter |= common;
+        }
+    }
+}
+
 GtkCssSelectorTree *
 _gtk_css_selector_tree_builder_build (GtkCssSelectorTreeBuilder *builder)
 {
@@ -2126,6 +2222,9 @@ _gtk_css_selector_tree_builder_build (GtkCssSelectorTreeBuilder *builder)
 
   fixup_offsets (tree, data);
 
+  compute_tree_filters (tree);
+  compute_tree_changes (tree);
+
   /* Convert offsets to final pointers */
   for (l = builder->infos; l != NULL; l = l->next)
     {
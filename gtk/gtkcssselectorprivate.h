@@ -37,6 +37,9 @@ void              _gtk_css_selector_print           (const GtkCssSelector   *sel
 gboolean          _gtk_css_selector_matches         (const GtkCssSelector   *selector,
                                                      const GtkCssMatcher    *matcher);
 GtkCssChange      _gtk_css_selector_get_change      (const GtkCssSelector   *selector);
+void              _gtk_css_selector_add_class_references
+                                                    (const GtkCssSelector   *selector,
+                                                     GHashTable             *classes);
 int               _gtk_css_selector_compare         (const GtkCssSelector   *a,
                                                      const GtkCssSelector   *b);
 
@@ -30,6 +30,7 @@
 #include "gtkpango.h"
 
 #include <math.h>
+#include <string.h>
 
 struct _GtkCssValue {
   GTK_CSS_VALUE_BASE
@@ -308,6 +309,69 @@ needs_blur (const GtkCssValue *shadow)
 
 static const cairo_user_data_key_t original_cr_key;
 
+/* Shadow blurring needs a scratch mask surface per draw call, and
+ * widgets repaint their shadows at the same handful of sizes every
+ * frame.  Keep a small pool of recently used masks, matched by exact
+ * size: rounding sizes up to share entries would make the blur pass
+ * itself more expensive, since it walks the whole surface.
+ */
+#define SCRATCH_SURFACE_POOL_SIZE 8
+
+static cairo_surface_t *scratch_surface_pool[SCRATCH_SURFACE_POOL_SIZE];
+
+static cairo_surface_t *
+scratch_surface_acquire (cairo_t *cr,
+                         int      width,
+                         int      height)
+{
+  guint i;
+
+  for (i = 0; i < SCRATCH_SURFACE_POOL_SIZE; i++)
+    {
+      cairo_surface_t *surface = scratch_surface_pool[i];
+      cairo_t *clear_cr;
+
+      if (surface == NULL ||
+          cairo_image_surface_get_width (surface) != width ||
+          cairo_image_surface_get_height (surface) != height)
+        continue;
+
+      scratch_surface_pool[i] = NULL;
+
+      clear_cr = cairo_create (surface);
+      cairo_set_operator (clear_cr, CAIRO_OPERATOR_CLEAR);
+      cairo_paint (clear_cr);
+      cairo_destroy (clear_cr);
+
+      return surface;
+    }
+
+  return cairo_surface_create_similar_image (cairo_get_target (cr),
+                                             CAIRO_FORMAT_A8,
+                                             width, height);
+}
+
+static void
+scratch_surface_release (cairo_surface_t *surface)
+{
+  guint i;
+
+  for (i = 0; i < SCRATCH_SURFACE_POOL_SIZE; i++)
+    {
+      if (scratch_surface_pool[i] == NULL)
+        {
+          scratch_surface_pool[i] = surface;
+          return;
+        }
+    }
+
+  /* pool is full, evict the first entry */
+  cairo_surface_destroy (scratch_surface_pool[0]);
+  memmove (scratch_surface_pool, scratch_surface_pool + 1,
+           (SCRATCH_SURFACE_POOL_SIZE - 1) * sizeof (cairo_surface_t *));
+  scratch_surface_pool[SCRATCH_SURFACE_POOL_SIZE - 1] = surface;
+}
+
 static cairo_t *
 gtk_css_shadow_value_start_drawing (const GtkCssValue *shadow,
                                     cairo_t           *cr,
@@ -336,11 +400,10 @@ gtk_css_shadow_value_start_drawing (const GtkCssValue *shadow,
         clip_rect.height = 1;
     }
 
-  /* Create a larger surface to center the blur. */
-  surface = cairo_surface_create_similar_image (cairo_get_target (cr),
-                                                CAIRO_FORMAT_A8,
-                                                clip_rect.width + (blur_x ? 2 * clip_radius : 0),
-                                                clip_rect.height + (blur_y ? 2 * clip_radius : 0));
+  /* Use a larger surface to center the blur. */
+  surface = scratch_surface_acquire (cr,
+                                     clip_rect.width + (blur_x ? 2 * clip_radius : 0),
+                                     clip_rect.height + (blur_y ? 2 * clip_radius : 0));
   cairo_surface_set_device_offset (surface,
                                    (blur_x ? clip_radius : 0) - clip_rect.x,
                                    (blur_y ? clip_radius : 0) - clip_rect.y);
@@ -399,7 +462,7 @@ gtk_css_shadow_value_finish_drawing (const GtkCssValue *shadow,
 
   cairo_destroy (cr);
 
-  cairo_surface_destroy (surface);
+  scratch_surface_release (surface);
 
   return original_cr;
 }
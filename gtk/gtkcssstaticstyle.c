@@ -26,6 +26,7 @@
 #include "gtkcssenumvalueprivate.h"
 #include "gtkcssinheritvalueprivate.h"
 #include "gtkcssinitialvalueprivate.h"
+#include "gtkcsslookupprivate.h"
 #include "gtkcssnumbervalueprivate.h"
 #include "gtkcsssectionprivate.h"
 #include "gtkcssshorthandpropertyprivate.h"
@@ -164,6 +165,100 @@ gtk_css_static_style_get_default (void)
   return result;
 }
 
+/* Cache of already computed styles, so that the thousands of nodes
+ * that match the same declarations with the same parent style can
+ * share one style object instead of recomputing identical values.
+ * The key is the set of winning declarations from the lookup - the
+ * computed values are a pure function of those, the provider and the
+ * parent style. Entries are removed when their style is finalized,
+ * so the cache never keeps styles alive on its own. */
+typedef struct {
+  guint                    hash;
+  GtkStyleProviderPrivate *provider;           /* referenced */
+  GtkCssStyle             *parent;             /* referenced or NULL */
+  GtkCssChange             change;
+  guint                    n_values;
+  guint                   *ids;
+  GtkCssValue            **values;             /* winning declarations, referenced */
+  GtkCssStaticStyle       *style;              /* unowned, owns this entry via weak ref */
+} ComputeCacheEntry;
+
+static GHashTable *compute_cache = NULL;
+
+static guint
+compute_cache_entry_hash (gconstpointer data)
+{
+  const ComputeCacheEntry *entry = data;
+
+  return entry->hash;
+}
+
+static gboolean
+compute_cache_entry_equal (gconstpointer a,
+                           gconstpointer b)
+{
+  const ComputeCacheEntry *one = a;
+  const ComputeCacheEntry *two = b;
+  guint i;
+
+  if (one->hash != two->hash ||
+      one->provider != two->provider ||
+      one->parent != two->parent ||
+      one->change != two->change ||
+      one->n_values != two->n_values)
+    return FALSE;
+
+  for (i = 0; i < one->n_values; i++)
+    {
+      if (one->ids[i] != two->ids[i] ||
+          one->values[i] != two->values[i])
+        return FALSE;
+    }
+
+  return TRUE;
+}
+
+static guint
+compute_cache_hash (GtkStyleProviderPrivate  *provider,
+                    GtkCssStyle              *parent,
+                    GtkCssChange              change,
+                    guint                     n_values,
+                    const guint              *ids,
+                    GtkCssValue             **values)
+{
+  guint hash, i;
+
+  hash = g_direct_hash (provider) ^ g_direct_hash (parent) ^ (guint) change;
+
+  for (i = 0; i < n_values; i++)
+    hash = hash * 33 + ids[i] + g_direct_hash (values[i]);
+
+  return hash;
+}
+
+static void
+compute_cache_entry_free (gpointer data)
+{
+  ComputeCacheEntry *entry = data;
+  guint i;
+
+  for (i = 0; i < entry->n_values; i++)
+    _gtk_css_value_unref (entry->values[i]);
+  g_free (entry->ids);
+  g_free (entry->values);
+  if (entry->parent)
+    g_object_unref (entry->parent);
+  g_object_unref (entry->provider);
+  g_slice_free (ComputeCacheEntry, entry);
+}
+
+static void
+compute_cache_style_finalized (gpointer  data,
+                               GObject  *where_the_object_was)
+{
+  g_hash_table_remove (compute_cache, data);
+}
+
 GtkCssStyle *
 gtk_css_static_style_new_compute (GtkStyleProviderPrivate *provider,
                                   const GtkCssMatcher     *matcher,
@@ -172,6 +267,10 @@ gtk_css_static_style_new_compute (GtkStyleProviderPrivate *provider,
   GtkCssStaticStyle *result;
   GtkCssLookup *lookup;
   GtkCssChange change = GTK_CSS_CHANGE_ANY_SELF | GTK_CSS_CHANGE_ANY_SIBLING | GTK_CSS_CHANGE_ANY_PARENT;
+  ComputeCacheEntry probe, *entry;
+  guint *ids;
+  GtkCssValue **values;
+  guint i, n, n_values;
 
   lookup = _gtk_css_lookup_new (NULL);
 
@@ -181,17 +280,70 @@ gtk_css_static_style_new_compute (GtkStyleProviderPrivate *provider,
                                         lookup,
                                         &change);
 
+  n = _gtk_css_style_property_get_n_properties ();
+  ids = g_new (guint, n);
+  values = g_new (GtkCssValue *, n);
+  n_values = 0;
+  for (i = 0; i < n; i++)
+    {
+      if (lookup->values[i].value == NULL)
+        continue;
+
+      ids[n_values] = i;
+      values[n_values] = lookup->values[i].value;
+      n_values++;
+    }
+
+  probe.hash = compute_cache_hash (provider, parent, change, n_values, ids, values);
+  probe.provider = provider;
+  probe.parent = parent;
+  probe.change = change;
+  probe.n_values = n_values;
+  probe.ids = ids;
+  probe.values = values;
+
+  if (compute_cache == NULL)
+    compute_cache = g_hash_table_new_full (compute_cache_entry_hash,
+                                           compute_cache_entry_equal,
+                                           compute_cache_entry_free,
+                                           NULL);
+
+  entry = g_hash_table_lookup (compute_cache, &probe);
+  if (entry)
+    {
+      g_free (ids);
+      g_free (values);
+      _gtk_css_lookup_free (lookup);
+
+      return g_object_ref (GTK_CSS_STYLE (entry->style));
+    }
+
   result = g_object_new (GTK_TYPE_CSS_STATIC_STYLE, NULL);
 
   result->change = change;
 
-  _gtk_css_lookup_resolve (lookup, 
+  _gtk_css_lookup_resolve (lookup,
                            provider,
                            result,
                            parent);
 
   _gtk_css_lookup_free (lookup);
 
+  entry = g_slice_new (ComputeCacheEntry);
+  entry->hash = probe.hash;
+  entry->provider = g_object_ref (provider);
+  entry->parent = parent ? g_object_ref (parent) : NULL;
+  entry->change = change;
+  entry->n_values = n_values;
+  entry->ids = g_renew (guint, ids, n_values);
+  entry->values = g_renew (GtkCssValue *, values, n_values);
+  for (i = 0; i < n_values; i++)
+    _gtk_css_value_ref (entry->values[i]);
+  entry->style = result;
+
+  g_object_weak_ref (G_OBJECT (result), compute_cache_style_finalized, entry);
+  g_hash_table_add (compute_cache, entry);
+
   return GTK_CSS_STYLE (result);
 }
 
@@ -241,3 +393,52 @@ gtk_css_static_style_get_change (GtkCssStaticStyle *style)
 
   return style->change;
 }
+
+static gboolean
+gtk_css_static_style_compute_needs_animations (GtkCssStaticStyle *style)
+{
+  GtkCssStyle *css_style = GTK_CSS_STYLE (style);
+  GtkCssValue *names, *durations, *delays;
+  guint i, n;
+
+  names = gtk_css_style_get_value (css_style, GTK_CSS_PROPERTY_ANIMATION_NAME);
+  for (i = 0; i < _gtk_css_array_value_get_n_values (names); i++)
+    {
+      if (g_ascii_strcasecmp (_gtk_css_ident_value_get (_gtk_css_array_value_get_nth (names, i)),
+                              "none") != 0)
+        return TRUE;
+    }
+
+  /* A transition only ever starts when its duration plus delay is
+   * positive, no matter what transition-property says */
+  durations = gtk_css_style_get_value (css_style, GTK_CSS_PROPERTY_TRANSITION_DURATION);
+  delays = gtk_css_style_get_value (css_style, GTK_CSS_PROPERTY_TRANSITION_DELAY);
+  n = MAX (_gtk_css_array_value_get_n_values (durations),
+           _gtk_css_array_value_get_n_values (delays));
+  for (i = 0; i < n; i++)
+    {
+      if (_gtk_css_number_value_get (_gtk_css_array_value_get_nth (durations, i), 100)
+          + _gtk_css_number_value_get (_gtk_css_array_value_get_nth (delays, i), 100) > 0)
+        return TRUE;
+    }
+
+  return FALSE;
+}
+
+/* Returns whether creating an animated style on top of this style
+ * could ever result in running animations or transitions. Most nodes
+ * have neither, and this check lets them skip the animated style
+ * machinery completely. */
+gboolean
+gtk_css_static_style_needs_animations (GtkCssStaticStyle *style)
+{
+  g_return_val_if_fail (GTK_IS_CSS_STATIC_STYLE (style), TRUE);
+
+  if (!style->needs_animations_valid)
+    {
+      style->needs_animations = gtk_css_static_style_compute_needs_animations (style);
+      style->needs_animations_valid = TRUE;
+    }
+
+  return style->needs_animations;
+}
@@ -43,6 +43,9 @@ struct _GtkCssStaticStyle
   GPtrArray             *sections;             /* sections the values are defined in */
 
   GtkCssChange           change;               /* change as returned by value lookup */
+
+  guint                  needs_animations : 1; /* whether animated style creation can do anything */
+  guint                  needs_animations_valid : 1;
 };
 
 struct _GtkCssStaticStyleClass
@@ -65,6 +68,7 @@ void                    gtk_css_static_style_compute_value      (GtkCssStaticSty
                                                                  GtkCssSection          *section);
 
 GtkCssChange            gtk_css_static_style_get_change         (GtkCssStaticStyle      *style);
+gboolean                gtk_css_static_style_needs_animations   (GtkCssStaticStyle      *style);
 
 G_END_DECLS
 
@@ -92,3 +92,25 @@ gtk_css_transient_node_new (GtkCssNode *parent)
   return result;
 }
 
+/* Puts a parked transient node back into the state a freshly created
+ * one would have, so style contexts can recycle nodes across
+ * save/restore pairs instead of allocating a new one per save.
+ */
+GtkCssNode *
+gtk_css_transient_node_reuse (GtkCssNode *node,
+                              GtkCssNode *parent)
+{
+  gtk_internal_return_val_if_fail (GTK_IS_CSS_TRANSIENT_NODE (node), NULL);
+  gtk_internal_return_val_if_fail (GTK_IS_CSS_NODE (parent), NULL);
+  gtk_internal_return_val_if_fail (node->parent == NULL, NULL);
+
+  gtk_css_node_declaration_unref (node->decl);
+  node->decl = gtk_css_node_declaration_ref (parent->decl);
+
+  g_clear_object (&node->style);
+  node->pending_changes = 0;
+  node->style_is_invalid = TRUE;
+
+  return node;
+}
+
@@ -45,6 +45,8 @@ struct _GtkCssTransientNodeClass
 GType                   gtk_css_transient_node_get_type         (void) G_GNUC_CONST;
 
 GtkCssNode *            gtk_css_transient_node_new              (GtkCssNode     *parent);
+GtkCssNode *            gtk_css_transient_node_reuse            (GtkCssNode     *node,
+                                                                 GtkCssNode     *parent);
 
 G_END_DECLS
 
@@ -87,13 +87,27 @@ _gtk_css_value_compute (GtkCssValue             *value,
                         GtkCssStyle             *style,
                         GtkCssStyle             *parent_style)
 {
+  GtkCssValue *computed;
 
   gtk_internal_return_val_if_fail (value != NULL, NULL);
   gtk_internal_return_val_if_fail (GTK_IS_STYLE_PROVIDER_PRIVATE (provider), NULL);
   gtk_internal_return_val_if_fail (GTK_IS_CSS_STYLE (style), NULL);
   gtk_internal_return_val_if_fail (parent_style == NULL || GTK_IS_CSS_STYLE (parent_style), NULL);
 
-  return value->class->compute (value, property_id, provider, style, parent_style);
+  computed = value->class->compute (value, property_id, provider, style, parent_style);
+
+  /* Not all compute functions bother checking if they produced the
+   * value they started from. Catching that here lets the transient
+   * copy die right away and makes every style that computes this
+   * declaration share the one value owned by the rule, which also
+   * keeps the values pointer-comparable for caches. */
+  if (computed != value && _gtk_css_value_equal (computed, value))
+    {
+      _gtk_css_value_unref (computed);
+      computed = _gtk_css_value_ref (value);
+    }
+
+  return computed;
 }
 
 gboolean
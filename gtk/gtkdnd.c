@@ -129,8 +129,13 @@ struct _GtkDragSourceInfo
   guint              drop_timeout;     /* Timeout for aborting drop */
   guint              destroy_icon : 1; /* If true, destroy icon_window */
   guint              have_grab : 1;    /* Do we still have the pointer grab */
+  guint              icon_snapshotting : 1; /* Guard while rendering the
+                                             * icon snapshot */
   GtkIconHelper     *icon_helper;
   GdkCursor         *drag_cursors[6];
+
+  cairo_surface_t   *icon_snapshot;    /* Cached rendering of a widget icon */
+  gint               icon_snapshot_scale;
 };
 
 struct _GtkDragDestSite
@@ -267,6 +272,9 @@ static void gtk_drag_selection_get             (GtkWidget         *widget,
 static void gtk_drag_anim_destroy              (GtkDragAnim       *anim);
 static gboolean gtk_drag_anim_timeout          (gpointer           data);
 static void gtk_drag_remove_icon               (GtkDragSourceInfo *info);
+static gboolean gtk_drag_icon_window_draw      (GtkWidget         *widget,
+                                                cairo_t           *cr,
+                                                GtkDragSourceInfo *info);
 static void gtk_drag_source_info_destroy       (GtkDragSourceInfo *info);
 static void gtk_drag_add_update_idle           (GtkDragSourceInfo *info);
 
@@ -3018,6 +3026,52 @@ gtk_drag_update_icon (GtkDragSourceInfo *info)
     }
 }
 
+/* Draw handler for widget drag icons. The widget is rendered once
+ * into an offscreen surface (per scale factor) and further exposes
+ * caused by the icon window chasing the pointer just blit the cached
+ * snapshot instead of re-painting the whole widget tree.
+ */
+static gboolean
+gtk_drag_icon_window_draw (GtkWidget         *widget,
+                           cairo_t           *cr,
+                           GtkDragSourceInfo *info)
+{
+  gint scale;
+
+  if (info->icon_snapshotting)
+    return FALSE;
+
+  scale = gtk_widget_get_scale_factor (widget);
+
+  if (info->icon_snapshot == NULL ||
+      info->icon_snapshot_scale != scale)
+    {
+      cairo_surface_t *snapshot;
+      cairo_t *snapshot_cr;
+
+      snapshot = gdk_window_create_similar_surface (gtk_widget_get_window (widget),
+                                                    CAIRO_CONTENT_COLOR_ALPHA,
+                                                    gtk_widget_get_allocated_width (widget),
+                                                    gtk_widget_get_allocated_height (widget));
+      snapshot_cr = cairo_create (snapshot);
+      info->icon_snapshotting = TRUE;
+      gtk_widget_draw (widget, snapshot_cr);
+      info->icon_snapshotting = FALSE;
+      cairo_destroy (snapshot_cr);
+
+      if (info->icon_snapshot)
+        cairo_surface_destroy (info->icon_snapshot);
+
+      info->icon_snapshot = snapshot;
+      info->icon_snapshot_scale = scale;
+    }
+
+  cairo_set_source_surface (cr, info->icon_snapshot, 0, 0);
+  cairo_paint (cr);
+
+  return TRUE;
+}
+
 static void
 gtk_drag_set_icon_window (GdkDragContext *context,
                           GtkWidget      *widget,
@@ -3062,6 +3116,12 @@ gtk_drag_set_icon_window (GdkDragContext *context,
   if (widget && info->icon_helper)
     g_clear_object (&info->icon_helper);
 
+  /* Internally created icon windows already paint from a cached
+   * pattern; application widgets get snapshotted on first draw */
+  if (widget && !destroy_on_release)
+    g_signal_connect (widget, "draw",
+                      G_CALLBACK (gtk_drag_icon_window_draw), info);
+
   gtk_drag_update_cursor (info);
   gtk_drag_update_icon (info);
 }
@@ -3919,6 +3979,9 @@ gtk_drag_remove_icon (GtkDragSourceInfo *info)
 {
   if (info->icon_window)
     {
+      g_signal_handlers_disconnect_by_func (info->icon_window,
+                                            gtk_drag_icon_window_draw,
+                                            info);
       gtk_widget_hide (info->icon_window);
       gtk_widget_set_opacity (info->icon_window, 1.0);
       if (info->destroy_icon)
@@ -3933,6 +3996,12 @@ gtk_drag_remove_icon (GtkDragSourceInfo *info)
       g_object_unref (info->icon_window);
       info->icon_window = NULL;
     }
+
+  if (info->icon_snapshot)
+    {
+      cairo_surface_destroy (info->icon_snapshot);
+      info->icon_snapshot = NULL;
+    }
 }
 
 static void
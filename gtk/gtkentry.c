@@ -183,6 +183,7 @@ struct _GtkEntryPrivate
   gint          drag_start_x;
   gint          drag_start_y;
   gint          insert_pos;
+  gint          redraw_from;               /* first char a pending redraw must cover, -1 == none */
   gint          selection_bound;
   gint          scroll_offset;
   gint          start_x;
@@ -212,6 +213,7 @@ struct _GtkEntryPrivate
 
   guint         activates_default       : 1;
   guint         cache_includes_preedit  : 1;
+  guint         cache_needs_update      : 1;
   guint         caps_lock_warning       : 1;
   guint         caps_lock_warning_shown : 1;
   guint         change_count            : 8;
@@ -225,6 +227,8 @@ struct _GtkEntryPrivate
   guint         progress_pulse_mode     : 1;
   guint         progress_pulse_way_back : 1;
   guint         real_changed            : 1;
+  guint         recompute_is_edit       : 1;
+  guint         redraw_everything       : 1;
   guint         resolved_dir            : 4; /* PangoDirection */
   guint         select_words            : 1;
   guint         select_lines            : 1;
@@ -562,6 +566,8 @@ static void         gtk_entry_draw_cursor              (GtkEntry       *entry,
 static PangoLayout *gtk_entry_ensure_layout            (GtkEntry       *entry,
                                                         gboolean        include_preedit);
 static void         gtk_entry_reset_layout             (GtkEntry       *entry);
+static gboolean     gtk_entry_queue_edit_redraw        (GtkEntry       *entry,
+							gint            old_scroll_offset);
 static void         gtk_entry_recompute                (GtkEntry       *entry);
 static gint         gtk_entry_find_position            (GtkEntry       *entry,
 							gint            x);
@@ -2654,6 +2660,7 @@ gtk_entry_init (GtkEntry *entry)
   priv->editable = TRUE;
   priv->visible = TRUE;
   priv->dnd_position = -1;
+  priv->redraw_from = -1;
   priv->width_chars = -1;
   priv->max_width_chars = -1;
   priv->is_cell_renderer = FALSE;
@@ -2897,7 +2904,7 @@ gtk_entry_destroy (GtkWidget *widget)
 
   priv->current_pos = priv->selection_bound = 0;
   gtk_entry_reset_im_context (entry);
-  gtk_entry_reset_layout (entry);
+  g_clear_object (&priv->cached_layout);
 
   if (priv->blink_timeout)
     {
@@ -3323,8 +3330,8 @@ gtk_entry_unrealize (GtkWidget *widget)
   EntryIconInfo *icon_info;
   gint i;
 
-  gtk_entry_reset_layout (entry);
-  
+  g_clear_object (&priv->cached_layout);
+
   gtk_im_context_set_client_window (priv->im_context, NULL);
 
   clipboard = gtk_widget_get_clipboard (widget, GDK_SELECTION_PRIMARY);
@@ -3401,9 +3408,7 @@ gtk_entry_get_preferred_width (GtkWidget *widget,
   _gtk_entry_get_borders (entry, &borders);
 
   context = gtk_widget_get_pango_context (widget);
-  metrics = pango_context_get_metrics (context,
-                                       pango_context_get_font_description (context),
-                                       pango_context_get_language (context));
+  metrics = _gtk_pango_get_metrics (context);
 
   char_width = pango_font_metrics_get_approximate_char_width (metrics);
   digit_width = pango_font_metrics_get_approximate_digit_width (metrics);
@@ -3451,9 +3456,7 @@ gtk_entry_get_preferred_height_and_baseline_for_width (GtkWidget *widget,
   layout = gtk_entry_ensure_layout (entry, TRUE);
   context = gtk_widget_get_pango_context (widget);
 
-  metrics = pango_context_get_metrics (context,
-                                       pango_context_get_font_description (context),
-				       pango_context_get_language (context));
+  metrics = _gtk_pango_get_metrics (context);
 
   priv->ascent = pango_font_metrics_get_ascent (metrics);
   priv->descent = pango_font_metrics_get_descent (metrics);
@@ -5356,6 +5359,12 @@ buffer_inserted_text (GtkEntryBuffer *buffer,
   guint current_pos;
   gint selection_bound;
 
+  if (priv->redraw_from < 0)
+    priv->redraw_from = position;
+  else
+    priv->redraw_from = MIN (priv->redraw_from, (gint) position);
+  priv->recompute_is_edit = TRUE;
+
   current_pos = priv->current_pos;
   if (current_pos > position)
     current_pos += n_chars;
@@ -5405,6 +5414,12 @@ buffer_deleted_text (GtkEntryBuffer *buffer,
   gint selection_bound;
   guint current_pos;
 
+  if (priv->redraw_from < 0)
+    priv->redraw_from = position;
+  else
+    priv->redraw_from = MIN (priv->redraw_from, (gint) position);
+  priv->recompute_is_edit = TRUE;
+
   current_pos = priv->current_pos;
   if (current_pos > position)
     current_pos -= MIN (current_pos, end_pos) - position;
@@ -5441,6 +5456,12 @@ buffer_notify_text (GtkEntryBuffer *buffer,
   if (entry->priv->handling_key_event)
     gtk_entry_obscure_mouse_cursor (entry);
   gtk_entry_recompute (entry);
+
+  /* Whatever ::changed handlers do to us is not part of the edit
+   * anymore and must repaint everything it touches.
+   */
+  entry->priv->recompute_is_edit = FALSE;
+
   emit_changed (entry);
   g_object_notify_by_pspec (G_OBJECT (entry), entry_props[PROP_TEXT]);
 }
@@ -6096,11 +6117,11 @@ gtk_entry_reset_layout (GtkEntry *entry)
 {
   GtkEntryPrivate *priv = entry->priv;
 
-  if (priv->cached_layout)
-    {
-      g_object_unref (priv->cached_layout);
-      priv->cached_layout = NULL;
-    }
+  /* The layout object is kept around and refilled in place by
+   * gtk_entry_ensure_layout(), so that Pango does not have to recreate
+   * layout and attribute state from scratch on every keystroke.
+   */
+  priv->cache_needs_update = TRUE;
 }
 
 static void
@@ -6143,9 +6164,16 @@ recompute_idle_func (gpointer data)
   if (gtk_widget_has_screen (GTK_WIDGET (entry)))
     {
       GtkTextHandleMode handle_mode;
+      gint old_scroll_offset = priv->scroll_offset;
 
       gtk_entry_adjust_scroll (entry);
-      gtk_widget_queue_draw (GTK_WIDGET (entry));
+
+      if (!gtk_entry_queue_edit_redraw (entry, old_scroll_offset))
+        gtk_widget_queue_draw (GTK_WIDGET (entry));
+
+      priv->redraw_from = -1;
+      priv->redraw_everything = FALSE;
+      priv->recompute_is_edit = FALSE;
 
       update_im_cursor_location (entry);
 
@@ -6166,6 +6194,13 @@ gtk_entry_recompute (GtkEntry *entry)
 {
   GtkEntryPrivate *priv = entry->priv;
 
+  /* Anything but a plain buffer edit may change the text left of the
+   * edit point too, so it repaints the whole text area;
+   * see gtk_entry_queue_edit_redraw().
+   */
+  if (!priv->recompute_is_edit)
+    priv->redraw_everything = TRUE;
+
   gtk_entry_reset_layout (entry);
   gtk_entry_check_cursor_blink (entry);
 
@@ -6206,14 +6241,14 @@ show_placeholder_text (GtkEntry *entry)
   return FALSE;
 }
 
-static PangoLayout *
-gtk_entry_create_layout (GtkEntry *entry,
-			 gboolean  include_preedit)
+static void
+gtk_entry_fill_layout (GtkEntry    *entry,
+                       PangoLayout *layout,
+                       gboolean     include_preedit)
 {
   GtkEntryPrivate *priv = entry->priv;
   GtkWidget *widget = GTK_WIDGET (entry);
   GtkStyleContext *context;
-  PangoLayout *layout;
   PangoAttrList *tmp_attrs;
   gboolean placeholder_layout;
 
@@ -6226,9 +6261,6 @@ gtk_entry_create_layout (GtkEntry *entry,
 
   context = gtk_widget_get_style_context (widget);
 
-  layout = gtk_widget_create_pango_layout (widget, NULL);
-  pango_layout_set_single_paragraph_mode (layout, TRUE);
-
   tmp_attrs = _gtk_style_context_get_pango_attributes (context);
   tmp_attrs = _gtk_pango_attr_list_merge (tmp_attrs, priv->attrs);
   if (!tmp_attrs)
@@ -6258,7 +6290,6 @@ gtk_entry_create_layout (GtkEntry *entry,
       attr->start_index = 0;
       attr->end_index = G_MAXINT;
       pango_attr_list_insert (tmp_attrs, attr);
-      pango_layout_set_ellipsize (layout, PANGO_ELLIPSIZE_END);
     }
 
   if (preedit_length)
@@ -6310,8 +6341,13 @@ gtk_entry_create_layout (GtkEntry *entry,
 
   pango_layout_set_attributes (layout, tmp_attrs);
 
-  if (priv->tabs)
-    pango_layout_set_tabs (layout, priv->tabs);
+  /* The layout may be reused from an earlier fill; make sure state
+   * that is only set conditionally above does not leak through, and
+   * undo the width draw_text_with_color() sets for the placeholder.
+   */
+  pango_layout_set_ellipsize (layout, placeholder_layout ? PANGO_ELLIPSIZE_END : PANGO_ELLIPSIZE_NONE);
+  pango_layout_set_width (layout, -1);
+  pango_layout_set_tabs (layout, priv->tabs);
 
   g_free (preedit_string);
   g_free (display_text);
@@ -6320,6 +6356,19 @@ gtk_entry_create_layout (GtkEntry *entry,
     pango_attr_list_unref (preedit_attrs);
 
   pango_attr_list_unref (tmp_attrs);
+}
+
+static PangoLayout *
+gtk_entry_create_layout (GtkEntry *entry,
+			 gboolean  include_preedit)
+{
+  GtkWidget *widget = GTK_WIDGET (entry);
+  PangoLayout *layout;
+
+  layout = gtk_widget_create_pango_layout (widget, NULL);
+  pango_layout_set_single_paragraph_mode (layout, TRUE);
+
+  gtk_entry_fill_layout (entry, layout, include_preedit);
 
   return layout;
 }
@@ -6338,11 +6387,109 @@ gtk_entry_ensure_layout (GtkEntry *entry,
     {
       priv->cached_layout = gtk_entry_create_layout (entry, include_preedit);
       priv->cache_includes_preedit = include_preedit;
+      priv->cache_needs_update = FALSE;
+    }
+  else if (priv->cache_needs_update)
+    {
+      /* The widget's pango context may have changed behind our back
+       * (style, screen or keymap direction updates all land here), so
+       * let the layout drop everything it derived from it.
+       */
+      pango_layout_context_changed (priv->cached_layout);
+      gtk_entry_fill_layout (entry, priv->cached_layout, include_preedit);
+      priv->cache_includes_preedit = include_preedit;
+      priv->cache_needs_update = FALSE;
     }
 
   return priv->cached_layout;
 }
 
+/* Invalidates only the part of the text area that a buffer edit can
+ * have changed, instead of the whole widget.  Returns %FALSE when the
+ * edit cannot be contained that way (selection, preedit, bidi text,
+ * scrolling, ...) and the caller has to queue a full redraw.
+ */
+static gboolean
+gtk_entry_queue_edit_redraw (GtkEntry *entry,
+                             gint      old_scroll_offset)
+{
+  GtkEntryPrivate *priv = entry->priv;
+  GtkWidget *widget = GTK_WIDGET (entry);
+  GtkAllocation allocation;
+  PangoLayout *layout;
+  PangoLayoutLine *line;
+  PangoRectangle pos;
+  GSList *run;
+  const gchar *text;
+  const gchar *p;
+  gint area_x, area_y;
+  gint x, width;
+  gint n_chars;
+  gint i;
+
+  if (priv->redraw_from < 0 ||
+      priv->redraw_everything ||
+      priv->text_area == NULL ||
+      priv->scroll_offset != old_scroll_offset ||
+      priv->selection_bound != priv->current_pos ||
+      priv->preedit_length > 0 ||
+      priv->dnd_position != -1 ||
+      priv->xalign != 0.0 ||
+      priv->resolved_dir != PANGO_DIRECTION_LTR ||
+      show_placeholder_text (entry))
+    return FALSE;
+
+  layout = gtk_entry_ensure_layout (entry, TRUE);
+
+  /* Mixed-direction text reorders runs, so a change is not guaranteed
+   * to stay right of the edit point; bail out if any run is RTL.
+   */
+  line = pango_layout_get_lines_readonly (layout)->data;
+  for (run = line->runs; run; run = run->next)
+    {
+      PangoLayoutRun *line_run = run->data;
+
+      if (line_run->item->analysis.level % 2)
+        return FALSE;
+    }
+
+  text = pango_layout_get_text (layout);
+  n_chars = g_utf8_strlen (text, -1);
+  p = g_utf8_offset_to_pointer (text, MIN (priv->redraw_from, n_chars));
+
+  /* Shaping can join the edited text with what precedes it (ligatures,
+   * kerning), so start a few characters early, but never cross the
+   * previous space.
+   */
+  for (i = 0; i < 8 && p > text; i++)
+    {
+      const gchar *prev = g_utf8_prev_char (p);
+
+      if (*prev == ' ')
+        break;
+      p = prev;
+    }
+
+  pango_layout_index_to_pos (layout, p - text, &pos);
+
+  x = - priv->scroll_offset + PANGO_PIXELS (pos.x) - 2;
+  x = MAX (x, 0);
+  width = gdk_window_get_width (priv->text_area) - x;
+  if (width <= 0)
+    return TRUE;
+
+  gdk_window_get_position (priv->text_area, &area_x, &area_y);
+  gtk_widget_get_allocation (widget, &allocation);
+
+  gtk_widget_queue_draw_area (widget,
+                              area_x - allocation.x + x,
+                              area_y - allocation.y,
+                              width,
+                              gdk_window_get_height (priv->text_area));
+
+  return TRUE;
+}
+
 static void
 get_layout_position (GtkEntry *entry,
                      gint     *x,
@@ -7051,9 +7198,7 @@ gtk_entry_move_adjustments (GtkEntry *entry)
   /* Approximate width of a char, so user can see what is ahead/behind */
   context = gtk_widget_get_pango_context (widget);
 
-  metrics = pango_context_get_metrics (context,
-                                       pango_context_get_font_description (context),
-				       pango_context_get_language (context));
+  metrics = _gtk_pango_get_metrics (context);
   char_width = pango_font_metrics_get_approximate_char_width (metrics) / PANGO_SCALE;
 
   /* Scroll it */
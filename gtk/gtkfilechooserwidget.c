@@ -330,6 +330,14 @@ struct _GtkFileChooserWidgetPrivate {
   gulong settings_signal_id;
   int icon_size;
 
+  /* shared blank surface handed out while the real icons are being
+   * resolved from the idle queue below
+   */
+  cairo_surface_t *icon_placeholder;
+  GList *icon_resolve_queue;
+  guint icon_resolve_idle;
+  guint icon_serial;
+
   GSource *focus_entry_idle;
 
   gulong toplevel_set_focus_id;
@@ -358,6 +366,11 @@ struct _GtkFileChooserWidgetPrivate {
 
 #define MAX_LOADING_TIME 500
 
+/* Keep full file metadata for at most this many rows; the rest is
+ * re-fetched on demand. Bounds memory use in huge directories.
+ */
+#define BROWSE_FILES_HYDRATION_LIMIT 10000
+
 #define DEFAULT_NEW_FOLDER_NAME _("Type name of new folder")
 
 /* Signal IDs */
@@ -503,6 +516,14 @@ static void           gtk_file_chooser_widget_initial_focus          (GtkFileCho
 
 static void add_selection_to_recent_list (GtkFileChooserWidget *impl);
 
+typedef struct
+{
+  GtkFileSystemModel *model;
+  GFile *file;
+} IconResolveData;
+
+static void icon_resolve_data_free (IconResolveData *data);
+
 static void location_popup_handler  (GtkFileChooserWidget *impl,
                                      const gchar           *path);
 static void location_popup_on_paste_handler (GtkFileChooserWidget *impl);
@@ -3576,6 +3597,17 @@ gtk_file_chooser_widget_dispose (GObject *object)
 
   cancel_all_operations (impl);
 
+  if (priv->icon_resolve_idle != 0)
+    {
+      g_source_remove (priv->icon_resolve_idle);
+      priv->icon_resolve_idle = 0;
+    }
+
+  g_list_free_full (priv->icon_resolve_queue, (GDestroyNotify) icon_resolve_data_free);
+  priv->icon_resolve_queue = NULL;
+
+  g_clear_pointer (&priv->icon_placeholder, cairo_surface_destroy);
+
   if (priv->rename_file_popover)
     gtk_popover_set_relative_to (GTK_POPOVER (priv->rename_file_popover), NULL);
 
@@ -3687,6 +3719,9 @@ change_icon_theme (GtkFileChooserWidget *impl)
   /* the first cell in the first column is the icon column, and we have a fixed size there */
   set_icon_cell_renderer_fixed_size (impl);
 
+  g_clear_pointer (&priv->icon_placeholder, cairo_surface_destroy);
+  priv->icon_serial += 1;
+
   clear_model_cache (impl, MODEL_COL_SURFACE);
   gtk_widget_queue_resize (priv->browse_files_tree_view);
 
@@ -4841,6 +4876,156 @@ file_system_model_got_thumbnail (GObject      *object,
   gdk_threads_leave ();
 }
 
+/* checks whether the row for the file is inside the range of rows the
+ * list is currently displaying; icon work for the other rows can be
+ * deferred
+ */
+static gboolean
+file_is_visible_in_list (GtkFileChooserWidget *impl,
+                         GtkFileSystemModel   *model,
+                         GFile                *file)
+{
+  GtkFileChooserWidgetPrivate *priv = impl->priv;
+  GtkTreePath *start, *end;
+  GtkTreeIter iter;
+  gboolean visible;
+
+  if (!_gtk_file_system_model_get_iter_for_file (model, &iter, file))
+    return FALSE;
+
+  if (gtk_tree_view_get_visible_range (GTK_TREE_VIEW (priv->browse_files_tree_view), &start, &end))
+    {
+      GtkTreePath *path;
+
+      gtk_tree_path_prev (start);
+      gtk_tree_path_next (end);
+      path = gtk_tree_model_get_path (GTK_TREE_MODEL (model), &iter);
+      visible = gtk_tree_path_compare (start, path) != 1 &&
+                gtk_tree_path_compare (path, end) != 1;
+      gtk_tree_path_free (path);
+      gtk_tree_path_free (start);
+      gtk_tree_path_free (end);
+    }
+  else
+    visible = TRUE;
+
+  return visible;
+}
+
+static cairo_surface_t *
+get_icon_placeholder (GtkFileChooserWidget *impl)
+{
+  GtkFileChooserWidgetPrivate *priv = impl->priv;
+
+  if (priv->icon_placeholder == NULL)
+    {
+      gint scale = gtk_widget_get_scale_factor (GTK_WIDGET (impl));
+
+      priv->icon_placeholder =
+        cairo_image_surface_create (CAIRO_FORMAT_ARGB32,
+                                    priv->icon_size * scale,
+                                    priv->icon_size * scale);
+      cairo_surface_set_device_scale (priv->icon_placeholder, scale, scale);
+    }
+
+  return priv->icon_placeholder;
+}
+
+static void
+icon_resolve_data_free (IconResolveData *data)
+{
+  g_object_unref (data->model);
+  g_object_unref (data->file);
+  g_slice_free (IconResolveData, data);
+}
+
+static gboolean
+icon_resolve_idle_cb (gpointer data)
+{
+  GtkFileChooserWidget *impl = data;
+  GtkFileChooserWidgetPrivate *priv = impl->priv;
+  GtkTreeModel *tree_model = NULL;
+  IconResolveData *icon_data;
+  GtkTreeIter iter;
+  GList *l = NULL;
+
+  if (priv->browse_files_tree_view != NULL)
+    tree_model = gtk_tree_view_get_model (GTK_TREE_VIEW (priv->browse_files_tree_view));
+
+  /* resolve the rows the user is looking at first */
+  if (tree_model != NULL)
+    {
+      for (l = priv->icon_resolve_queue; l != NULL; l = l->next)
+        {
+          icon_data = l->data;
+
+          if (GTK_TREE_MODEL (icon_data->model) == tree_model &&
+              file_is_visible_in_list (impl, icon_data->model, icon_data->file))
+            break;
+        }
+    }
+
+  /* otherwise, oldest request first */
+  if (l == NULL)
+    l = g_list_last (priv->icon_resolve_queue);
+
+  icon_data = l->data;
+  priv->icon_resolve_queue = g_list_delete_link (priv->icon_resolve_queue, l);
+
+  /* requests for a model the view no longer displays are dropped */
+  if (GTK_TREE_MODEL (icon_data->model) == tree_model &&
+      _gtk_file_system_model_get_iter_for_file (icon_data->model, &iter, icon_data->file))
+    {
+      GFileInfo *info;
+      cairo_surface_t *surface;
+
+      info = _gtk_file_system_model_get_info (icon_data->model, &iter);
+      surface = _gtk_file_info_render_icon (info, GTK_WIDGET (impl), priv->icon_size);
+      if (surface != NULL)
+        {
+          g_object_set_data_full (G_OBJECT (info), "filechooser::icon-surface",
+                                  surface,
+                                  (GDestroyNotify) cairo_surface_destroy);
+          g_object_set_data (G_OBJECT (info), "filechooser::icon-serial",
+                             GUINT_TO_POINTER (priv->icon_serial));
+        }
+
+      /* invalidates the cached cell values and redraws the row */
+      _gtk_file_system_model_update_file (icon_data->model, icon_data->file, info);
+    }
+
+  icon_resolve_data_free (icon_data);
+
+  if (priv->icon_resolve_queue == NULL)
+    {
+      priv->icon_resolve_idle = 0;
+      return FALSE;
+    }
+
+  return TRUE;
+}
+
+static void
+queue_icon_resolve (GtkFileChooserWidget *impl,
+                    GtkFileSystemModel   *model,
+                    GFile                *file)
+{
+  GtkFileChooserWidgetPrivate *priv = impl->priv;
+  IconResolveData *data;
+
+  data = g_slice_new (IconResolveData);
+  data->model = g_object_ref (model);
+  data->file = g_object_ref (file);
+
+  priv->icon_resolve_queue = g_list_prepend (priv->icon_resolve_queue, data);
+
+  if (priv->icon_resolve_idle == 0)
+    {
+      priv->icon_resolve_idle = gdk_threads_add_idle (icon_resolve_idle_cb, impl);
+      g_source_set_name_by_id (priv->icon_resolve_idle, "[gtk+] icon_resolve_idle_cb");
+    }
+}
+
 static gboolean
 file_system_model_set (GtkFileSystemModel *model,
                        GFile              *file,
@@ -4905,14 +5090,37 @@ file_system_model_set (GtkFileSystemModel *model,
         {
           if (g_file_info_has_attribute (info, G_FILE_ATTRIBUTE_STANDARD_ICON))
             {
-              g_value_take_boxed (value, _gtk_file_info_render_icon (info, GTK_WIDGET (impl), priv->icon_size));
+              cairo_surface_t *surface;
+
+              surface = g_object_get_data (G_OBJECT (info), "filechooser::icon-surface");
+              if (surface != NULL &&
+                  GPOINTER_TO_UINT (g_object_get_data (G_OBJECT (info), "filechooser::icon-serial")) == priv->icon_serial)
+                g_value_set_boxed (value, surface);
+              else
+                {
+                  guint queued_serial;
+
+                  /* the row shows up with the shared placeholder right
+                   * away; the icon lookup happens from the idle queue
+                   * and redraws the row once it is done. the serial is
+                   * bumped when the icon theme changes, which voids
+                   * both resolved and queued icons.
+                   */
+                  queued_serial =
+                    GPOINTER_TO_UINT (g_object_get_data (G_OBJECT (info), "filechooser::icon-queued"));
+                  if (queued_serial != priv->icon_serial)
+                    {
+                      g_object_set_data (G_OBJECT (info), "filechooser::icon-queued",
+                                         GUINT_TO_POINTER (priv->icon_serial));
+                      queue_icon_resolve (impl, model, file);
+                    }
+
+                  g_value_set_boxed (value, get_icon_placeholder (impl));
+                }
             }
           else
             {
               GtkTreeModel *tree_model;
-              GtkTreePath *start, *end;
-              GtkTreeIter iter;
-              gboolean visible;
 
               if (priv->browse_files_tree_view == NULL ||
                   g_file_info_has_attribute (info, "filechooser::queried"))
@@ -4922,25 +5130,7 @@ file_system_model_set (GtkFileSystemModel *model,
               if (tree_model != GTK_TREE_MODEL (model))
                 return FALSE;
 
-              if (!_gtk_file_system_model_get_iter_for_file (model, &iter, file))
-                g_assert_not_reached ();
-
-              if (gtk_tree_view_get_visible_range (GTK_TREE_VIEW (priv->browse_files_tree_view), &start, &end))
-                {
-                  GtkTreePath *path;
-
-                  gtk_tree_path_prev (start);
-                  gtk_tree_path_next (end);
-                  path = gtk_tree_model_get_path (tree_model, &iter);
-                  visible = gtk_tree_path_compare (start, path) != 1 &&
-                            gtk_tree_path_compare (path, end) != 1;
-                  gtk_tree_path_free (path);
-                  gtk_tree_path_free (start);
-                  gtk_tree_path_free (end);
-                }
-              else
-                visible = TRUE;
-              if (visible)
+              if (file_is_visible_in_list (impl, model, file))
                 {
                   g_file_info_set_attribute_boolean (info, "filechooser::queried", TRUE);
                   g_file_query_info_async (file,
@@ -5075,6 +5265,8 @@ set_list_model (GtkFileChooserWidget  *impl,
                                               impl,
                                               MODEL_COLUMN_TYPES);
 
+  _gtk_file_system_model_set_hydration_limit (priv->browse_files_model,
+                                              BROWSE_FILES_HYDRATION_LIMIT);
   _gtk_file_system_model_set_show_hidden (priv->browse_files_model, priv->show_hidden);
 
   profile_msg ("    set sort function", NULL);
@@ -8556,6 +8748,7 @@ gtk_file_chooser_widget_init (GtkFileChooserWidget *impl)
   priv->show_hidden = FALSE;
   priv->show_size_column = TRUE;
   priv->icon_size = FALLBACK_ICON_SIZE;
+  priv->icon_serial = 1;
   priv->load_state = LOAD_EMPTY;
   priv->reload_state = RELOAD_EMPTY;
   priv->pending_select_files = NULL;
@@ -134,6 +134,7 @@ struct _FileModelNode
 {
   GFile *               file;           /* file represented by this node or NULL for editable */
   GFileInfo *           info;           /* info for this file or NULL if unknown */
+  GList *               hydrated_link;  /* this node's link in the model's hydrated queue, or NULL */
 
   guint                 row;            /* if valid (see model->n_valid_indexes), visible nodes before and including
 					 * this one - see the "Structure" comment above.
@@ -142,6 +143,8 @@ struct _FileModelNode
   guint                 visible :1;     /* if the file is currently visible */
   guint                 filtered_out :1;/* if the file is currently filtered out (i.e. it didn't pass the filters) */
   guint                 frozen_add :1;  /* true if the model was frozen and the entry has not been added yet */
+  guint                 from_cache :1;  /* true if the info came from the metadata cache and was not revalidated yet */
+  guint                 dehydrated :1;  /* true if the info was slimmed down to the inline attributes */
 
   GValue                values[1];      /* actually n_columns values */
 };
@@ -180,11 +183,17 @@ struct _GtkFileSystemModel
   gpointer              default_sort_data; /* data to pass to default sort func */
   GDestroyNotify        default_sort_destroy; /* function to call to destroy default_sort_data */
 
+  guint                 hydration_limit;/* max number of nodes with a full info, or 0 for no limit */
+  GQueue                hydrated;       /* queue of GFiles of fully hydrated nodes, most recent first */
+
   guint                 frozen;         /* number of times we're frozen */
+  guint                 first_frozen_add;/* lowest index of a node added while frozen, or G_MAXUINT */
+  guint                 sorted_len;     /* nodes [0, sorted_len) are known to be in sorted order */
 
   gboolean              filter_on_thaw :1;/* set when filtering needs to happen upon thawing */
   gboolean              sort_on_thaw :1;/* set when sorting needs to happen upon thawing */
 
+  guint                 populated_from_cache :1;/* whether nodes were preloaded from the metadata cache */
   guint                 show_hidden :1; /* whether to show hidden files */
   guint                 show_folders :1;/* whether to show folders */
   guint                 show_files :1;  /* whether to show files */
@@ -207,12 +216,16 @@ struct _GtkFileSystemModelClass
 static void freeze_updates (GtkFileSystemModel *model);
 static void thaw_updates (GtkFileSystemModel *model);
 
+static void node_lru_enroll (GtkFileSystemModel *model,
+                             guint               id);
 static guint node_get_for_file (GtkFileSystemModel *model,
 				GFile              *file);
 
 static void add_file (GtkFileSystemModel *model,
 		      GFile              *file,
 		      GFileInfo          *info);
+static void add_files (GtkFileSystemModel *model,
+		       GList              *files);
 static void remove_file (GtkFileSystemModel *model,
 			 GFile              *file);
 
@@ -766,6 +779,58 @@ compare_array_element (gconstpointer a, gconstpointer b, gpointer user_data)
   return data->func (GTK_TREE_MODEL (data->model), &itera, &iterb, data->data) * data->order;
 }
 
+/* Sorts the unsorted tail of the files array and merges it into the
+ * sorted prefix. Compared to resorting the whole array this only costs
+ * O(tail log tail + n) when a batch of files is appended, which is what
+ * happens during enumeration of a large directory.
+ */
+static void
+gtk_file_system_model_sort_merge_tail (GtkFileSystemModel *model,
+                                       SortData           *data)
+{
+  guint n_nodes = model->files->len - 1; /* without the editable row */
+  guint *merged;
+  guchar *tmp;
+  guint i, j, k;
+
+  g_qsort_with_data (get_node (model, model->sorted_len),
+                     model->files->len - model->sorted_len,
+                     model->node_size,
+                     compare_array_element,
+                     data);
+
+  /* Merge the two sorted runs into a permutation of node indexes.
+   * compare_array_element() maps its arguments back to array indexes,
+   * so the comparisons have to happen on the nodes in place; the nodes
+   * are only moved once the full order is known.
+   */
+  merged = g_new (guint, n_nodes);
+  i = 1;
+  j = model->sorted_len;
+  k = 0;
+  while (i < model->sorted_len && j < model->files->len)
+    {
+      if (compare_array_element (get_node (model, i),
+                                 get_node (model, j),
+                                 data) <= 0)
+        merged[k++] = i++;
+      else
+        merged[k++] = j++;
+    }
+  while (i < model->sorted_len)
+    merged[k++] = i++;
+  while (j < model->files->len)
+    merged[k++] = j++;
+
+  tmp = g_malloc (n_nodes * model->node_size);
+  for (k = 0; k < n_nodes; k++)
+    memcpy (tmp + k * model->node_size, get_node (model, merged[k]), model->node_size);
+  memcpy (get_node (model, 1), tmp, n_nodes * model->node_size);
+
+  g_free (tmp);
+  g_free (merged);
+}
+
 static void
 gtk_file_system_model_sort (GtkFileSystemModel *model)
 {
@@ -787,11 +852,15 @@ gtk_file_system_model_sort (GtkFileSystemModel *model)
       n_visible_rows = node_get_tree_row (model, model->files->len - 1) + 1;
       model->n_nodes_valid = 0;
       g_hash_table_remove_all (model->file_lookup);
-      g_qsort_with_data (get_node (model, 1), /* start at index 1; don't sort the editable row */
-                         model->files->len - 1,
-                         model->node_size,
-                         compare_array_element,
-                         &data);
+      if (model->sorted_len > 1 && model->sorted_len < model->files->len)
+        gtk_file_system_model_sort_merge_tail (model, &data);
+      else
+        g_qsort_with_data (get_node (model, 1), /* start at index 1; don't sort the editable row */
+                           model->files->len - 1,
+                           model->node_size,
+                           compare_array_element,
+                           &data);
+      model->sorted_len = model->files->len;
       g_assert (model->n_nodes_valid == 0);
       g_assert (g_hash_table_size (model->file_lookup) == 0);
       if (n_visible_rows)
@@ -829,7 +898,11 @@ gtk_file_system_model_sort (GtkFileSystemModel *model)
 static void
 gtk_file_system_model_sort_node (GtkFileSystemModel *model, guint node)
 {
-  /* FIXME: improve */
+  /* Everything from @node on is treated as the unsorted tail and
+   * merged back in; a full resort only happens when the sort keys
+   * themselves change.
+   */
+  model->sorted_len = MIN (model->sorted_len, node);
   gtk_file_system_model_sort (model);
 }
 
@@ -888,6 +961,7 @@ gtk_file_system_model_set_sort_column_id (GtkTreeSortable  *sortable,
 
   gtk_tree_sortable_sort_column_changed (sortable);
 
+  model->sorted_len = 0;
   gtk_file_system_model_sort (model);
 }
 
@@ -905,7 +979,10 @@ gtk_file_system_model_set_sort_func (GtkTreeSortable        *sortable,
                                                      func, data, destroy);
 
   if (model->sort_column_id == sort_column_id)
-    gtk_file_system_model_sort (model);
+    {
+      model->sorted_len = 0;
+      gtk_file_system_model_sort (model);
+    }
 }
 
 static void
@@ -929,7 +1006,10 @@ gtk_file_system_model_set_default_sort_func (GtkTreeSortable        *sortable,
   model->default_sort_destroy = destroy;
 
   if (model->sort_column_id == GTK_TREE_SORTABLE_DEFAULT_SORT_COLUMN_ID)
-    gtk_file_system_model_sort (model);
+    {
+      model->sorted_len = 0;
+      gtk_file_system_model_sort (model);
+    }
 }
 
 static gboolean
@@ -1059,6 +1139,13 @@ gtk_file_system_model_finalize (GObject *object)
     }
   g_array_free (model->files, TRUE);
 
+  {
+    GFile *file;
+
+    while ((file = g_queue_pop_head (&model->hydrated)) != NULL)
+      g_object_unref (file);
+  }
+
   g_object_unref (model->cancellable);
   g_free (model->attributes);
   if (model->dir)
@@ -1106,8 +1193,382 @@ _gtk_file_system_model_init (GtkFileSystemModel *model)
 
   model->sort_column_id = GTK_TREE_SORTABLE_UNSORTED_SORT_COLUMN_ID;
 
+  model->first_frozen_add = G_MAXUINT;
+
   model->file_lookup = g_hash_table_new (g_file_hash, (GEqualFunc) g_file_equal);
   model->cancellable = g_cancellable_new ();
+  g_queue_init (&model->hydrated);
+}
+
+/*** Directory metadata cache ***/
+
+/* To make revisiting large directories fast, the file infos gathered by
+ * enumerating a native directory are serialized to a per-directory file
+ * under the user cache dir, keyed by the directory's mtime. When a model
+ * is created for a directory with a matching cache entry, its rows are
+ * populated from the cache immediately and the normal enumeration then
+ * revalidates them in the background, only emitting change notification
+ * for rows whose metadata actually differs.
+ */
+
+#define METADATA_CACHE_FORMAT_VERSION 1
+#define METADATA_CACHE_ENTRY_TYPE "(aysutttsbbbbbs)"
+#define METADATA_CACHE_TYPE "(usxa" METADATA_CACHE_ENTRY_TYPE ")"
+
+static char *
+metadata_cache_get_path (GtkFileSystemModel *model)
+{
+  char *uri, *checksum, *path;
+
+  uri = g_file_get_uri (model->dir);
+  checksum = g_compute_checksum_for_string (G_CHECKSUM_MD5, uri, -1);
+  path = g_build_filename (g_get_user_cache_dir (), "gtk-3.0",
+                           "directory-metadata", checksum, NULL);
+  g_free (checksum);
+  g_free (uri);
+
+  return path;
+}
+
+static gboolean
+metadata_cache_get_dir_mtime (GtkFileSystemModel *model, gint64 *mtime)
+{
+  GFileInfo *info;
+
+  info = g_file_query_info (model->dir,
+                            G_FILE_ATTRIBUTE_TIME_MODIFIED,
+                            G_FILE_QUERY_INFO_NONE,
+                            NULL, NULL);
+  if (info == NULL)
+    return FALSE;
+
+  if (!g_file_info_has_attribute (info, G_FILE_ATTRIBUTE_TIME_MODIFIED))
+    {
+      g_object_unref (info);
+      return FALSE;
+    }
+
+  *mtime = (gint64) g_file_info_get_attribute_uint64 (info, G_FILE_ATTRIBUTE_TIME_MODIFIED);
+  g_object_unref (info);
+
+  return TRUE;
+}
+
+static GVariant *
+metadata_cache_serialize_info (GFileInfo *info)
+{
+  const char *display_name, *content_type, *target_uri;
+
+  display_name = g_file_info_get_display_name (info);
+  content_type = g_file_info_get_content_type (info);
+  target_uri = g_file_info_get_attribute_string (info, G_FILE_ATTRIBUTE_STANDARD_TARGET_URI);
+
+  return g_variant_new ("(^aysutttsbbbbbs)",
+                        g_file_info_get_name (info),
+                        display_name ? display_name : "",
+                        (guint32) g_file_info_get_file_type (info),
+                        (guint64) g_file_info_get_size (info),
+                        g_file_info_get_attribute_uint64 (info, G_FILE_ATTRIBUTE_TIME_MODIFIED),
+                        g_file_info_get_attribute_uint64 (info, G_FILE_ATTRIBUTE_TIME_ACCESS),
+                        content_type ? content_type : "",
+                        g_file_info_get_is_hidden (info),
+                        g_file_info_get_attribute_boolean (info, G_FILE_ATTRIBUTE_STANDARD_IS_BACKUP),
+                        g_file_info_get_attribute_boolean (info, G_FILE_ATTRIBUTE_ACCESS_CAN_RENAME),
+                        g_file_info_get_attribute_boolean (info, G_FILE_ATTRIBUTE_ACCESS_CAN_DELETE),
+                        g_file_info_get_attribute_boolean (info, G_FILE_ATTRIBUTE_ACCESS_CAN_TRASH),
+                        target_uri ? target_uri : "");
+}
+
+static GFileInfo *
+metadata_cache_deserialize_info (const char *name,
+                                 const char *display_name,
+                                 guint32     type,
+                                 guint64     size,
+                                 guint64     mtime,
+                                 guint64     atime,
+                                 const char *content_type,
+                                 gboolean    is_hidden,
+                                 gboolean    is_backup,
+                                 gboolean    can_rename,
+                                 gboolean    can_delete,
+                                 gboolean    can_trash,
+                                 const char *target_uri)
+{
+  GFileInfo *info;
+
+  info = g_file_info_new ();
+  g_file_info_set_name (info, name);
+  if (display_name[0])
+    g_file_info_set_display_name (info, display_name);
+  g_file_info_set_file_type (info, type);
+  g_file_info_set_size (info, size);
+  g_file_info_set_attribute_uint64 (info, G_FILE_ATTRIBUTE_TIME_MODIFIED, mtime);
+  g_file_info_set_attribute_uint64 (info, G_FILE_ATTRIBUTE_TIME_ACCESS, atime);
+  if (content_type[0])
+    {
+      GIcon *icon;
+
+      g_file_info_set_content_type (info, content_type);
+      icon = g_content_type_get_icon (content_type);
+      g_file_info_set_icon (info, icon);
+      g_object_unref (icon);
+    }
+  g_file_info_set_is_hidden (info, is_hidden);
+  g_file_info_set_attribute_boolean (info, G_FILE_ATTRIBUTE_STANDARD_IS_BACKUP, is_backup);
+  g_file_info_set_attribute_boolean (info, G_FILE_ATTRIBUTE_ACCESS_CAN_RENAME, can_rename);
+  g_file_info_set_attribute_boolean (info, G_FILE_ATTRIBUTE_ACCESS_CAN_DELETE, can_delete);
+  g_file_info_set_attribute_boolean (info, G_FILE_ATTRIBUTE_ACCESS_CAN_TRASH, can_trash);
+  if (target_uri[0])
+    g_file_info_set_attribute_string (info, G_FILE_ATTRIBUTE_STANDARD_TARGET_URI, target_uri);
+
+  return info;
+}
+
+static void
+gtk_file_system_model_load_metadata_cache (GtkFileSystemModel *model)
+{
+  char *path, *dir_uri, *name;
+  const char *cached_uri, *display_name, *content_type, *target_uri;
+  GMappedFile *mapped;
+  GVariant *variant;
+  GVariantIter *entries;
+  guint32 version, type;
+  guint64 size, mtime, atime;
+  gboolean is_hidden, is_backup, can_rename, can_delete, can_trash;
+  gint64 cached_mtime, dir_mtime;
+  GList *infos = NULL, *walk;
+  guint i;
+
+  if (!g_file_is_native (model->dir))
+    return;
+
+  if (!metadata_cache_get_dir_mtime (model, &dir_mtime))
+    return;
+
+  path = metadata_cache_get_path (model);
+  mapped = g_mapped_file_new (path, FALSE, NULL);
+  g_free (path);
+  if (mapped == NULL)
+    return;
+
+  variant = g_variant_new_from_data (G_VARIANT_TYPE (METADATA_CACHE_TYPE),
+                                     g_mapped_file_get_contents (mapped),
+                                     g_mapped_file_get_length (mapped),
+                                     FALSE,
+                                     (GDestroyNotify) g_mapped_file_unref,
+                                     mapped);
+  if (variant == NULL)
+    {
+      g_mapped_file_unref (mapped);
+      return;
+    }
+  g_variant_ref_sink (variant);
+
+  dir_uri = g_file_get_uri (model->dir);
+  g_variant_get (variant, "(u&sxa" METADATA_CACHE_ENTRY_TYPE ")",
+                 &version, &cached_uri, &cached_mtime, &entries);
+
+  if (version != METADATA_CACHE_FORMAT_VERSION ||
+      strcmp (cached_uri, dir_uri) != 0 ||
+      cached_mtime != dir_mtime)
+    {
+      g_variant_iter_free (entries);
+      g_variant_unref (variant);
+      g_free (dir_uri);
+      return;
+    }
+
+  while (g_variant_iter_loop (entries, "(^ay&suttt&sbbbbb&s)",
+                              &name, &display_name, &type, &size, &mtime, &atime,
+                              &content_type, &is_hidden, &is_backup,
+                              &can_rename, &can_delete, &can_trash, &target_uri))
+    {
+      infos = g_list_prepend (infos,
+                              metadata_cache_deserialize_info (name, display_name, type,
+                                                               size, mtime, atime,
+                                                               content_type, is_hidden, is_backup,
+                                                               can_rename, can_delete, can_trash,
+                                                               target_uri));
+    }
+  infos = g_list_reverse (infos);
+
+  g_variant_iter_free (entries);
+  g_variant_unref (variant);
+  g_free (dir_uri);
+
+  if (infos == NULL)
+    return;
+
+  add_files (model, infos);
+
+  for (i = 1; i < model->files->len; i++)
+    get_node (model, i)->from_cache = TRUE;
+  model->populated_from_cache = TRUE;
+
+  for (walk = infos; walk; walk = walk->next)
+    g_object_unref (walk->data);
+  g_list_free (infos);
+}
+
+static void
+gtk_file_system_model_save_metadata_cache (GtkFileSystemModel *model)
+{
+  GVariantBuilder builder;
+  GVariant *variant;
+  char *path, *cache_dir, *uri;
+  gint64 dir_mtime;
+  guint i;
+
+  if (!g_file_is_native (model->dir))
+    return;
+
+  if (!metadata_cache_get_dir_mtime (model, &dir_mtime))
+    return;
+
+  g_variant_builder_init (&builder, G_VARIANT_TYPE ("a" METADATA_CACHE_ENTRY_TYPE));
+  for (i = 1; i < model->files->len; i++)
+    {
+      FileModelNode *node = get_node (model, i);
+
+      /* dehydrated nodes lost attributes we would serialize as bogus
+       * defaults; leaving them out just makes the next load treat them
+       * as new files
+       */
+      if (node->info == NULL || node->dehydrated ||
+          g_file_info_get_name (node->info) == NULL)
+        continue;
+
+      g_variant_builder_add_value (&builder, metadata_cache_serialize_info (node->info));
+    }
+
+  uri = g_file_get_uri (model->dir);
+  variant = g_variant_new ("(usx@a" METADATA_CACHE_ENTRY_TYPE ")",
+                           (guint32) METADATA_CACHE_FORMAT_VERSION,
+                           uri,
+                           dir_mtime,
+                           g_variant_builder_end (&builder));
+  g_variant_ref_sink (variant);
+  g_free (uri);
+
+  path = metadata_cache_get_path (model);
+  cache_dir = g_path_get_dirname (path);
+  if (g_mkdir_with_parents (cache_dir, 0700) == 0)
+    g_file_set_contents (path, g_variant_get_data (variant), g_variant_get_size (variant), NULL);
+  g_free (cache_dir);
+  g_free (path);
+  g_variant_unref (variant);
+}
+
+static gboolean
+metadata_cache_info_differs (GFileInfo *cached, GFileInfo *fresh)
+{
+  if (cached == NULL)
+    return TRUE;
+
+  return g_file_info_get_file_type (cached) != g_file_info_get_file_type (fresh) ||
+         g_file_info_get_size (cached) != g_file_info_get_size (fresh) ||
+         g_file_info_get_attribute_uint64 (cached, G_FILE_ATTRIBUTE_TIME_MODIFIED) !=
+         g_file_info_get_attribute_uint64 (fresh, G_FILE_ATTRIBUTE_TIME_MODIFIED) ||
+         g_strcmp0 (g_file_info_get_display_name (cached),
+                    g_file_info_get_display_name (fresh)) != 0;
+}
+
+/* Matches one enumeration batch against the rows preloaded from the
+ * metadata cache. Unchanged rows just get the fresh info swapped in
+ * silently; rows whose metadata differs are updated and resorted, and
+ * files missing from the cache are added.
+ */
+static void
+gtk_file_system_model_revalidate_files (GtkFileSystemModel *model, GList *files)
+{
+  GList *walk, *new_files = NULL;
+  gboolean changed_any = FALSE;
+
+  for (walk = files; walk; walk = walk->next)
+    {
+      GFileInfo *info = walk->data;
+      const char *name;
+      GFile *file;
+      guint id;
+
+      name = g_file_info_get_name (info);
+      if (name == NULL)
+        continue;
+
+      file = g_file_get_child (model->dir, name);
+      id = node_get_for_file (model, file);
+      g_object_unref (file);
+
+      if (id != 0)
+        {
+          FileModelNode *node = get_node (model, id);
+          gboolean changed;
+
+          changed = node->from_cache && metadata_cache_info_differs (node->info, info);
+          node->from_cache = FALSE;
+
+          if (node->info)
+            g_object_unref (node->info);
+          node->info = g_object_ref (info);
+
+          if (changed)
+            {
+              guint j;
+
+              for (j = 0; j < model->n_columns; j++)
+                {
+                  if (G_VALUE_TYPE (&node->values[j]))
+                    g_value_unset (&node->values[j]);
+                }
+              if (node->visible)
+                emit_row_changed_for_node (model, id);
+              changed_any = TRUE;
+            }
+        }
+      else
+        new_files = g_list_prepend (new_files, info);
+    }
+
+  if (changed_any)
+    {
+      model->sorted_len = 0;
+      gtk_file_system_model_sort (model);
+    }
+
+  if (new_files)
+    {
+      new_files = g_list_reverse (new_files);
+      add_files (model, new_files);
+      g_list_free (new_files);
+    }
+}
+
+/* Removes rows that were preloaded from the metadata cache but never
+ * seen during the revalidating enumeration, i.e. files that vanished
+ * while the cache entry was stale.
+ */
+static void
+gtk_file_system_model_finish_revalidation (GtkFileSystemModel *model)
+{
+  guint i;
+
+  if (!model->populated_from_cache)
+    return;
+
+  model->populated_from_cache = FALSE;
+
+  for (i = model->files->len - 1; i >= 1; i--)
+    {
+      FileModelNode *node = get_node (model, i);
+
+      if (node->from_cache)
+        {
+          GFile *file = g_object_ref (node->file);
+
+          remove_file (model, file);
+          g_object_unref (file);
+        }
+    }
 }
 
 /*** API ***/
@@ -1154,25 +1615,13 @@ gtk_file_system_model_got_files (GObject *object, GAsyncResult *res, gpointer da
           g_source_set_name_by_id (model->dir_thaw_source, "[gtk+] thaw_func");
         }
 
+      if (model->populated_from_cache)
+        gtk_file_system_model_revalidate_files (model, files);
+      else
+        add_files (model, files);
+
       for (walk = files; walk; walk = walk->next)
-        {
-          const char *name;
-          GFileInfo *info;
-          GFile *file;
-          
-          info = walk->data;
-          name = g_file_info_get_name (info);
-          if (name == NULL)
-            {
-              /* Shouldn't happen, but the APIs allow it */
-              g_object_unref (info);
-              continue;
-            }
-          file = g_file_get_child (model->dir, name);
-          add_file (model, file, info);
-          g_object_unref (file);
-          g_object_unref (info);
-        }
+        g_object_unref (walk->data);
       g_list_free (files);
 
       g_file_enumerator_next_files_async (enumerator,
@@ -1198,6 +1647,12 @@ gtk_file_system_model_got_files (GObject *object, GAsyncResult *res, gpointer da
               thaw_updates (model);
             }
 
+          if (error == NULL)
+            {
+              gtk_file_system_model_finish_revalidation (model);
+              gtk_file_system_model_save_metadata_cache (model);
+            }
+
           g_signal_emit (model, file_system_model_signals[FINISHED_LOADING], 0, error);
         }
 
@@ -1344,6 +1799,7 @@ gtk_file_system_model_set_n_columns (GtkFileSystemModel *model,
   /* add editable node at start */
   g_array_set_size (model->files, 1);
   memset (get_node (model, 0), 0, model->node_size);
+  model->sorted_len = 1;
 }
 
 static void
@@ -1356,6 +1812,8 @@ gtk_file_system_model_set_directory (GtkFileSystemModel *model,
   model->dir = g_object_ref (dir);
   model->attributes = g_strdup (attributes);
 
+  gtk_file_system_model_load_metadata_cache (model);
+
   g_file_enumerate_children_async (model->dir,
                                    attributes,
                                    G_FILE_QUERY_INFO_NONE,
@@ -1591,6 +2049,30 @@ _gtk_file_system_model_get_cancellable (GtkFileSystemModel *model)
   return model->cancellable;
 }
 
+/**
+ * _gtk_file_system_model_set_hydration_limit:
+ * @model: a #GtkFileSystemModel
+ * @limit: the maximum number of rows keeping a full #GFileInfo,
+ *   or 0 for no limit
+ *
+ * Bounds the amount of file metadata the model keeps in memory. Rows
+ * beyond the limit retain only the attributes needed for filtering,
+ * sorting and the text columns; the full info of the least recently
+ * used rows is dropped and fetched again from GIO when it is next
+ * requested through _gtk_file_system_model_get_info().
+ *
+ * This is meant to be called right after creating the model, before
+ * the directory is loaded.
+ **/
+void
+_gtk_file_system_model_set_hydration_limit (GtkFileSystemModel *model,
+                                            guint               limit)
+{
+  g_return_if_fail (GTK_IS_FILE_SYSTEM_MODEL (model));
+
+  model->hydration_limit = limit;
+}
+
 /**
  * _gtk_file_system_model_iter_is_visible:
  * @model: the model
@@ -1668,6 +2150,26 @@ _gtk_file_system_model_get_info (GtkFileSystemModel *model,
 
   node = get_node (model, ITER_INDEX (iter));
   g_assert (node->info == NULL || G_IS_FILE_INFO (node->info));
+
+  if (node->dehydrated)
+    {
+      GFileInfo *info;
+
+      info = g_file_query_info (node->file,
+                                model->attributes,
+                                G_FILE_QUERY_INFO_NONE,
+                                model->cancellable,
+                                NULL);
+      if (info != NULL)
+        {
+          g_object_unref (node->info);
+          node->info = info;
+          node->dehydrated = FALSE;
+        }
+    }
+
+  node_lru_enroll (model, ITER_INDEX (iter));
+
   return node->info;
 }
 
@@ -1742,6 +2244,91 @@ _gtk_file_system_model_get_value (GtkFileSystemModel *model,
   return &node->values[column];
 }
 
+/* replaces the node's info with a slim copy holding just the inline
+ * attributes the filters, the visibility checks and the text columns
+ * need; everything else - icons, thumbnails, access rights - can be
+ * fetched again on demand. this is what keeps the model's memory
+ * bounded when a hydration limit is set.
+ */
+static void
+node_dehydrate (GtkFileSystemModel *model, guint id)
+{
+  FileModelNode *node = get_node (model, id);
+  GFileInfo *slim;
+  const char *s;
+
+  slim = g_file_info_new ();
+
+  s = g_file_info_get_name (node->info);
+  if (s)
+    g_file_info_set_name (slim, s);
+  s = g_file_info_get_display_name (node->info);
+  if (s)
+    g_file_info_set_display_name (slim, s);
+  s = g_file_info_get_content_type (node->info);
+  if (s)
+    g_file_info_set_content_type (slim, s);
+
+  g_file_info_set_file_type (slim, g_file_info_get_file_type (node->info));
+  g_file_info_set_size (slim, g_file_info_get_size (node->info));
+  g_file_info_set_is_hidden (slim, g_file_info_get_is_hidden (node->info));
+  g_file_info_set_attribute_boolean (slim, G_FILE_ATTRIBUTE_STANDARD_IS_BACKUP,
+                                     g_file_info_get_is_backup (node->info));
+  g_file_info_set_attribute_uint64 (slim, G_FILE_ATTRIBUTE_TIME_MODIFIED,
+                                    g_file_info_get_attribute_uint64 (node->info, G_FILE_ATTRIBUTE_TIME_MODIFIED));
+  g_file_info_set_attribute_uint64 (slim, G_FILE_ATTRIBUTE_TIME_ACCESS,
+                                    g_file_info_get_attribute_uint64 (node->info, G_FILE_ATTRIBUTE_TIME_ACCESS));
+
+  g_object_unref (node->info);
+  node->info = slim;
+  node->dehydrated = TRUE;
+}
+
+/* moves the node to the front of the hydrated queue, enrolling it if
+ * necessary, and dehydrates the least recently hydrated nodes that
+ * exceed the limit. a no-op when no hydration limit is set.
+ */
+static void
+node_lru_enroll (GtkFileSystemModel *model, guint id)
+{
+  FileModelNode *node = get_node (model, id);
+
+  if (model->hydration_limit == 0 ||
+      node->file == NULL ||
+      node->info == NULL)
+    return;
+
+  if (node->hydrated_link != NULL)
+    {
+      g_queue_unlink (&model->hydrated, node->hydrated_link);
+      g_queue_push_head_link (&model->hydrated, node->hydrated_link);
+      return;
+    }
+
+  node->hydrated_link = g_list_prepend (NULL, g_object_ref (node->file));
+  g_queue_push_head_link (&model->hydrated, node->hydrated_link);
+
+  while (g_queue_get_length (&model->hydrated) > model->hydration_limit)
+    {
+      GList *link = g_queue_pop_tail_link (&model->hydrated);
+      GFile *victim_file = link->data;
+      guint victim;
+
+      g_list_free (link);
+
+      victim = node_get_for_file (model, victim_file);
+      if (victim != 0 && victim != id)
+        {
+          FileModelNode *victim_node = get_node (model, victim);
+
+          victim_node->hydrated_link = NULL;
+          node_dehydrate (model, victim);
+        }
+
+      g_object_unref (victim_file);
+    }
+}
+
 static guint
 node_get_for_file (GtkFileSystemModel *model,
                    GFile *             file)
@@ -1863,12 +2450,77 @@ add_file (GtkFileSystemModel *model,
   g_array_append_vals (model->files, node, 1);
   g_slice_free1 (model->node_size, node);
 
-  if (!model->frozen)
+  node_lru_enroll (model, model->files->len - 1);
+
+  if (model->frozen)
+    model->first_frozen_add = MIN (model->first_frozen_add, model->files->len - 1);
+  else
     node_compute_visibility_and_filters (model, model->files->len -1);
 
   gtk_file_system_model_sort_node (model, model->files->len -1);
 }
 
+/**
+ * add_files:
+ * @model: the model
+ * @files: a #GList of #GFileInfo to add
+ *
+ * Appends one enumeration batch to the model in a single array grow,
+ * instead of reallocating and resorting per file like add_file() does.
+ * The new nodes form the unsorted tail that the next sort merges in.
+ **/
+static void
+add_files (GtkFileSystemModel *model,
+           GList              *files)
+{
+  guint start, i, n_added;
+  GList *walk;
+
+  n_added = 0;
+  for (walk = files; walk; walk = walk->next)
+    {
+      /* NULL names shouldn't happen, but the APIs allow it */
+      if (g_file_info_get_name (walk->data) != NULL)
+        n_added++;
+    }
+
+  if (n_added == 0)
+    return;
+
+  start = model->files->len;
+  g_array_set_size (model->files, start + n_added);
+  memset (get_node (model, start), 0, n_added * model->node_size);
+
+  i = start;
+  for (walk = files; walk; walk = walk->next)
+    {
+      GFileInfo *info = walk->data;
+      const char *name;
+      FileModelNode *node;
+
+      name = g_file_info_get_name (info);
+      if (name == NULL)
+        continue;
+
+      node = get_node (model, i);
+      node->file = g_file_get_child (model->dir, name);
+      node->info = g_object_ref (info);
+      node->frozen_add = model->frozen ? TRUE : FALSE;
+      node_lru_enroll (model, i);
+      i++;
+    }
+
+  if (model->frozen)
+    model->first_frozen_add = MIN (model->first_frozen_add, start);
+  else
+    {
+      for (i = start; i < model->files->len; i++)
+        node_compute_visibility_and_filters (model, i);
+    }
+
+  gtk_file_system_model_sort_node (model, start);
+}
+
 /**
  * remove_file:
  * @model: the model
@@ -1904,10 +2556,18 @@ remove_file (GtkFileSystemModel *model,
   g_object_unref (node->file);
   adjust_file_lookup (model, id, -1);
 
+  if (node->hydrated_link)
+    {
+      g_object_unref (node->hydrated_link->data);
+      g_queue_delete_link (&model->hydrated, node->hydrated_link);
+    }
+
   if (node->info)
     g_object_unref (node->info);
 
   g_array_remove_index (model->files, id);
+  if (id < model->sorted_len)
+    model->sorted_len--;
 
   /* We don't need to resort, as removing a row doesn't change the sorting order of the other rows */
 
@@ -1952,6 +2612,9 @@ _gtk_file_system_model_update_file (GtkFileSystemModel *model,
   if (old_info)
     g_object_unref (old_info);
 
+  node->dehydrated = FALSE;
+  node_lru_enroll (model, id);
+
   for (i = 0; i < model->n_columns; i++)
     {
       if (G_VALUE_TYPE (&node->values[i]))
@@ -2035,8 +2698,6 @@ freeze_updates (GtkFileSystemModel *model)
 static void
 thaw_updates (GtkFileSystemModel *model)
 {
-  gboolean stuff_added;
-
   g_return_if_fail (GTK_IS_FILE_SYSTEM_MODEL (model));
   g_return_if_fail (model->frozen > 0);
 
@@ -2044,17 +2705,15 @@ thaw_updates (GtkFileSystemModel *model)
   if (model->frozen > 0)
     return;
 
-  stuff_added = get_node (model, model->files->len - 1)->frozen_add;
-
-  if (model->filter_on_thaw)
-    gtk_file_system_model_refilter_all (model);
-  if (model->sort_on_thaw)
-    gtk_file_system_model_sort (model);
-  if (stuff_added)
+  /* Process nodes added while frozen before sorting moves them around,
+   * so only the appended tail needs to be scanned rather than the
+   * whole array on every thaw.
+   */
+  if (model->first_frozen_add != G_MAXUINT)
     {
       guint i;
 
-      for (i = 0; i < model->files->len; i++)
+      for (i = model->first_frozen_add; i < model->files->len; i++)
         {
           FileModelNode *node = get_node (model, i);
 
@@ -2063,7 +2722,13 @@ thaw_updates (GtkFileSystemModel *model)
           node->frozen_add = FALSE;
           node_compute_visibility_and_filters (model, i);
         }
+      model->first_frozen_add = G_MAXUINT;
     }
+
+  if (model->filter_on_thaw)
+    gtk_file_system_model_refilter_all (model);
+  if (model->sort_on_thaw)
+    gtk_file_system_model_sort (model);
 }
 
 /**
@@ -52,6 +52,8 @@ GtkFileSystemModel *_gtk_file_system_model_new_for_directory(GFile *
                                                              ...);
 GFile *             _gtk_file_system_model_get_directory    (GtkFileSystemModel *model);
 GCancellable *      _gtk_file_system_model_get_cancellable  (GtkFileSystemModel *model);
+void                _gtk_file_system_model_set_hydration_limit (GtkFileSystemModel *model,
+                                                             guint               limit);
 gboolean            _gtk_file_system_model_iter_is_visible  (GtkFileSystemModel *model,
 							     GtkTreeIter        *iter);
 gboolean            _gtk_file_system_model_iter_is_filtered_out (GtkFileSystemModel *model,
@@ -783,6 +783,7 @@ struct _GtkFlowBoxPrivate {
   guint16           cur_children_per_line;
 
   GSequence        *children;
+  GArray           *lines;
 
   GtkFlowBoxFilterFunc filter_func;
   gpointer             filter_data;
@@ -858,6 +859,173 @@ get_visible_children (GtkFlowBox *box)
   return i;
 }
 
+/* Spatial index {{{3 */
+
+/* One allocated line of children, bucketed for hit testing. The
+ * children from first to last are consecutive in the sequence; the
+ * index is rebuilt after each allocation and dropped whenever children
+ * are added, removed or resorted, falling back to a linear scan until
+ * the next allocation.
+ */
+typedef struct {
+  GSequenceIter *first;
+  GSequenceIter *last;
+  GdkRectangle   bounds;
+} GtkFlowBoxLine;
+
+static void
+gtk_flow_box_invalidate_line_index (GtkFlowBox *box)
+{
+  GtkFlowBoxPrivate *priv = BOX_PRIV (box);
+
+  if (priv->lines != NULL)
+    g_array_set_size (priv->lines, 0);
+}
+
+static void
+gtk_flow_box_rebuild_line_index (GtkFlowBox *box)
+{
+  GtkFlowBoxPrivate *priv = BOX_PRIV (box);
+  GtkFlowBoxLine *line = NULL;
+  GSequenceIter *iter;
+  gboolean vertical;
+  gint line_start = 0;
+
+  vertical = priv->orientation == GTK_ORIENTATION_VERTICAL;
+
+  if (priv->lines == NULL)
+    priv->lines = g_array_new (FALSE, FALSE, sizeof (GtkFlowBoxLine));
+  else
+    g_array_set_size (priv->lines, 0);
+
+  for (iter = g_sequence_get_begin_iter (priv->children);
+       !g_sequence_iter_is_end (iter);
+       iter = g_sequence_iter_next (iter))
+    {
+      GtkWidget *child;
+      GtkAllocation allocation;
+      gint start;
+
+      child = g_sequence_get (iter);
+      if (!child_is_visible (child))
+        continue;
+
+      gtk_widget_get_allocation (child, &allocation);
+
+      /* All children in a line are allocated at the same line offset,
+       * so a new offset starts a new line.
+       */
+      start = vertical ? allocation.x : allocation.y;
+      if (line == NULL || start != line_start)
+        {
+          GtkFlowBoxLine new_line;
+
+          new_line.first = iter;
+          new_line.last = iter;
+          new_line.bounds = allocation;
+          g_array_append_val (priv->lines, new_line);
+          line = &g_array_index (priv->lines, GtkFlowBoxLine, priv->lines->len - 1);
+          line_start = start;
+        }
+      else
+        {
+          gdk_rectangle_union (&line->bounds, &allocation, &line->bounds);
+          line->last = iter;
+        }
+    }
+}
+
+static GtkFlowBoxChild *
+gtk_flow_box_line_index_lookup (GtkFlowBox *box,
+                                gint        x,
+                                gint        y)
+{
+  GtkFlowBoxPrivate *priv = BOX_PRIV (box);
+  GtkFlowBoxLine *line = NULL;
+  GSequenceIter *iter;
+  gboolean vertical, ascending;
+  gint cross;
+  guint lo, hi;
+
+  vertical = priv->orientation == GTK_ORIENTATION_VERTICAL;
+  cross = vertical ? x : y;
+
+  /* Lines are appended in allocation order, which runs backwards along
+   * the line axis for vertical orientation in RTL.
+   */
+  if (priv->lines->len > 1)
+    {
+      GtkFlowBoxLine *first = &g_array_index (priv->lines, GtkFlowBoxLine, 0);
+      GtkFlowBoxLine *last = &g_array_index (priv->lines, GtkFlowBoxLine, priv->lines->len - 1);
+
+      ascending = vertical ? first->bounds.x <= last->bounds.x
+                           : first->bounds.y <= last->bounds.y;
+    }
+  else
+    ascending = TRUE;
+
+  lo = 0;
+  hi = priv->lines->len;
+  while (lo < hi)
+    {
+      GtkFlowBoxLine *candidate;
+      gint start, size;
+      guint mid;
+
+      mid = lo + (hi - lo) / 2;
+      candidate = &g_array_index (priv->lines, GtkFlowBoxLine, mid);
+      start = vertical ? candidate->bounds.x : candidate->bounds.y;
+      size = vertical ? candidate->bounds.width : candidate->bounds.height;
+
+      if (cross < start)
+        {
+          if (ascending)
+            hi = mid;
+          else
+            lo = mid + 1;
+        }
+      else if (cross >= start + size)
+        {
+          if (ascending)
+            lo = mid + 1;
+          else
+            hi = mid;
+        }
+      else
+        {
+          line = candidate;
+          break;
+        }
+    }
+
+  if (line == NULL)
+    return NULL;
+
+  for (iter = line->first;
+       !g_sequence_iter_is_end (iter);
+       iter = g_sequence_iter_next (iter))
+    {
+      GtkWidget *child;
+      GtkAllocation allocation;
+
+      child = g_sequence_get (iter);
+      if (child_is_visible (child))
+        {
+          gtk_widget_get_allocation (child, &allocation);
+          if (x >= allocation.x && x < (allocation.x + allocation.width) &&
+              y >= allocation.y && y < (allocation.y + allocation.height))
+            return GTK_FLOW_BOX_CHILD (child);
+        }
+
+      if (iter == line->last)
+        break;
+    }
+
+  return NULL;
+}
+
+/* General utilities {{{3 */
+
 static GtkFlowBoxChild *
 gtk_flow_box_find_child_at_pos (GtkFlowBox *box,
                                 gint        x,
@@ -866,8 +1034,12 @@ gtk_flow_box_find_child_at_pos (GtkFlowBox *box,
   GtkWidget *child;
   GSequenceIter *iter;
   GtkAllocation allocation;
+  GtkFlowBoxPrivate *priv = BOX_PRIV (box);
 
-  for (iter = g_sequence_get_begin_iter (BOX_PRIV (box)->children);
+  if (priv->lines != NULL && priv->lines->len > 0)
+    return gtk_flow_box_line_index_lookup (box, x, y);
+
+  for (iter = g_sequence_get_begin_iter (priv->children);
        !g_sequence_iter_is_end (iter);
        iter = g_sequence_iter_next (iter))
     {
@@ -1940,6 +2112,8 @@ gtk_flow_box_size_allocate (GtkWidget     *widget,
 
   g_free (item_sizes);
   g_free (line_sizes);
+
+  gtk_flow_box_rebuild_line_index (box);
 }
 
 static GtkSizeRequestMode
@@ -3151,6 +3325,7 @@ gtk_flow_box_remove (GtkContainer *container,
 
   gtk_widget_unparent (GTK_WIDGET (child));
   g_sequence_remove (CHILD_PRIV (child)->iter);
+  gtk_flow_box_invalidate_line_index (box);
 
   if (was_visible && gtk_widget_get_visible (GTK_WIDGET (box)))
     gtk_widget_queue_resize (GTK_WIDGET (box));
@@ -3610,6 +3785,8 @@ gtk_flow_box_finalize (GObject *obj)
     priv->sort_destroy (priv->sort_data);
 
   g_sequence_free (priv->children);
+  if (priv->lines != NULL)
+    g_array_free (priv->lines, TRUE);
   g_clear_object (&priv->hadjustment);
   g_clear_object (&priv->vadjustment);
 
@@ -4144,6 +4321,7 @@ gtk_flow_box_insert (GtkFlowBox *box,
   CHILD_PRIV (child)->iter = iter;
   gtk_widget_set_parent (GTK_WIDGET (child), GTK_WIDGET (box));
   gtk_flow_box_apply_filter (box, child);
+  gtk_flow_box_invalidate_line_index (box);
 }
 
 /**
@@ -5018,6 +5196,7 @@ gtk_flow_box_invalidate_sort (GtkFlowBox *box)
     {
       g_sequence_sort (priv->children, (GCompareDataFunc)gtk_flow_box_sort, box);
       g_sequence_foreach (priv->children, gtk_flow_box_css_node_foreach, &previous);
+      gtk_flow_box_invalidate_line_index (box);
       gtk_widget_queue_resize (GTK_WIDGET (box));
     }
 }
@@ -127,6 +127,17 @@
 
 typedef struct _GtkGesturePrivate GtkGesturePrivate;
 typedef struct _PointData PointData;
+typedef struct _HistoryEntry HistoryEntry;
+
+/* Number of (time, x, y) samples kept per point for windowed
+ * velocity queries; see _gtk_gesture_get_velocity().
+ */
+#define GESTURE_HISTORY_SIZE 16
+
+/* Window of position history considered when resampling points
+ * towards the predicted presentation time of the next frame.
+ */
+#define GESTURE_RESAMPLE_WINDOW_MS 100
 
 enum {
   PROP_N_POINTS = 1,
@@ -142,12 +153,24 @@ enum {
   N_SIGNALS
 };
 
+struct _HistoryEntry
+{
+  guint32 evtime;
+  gdouble widget_x;
+  gdouble widget_y;
+};
+
 struct _PointData
 {
   GdkEvent *event;
   gdouble widget_x;
   gdouble widget_y;
 
+  /* Ring buffer of recent positions for velocity queries */
+  HistoryEntry history[GESTURE_HISTORY_SIZE];
+  guint history_start;
+  guint history_length;
+
   /* Acummulators for touchpad events */
   gdouble accum_dx;
   gdouble accum_dy;
@@ -503,6 +526,24 @@ _update_widget_coordinates (GtkGesture *gesture,
   data->widget_y = y;
 }
 
+static void
+_append_point_history (PointData *data,
+                       guint32    evtime)
+{
+  guint pos;
+
+  pos = (data->history_start + data->history_length) % GESTURE_HISTORY_SIZE;
+
+  if (data->history_length < GESTURE_HISTORY_SIZE)
+    data->history_length++;
+  else
+    data->history_start = (data->history_start + 1) % GESTURE_HISTORY_SIZE;
+
+  data->history[pos].evtime = evtime;
+  data->history[pos].widget_x = data->widget_x;
+  data->history[pos].widget_y = data->widget_y;
+}
+
 static GtkEventSequenceState
 gtk_gesture_get_group_state (GtkGesture       *gesture,
                              GdkEventSequence *sequence)
@@ -605,6 +646,7 @@ _gtk_gesture_update_point (GtkGesture     *gesture,
   data->event = gdk_event_copy (event);
   _update_touchpad_deltas (data);
   _update_widget_coordinates (gesture, data);
+  _append_point_history (data, gdk_event_get_time (event));
 
   /* Deny the sequence right away if the expected
    * number of points is exceeded, so this sequence
@@ -1342,6 +1384,127 @@ _gtk_gesture_get_last_update_time (GtkGesture       *gesture,
   return TRUE;
 };
 
+gboolean
+_gtk_gesture_get_velocity (GtkGesture       *gesture,
+                           GdkEventSequence *sequence,
+                           guint32           window_ms,
+                           gdouble          *velocity_x,
+                           gdouble          *velocity_y)
+{
+  GtkGesturePrivate *priv;
+  HistoryEntry *first, *last;
+  PointData *data;
+  guint32 diff_time;
+  guint i;
+
+  g_return_val_if_fail (GTK_IS_GESTURE (gesture), FALSE);
+
+  if (velocity_x)
+    *velocity_x = 0;
+  if (velocity_y)
+    *velocity_y = 0;
+
+  priv = gtk_gesture_get_instance_private (gesture);
+
+  if (!g_hash_table_lookup_extended (priv->points, sequence,
+                                     NULL, (gpointer *) &data))
+    return FALSE;
+
+  if (data->history_length == 0)
+    return FALSE;
+
+  last = &data->history[(data->history_start + data->history_length - 1) % GESTURE_HISTORY_SIZE];
+  first = last;
+
+  /* The ring holds a bounded number of samples, so this stays O(1) */
+  for (i = 1; i < data->history_length; i++)
+    {
+      HistoryEntry *entry;
+
+      entry = &data->history[(data->history_start + data->history_length - 1 - i) % GESTURE_HISTORY_SIZE];
+
+      if (last->evtime - entry->evtime > window_ms)
+        break;
+
+      first = entry;
+    }
+
+  diff_time = last->evtime - first->evtime;
+
+  if (diff_time == 0)
+    return FALSE;
+
+  /* Velocity in pixels/sec */
+  if (velocity_x)
+    *velocity_x = (last->widget_x - first->widget_x) * 1000 / diff_time;
+  if (velocity_y)
+    *velocity_y = (last->widget_y - first->widget_y) * 1000 / diff_time;
+
+  return TRUE;
+}
+
+/* Returns the position of @sequence resampled to the predicted
+ * presentation time of the widget's frame clock, so consumers
+ * redrawing from high-rate input see positions aligned with what
+ * ends up on screen. Falls back to the last event position when
+ * there is no frame clock or not enough history.
+ */
+gboolean
+_gtk_gesture_get_resampled_point (GtkGesture       *gesture,
+                                  GdkEventSequence *sequence,
+                                  gdouble          *x,
+                                  gdouble          *y)
+{
+  gint64 frame_time, refresh_interval, presentation_time;
+  gdouble velocity_x, velocity_y, lead;
+  GdkFrameClock *frame_clock;
+  GtkGesturePrivate *priv;
+  GtkWidget *widget;
+  PointData *data;
+
+  g_return_val_if_fail (GTK_IS_GESTURE (gesture), FALSE);
+
+  priv = gtk_gesture_get_instance_private (gesture);
+
+  if (!g_hash_table_lookup_extended (priv->points, sequence,
+                                     NULL, (gpointer *) &data))
+    return FALSE;
+
+  if (x)
+    *x = data->widget_x;
+  if (y)
+    *y = data->widget_y;
+
+  widget = gtk_event_controller_get_widget (GTK_EVENT_CONTROLLER (gesture));
+  frame_clock = gtk_widget_get_frame_clock (widget);
+
+  if (!frame_clock)
+    return TRUE;
+
+  if (!_gtk_gesture_get_velocity (gesture, sequence,
+                                  GESTURE_RESAMPLE_WINDOW_MS,
+                                  &velocity_x, &velocity_y))
+    return TRUE;
+
+  frame_time = gdk_frame_clock_get_frame_time (frame_clock);
+  gdk_frame_clock_get_refresh_info (frame_clock, frame_time,
+                                    &refresh_interval, &presentation_time);
+
+  if (presentation_time == 0)
+    presentation_time = frame_time + refresh_interval;
+
+  /* Extrapolate no further than one refresh cycle ahead */
+  lead = MIN (presentation_time - frame_time, refresh_interval) /
+    (gdouble) G_USEC_PER_SEC;
+
+  if (x)
+    *x += velocity_x * lead;
+  if (y)
+    *y += velocity_y * lead;
+
+  return TRUE;
+}
+
 /**
  * gtk_gesture_get_bounding_box:
  * @gesture: a #GtkGesture
@@ -33,6 +33,7 @@
 #include "config.h"
 #include "gtkgesturedrag.h"
 #include "gtkgesturedragprivate.h"
+#include "gtkgestureprivate.h"
 
 typedef struct _GtkGestureDragPrivate GtkGestureDragPrivate;
 typedef struct _EventData EventData;
@@ -101,7 +102,8 @@ gtk_gesture_drag_update (GtkGesture       *gesture,
   gdouble x, y;
 
   priv = gtk_gesture_drag_get_instance_private (GTK_GESTURE_DRAG (gesture));
-  gtk_gesture_get_point (gesture, sequence, &priv->last_x, &priv->last_y);
+  _gtk_gesture_get_resampled_point (gesture, sequence,
+                                    &priv->last_x, &priv->last_y);
   x = priv->last_x - priv->start_x;
   y = priv->last_y - priv->start_y;
 
@@ -70,6 +70,16 @@ gboolean _gtk_gesture_get_last_update_time   (GtkGesture       *gesture,
                                               GdkEventSequence *sequence,
                                               guint32          *evtime);
 
+gboolean _gtk_gesture_get_velocity           (GtkGesture       *gesture,
+                                              GdkEventSequence *sequence,
+                                              guint32           window_ms,
+                                              gdouble          *velocity_x,
+                                              gdouble          *velocity_y);
+gboolean _gtk_gesture_get_resampled_point    (GtkGesture       *gesture,
+                                              GdkEventSequence *sequence,
+                                              gdouble          *x,
+                                              gdouble          *y);
+
 G_END_DECLS
 
 #endif /* __GTK_GESTURE_PRIVATE_H__ */
@@ -43,20 +43,6 @@
 
 #define CAPTURE_THRESHOLD_MS 150
 
-typedef struct _GtkGestureSwipePrivate GtkGestureSwipePrivate;
-typedef struct _EventData EventData;
-
-struct _EventData
-{
-  guint32 evtime;
-  GdkPoint point;
-};
-
-struct _GtkGestureSwipePrivate
-{
-  GArray *events;
-};
-
 enum {
   SWIPE,
   N_SIGNALS
@@ -64,18 +50,7 @@ enum {
 
 static guint signals[N_SIGNALS] = { 0 };
 
-G_DEFINE_TYPE_WITH_PRIVATE (GtkGestureSwipe, gtk_gesture_swipe, GTK_TYPE_GESTURE_SINGLE)
-
-static void
-gtk_gesture_swipe_finalize (GObject *object)
-{
-  GtkGestureSwipePrivate *priv;
-
-  priv = gtk_gesture_swipe_get_instance_private (GTK_GESTURE_SWIPE (object));
-  g_array_free (priv->events, TRUE);
-
-  G_OBJECT_CLASS (gtk_gesture_swipe_parent_class)->finalize (object);
-}
+G_DEFINE_TYPE (GtkGestureSwipe, gtk_gesture_swipe, GTK_TYPE_GESTURE_SINGLE)
 
 static gboolean
 gtk_gesture_swipe_filter_event (GtkEventController *controller,
@@ -97,86 +72,16 @@ gtk_gesture_swipe_filter_event (GtkEventController *controller,
   return GTK_EVENT_CONTROLLER_CLASS (gtk_gesture_swipe_parent_class)->filter_event (controller, event);
 }
 
-static void
-_gtk_gesture_swipe_clear_backlog (GtkGestureSwipe *gesture,
-                                  guint32          evtime)
-{
-  GtkGestureSwipePrivate *priv;
-  gint i, length = 0;
-
-  priv = gtk_gesture_swipe_get_instance_private (gesture);
-
-  for (i = 0; i < (gint) priv->events->len; i++)
-    {
-      EventData *data;
-
-      data = &g_array_index (priv->events, EventData, i);
-
-      if (data->evtime >= evtime - CAPTURE_THRESHOLD_MS)
-        {
-          length = i - 1;
-          break;
-        }
-    }
-
-  if (length > 0)
-    g_array_remove_range (priv->events, 0, length);
-}
-
-static void
-gtk_gesture_swipe_update (GtkGesture       *gesture,
-                          GdkEventSequence *sequence)
-{
-  GtkGestureSwipe *swipe = GTK_GESTURE_SWIPE (gesture);
-  GtkGestureSwipePrivate *priv;
-  EventData new;
-  gdouble x, y;
-
-  priv = gtk_gesture_swipe_get_instance_private (swipe);
-  _gtk_gesture_get_last_update_time (gesture, sequence, &new.evtime);
-  gtk_gesture_get_point (gesture, sequence, &x, &y);
-
-  new.point.x = x;
-  new.point.y = y;
-
-  _gtk_gesture_swipe_clear_backlog (swipe, new.evtime);
-  g_array_append_val (priv->events, new);
-}
-
 static void
 _gtk_gesture_swipe_calculate_velocity (GtkGestureSwipe *gesture,
                                        gdouble         *velocity_x,
                                        gdouble         *velocity_y)
 {
-  GtkGestureSwipePrivate *priv;
   GdkEventSequence *sequence;
-  guint32 evtime, diff_time;
-  EventData *start, *end;
-  gdouble diff_x, diff_y;
-
-  priv = gtk_gesture_swipe_get_instance_private (gesture);
-  *velocity_x = *velocity_y = 0;
 
   sequence = gtk_gesture_single_get_current_sequence (GTK_GESTURE_SINGLE (gesture));
-  _gtk_gesture_get_last_update_time (GTK_GESTURE (gesture), sequence, &evtime);
-  _gtk_gesture_swipe_clear_backlog (gesture, evtime);
-
-  if (priv->events->len == 0)
-    return;
-
-  start = &g_array_index (priv->events, EventData, 0);
-  end = &g_array_index (priv->events, EventData, priv->events->len - 1);
-
-  diff_time = end->evtime - start->evtime;
-  diff_x = end->point.x - start->point.x;
-  diff_y = end->point.y - start->point.y;
-
-  if (diff_time == 0)
-    return;
-
-  /* Velocity in pixels/sec */
-  *velocity_x = diff_x * 1000 / diff_time;
-  *velocity_y = diff_y * 1000 / diff_time;
+  _gtk_gesture_get_velocity (GTK_GESTURE (gesture), sequence,
+                             CAPTURE_THRESHOLD_MS, velocity_x, velocity_y);
 }
 
 static void
@@ -184,7 +89,6 @@ gtk_gesture_swipe_end (GtkGesture       *gesture,
                        GdkEventSequence *sequence)
 {
   GtkGestureSwipe *swipe = GTK_GESTURE_SWIPE (gesture);
-  GtkGestureSwipePrivate *priv;
   gdouble velocity_x, velocity_y;
   GdkEventSequence *seq;
 
@@ -196,12 +100,8 @@ gtk_gesture_swipe_end (GtkGesture       *gesture,
   if (gtk_gesture_is_active (gesture))
     return;
 
-  priv = gtk_gesture_swipe_get_instance_private (swipe);
   _gtk_gesture_swipe_calculate_velocity (swipe, &velocity_x, &velocity_y);
   g_signal_emit (gesture, signals[SWIPE], 0, velocity_x, velocity_y);
-
-  if (priv->events->len > 0)
-    g_array_remove_range (priv->events, 0, priv->events->len);
 }
 
 static void
@@ -211,11 +111,8 @@ gtk_gesture_swipe_class_init (GtkGestureSwipeClass *klass)
   GtkEventControllerClass *event_controller_class = GTK_EVENT_CONTROLLER_CLASS (klass);
   GObjectClass *object_class = G_OBJECT_CLASS (klass);
 
-  object_class->finalize = gtk_gesture_swipe_finalize;
-
   event_controller_class->filter_event = gtk_gesture_swipe_filter_event;
 
-  gesture_class->update = gtk_gesture_swipe_update;
   gesture_class->end = gtk_gesture_swipe_end;
 
   /**
@@ -241,10 +138,6 @@ gtk_gesture_swipe_class_init (GtkGestureSwipeClass *klass)
 static void
 gtk_gesture_swipe_init (GtkGestureSwipe *gesture)
 {
-  GtkGestureSwipePrivate *priv;
-
-  priv = gtk_gesture_swipe_get_instance_private (gesture);
-  priv->events = g_array_new (FALSE, FALSE, sizeof (EventData));
 }
 
 /**
@@ -27,6 +27,10 @@
 #include "gtkiconhelperprivate.h"
 #include "gtkstylecontextprivate.h"
 
+static cairo_surface_t *get_surface_for_shared_pixbuf (GtkIconHelper *self,
+                                                       GdkPixbuf     *pixbuf,
+                                                       int            scale);
+
 struct _GtkIconHelperPrivate {
   GtkImageType storage_type;
 
@@ -176,6 +180,20 @@ ensure_stated_pixbuf_from_pixbuf (GtkIconHelper   *self,
 {
   GdkPixbuf *rendered;
   GtkIconSource *source;
+  GtkStateFlags state;
+
+  state = gtk_style_context_get_state (context);
+
+  /* The icon effect only depends on the state flags, so the rendered
+   * variant can be shared between all widgets showing this pixbuf in
+   * the same state; one variant is kept per source pixbuf, which is
+   * plenty since the users of a shared icon pixbuf are normally all
+   * in the same state.
+   */
+  rendered = g_object_get_data (G_OBJECT (pixbuf), "gtk-icon-helper-stated-pixbuf");
+  if (rendered != NULL &&
+      GPOINTER_TO_UINT (g_object_get_data (G_OBJECT (pixbuf), "gtk-icon-helper-stated-state")) == state)
+    return g_object_ref (rendered);
 
   G_GNUC_BEGIN_IGNORE_DEPRECATIONS;
 
@@ -196,6 +214,18 @@ ensure_stated_pixbuf_from_pixbuf (GtkIconHelper   *self,
 
   G_GNUC_END_IGNORE_DEPRECATIONS;
 
+  /* An identity rendering comes back as the source itself; no point
+   * in caching that.
+   */
+  if (rendered != NULL && rendered != pixbuf)
+    {
+      g_object_set_data_full (G_OBJECT (pixbuf), "gtk-icon-helper-stated-pixbuf",
+			      g_object_ref (rendered),
+			      g_object_unref);
+      g_object_set_data (G_OBJECT (pixbuf), "gtk-icon-helper-stated-state",
+			 GUINT_TO_POINTER (state));
+    }
+
   return rendered;
 }
 
@@ -622,6 +652,7 @@ ensure_surface_from_pixbuf (GtkIconHelper   *self,
 {
   gint width, height;
   GdkPixbuf *pixbuf, *stated;
+  gboolean shared;
   int scale;
 
   if (!check_invalidate_surface (self, context))
@@ -631,11 +662,17 @@ ensure_surface_from_pixbuf (GtkIconHelper   *self,
     return;
 
   if (get_pixbuf_size (self, context, &width, &height, &scale))
-    pixbuf = gdk_pixbuf_scale_simple (self->priv->orig_pixbuf,
-                                      width, height,
-                                      GDK_INTERP_BILINEAR);
+    {
+      pixbuf = gdk_pixbuf_scale_simple (self->priv->orig_pixbuf,
+                                        width, height,
+                                        GDK_INTERP_BILINEAR);
+      shared = FALSE;
+    }
   else
-    pixbuf = g_object_ref (self->priv->orig_pixbuf);
+    {
+      pixbuf = g_object_ref (self->priv->orig_pixbuf);
+      shared = TRUE;
+    }
 
   stated = ensure_stated_pixbuf_from_pixbuf (self, context, pixbuf);
   g_object_unref (pixbuf);
@@ -644,7 +681,14 @@ ensure_surface_from_pixbuf (GtkIconHelper   *self,
   self->priv->rendered_surface_width = (width + scale - 1) / scale;
   self->priv->rendered_surface_height = (height + scale - 1) / scale;
 
-  self->priv->rendered_surface = gdk_cairo_surface_create_from_pixbuf (pixbuf, scale, self->priv->window);
+  /* Unless we scaled a private copy above, the pixbuf here is a shared
+   * object - either the original or the stated variant cached on it -
+   * and the surface can be shared with everybody else drawing it.
+   */
+  if (shared)
+    self->priv->rendered_surface = get_surface_for_shared_pixbuf (self, pixbuf, scale);
+  else
+    self->priv->rendered_surface = gdk_cairo_surface_create_from_pixbuf (pixbuf, scale, self->priv->window);
   g_object_unref (pixbuf);
 }
 
@@ -673,6 +717,38 @@ ensure_surface_for_icon_set (GtkIconHelper *self,
 		      &self->priv->rendered_surface_height);
 }
 
+/* Pixbufs whose pixels are drawn as-is are often shared across
+ * widgets: recolored symbolic pixbufs are dedup'd by the icon theme
+ * per icon, size and color set, and applications routinely show one
+ * pixbuf in many places. The surface conversion can then be shared
+ * too: cache it on the pixbuf itself, and every icon helper drawing
+ * that pixbuf reuses one surface instead of each holding its own copy
+ * of the pixels. Only valid when the surface is a straight conversion
+ * of the pixbuf, i.e. no state effect was applied on the way.
+ */
+static cairo_surface_t *
+get_surface_for_shared_pixbuf (GtkIconHelper *self,
+			       GdkPixbuf     *pixbuf,
+			       int            scale)
+{
+  cairo_surface_t *surface;
+
+  surface = g_object_get_data (G_OBJECT (pixbuf), "gtk-icon-helper-surface");
+  if (surface != NULL &&
+      GPOINTER_TO_INT (g_object_get_data (G_OBJECT (pixbuf), "gtk-icon-helper-surface-scale")) == scale)
+    return cairo_surface_reference (surface);
+
+  surface = gdk_cairo_surface_create_from_pixbuf (pixbuf, scale, self->priv->window);
+
+  g_object_set_data_full (G_OBJECT (pixbuf), "gtk-icon-helper-surface",
+			  cairo_surface_reference (surface),
+			  (GDestroyNotify) cairo_surface_destroy);
+  g_object_set_data (G_OBJECT (pixbuf), "gtk-icon-helper-surface-scale",
+		     GINT_TO_POINTER (scale));
+
+  return surface;
+}
+
 static void
 ensure_stated_surface_from_info (GtkIconHelper *self,
 				 GtkStyleContext *context,
@@ -717,7 +793,11 @@ ensure_stated_surface_from_info (GtkIconHelper *self,
   surface = NULL;
   if (destination)
     {
-      surface = gdk_cairo_surface_create_from_pixbuf (destination, scale, self->priv->window);
+      /* Whether recolored symbolic, plain themed or a stated variant,
+       * the pixbuf at this point is shared between every widget showing
+       * this icon at this size and state, so the surface can be too.
+       */
+      surface = get_surface_for_shared_pixbuf (self, destination, scale);
 
       self->priv->rendered_surface_width = 
 	(gdk_pixbuf_get_width (destination) + scale - 1) / scale;
@@ -949,6 +1029,38 @@ _gtk_icon_helper_set_pixbuf (GtkIconHelper *self,
     }
 }
 
+/* Swaps in a new pixbuf of identical dimensions without resetting the
+ * rest of the helper state, so callers updating pixel content (frame
+ * sources like camera previews) only need a redraw, not a relayout.
+ * Returns FALSE when the current storage doesn't allow that.
+ */
+gboolean
+_gtk_icon_helper_replace_pixbuf (GtkIconHelper *self,
+                                 GdkPixbuf     *pixbuf)
+{
+  if (self->priv->storage_type != GTK_IMAGE_PIXBUF ||
+      pixbuf == NULL ||
+      self->priv->orig_pixbuf == NULL ||
+      gdk_pixbuf_get_width (pixbuf) != gdk_pixbuf_get_width (self->priv->orig_pixbuf) ||
+      gdk_pixbuf_get_height (pixbuf) != gdk_pixbuf_get_height (self->priv->orig_pixbuf))
+    return FALSE;
+
+  /* Re-setting the pixbuf object that is already shown means its
+   * pixel content changed, so any surface shared through the pixbuf
+   * is stale too; setting a different object invalidates by identity.
+   */
+  if (pixbuf == self->priv->orig_pixbuf)
+    g_object_set_data (G_OBJECT (pixbuf), "gtk-icon-helper-surface", NULL);
+
+  g_object_ref (pixbuf);
+  g_object_unref (self->priv->orig_pixbuf);
+  self->priv->orig_pixbuf = pixbuf;
+
+  _gtk_icon_helper_invalidate (self);
+
+  return TRUE;
+}
+
 void 
 _gtk_icon_helper_set_animation (GtkIconHelper *self,
                                 GdkPixbufAnimation *animation)
@@ -80,6 +80,8 @@ void _gtk_icon_helper_set_gicon (GtkIconHelper *self,
                                  GtkIconSize icon_size);
 void _gtk_icon_helper_set_pixbuf (GtkIconHelper *self,
 				  GdkPixbuf *pixbuf);
+gboolean _gtk_icon_helper_replace_pixbuf (GtkIconHelper *self,
+                                          GdkPixbuf *pixbuf);
 void _gtk_icon_helper_set_pixbuf_scale (GtkIconHelper *self,
 					int scale);
 int  _gtk_icon_helper_get_pixbuf_scale (GtkIconHelper *self);
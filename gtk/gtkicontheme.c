@@ -45,6 +45,7 @@
 #include "gtkmain.h"
 #include "deprecated/gtknumerableiconprivate.h"
 #include "gtksettingsprivate.h"
+#include "gtktraceprivate.h"
 #include "gtkprivate.h"
 
 #undef GDK_DEPRECATED
@@ -156,6 +157,7 @@ typedef enum
 } IconSuffix;
 
 #define INFO_CACHE_LRU_SIZE 32
+#define INFO_CACHE_MAX_BYTES (8 * 1024 * 1024)
 #if 0
 #define DEBUG_CACHE(args) g_print args
 #else
@@ -347,6 +349,20 @@ static gboolean     rescan_themes             (GtkIconTheme     *icon_themes);
 static IconSuffix   theme_dir_get_icon_suffix (IconThemeDir     *dir,
                                                const gchar      *icon_name,
                                                gboolean         *has_icon_file);
+static IconSuffix   best_suffix               (IconSuffix        suffix,
+                                               gboolean          allow_svg);
+static gint         theme_dir_size_difference (IconThemeDir     *dir,
+                                               gint              size,
+                                               gint              scale);
+static gboolean     compare_dir_matches       (IconThemeDir     *dir_a,
+                                               gint              difference_a,
+                                               IconThemeDir     *dir_b,
+                                               gint              difference_b,
+                                               gint              requested_size,
+                                               gint              requested_scale);
+static GtkIconInfo *theme_dir_build_icon_info (IconThemeDir     *min_dir,
+                                               const gchar      *icon_name,
+                                               gboolean          allow_svg);
 static GtkIconInfo *icon_info_new             (IconThemeDirType  type,
                                                gint              dir_size,
                                                gint              dir_scale);
@@ -1382,7 +1398,9 @@ load_themes (GtkIconTheme *icon_theme)
       dir_mtime->mtime = stat_buf.st_mtime;
       dir_mtime->exists = TRUE;
 
+      _gtk_trace_begin ("icon cache open", dir);
       dir_mtime->cache = _gtk_icon_cache_new_for_path (dir);
+      _gtk_trace_end ("icon cache open");
       if (dir_mtime->cache != NULL)
         continue;
 
@@ -1454,7 +1472,9 @@ ensure_valid_themes (GtkIconTheme *icon_theme)
   
   if (!priv->themes_valid)
     {
+      _gtk_trace_begin ("icon theme load", priv->current_theme);
       load_themes (icon_theme);
+      _gtk_trace_end ("icon theme load");
 
       if (was_valid)
         queue_theme_changed (icon_theme);
@@ -1472,26 +1492,68 @@ ensure_valid_themes (GtkIconTheme *icon_theme)
  * we remove it from the list, and when the proxy
  * pixmap is released we put it on the list.
  */
+static guint64
+get_pixbuf_bytes (GdkPixbuf *pixbuf)
+{
+  if (pixbuf == NULL)
+    return 0;
+
+  return (guint64) gdk_pixbuf_get_rowstride (pixbuf) * gdk_pixbuf_get_height (pixbuf);
+}
+
+static guint64
+icon_info_get_pixel_bytes (GtkIconInfo *icon_info)
+{
+  SymbolicPixbufCache *symbolic_cache;
+  guint64 bytes;
+
+  bytes = get_pixbuf_bytes (icon_info->pixbuf);
+  bytes += get_pixbuf_bytes (icon_info->cache_pixbuf);
+
+  for (symbolic_cache = icon_info->symbolic_pixbuf_cache;
+       symbolic_cache != NULL;
+       symbolic_cache = symbolic_cache->next)
+    bytes += get_pixbuf_bytes (symbolic_cache->pixbuf);
+
+  return bytes;
+}
+
 static void
 ensure_lru_cache_space (GtkIconTheme *icon_theme)
 {
   GtkIconThemePrivate *priv = icon_theme->priv;
+  guint64 bytes = 0;
+  gint n = 0;
   GList *l;
 
-  /* Remove last item if LRU full */
-  l = g_list_nth (priv->info_cache_lru, INFO_CACHE_LRU_SIZE - 1);
+  /* Walk from the most recently used end and find the first entry
+   * that overflows either the entry count or the pixel byte budget;
+   * it and everything behind it is evicted. Counting bytes keeps a
+   * few large icons from outliving many small ones.
+   */
+  for (l = priv->info_cache_lru; l; l = l->next)
+    {
+      bytes += icon_info_get_pixel_bytes (l->data);
+      n++;
+
+      if (n >= INFO_CACHE_LRU_SIZE || bytes > INFO_CACHE_MAX_BYTES)
+        break;
+    }
+
   if (l)
     {
-      GtkIconInfo *icon_info = l->data;
+      DEBUG_CACHE (("evicting %d entries (%d in cache, %" G_GUINT64_FORMAT " bytes) from LRU cache\n",
+                    g_list_length (l),
+                    g_list_length (priv->info_cache_lru),
+                    bytes));
 
-      DEBUG_CACHE (("removing (due to out of space) %p (%s %d 0x%x) from LRU cache (cache size %d)\n",
-                    icon_info,
-                    g_strjoinv (",", icon_info->key.icon_names),
-                    icon_info->key.size, icon_info->key.flags,
-                    g_list_length (priv->info_cache_lru)));
+      if (l->prev)
+        l->prev->next = NULL;
+      else
+        priv->info_cache_lru = NULL;
+      l->prev = NULL;
 
-      priv->info_cache_lru = g_list_delete_link (priv->info_cache_lru, l);
-      g_object_unref (icon_info);
+      g_list_free_full (l, g_object_unref);
     }
 }
 
@@ -2121,6 +2183,158 @@ gtk_icon_theme_lookup_icon_for_scale (GtkIconTheme       *icon_theme,
   return info;
 }
 
+/**
+ * gtk_icon_theme_lookup_batch:
+ * @icon_theme: a #GtkIconTheme
+ * @icon_names: (array length=n_icons): names of the icons to look up
+ * @sizes: (array length=n_icons): desired icon sizes
+ * @n_icons: the number of icons to look up
+ * @flags: flags modifying the behavior of the icon lookup
+ *
+ * Looks up a number of named icons at once, resolving them against
+ * each theme in a single pass over its directory list rather than
+ * re-walking it per icon. This amortizes the lookup cost when many
+ * icons are resolved together, e.g. when populating a toolbar.
+ *
+ * Apart from the batching this behaves like calling
+ * gtk_icon_theme_lookup_icon() once per icon.
+ *
+ * Returns: (array length=n_icons) (transfer full): a newly allocated
+ *     array of #GtkIconInfo objects, with %NULL entries for icons
+ *     that weren't found. Unref the entries and free the array with
+ *     g_free() when done.
+ *
+ * Since: 3.18
+ */
+GtkIconInfo **
+gtk_icon_theme_lookup_batch (GtkIconTheme       *icon_theme,
+                             const gchar       **icon_names,
+                             const gint         *sizes,
+                             gint                n_icons,
+                             GtkIconLookupFlags  flags)
+{
+  GtkIconThemePrivate *priv;
+  GtkIconInfo **infos;
+  gboolean allow_svg;
+  gint i, unresolved;
+  GList *l;
+
+  g_return_val_if_fail (GTK_IS_ICON_THEME (icon_theme), NULL);
+  g_return_val_if_fail (icon_names != NULL, NULL);
+  g_return_val_if_fail (sizes != NULL, NULL);
+  g_return_val_if_fail (n_icons >= 0, NULL);
+  g_return_val_if_fail ((flags & GTK_ICON_LOOKUP_NO_SVG) == 0 ||
+                        (flags & GTK_ICON_LOOKUP_FORCE_SVG) == 0, NULL);
+
+  priv = icon_theme->priv;
+  infos = g_new0 (GtkIconInfo *, n_icons);
+
+  if (flags & GTK_ICON_LOOKUP_NO_SVG)
+    allow_svg = FALSE;
+  else if (flags & GTK_ICON_LOOKUP_FORCE_SVG)
+    allow_svg = TRUE;
+  else
+    allow_svg = priv->pixbuf_supports_svg;
+
+  ensure_valid_themes (icon_theme);
+
+  /* The batched pass handles plain named lookups; flags that rewrite
+   * the name list per icon (forcing symbolic/regular, direction
+   * suffixes, generic fallback) and symbolic names (which prefer
+   * symbolic variants from inherited themes over regular ones from
+   * the theme itself) go through the one-at-a-time path below.
+   */
+  if ((flags & (GTK_ICON_LOOKUP_FORCE_REGULAR |
+                GTK_ICON_LOOKUP_FORCE_SYMBOLIC |
+                GTK_ICON_LOOKUP_DIR_LTR |
+                GTK_ICON_LOOKUP_DIR_RTL |
+                GTK_ICON_LOOKUP_GENERIC_FALLBACK |
+                GTK_ICON_LOOKUP_USE_BUILTIN)) == 0)
+    {
+      IconThemeDir **min_dirs;
+      gint *min_differences;
+
+      min_dirs = g_new (IconThemeDir *, n_icons);
+      min_differences = g_new (gint, n_icons);
+
+      unresolved = 0;
+      for (i = 0; i < n_icons; i++)
+        if (!icon_name_is_symbolic (icon_names[i]))
+          unresolved++;
+
+      for (l = priv->themes; l != NULL && unresolved > 0; l = l->next)
+        {
+          IconTheme *theme = l->data;
+          GList *d;
+
+          for (i = 0; i < n_icons; i++)
+            {
+              min_dirs[i] = NULL;
+              min_differences[i] = G_MAXINT;
+            }
+
+          for (d = theme->dirs; d != NULL; d = d->next)
+            {
+              IconThemeDir *dir = d->data;
+
+              for (i = 0; i < n_icons; i++)
+                {
+                  IconSuffix suffix;
+                  gint difference;
+
+                  if (infos[i] != NULL ||
+                      icon_name_is_symbolic (icon_names[i]))
+                    continue;
+
+                  suffix = theme_dir_get_icon_suffix (dir, icon_names[i], NULL);
+                  if (best_suffix (suffix, allow_svg) == ICON_SUFFIX_NONE)
+                    continue;
+
+                  difference = theme_dir_size_difference (dir, sizes[i], 1);
+                  if (min_dirs[i] == NULL ||
+                      compare_dir_matches (dir, difference,
+                                           min_dirs[i], min_differences[i],
+                                           sizes[i], 1))
+                    {
+                      min_dirs[i] = dir;
+                      min_differences[i] = difference;
+                    }
+                }
+            }
+
+          for (i = 0; i < n_icons; i++)
+            {
+              if (infos[i] == NULL && min_dirs[i] != NULL)
+                {
+                  infos[i] = theme_dir_build_icon_info (min_dirs[i],
+                                                        icon_names[i],
+                                                        allow_svg);
+                  infos[i]->desired_size = sizes[i];
+                  infos[i]->desired_scale = 1;
+                  infos[i]->forced_size = (flags & GTK_ICON_LOOKUP_FORCE_SIZE) != 0;
+                  infos[i]->unscaled_scale = 1.0;
+                  unresolved--;
+                }
+            }
+        }
+
+      g_free (min_dirs);
+      g_free (min_differences);
+    }
+
+  /* Whatever the batched pass didn't resolve (unthemed icons, missing
+   * icons, symbolic names, variant flags) takes the regular path.
+   */
+  for (i = 0; i < n_icons; i++)
+    {
+      if (infos[i] == NULL)
+        infos[i] = gtk_icon_theme_lookup_icon (icon_theme, icon_names[i],
+                                               sizes[i], flags);
+    }
+
+  return infos;
+}
+
 /**
  * gtk_icon_theme_choose_icon:
  * @icon_theme: a #GtkIconTheme
@@ -2699,6 +2913,48 @@ gtk_icon_theme_get_example_icon_name (GtkIconTheme *icon_theme)
   return NULL;
 }
 
+/**
+ * gtk_icon_theme_get_cache_stats:
+ * @icon_theme: a #GtkIconTheme
+ * @n_infos: (out) (allow-none): return location for the number of
+ *     cached icon infos, or %NULL
+ * @pixel_bytes: (out) (allow-none): return location for the amount of
+ *     decoded pixel data held by the cache, in bytes, or %NULL
+ *
+ * Reports the size of the icon caches kept by @icon_theme: the number
+ * of looked-up icons being kept around, and the decoded pixel data
+ * they hold alive. This is meant for instrumenting the icon memory
+ * use of long-lived applications; the cache itself is bounded by a
+ * fixed entry and pixel byte budget.
+ *
+ * Since: 3.18
+ */
+void
+gtk_icon_theme_get_cache_stats (GtkIconTheme *icon_theme,
+                                guint        *n_infos,
+                                guint64      *pixel_bytes)
+{
+  GtkIconThemePrivate *priv;
+  GHashTableIter iter;
+  gpointer value;
+  guint64 bytes = 0;
+
+  g_return_if_fail (GTK_IS_ICON_THEME (icon_theme));
+
+  priv = icon_theme->priv;
+
+  if (n_infos)
+    *n_infos = g_hash_table_size (priv->info_cache);
+
+  if (pixel_bytes)
+    {
+      g_hash_table_iter_init (&iter, priv->info_cache);
+      while (g_hash_table_iter_next (&iter, NULL, &value))
+        bytes += icon_info_get_pixel_bytes (value);
+
+      *pixel_bytes = bytes;
+    }
+}
 
 static gboolean
 rescan_themes (GtkIconTheme *icon_theme)
@@ -2917,7 +3173,10 @@ theme_dir_get_icon_suffix (IconThemeDir *dir,
       suffix = suffix & ~HAS_ICON_FILE;
     }
   else
-    suffix = GPOINTER_TO_UINT (g_hash_table_lookup (dir->icons, icon_name));
+    {
+      theme_dir_ensure_scanned (dir);
+      suffix = GPOINTER_TO_UINT (g_hash_table_lookup (dir->icons, icon_name));
+    }
 
   GTK_NOTE (ICONTHEME, 
             g_print ("get_icon_suffix%s %u\n", dir->cache ? " (cached)" : "", suffix));
@@ -2990,6 +3249,58 @@ compare_dir_matches (IconThemeDir *dir_a, gint difference_a,
   return diff_a <= diff_b;
 }
 
+static GtkIconInfo *
+theme_dir_build_icon_info (IconThemeDir *min_dir,
+                           const gchar  *icon_name,
+                           gboolean      allow_svg)
+{
+  GtkIconInfo *icon_info;
+  gboolean has_icon_file = FALSE;
+  IconSuffix suffix;
+  gchar *file;
+
+  icon_info = icon_info_new (min_dir->type, min_dir->size, min_dir->scale);
+  icon_info->min_size = min_dir->min_size;
+  icon_info->max_size = min_dir->max_size;
+
+  suffix = theme_dir_get_icon_suffix (min_dir, icon_name, &has_icon_file);
+  suffix = best_suffix (suffix, allow_svg);
+  g_assert (suffix != ICON_SUFFIX_NONE);
+
+  if (min_dir->dir)
+    {
+      file = g_strconcat (icon_name, string_from_suffix (suffix), NULL);
+      icon_info->filename = g_build_filename (min_dir->dir, file, NULL);
+
+      if (min_dir->is_resource)
+        {
+          gchar *uri;
+          uri = g_strconcat ("resource://", icon_info->filename, NULL);
+          icon_info->icon_file = g_file_new_for_uri (uri);
+          g_free (uri);
+        }
+      else
+        icon_info->icon_file = g_file_new_for_path (icon_info->filename);
+
+      icon_info->is_svg = suffix == ICON_SUFFIX_SVG;
+      icon_info->is_resource = min_dir->is_resource;
+      g_free (file);
+    }
+  else
+    {
+      icon_info->filename = NULL;
+      icon_info->icon_file = NULL;
+    }
+
+  if (min_dir->cache)
+    {
+      icon_info->cache_pixbuf = _gtk_icon_cache_get_icon (min_dir->cache, icon_name,
+                                                          min_dir->subdir_index);
+    }
+
+  return icon_info;
+}
+
 static GtkIconInfo *
 theme_lookup_icon (IconTheme   *theme,
                    const gchar *icon_name,
@@ -3000,7 +3311,6 @@ theme_lookup_icon (IconTheme   *theme,
 {
   GList *dirs, *l;
   IconThemeDir *dir, *min_dir;
-  gchar *file;
   gint min_difference, difference;
   BuiltinIcon *closest_builtin = NULL;
   IconSuffix suffix;
@@ -3048,51 +3358,7 @@ theme_lookup_icon (IconTheme   *theme,
     }
 
   if (min_dir)
-    {
-      GtkIconInfo *icon_info;
-      gboolean has_icon_file = FALSE;
-
-      icon_info = icon_info_new (min_dir->type, min_dir->size, min_dir->scale);
-      icon_info->min_size = min_dir->min_size;
-      icon_info->max_size = min_dir->max_size;
-
-      suffix = theme_dir_get_icon_suffix (min_dir, icon_name, &has_icon_file);
-      suffix = best_suffix (suffix, allow_svg);
-      g_assert (suffix != ICON_SUFFIX_NONE);
-
-      if (min_dir->dir)
-        {
-          file = g_strconcat (icon_name, string_from_suffix (suffix), NULL);
-          icon_info->filename = g_build_filename (min_dir->dir, file, NULL);
-
-          if (min_dir->is_resource)
-            {
-              gchar *uri;
-              uri = g_strconcat ("resource://", icon_info->filename, NULL);
-              icon_info->icon_file = g_file_new_for_uri (uri);
-              g_free (uri);
-            }
-          else
-            icon_info->icon_file = g_file_new_for_path (icon_info->filename);
-
-          icon_info->is_svg = suffix == ICON_SUFFIX_SVG;
-          icon_info->is_resource = min_dir->is_resource;
-          g_free (file);
-        }
-      else
-        {
-          icon_info->filename = NULL;
-          icon_info->icon_file = NULL;
-        }
-
-      if (min_dir->cache)
-        {
-          icon_info->cache_pixbuf = _gtk_icon_cache_get_icon (min_dir->cache, icon_name,
-                                                              min_dir->subdir_index);
-        }
-
-      return icon_info;
-    }
+    return theme_dir_build_icon_info (min_dir, icon_name, allow_svg);
 
   if (closest_builtin)
     return icon_info_new_builtin (closest_builtin);
@@ -3118,7 +3384,10 @@ theme_list_icons (IconTheme  *theme,
           if (dir->cache)
             _gtk_icon_cache_add_icons (dir->cache, dir->subdir, icons);
           else
-            g_hash_table_foreach (dir->icons, add_key_to_hash, icons);
+            {
+              theme_dir_ensure_scanned (dir);
+              g_hash_table_foreach (dir->icons, add_key_to_hash, icons);
+            }
         }
       l = l->next;
     }
@@ -3141,6 +3410,7 @@ theme_has_icon (IconTheme   *theme,
         }
       else
         {
+          theme_dir_ensure_scanned (dir);
           if (g_hash_table_lookup (dir->icons, icon_name) != NULL)
             return TRUE;
         }
@@ -3242,6 +3512,22 @@ scan_resources (GtkIconThemePrivate  *icon_theme,
   return g_hash_table_size (dir->icons) > 0;
 }
 
+/* Scans an uncached theme directory the first time it is consulted.
+ * If the directory can't be read, an empty icon hash is left behind
+ * so the scan isn't retried on every lookup.
+ */
+static void
+theme_dir_ensure_scanned (IconThemeDir *dir)
+{
+  if (dir->cache != NULL || dir->icons != NULL)
+    return;
+
+  scan_directory (NULL, dir, dir->dir);
+
+  if (dir->icons == NULL)
+    dir->icons = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, NULL);
+}
+
 static void
 theme_subdir_load (GtkIconTheme *icon_theme,
                    IconTheme    *theme,
@@ -3325,46 +3611,52 @@ theme_subdir_load (GtkIconTheme *icon_theme,
       full_dir = g_build_filename (dir_mtime->dir, subdir, NULL);
 
       /* First, see if we have a cache for the directory */
-      if (dir_mtime->cache != NULL || g_file_test (full_dir, G_FILE_TEST_IS_DIR))
+      if (dir_mtime->cache == NULL)
         {
-          if (dir_mtime->cache == NULL)
-            {
-              /* This will return NULL if the cache doesn't exist or is outdated */
-              dir_mtime->cache = _gtk_icon_cache_new_for_path (dir_mtime->dir);
-            }
-
-          dir = g_new0 (IconThemeDir, 1);
-          dir->type = type;
-          dir->is_resource = FALSE;
-          dir->context = context;
-          dir->size = size;
-          dir->min_size = min_size;
-          dir->max_size = max_size;
-          dir->threshold = threshold;
-          dir->dir = full_dir;
-          dir->subdir = g_strdup (subdir);
-          dir->scale = scale;
+          /* This will return NULL if the cache doesn't exist or is outdated */
+          dir_mtime->cache = _gtk_icon_cache_new_for_path (dir_mtime->dir);
+        }
 
-          if (dir_mtime->cache != NULL)
-            {
-              dir->cache = _gtk_icon_cache_ref (dir_mtime->cache);
-              dir->subdir_index = _gtk_icon_cache_get_directory_index (dir->cache, dir->subdir);
-              has_icons = _gtk_icon_cache_has_icons (dir->cache, dir->subdir);
-            }
-          else
+      /* The cache tells us whether the subdirectory has icons without
+       * touching the filesystem; when there is no cache, don't stat or
+       * scan anything here either - the scan is deferred until the
+       * directory is first consulted, so loading a theme doesn't hit
+       * every subdirectory of every search path up front.
+       */
+      if (dir_mtime->cache != NULL)
+        {
+          has_icons = _gtk_icon_cache_has_icons (dir_mtime->cache, subdir);
+          if (!has_icons)
             {
-              dir->cache = NULL;
-              dir->subdir_index = -1;
-              has_icons = scan_directory (icon_theme->priv, dir, full_dir);
+              g_free (full_dir);
+              continue;
             }
+        }
 
-          if (has_icons)
-            theme->dirs = g_list_prepend (theme->dirs, dir);
-          else
-            theme_dir_destroy (dir);
+      dir = g_new0 (IconThemeDir, 1);
+      dir->type = type;
+      dir->is_resource = FALSE;
+      dir->context = context;
+      dir->size = size;
+      dir->min_size = min_size;
+      dir->max_size = max_size;
+      dir->threshold = threshold;
+      dir->dir = full_dir;
+      dir->subdir = g_strdup (subdir);
+      dir->scale = scale;
+
+      if (dir_mtime->cache != NULL)
+        {
+          dir->cache = _gtk_icon_cache_ref (dir_mtime->cache);
+          dir->subdir_index = _gtk_icon_cache_get_directory_index (dir->cache, dir->subdir);
         }
       else
-        g_free (full_dir);
+        {
+          dir->cache = NULL;
+          dir->subdir_index = -1;
+        }
+
+      theme->dirs = g_list_prepend (theme->dirs, dir);
     }
 
   if (strcmp (theme->name, FALLBACK_ICON_THEME) == 0)
@@ -5437,10 +5729,23 @@ gtk_icon_theme_lookup_by_gicon_for_scale (GtkIconTheme       *icon_theme,
           max = MAX (width, height);
           pixbuf_scale = (gdouble) size * scale / (gdouble) max;
 
-          scaled = gdk_pixbuf_scale_simple (pixbuf,
-                                            0.5 + width * pixbuf_scale,
-                                            0.5 + height * pixbuf_scale,
-                                            GDK_INTERP_BILINEAR);
+          /* Repeated lookups of the same pixbuf at the same size are
+           * common (think a model shared between views), so keep the
+           * rescaled copy around rather than resampling per lookup.
+           */
+          scaled = g_object_get_data (G_OBJECT (pixbuf), "gtk-icon-theme-scaled-pixbuf");
+          if (scaled != NULL &&
+              MAX (gdk_pixbuf_get_width (scaled), gdk_pixbuf_get_height (scaled)) == size * scale)
+            g_object_ref (scaled);
+          else
+            {
+              scaled = gdk_pixbuf_scale_simple (pixbuf,
+                                                0.5 + width * pixbuf_scale,
+                                                0.5 + height * pixbuf_scale,
+                                                GDK_INTERP_BILINEAR);
+              g_object_set_data_full (G_OBJECT (pixbuf), "gtk-icon-theme-scaled-pixbuf",
+                                      g_object_ref (scaled), g_object_unref);
+            }
 
           info = gtk_icon_info_new_for_pixbuf (icon_theme, scaled);
 
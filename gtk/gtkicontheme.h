@@ -212,6 +212,12 @@ GtkIconInfo * gtk_icon_theme_lookup_icon_for_scale (GtkIconTheme
                                                     gint                         size,
                                                     gint                         scale,
                                                     GtkIconLookupFlags           flags);
+GDK_AVAILABLE_IN_3_18
+GtkIconInfo **gtk_icon_theme_lookup_batch          (GtkIconTheme                *icon_theme,
+                                                    const gchar                **icon_names,
+                                                    const gint                  *sizes,
+                                                    gint                         n_icons,
+                                                    GtkIconLookupFlags           flags);
 
 GDK_AVAILABLE_IN_ALL
 GtkIconInfo * gtk_icon_theme_choose_icon           (GtkIconTheme                *icon_theme,
@@ -266,6 +272,10 @@ GDK_AVAILABLE_IN_ALL
 GList *       gtk_icon_theme_list_contexts         (GtkIconTheme                *icon_theme);
 GDK_AVAILABLE_IN_ALL
 char *        gtk_icon_theme_get_example_icon_name (GtkIconTheme                *icon_theme);
+GDK_AVAILABLE_IN_3_18
+void          gtk_icon_theme_get_cache_stats     (GtkIconTheme                *icon_theme,
+                                                  guint                       *n_infos,
+                                                  guint64                     *pixel_bytes);
 
 GDK_AVAILABLE_IN_ALL
 gboolean      gtk_icon_theme_rescan_if_needed      (GtkIconTheme                *icon_theme);
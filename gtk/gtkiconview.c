@@ -84,6 +84,7 @@ enum
   TOGGLE_CURSOR_ITEM,
   MOVE_CURSOR,
   ACTIVATE_CURSOR_ITEM,
+  PREFETCH_ITEMS,
   LAST_SIGNAL
 };
 
@@ -111,7 +112,8 @@ enum
   PROP_VADJUSTMENT,
   PROP_HSCROLL_POLICY,
   PROP_VSCROLL_POLICY,
-  PROP_ACTIVATE_ON_SINGLE_CLICK
+  PROP_ACTIVATE_ON_SINGLE_CLICK,
+  PROP_PREFETCH_ROWS
 };
 
 /* GObject vfuncs */
@@ -190,6 +192,7 @@ static void                 gtk_icon_view_set_vadjustment                (GtkIco
 static void                 gtk_icon_view_adjustment_changed             (GtkAdjustment          *adjustment,
 									  GtkIconView            *icon_view);
 static void                 gtk_icon_view_layout                         (GtkIconView            *icon_view);
+static void                 gtk_icon_view_maybe_prefetch                 (GtkIconView            *icon_view);
 static void                 gtk_icon_view_paint_item                     (GtkIconView            *icon_view,
 									  cairo_t                *cr,
 									  GtkIconViewItem        *item,
@@ -654,6 +657,23 @@ gtk_icon_view_class_init (GtkIconViewClass *klass)
 							 FALSE,
 							 GTK_PARAM_READWRITE|G_PARAM_EXPLICIT_NOTIFY));
 
+  /**
+   * GtkIconView:prefetch-rows:
+   *
+   * The number of rows above and below the visible range that are
+   * included in the #GtkIconView::prefetch-items signal. A value of
+   * zero disables emission of the signal.
+   *
+   * Since: 3.18
+   */
+  g_object_class_install_property (gobject_class,
+                                   PROP_PREFETCH_ROWS,
+                                   g_param_spec_int ("prefetch-rows",
+                                                     P_("Prefetch Rows"),
+                                                     P_("Number of rows to prefetch ahead of the visible range"),
+                                                     0, G_MAXINT, 0,
+                                                     GTK_PARAM_READWRITE|G_PARAM_EXPLICIT_NOTIFY));
+
   /* Scrollable interface properties */
   g_object_class_override_property (gobject_class, PROP_HADJUSTMENT,    "hadjustment");
   g_object_class_override_property (gobject_class, PROP_VADJUSTMENT,    "vadjustment");
@@ -700,6 +720,36 @@ gtk_icon_view_class_init (GtkIconViewClass *klass)
 		  G_TYPE_NONE, 1,
 		  GTK_TYPE_TREE_PATH);
 
+  /**
+   * GtkIconView::prefetch-items:
+   * @iconview: the object on which the signal is emitted
+   * @start_path: the #GtkTreePath of the first item in the range
+   * @end_path: the #GtkTreePath of the last item in the range
+   *
+   * The ::prefetch-items signal is emitted when the range of items
+   * that is visible, or about to become visible, changes. The range
+   * covers the visible rows extended by #GtkIconView:prefetch-rows
+   * rows above and below, so applications that load expensive item
+   * content, such as thumbnails, can schedule loading before the
+   * items scroll into view.
+   *
+   * The signal is only emitted when #GtkIconView:prefetch-rows is
+   * greater than zero. The range is a hint; items in it may never
+   * actually become visible.
+   *
+   * Since: 3.18
+   */
+  icon_view_signals[PREFETCH_ITEMS] =
+    g_signal_new (I_("prefetch-items"),
+		  G_TYPE_FROM_CLASS (gobject_class),
+		  G_SIGNAL_RUN_LAST,
+		  0,
+		  NULL, NULL,
+		  _gtk_marshal_VOID__BOXED_BOXED,
+		  G_TYPE_NONE, 2,
+		  GTK_TYPE_TREE_PATH,
+		  GTK_TYPE_TREE_PATH);
+
   /**
    * GtkIconView::selection-changed:
    * @iconview: the object on which the signal is emitted
@@ -977,6 +1027,9 @@ gtk_icon_view_init (GtkIconView *icon_view)
   icon_view->priv->margin = 6;
   icon_view->priv->item_padding = 6;
   icon_view->priv->activate_on_single_click = FALSE;
+  icon_view->priv->prefetch_rows = 0;
+  icon_view->priv->prefetch_first = -1;
+  icon_view->priv->prefetch_last = -1;
 
   icon_view->priv->draw_focus = TRUE;
 
@@ -1101,6 +1154,10 @@ gtk_icon_view_set_property (GObject      *object,
       gtk_icon_view_set_activate_on_single_click (icon_view, g_value_get_boolean (value));
       break;
 
+    case PROP_PREFETCH_ROWS:
+      gtk_icon_view_set_prefetch_rows (icon_view, g_value_get_int (value));
+      break;
+
     case PROP_CELL_AREA:
       /* Construct-only, can only be assigned once */
       area = g_value_get_object (value);
@@ -1209,6 +1266,10 @@ gtk_icon_view_get_property (GObject      *object,
       g_value_set_boolean (value, icon_view->priv->activate_on_single_click);
       break;
 
+    case PROP_PREFETCH_ROWS:
+      g_value_set_int (value, icon_view->priv->prefetch_rows);
+      break;
+
     case PROP_CELL_AREA:
       g_value_set_object (value, icon_view->priv->cell_area);
       break;
@@ -2892,6 +2953,8 @@ gtk_icon_view_adjustment_changed (GtkAdjustment *adjustment,
         gtk_icon_view_update_rubberband (GTK_WIDGET (icon_view));
 
       _gtk_icon_view_accessible_adjustment_changed (icon_view);
+
+      gtk_icon_view_maybe_prefetch (icon_view);
     }
 }
 
@@ -3023,6 +3086,82 @@ gtk_icon_view_layout (GtkIconView *icon_view)
   priv->height -= priv->row_spacing;
   priv->height += priv->margin;
   priv->height = MAX (priv->height, gtk_widget_get_allocated_height (widget));
+
+  gtk_icon_view_maybe_prefetch (icon_view);
+}
+
+/* Emits ::prefetch-items for the visible rows extended by
+ * prefetch-rows rows above and below, if that range changed since
+ * the last emission. Items are laid out row-major, so the range is
+ * always a contiguous span of indexes.
+ */
+static void
+gtk_icon_view_maybe_prefetch (GtkIconView *icon_view)
+{
+  GtkIconViewPrivate *priv = icon_view->priv;
+  GtkTreePath *start_path, *end_path;
+  GList *icons;
+  gint first_row = -1;
+  gint last_row = -1;
+  gint first_index = -1;
+  gint last_index = -1;
+  gint value, page_size;
+
+  if (priv->prefetch_rows <= 0 ||
+      priv->vadjustment == NULL ||
+      priv->items == NULL)
+    return;
+
+  value = (gint) gtk_adjustment_get_value (priv->vadjustment);
+  page_size = (gint) gtk_adjustment_get_page_size (priv->vadjustment);
+
+  for (icons = priv->items; icons; icons = icons->next)
+    {
+      GtkIconViewItem *item = icons->data;
+
+      if (item->cell_area.y + item->cell_area.height >= value &&
+          item->cell_area.y <= value + page_size)
+        {
+          if (first_row == -1)
+            first_row = item->row;
+          last_row = item->row;
+        }
+    }
+
+  if (first_row == -1)
+    return;
+
+  first_row = MAX (first_row - priv->prefetch_rows, 0);
+  last_row += priv->prefetch_rows;
+
+  for (icons = priv->items; icons; icons = icons->next)
+    {
+      GtkIconViewItem *item = icons->data;
+
+      if (item->row >= first_row && item->row <= last_row)
+        {
+          if (first_index == -1)
+            first_index = item->index;
+          last_index = item->index;
+        }
+    }
+
+  if (first_index == -1 ||
+      (first_index == priv->prefetch_first &&
+       last_index == priv->prefetch_last))
+    return;
+
+  priv->prefetch_first = first_index;
+  priv->prefetch_last = last_index;
+
+  start_path = gtk_tree_path_new_from_indices (first_index, -1);
+  end_path = gtk_tree_path_new_from_indices (last_index, -1);
+
+  g_signal_emit (icon_view, icon_view_signals[PREFETCH_ITEMS], 0,
+                 start_path, end_path);
+
+  gtk_tree_path_free (start_path);
+  gtk_tree_path_free (end_path);
 }
 
 static void
@@ -4936,6 +5075,9 @@ gtk_icon_view_set_model (GtkIconView *icon_view,
       icon_view->priv->scroll_to_path = NULL;
     }
 
+  icon_view->priv->prefetch_first = -1;
+  icon_view->priv->prefetch_last = -1;
+
   /* The area can be NULL while disposing */
   if (icon_view->priv->cell_area)
     gtk_cell_area_stop_editing (icon_view->priv->cell_area, TRUE);
@@ -7217,6 +7359,57 @@ gtk_icon_view_get_activate_on_single_click (GtkIconView *icon_view)
   return icon_view->priv->activate_on_single_click;
 }
 
+/**
+ * gtk_icon_view_set_prefetch_rows:
+ * @icon_view: a #GtkIconView
+ * @rows: the number of rows to prefetch above and below the visible
+ *     range, or 0 to disable prefetching
+ *
+ * Sets the number of rows above and below the visible range that are
+ * included in the #GtkIconView::prefetch-items signal. Setting this
+ * to a value greater than zero enables emission of the signal, which
+ * applications can use to start loading expensive item content, such
+ * as thumbnails, before the items scroll into view.
+ *
+ * Since: 3.18
+ **/
+void
+gtk_icon_view_set_prefetch_rows (GtkIconView *icon_view,
+                                 gint         rows)
+{
+  g_return_if_fail (GTK_IS_ICON_VIEW (icon_view));
+  g_return_if_fail (rows >= 0);
+
+  if (icon_view->priv->prefetch_rows == rows)
+    return;
+
+  icon_view->priv->prefetch_rows = rows;
+  icon_view->priv->prefetch_first = -1;
+  icon_view->priv->prefetch_last = -1;
+
+  g_object_notify (G_OBJECT (icon_view), "prefetch-rows");
+
+  gtk_icon_view_maybe_prefetch (icon_view);
+}
+
+/**
+ * gtk_icon_view_get_prefetch_rows:
+ * @icon_view: a #GtkIconView
+ *
+ * Gets the setting set by gtk_icon_view_set_prefetch_rows().
+ *
+ * Returns: the number of rows prefetched ahead of the visible range
+ *
+ * Since: 3.18
+ **/
+gint
+gtk_icon_view_get_prefetch_rows (GtkIconView *icon_view)
+{
+  g_return_val_if_fail (GTK_IS_ICON_VIEW (icon_view), 0);
+
+  return icon_view->priv->prefetch_rows;
+}
+
 static gboolean
 gtk_icon_view_buildable_custom_tag_start (GtkBuildable  *buildable,
                                           GtkBuilder    *builder,
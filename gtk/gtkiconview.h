@@ -194,6 +194,11 @@ GDK_AVAILABLE_IN_ALL
 gboolean       gtk_icon_view_get_visible_range (GtkIconView      *icon_view,
 						GtkTreePath     **start_path,
 						GtkTreePath     **end_path);
+GDK_AVAILABLE_IN_3_18
+void           gtk_icon_view_set_prefetch_rows  (GtkIconView    *icon_view,
+                                                 gint            rows);
+GDK_AVAILABLE_IN_3_18
+gint           gtk_icon_view_get_prefetch_rows  (GtkIconView    *icon_view);
 GDK_AVAILABLE_IN_3_8
 void           gtk_icon_view_set_activate_on_single_click (GtkIconView  *icon_view,
                                                            gboolean      single);
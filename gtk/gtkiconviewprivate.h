@@ -110,6 +110,11 @@ struct _GtkIconViewPrivate
   gfloat scroll_to_col_align;
   guint scroll_to_use_align : 1;
 
+  /* prefetch */
+  gint prefetch_rows;
+  gint prefetch_first;
+  gint prefetch_last;
+
   guint source_set : 1;
   guint dest_set : 1;
   guint reorderable : 1;
@@ -37,6 +37,7 @@
 #include "gtkicontheme.h"
 #include "gtksizerequest.h"
 #include "gtkintl.h"
+#include "gtkpango.h"
 #include "gtkprivate.h"
 #include "gtktypebuiltins.h"
 #include "gtkcssshadowsvalueprivate.h"
@@ -1043,11 +1044,26 @@ gtk_image_set_from_pixbuf (GtkImage  *image,
   priv = image->priv;
 
   g_object_freeze_notify (G_OBJECT (image));
-  
-  gtk_image_clear (image);
 
-  if (pixbuf != NULL)
-    _gtk_icon_helper_set_pixbuf (priv->icon_helper, pixbuf);
+  /* A pixbuf with the same dimensions as the current one can be
+   * swapped in place: the size request can't change, so only a redraw
+   * is needed instead of a full reset and relayout. Frame sources
+   * (camera previews, thumbnailers) hit this on every update.
+   */
+  if (pixbuf != NULL &&
+      priv->filename == NULL &&
+      priv->resource_path == NULL &&
+      _gtk_icon_helper_replace_pixbuf (priv->icon_helper, pixbuf))
+    {
+      gtk_widget_queue_draw (GTK_WIDGET (image));
+    }
+  else
+    {
+      gtk_image_clear (image);
+
+      if (pixbuf != NULL)
+        _gtk_icon_helper_set_pixbuf (priv->icon_helper, pixbuf);
+    }
 
   g_object_notify_by_pspec (G_OBJECT (image), image_props[PROP_PIXBUF]);
   
@@ -1659,9 +1675,7 @@ gtk_image_get_baseline_align (GtkImage *image)
   if (image->priv->baseline_align == 0.0)
     {
       pango_context = gtk_widget_get_pango_context (GTK_WIDGET (image));
-      metrics = pango_context_get_metrics (pango_context,
-					   pango_context_get_font_description (pango_context),
-					   pango_context_get_language (pango_context));
+      metrics = _gtk_pango_get_metrics (pango_context);
       image->priv->baseline_align =
 	(float)pango_font_metrics_get_ascent (metrics) /
 	(pango_font_metrics_get_ascent (metrics) + pango_font_metrics_get_descent (metrics));
@@ -56,8 +56,27 @@ struct _GtkComposeTable
   const guint16 *data;
   gint max_seq_len;
   gint n_seqs;
+
+  /* First-keysym transition index, built lazily by
+   * gtk_compose_table_ensure_index(). Each distinct first keysym in
+   * the table maps to the contiguous range of rows starting with it,
+   * so matching only ever searches within that range.
+   */
+  guint16 *index_firsts;
+  guint   *index_offsets;
+  gint     n_index_firsts;
 };
 
+static void
+gtk_compose_table_free (gpointer data)
+{
+  GtkComposeTable *table = data;
+
+  g_free (table->index_firsts);
+  g_free (table->index_offsets);
+  g_free (table);
+}
+
 struct _GtkComposeTableCompact
 {
   const guint16 *data;
@@ -138,7 +157,7 @@ gtk_im_context_simple_finalize (GObject *obj)
   GtkIMContextSimple *context_simple = GTK_IM_CONTEXT_SIMPLE (obj);
   GtkIMContextSimplePrivate *priv = context_simple->priv;
 
-  g_slist_free_full (priv->tables, g_free);
+  g_slist_free_full (priv->tables, gtk_compose_table_free);
 
   G_OBJECT_CLASS (gtk_im_context_simple_parent_class)->finalize (obj);
 }
@@ -216,23 +235,90 @@ compare_seq (const void *key, const void *value)
   return 0;
 }
 
+static int
+compare_seq_first (const void *key, const void *value)
+{
+  const guint *keysym = key;
+  const guint16 *first = value;
+
+  if (*keysym < *first)
+    return -1;
+  else if (*keysym > *first)
+    return 1;
+
+  return 0;
+}
+
+static void
+gtk_compose_table_ensure_index (GtkComposeTable *table)
+{
+  gint row_stride = table->max_seq_len + 2;
+  gint i, n;
+
+  if (table->index_firsts)
+    return;
+
+  /* Since the table is sorted, rows sharing a first keysym are
+   * contiguous; one linear pass collects the range boundaries.
+   */
+  table->index_firsts = g_new (guint16, table->n_seqs);
+  table->index_offsets = g_new (guint, table->n_seqs + 1);
+  n = 0;
+
+  for (i = 0; i < table->n_seqs; i++)
+    {
+      guint16 first = table->data[i * row_stride];
+
+      if (n == 0 || table->index_firsts[n - 1] != first)
+	{
+	  table->index_firsts[n] = first;
+	  table->index_offsets[n] = i;
+	  n++;
+	}
+    }
+
+  table->index_offsets[n] = table->n_seqs;
+  table->n_index_firsts = n;
+}
+
 static gboolean
 check_table (GtkIMContextSimple    *context_simple,
-	     const GtkComposeTable *table,
+	     GtkComposeTable       *table,
 	     gint                   n_compose)
 {
   GtkIMContextSimplePrivate *priv = context_simple->priv;
   gint row_stride = table->max_seq_len + 2; 
+  const guint16 *range_start;
+  const guint16 *range_end;
+  guint16 *first;
   guint16 *seq; 
+  gint pos;
   
   /* Will never match, if the sequence in the compose buffer is longer
    * than the sequences in the table.  Further, compare_seq (key, val)
    * will overrun val if key is longer than val. */
   if (n_compose > table->max_seq_len)
     return FALSE;
-  
+
+  gtk_compose_table_ensure_index (table);
+
+  /* Take the automaton's first transition: reject sequences whose
+   * first keysym never starts a row without touching the table, and
+   * narrow the search to the rows that share the first keysym.
+   */
+  first = bsearch (priv->compose_buffer,
+		   table->index_firsts, table->n_index_firsts,
+		   sizeof (guint16),
+		   compare_seq_first);
+  if (!first)
+    return FALSE;
+
+  pos = first - table->index_firsts;
+  range_start = table->data + table->index_offsets[pos] * row_stride;
+  range_end = table->data + table->index_offsets[pos + 1] * row_stride;
+
   seq = bsearch (priv->compose_buffer,
-		 table->data, table->n_seqs,
+		 range_start, (range_end - range_start) / row_stride,
 		 sizeof (guint16) *  row_stride, 
 		 compare_seq);
 
@@ -243,7 +329,7 @@ check_table (GtkIMContextSimple    *context_simple,
       /* Back up to the first sequence that matches to make sure
        * we find the exact match if there is one.
        */
-      while (seq > table->data)
+      while (seq > range_start)
 	{
 	  prev_seq = seq - row_stride;
 	  if (compare_seq (priv->compose_buffer, prev_seq) != 0)
@@ -1237,6 +1323,9 @@ gtk_im_context_simple_add_table (GtkIMContextSimple *context_simple,
   table->data = data;
   table->max_seq_len = max_seq_len;
   table->n_seqs = n_seqs;
+  table->index_firsts = NULL;
+  table->index_offsets = NULL;
+  table->n_index_firsts = 0;
 
   priv->tables = g_slist_prepend (priv->tables, table);
 }
@@ -104,6 +104,63 @@ static void propagate_purpose (GtkIMMulticontext *context);
 
 static const gchar *global_context_id = NULL;
 
+/* Recently released slave contexts, keyed by context id, so that
+ * focus bouncing between widgets does not re-instantiate IM modules
+ * over and over. Each entry holds a bounded list of parked slaves.
+ */
+#define IM_SLAVE_POOL_MAX_PER_ID 4
+
+static GHashTable *im_slave_pool = NULL;
+
+static void
+im_slave_pool_park (const gchar  *context_id,
+                    GtkIMContext *slave)
+{
+  GSList *parked;
+
+  if (context_id == NULL)
+    return;
+
+  if (im_slave_pool == NULL)
+    im_slave_pool = g_hash_table_new_full (g_str_hash, g_str_equal,
+                                           g_free, NULL);
+
+  parked = g_hash_table_lookup (im_slave_pool, context_id);
+
+  if (g_slist_length (parked) >= IM_SLAVE_POOL_MAX_PER_ID)
+    return;
+
+  /* Scrub per-widget state; the caller has already disconnected its
+   * handlers, so none of this emits anything user-visible */
+  gtk_im_context_reset (slave);
+  gtk_im_context_set_client_window (slave, NULL);
+  gtk_im_context_set_use_preedit (slave, TRUE);
+
+  g_hash_table_insert (im_slave_pool, g_strdup (context_id),
+                       g_slist_prepend (parked, g_object_ref (slave)));
+}
+
+static GtkIMContext *
+im_slave_pool_take (const gchar *context_id)
+{
+  GtkIMContext *slave;
+  GSList *parked;
+
+  if (im_slave_pool == NULL)
+    return NULL;
+
+  parked = g_hash_table_lookup (im_slave_pool, context_id);
+  if (parked == NULL)
+    return NULL;
+
+  slave = parked->data;
+  g_hash_table_insert (im_slave_pool, g_strdup (context_id),
+                       g_slist_delete_link (parked, parked));
+
+  /* The pool's reference is transferred to the caller */
+  return slave;
+}
+
 G_DEFINE_TYPE_WITH_PRIVATE (GtkIMMulticontext, gtk_im_multicontext, GTK_TYPE_IM_CONTEXT)
 
 static void
@@ -193,6 +250,17 @@ gtk_im_multicontext_set_slave (GtkIMMulticontext *multicontext,
       g_signal_handlers_disconnect_by_func (priv->slave,
 					    gtk_im_multicontext_commit_cb,
 					    multicontext);
+      g_signal_handlers_disconnect_by_func (priv->slave,
+					    gtk_im_multicontext_retrieve_surrounding_cb,
+					    multicontext);
+      g_signal_handlers_disconnect_by_func (priv->slave,
+					    gtk_im_multicontext_delete_surrounding_cb,
+					    multicontext);
+
+      if (priv->focus_in)
+	gtk_im_context_focus_out (priv->slave);
+
+      im_slave_pool_park (priv->context_id, priv->slave);
 
       g_object_unref (priv->slave);
       priv->slave = NULL;
@@ -272,7 +340,9 @@ gtk_im_multicontext_get_slave (GtkIMMulticontext *multicontext)
 
       priv->context_id = g_strdup (get_effective_context_id (multicontext));
 
-      slave = _gtk_im_module_create (priv->context_id);
+      slave = im_slave_pool_take (priv->context_id);
+      if (!slave)
+        slave = _gtk_im_module_create (priv->context_id);
       if (slave)
         {
           gtk_im_multicontext_set_slave (multicontext, slave, FALSE);
@@ -130,6 +130,12 @@ gtk_kinetic_scrolling_free (GtkKineticScrolling *kinetic)
   g_slice_free (GtkKineticScrolling, kinetic);
 }
 
+gdouble
+gtk_kinetic_scrolling_get_velocity (GtkKineticScrolling *data)
+{
+  return data->velocity;
+}
+
 static void
 gtk_kinetic_scrolling_init_overshoot (GtkKineticScrolling *data,
                                       gdouble              equilibrium_position,
@@ -38,6 +38,8 @@ gboolean                 gtk_kinetic_scrolling_tick (GtkKineticScrolling  *data,
                                                      gdouble               time_delta,
                                                      gdouble              *position);
 
+gdouble                  gtk_kinetic_scrolling_get_velocity (GtkKineticScrolling *data);
+
 G_END_DECLS
 
 #endif /* __GTK_KINETIC_SCROLLING_H__ */
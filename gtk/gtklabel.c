@@ -239,6 +239,15 @@ struct _GtkLabelPrivate
   gchar   *label;
   gchar   *text;
 
+  /* Compiled result of the last plain (no mnemonic, no links) markup
+   * parse, so that resetting the same markup applies it without going
+   * through the two markup parsers again; compiled_markup is %NULL
+   * when nothing is compiled.
+   */
+  gchar         *compiled_markup;
+  gchar         *compiled_text;
+  PangoAttrList *compiled_attrs;
+
   gdouble  angle;
   gfloat   xalign;
   gfloat   yalign;
@@ -261,6 +270,16 @@ struct _GtkLabelPrivate
   gint     width_chars;
   gint     max_width_chars;
   gint     lines;
+
+  /* Memoized result of the last wrapped size request; for_size is -1
+   * when nothing is memoized. Every width between the widest line of
+   * the wrapped result and the width the lines were broken for yields
+   * the same line breaks, so all of them measure the same.
+   */
+  gint     wrap_memo_for_size;
+  gint     wrap_memo_used_size;
+  gint     wrap_memo_size;
+  gint     wrap_memo_baseline;
 };
 
 /* Notes about the handling of links:
@@ -1309,6 +1328,7 @@ gtk_label_init (GtkLabel *label)
   priv->max_width_chars = -1;
   priv->label = NULL;
   priv->lines = -1;
+  priv->wrap_memo_for_size = -1;
 
   priv->xalign = 0.5;
   priv->yalign = 0.5;
@@ -2592,6 +2612,28 @@ gtk_label_set_markup_internal (GtkLabel    *label,
   gchar *str_for_accel = NULL;
   GList *links = NULL;
 
+  /* Apply the compiled parse when the markup did not change; callers
+   * like tickers reset near-identical markup at a fixed interval and
+   * regularly hit the fully identical case.
+   */
+  if (!with_uline &&
+      priv->compiled_markup != NULL &&
+      strcmp (priv->compiled_markup, str) == 0)
+    {
+      gtk_label_set_text_internal (label, g_strdup (priv->compiled_text));
+
+      if (priv->compiled_attrs)
+        {
+          if (priv->markup_attrs)
+            pango_attr_list_unref (priv->markup_attrs);
+          priv->markup_attrs = pango_attr_list_ref (priv->compiled_attrs);
+        }
+
+      priv->mnemonic_keyval = GDK_KEY_VoidSymbol;
+
+      return;
+    }
+
   if (!parse_uri_markup (label, str, &str_for_display, &links, &error))
     {
       g_warning ("Failed to set text '%s` from markup due to error parsing markup: %s",
@@ -2678,6 +2720,25 @@ gtk_label_set_markup_internal (GtkLabel    *label,
   if (text)
     gtk_label_set_text_internal (label, text);
 
+  /* Compile the parse for next time. Mnemonic parsing depends on
+   * settings and widget state, and links carry per-link state in the
+   * select info, so only the plain case is kept.
+   */
+  g_free (priv->compiled_markup);
+  g_free (priv->compiled_text);
+  if (priv->compiled_attrs)
+    pango_attr_list_unref (priv->compiled_attrs);
+  priv->compiled_markup = NULL;
+  priv->compiled_text = NULL;
+  priv->compiled_attrs = NULL;
+
+  if (!with_uline && links == NULL && text != NULL)
+    {
+      priv->compiled_markup = g_strdup (str);
+      priv->compiled_text = g_strdup (text);
+      priv->compiled_attrs = attrs ? pango_attr_list_ref (attrs) : NULL;
+    }
+
   if (attrs)
     {
       if (priv->markup_attrs)
@@ -2725,8 +2786,21 @@ void
 gtk_label_set_markup (GtkLabel    *label,
                       const gchar *str)
 {
+  GtkLabelPrivate *priv;
+
   g_return_if_fail (GTK_IS_LABEL (label));
 
+  priv = label->priv;
+
+  /* Setting the exact markup the label already shows is a no-op; skip
+   * the reparse and relayout. Labels with links keep per-link state
+   * that a real reset would clear, so those take the long way.
+   */
+  if (priv->use_markup && !priv->use_underline &&
+      (priv->select_info == NULL || priv->select_info->links == NULL) &&
+      g_strcmp0 (priv->label, str ? str : "") == 0)
+    return;
+
   g_object_freeze_notify (G_OBJECT (label));
 
   gtk_label_set_label_internal (label, g_strdup (str ? str : ""));
@@ -3226,6 +3300,11 @@ gtk_label_finalize (GObject *object)
   if (priv->markup_attrs)
     pango_attr_list_unref (priv->markup_attrs);
 
+  g_free (priv->compiled_markup);
+  g_free (priv->compiled_text);
+  if (priv->compiled_attrs)
+    pango_attr_list_unref (priv->compiled_attrs);
+
   gtk_label_clear_links (label);
   g_free (priv->select_info);
 
@@ -3245,6 +3324,8 @@ gtk_label_clear_layout (GtkLabel *label)
       g_object_unref (priv->layout);
       priv->layout = NULL;
     }
+
+  priv->wrap_memo_for_size = -1;
 }
 
 /**
@@ -3576,12 +3657,57 @@ get_size_for_allocation (GtkLabel        *label,
 			 gint            *minimum_baseline,
                          gint            *natural_baseline)
 {
+  GtkLabelPrivate *priv = label->priv;
   PangoLayout *layout;
+  PangoRectangle rect;
   gint text_height, baseline;
 
+  /* Re-wrapping the layout dominates the cost of height-for-width
+   * requests, so before going back to pango, check whether @allocation
+   * falls into the interval covered by the last wrapped result.
+   */
+  if (priv->wrap_memo_for_size >= 0 &&
+      allocation <= priv->wrap_memo_for_size &&
+      allocation >= priv->wrap_memo_used_size)
+    {
+      if (minimum_size)
+	*minimum_size = priv->wrap_memo_size;
+
+      if (natural_size)
+	*natural_size = priv->wrap_memo_size;
+
+      if (minimum_baseline)
+	*minimum_baseline = priv->wrap_memo_baseline;
+
+      if (natural_baseline)
+	*natural_baseline = priv->wrap_memo_baseline;
+
+      return;
+    }
+
+  /* The layout is likely set up for the current allocation; force a
+   * fresh one for the width we are asked about.
+   */
+  if (priv->wrap)
+    gtk_label_clear_layout (label);
+
   layout = gtk_label_get_measuring_layout (label, NULL, allocation * PANGO_SCALE);
 
   pango_layout_get_pixel_size (layout, NULL, &text_height);
+  baseline = pango_layout_get_baseline (layout) / PANGO_SCALE;
+
+  /* Ellipsized lines are re-fitted to every width, so only remember
+   * results whose line breaks stay put.
+   */
+  if (!pango_layout_is_ellipsized (layout))
+    {
+      pango_layout_get_extents (layout, NULL, &rect);
+
+      priv->wrap_memo_for_size = allocation;
+      priv->wrap_memo_used_size = MIN (PANGO_PIXELS_CEIL (rect.width), allocation);
+      priv->wrap_memo_size = text_height;
+      priv->wrap_memo_baseline = baseline;
+    }
 
   if (minimum_size)
     *minimum_size = text_height;
@@ -3589,15 +3715,11 @@ get_size_for_allocation (GtkLabel        *label,
   if (natural_size)
     *natural_size = text_height;
 
-  if (minimum_baseline || natural_baseline)
-    {
-      baseline = pango_layout_get_baseline (layout) / PANGO_SCALE;
-      if (minimum_baseline)
-	*minimum_baseline = baseline;
+  if (minimum_baseline)
+    *minimum_baseline = baseline;
 
-      if (natural_baseline)
-	*natural_baseline = baseline;
-    }
+  if (natural_baseline)
+    *natural_baseline = baseline;
 
   g_object_unref (layout);
 }
@@ -3611,9 +3733,7 @@ get_char_pixels (GtkWidget   *label,
   gint char_width, digit_width;
 
   context = pango_layout_get_context (layout);
-  metrics = pango_context_get_metrics (context,
-                                       pango_context_get_font_description (context),
-                                       pango_context_get_language (context));
+  metrics = _gtk_pango_get_metrics (context);
   char_width = pango_font_metrics_get_approximate_char_width (metrics);
   digit_width = pango_font_metrics_get_approximate_digit_width (metrics);
   pango_font_metrics_unref (metrics);
@@ -3859,9 +3979,6 @@ G_GNUC_BEGIN_IGNORE_DEPRECATIONS
       _gtk_misc_get_padding_and_border (GTK_MISC (label), &border);
 G_GNUC_END_IGNORE_DEPRECATIONS
 
-      if (priv->wrap)
-        gtk_label_clear_layout (label);
-
       get_size_for_allocation (label, GTK_ORIENTATION_VERTICAL,
                                MAX (1, height - border.top - border.bottom),
                                minimum_width, natural_width,
@@ -3896,9 +4013,6 @@ G_GNUC_BEGIN_IGNORE_DEPRECATIONS
       _gtk_misc_get_padding_and_border (GTK_MISC (label), &border);
 G_GNUC_END_IGNORE_DEPRECATIONS
 
-      if (priv->wrap)
-        gtk_label_clear_layout (label);
-
       get_size_for_allocation (label, GTK_ORIENTATION_HORIZONTAL,
                                MAX (1, width - border.left - border.right),
                                minimum_height, natural_height,
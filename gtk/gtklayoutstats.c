@@ -0,0 +1,189 @@
+/* GTK - The GIMP Toolkit
+ * Copyright (C) 2015 Red Hat, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/* Layout cycle instrumentation.
+ *
+ * When the GTK_LAYOUT_STATS_FILE environment variable names a writable
+ * file, every layout frame run by the container idle sizer appends one
+ * CSV line per participating widget:
+ *
+ *   frame,time-us,widget,type,measures,allocates,requeues
+ *
+ * The requeues column counts resizes queued on the widget while the
+ * frame was being laid out. A widget with a non-zero count restarts
+ * layout from within layout, which is how layout feedback loops start;
+ * grepping the file for lines whose last field is non-zero yields the
+ * offender list directly. GTK_DEBUG=size-request prints individual
+ * requests, but nothing aggregated per frame and nothing a script can
+ * diff across runs. When the variable is unset every probe is a cheap
+ * branch, so the probes can stay in production builds.
+ */
+
+#include "config.h"
+
+#include "gtklayoutstatsprivate.h"
+
+#include <stdio.h>
+
+typedef struct {
+  const gchar *type_name;
+  guint measures;
+  guint allocates;
+  guint requeues;
+} WidgetStats;
+
+static FILE *stats_file = NULL;
+static GHashTable *stats_by_widget = NULL;
+static gboolean in_frame = FALSE;
+static gint64 frame_serial = 0;
+
+static void
+widget_stats_free (gpointer data)
+{
+  g_slice_free (WidgetStats, data);
+}
+
+void
+_gtk_layout_stats_init (void)
+{
+  static gboolean initialized = FALSE;
+  const gchar *path;
+
+  if (initialized)
+    return;
+
+  initialized = TRUE;
+
+  path = g_getenv ("GTK_LAYOUT_STATS_FILE");
+  if (path == NULL || path[0] == '\0')
+    return;
+
+  stats_file = fopen (path, "w");
+  if (stats_file == NULL)
+    {
+      g_warning ("Failed to open layout stats file '%s'", path);
+      return;
+    }
+
+  fputs ("frame,time-us,widget,type,measures,allocates,requeues\n", stats_file);
+
+  stats_by_widget = g_hash_table_new_full (NULL, NULL, NULL, widget_stats_free);
+}
+
+gboolean
+_gtk_layout_stats_is_enabled (void)
+{
+  return stats_file != NULL;
+}
+
+static WidgetStats *
+layout_stats_lookup (GtkWidget *widget)
+{
+  WidgetStats *stats;
+
+  stats = g_hash_table_lookup (stats_by_widget, widget);
+  if (stats == NULL)
+    {
+      stats = g_slice_new0 (WidgetStats);
+      /* The type name outlives the widget, which may well be destroyed
+       * before the frame ends; the pointer is only ever printed.
+       */
+      stats->type_name = G_OBJECT_TYPE_NAME (widget);
+      g_hash_table_insert (stats_by_widget, widget, stats);
+    }
+
+  return stats;
+}
+
+/*
+ * _gtk_layout_stats_frame_begin:
+ *
+ * Opens a layout frame; counts recorded until the matching
+ * _gtk_layout_stats_frame_end() are attributed to it.
+ */
+void
+_gtk_layout_stats_frame_begin (void)
+{
+  if (stats_file == NULL)
+    return;
+
+  in_frame = TRUE;
+}
+
+/*
+ * _gtk_layout_stats_frame_end:
+ *
+ * Closes the current layout frame and writes one line per widget
+ * that was measured, allocated or re-queued while it was open.
+ */
+void
+_gtk_layout_stats_frame_end (void)
+{
+  GHashTableIter iter;
+  gpointer widget;
+  gpointer value;
+  gint64 time_us;
+
+  if (stats_file == NULL || !in_frame)
+    return;
+
+  in_frame = FALSE;
+  time_us = g_get_monotonic_time ();
+
+  g_hash_table_iter_init (&iter, stats_by_widget);
+  while (g_hash_table_iter_next (&iter, &widget, &value))
+    {
+      WidgetStats *stats = value;
+
+      fprintf (stats_file,
+               "%" G_GINT64_FORMAT ",%" G_GINT64_FORMAT ",%p,%s,%u,%u,%u\n",
+               frame_serial, time_us, widget, stats->type_name,
+               stats->measures, stats->allocates, stats->requeues);
+    }
+
+  fflush (stats_file);
+
+  g_hash_table_remove_all (stats_by_widget);
+  frame_serial++;
+}
+
+void
+_gtk_layout_stats_count_measure (GtkWidget *widget)
+{
+  if (stats_file == NULL || !in_frame)
+    return;
+
+  layout_stats_lookup (widget)->measures++;
+}
+
+void
+_gtk_layout_stats_count_allocate (GtkWidget *widget)
+{
+  if (stats_file == NULL || !in_frame)
+    return;
+
+  layout_stats_lookup (widget)->allocates++;
+}
+
+void
+_gtk_layout_stats_count_queue_resize (GtkWidget *widget)
+{
+  if (stats_file == NULL || !in_frame)
+    return;
+
+  layout_stats_lookup (widget)->requeues++;
+}
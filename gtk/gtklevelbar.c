@@ -536,6 +536,127 @@ gtk_level_bar_draw (GtkWidget *widget,
   return FALSE;
 }
 
+/* Extra pixels invalidated around the fill's moving edge, covering the
+ * frame and rounded corners the theme draws there.
+ */
+#define FILL_REDRAW_SLACK 16
+
+/* Invalidate only the part of the trough whose filled state differs
+ * between the old and the new value. Only valid when the severity
+ * class stayed the same, since that class recolors the whole fill.
+ */
+static void
+gtk_level_bar_queue_value_redraw (GtkLevelBar *self,
+                                  gdouble      old_value)
+{
+  GtkWidget *widget = GTK_WIDGET (self);
+  GtkAllocation allocation;
+  GtkBorder trough_borders;
+  cairo_rectangle_int_t fill_area;
+  gboolean inverted;
+  gdouble range;
+  gint space, lo, hi;
+
+  if (!gtk_widget_is_drawable (widget))
+    return;
+
+  range = self->priv->max_value - self->priv->min_value;
+  if (range <= 0)
+    {
+      gtk_widget_queue_draw (widget);
+      return;
+    }
+
+  gtk_level_bar_get_borders (self, &trough_borders);
+  gtk_widget_get_allocation (widget, &allocation);
+
+  fill_area.x = trough_borders.left;
+  fill_area.y = trough_borders.top;
+  fill_area.width = allocation.width - trough_borders.left - trough_borders.right;
+  fill_area.height = allocation.height - trough_borders.top - trough_borders.bottom;
+
+  inverted = self->priv->inverted;
+  if (gtk_widget_get_direction (widget) == GTK_TEXT_DIR_RTL &&
+      self->priv->orientation == GTK_ORIENTATION_HORIZONTAL)
+    inverted = !inverted;
+
+  if (self->priv->orientation == GTK_ORIENTATION_HORIZONTAL)
+    space = fill_area.width;
+  else
+    space = fill_area.height;
+
+  if (space <= 0)
+    return;
+
+  if (self->priv->bar_mode == GTK_LEVEL_BAR_MODE_CONTINUOUS)
+    {
+      gdouble old_p, new_p;
+
+      old_p = CLAMP ((old_value - self->priv->min_value) / range, 0.0, 1.0);
+      new_p = CLAMP ((self->priv->cur_value - self->priv->min_value) / range, 0.0, 1.0);
+
+      if (old_p == new_p)
+        return;
+
+      lo = (gint) floor (space * MIN (old_p, new_p)) - FILL_REDRAW_SLACK;
+      hi = (gint) ceil (space * MAX (old_p, new_p)) + FILL_REDRAW_SLACK;
+    }
+  else
+    {
+      gint num_blocks, block_width, block_height, block_size;
+      gint num_filled_old, num_filled_new;
+
+      num_blocks = gtk_level_bar_get_num_blocks (self);
+      gtk_level_bar_get_min_block_size (self, &block_width, &block_height);
+
+      if (self->priv->orientation == GTK_ORIENTATION_HORIZONTAL)
+        block_size = MAX (block_width, (gint) floor (fill_area.width / num_blocks));
+      else
+        block_size = MAX (block_height, (gint) floor (fill_area.height / num_blocks));
+
+      num_filled_old = (gint) round (old_value) - (gint) round (self->priv->min_value);
+      num_filled_new = (gint) round (self->priv->cur_value) - (gint) round (self->priv->min_value);
+      num_filled_old = CLAMP (num_filled_old, 0, num_blocks);
+      num_filled_new = CLAMP (num_filled_new, 0, num_blocks);
+
+      if (num_filled_old == num_filled_new)
+        return;
+
+      lo = MIN (num_filled_old, num_filled_new) * block_size - FILL_REDRAW_SLACK;
+      hi = MAX (num_filled_old, num_filled_new) * block_size + FILL_REDRAW_SLACK;
+    }
+
+  lo = MAX (lo, 0);
+  hi = MIN (hi, space);
+
+  if (self->priv->orientation == GTK_ORIENTATION_HORIZONTAL)
+    {
+      gint x;
+
+      if (!inverted)
+        x = fill_area.x + lo;
+      else
+        x = fill_area.x + fill_area.width - hi;
+
+      gtk_widget_queue_draw_area (widget,
+                                  allocation.x + x, allocation.y,
+                                  hi - lo, allocation.height);
+    }
+  else
+    {
+      gint y;
+
+      if (!inverted)
+        y = fill_area.y + lo;
+      else
+        y = fill_area.y + fill_area.height - hi;
+
+      gtk_widget_queue_draw_area (widget,
+                                  allocation.x, allocation.y + y,
+                                  allocation.width, hi - lo);
+    }
+}
+
 static void
 gtk_level_bar_get_preferred_width (GtkWidget *widget,
                                    gint      *minimum,
@@ -1257,8 +1378,19 @@ gtk_level_bar_set_value (GtkLevelBar *self,
 
   if (value != self->priv->cur_value)
     {
-      gtk_level_bar_set_value_internal (self, value);
+      gdouble old_value = self->priv->cur_value;
+      gchar *old_class = g_strdup (self->priv->cur_value_class);
+
+      self->priv->cur_value = value;
+      g_object_notify_by_pspec (G_OBJECT (self), properties[PROP_VALUE]);
       gtk_level_bar_update_level_style_classes (self);
+
+      if (g_strcmp0 (old_class, self->priv->cur_value_class) == 0)
+        gtk_level_bar_queue_value_redraw (self, old_value);
+      else
+        gtk_widget_queue_draw (GTK_WIDGET (self));
+
+      g_free (old_class);
     }
 }
 
@@ -105,6 +105,17 @@ typedef struct
   GtkListBoxCreateWidgetFunc create_widget_func;
   gpointer create_widget_func_data;
   GDestroyNotify create_widget_func_data_destroy;
+
+  /* Windowed model binding (see gtk_list_box_bind_model_windowed()) */
+  GtkListBoxBindWidgetFunc bind_widget_func;
+  GtkListBoxUnbindWidgetFunc unbind_widget_func;
+  gboolean model_windowed;
+  guint window_margin;
+  guint window_start;
+  guint window_n_rows;
+  guint window_update_id;
+  gdouble estimated_row_height;
+  GQueue recycle_pool;
 } GtkListBoxPrivate;
 
 typedef struct
@@ -273,6 +284,19 @@ static void                 gtk_list_box_bound_model_changed            (GListMo
                                                                          gpointer             user_data);
 
 static void                 gtk_list_box_check_model_compat             (GtkListBox          *box);
+static void                 gtk_list_box_update_model_window            (GtkListBox          *box);
+static void                 gtk_list_box_bind_windowed_row              (GtkListBox          *box,
+                                                                         guint                model_index,
+                                                                         gint                 list_position);
+static void                 gtk_list_box_recycle_windowed_row           (GtkListBox          *box,
+                                                                         gint                 list_position);
+static void                 gtk_list_box_queue_window_update            (GtkListBox          *box);
+static void                 gtk_list_box_adjustment_window_changed      (GtkAdjustment       *adjustment,
+                                                                         GtkListBox          *box);
+static void                 gtk_list_box_teardown_model_window          (GtkListBox          *box);
+static void                 gtk_list_box_get_windowed_padding           (GtkListBox          *box,
+                                                                         gint                *lead,
+                                                                         gint                *tail);
 static GParamSpec *properties[LAST_PROPERTY] = { NULL, };
 static guint signals[LAST_SIGNAL] = { 0 };
 static GParamSpec *row_properties[LAST_ROW_PROPERTY] = { NULL, };
@@ -380,6 +404,8 @@ gtk_list_box_finalize (GObject *obj)
   if (priv->update_header_func_target_destroy_notify != NULL)
     priv->update_header_func_target_destroy_notify (priv->update_header_func_target);
 
+  gtk_list_box_teardown_model_window (GTK_LIST_BOX (obj));
+
   g_clear_object (&priv->adjustment);
   g_clear_object (&priv->drag_highlighted_row);
   g_clear_object (&priv->multipress_gesture);
@@ -955,8 +981,22 @@ gtk_list_box_set_adjustment (GtkListBox    *box,
   if (adjustment)
     g_object_ref_sink (adjustment);
   if (priv->adjustment)
-    g_object_unref (priv->adjustment);
+    {
+      if (priv->model_windowed)
+        g_signal_handlers_disconnect_by_func (priv->adjustment,
+                                              gtk_list_box_adjustment_window_changed, box);
+      g_object_unref (priv->adjustment);
+    }
   priv->adjustment = adjustment;
+
+  if (priv->adjustment && priv->model_windowed)
+    {
+      g_signal_connect (priv->adjustment, "value-changed",
+                        G_CALLBACK (gtk_list_box_adjustment_window_changed), box);
+      g_signal_connect (priv->adjustment, "changed",
+                        G_CALLBACK (gtk_list_box_adjustment_window_changed), box);
+      gtk_list_box_queue_window_update (box);
+    }
 }
 
 /**
@@ -1235,6 +1275,102 @@ gtk_list_box_invalidate_sort (GtkListBox *box)
   gtk_widget_queue_resize (GTK_WIDGET (box));
 }
 
+/**
+ * gtk_list_box_invalidate_filter_for_row:
+ * @box: a #GtkListBox
+ * @row: a #GtkListBoxRow in @box
+ *
+ * Like gtk_list_box_invalidate_filter(), but only re-tests @row
+ * against the filter function. Call this when an external factor
+ * changed the filter result for a single row; re-filtering only the
+ * affected rows is much cheaper than re-filtering the whole list,
+ * which matters when the filter is driven by something as frequent
+ * as a keystroke.
+ *
+ * Since: 3.18
+ */
+void
+gtk_list_box_invalidate_filter_for_row (GtkListBox    *box,
+                                        GtkListBoxRow *row)
+{
+  gboolean was_visible;
+
+  g_return_if_fail (GTK_IS_LIST_BOX (box));
+  g_return_if_fail (GTK_IS_LIST_BOX_ROW (row));
+  g_return_if_fail (gtk_widget_get_parent (GTK_WIDGET (row)) == GTK_WIDGET (box));
+
+  was_visible = gtk_widget_get_child_visible (GTK_WIDGET (row));
+
+  gtk_list_box_apply_filter (box, row);
+
+  if (was_visible != gtk_widget_get_child_visible (GTK_WIDGET (row)))
+    {
+      if (gtk_widget_get_visible (GTK_WIDGET (box)))
+        {
+          gtk_list_box_update_header (box, ROW_PRIV (row)->iter);
+          gtk_list_box_update_header (box,
+                                      gtk_list_box_get_next_visible (box, ROW_PRIV (row)->iter));
+        }
+      gtk_widget_queue_resize (GTK_WIDGET (box));
+    }
+}
+
+/**
+ * gtk_list_box_invalidate_sort_for_row:
+ * @box: a #GtkListBox
+ * @row: a #GtkListBoxRow in @box
+ *
+ * Like gtk_list_box_invalidate_sort(), but only moves @row to its
+ * new position, leaving the relative order of all other rows alone.
+ * Call this when an external factor changed the sort key of a single
+ * row; repairing one insertion point is much cheaper than resorting
+ * the whole list.
+ *
+ * Since: 3.18
+ */
+void
+gtk_list_box_invalidate_sort_for_row (GtkListBox    *box,
+                                      GtkListBoxRow *row)
+{
+  GtkListBoxPrivate *priv = BOX_PRIV (box);
+  GtkListBoxRowPrivate *row_priv;
+  GSequenceIter *prev_next;
+  GtkCssNode *row_node;
+  GtkCssNode *prev_node = NULL;
+
+  g_return_if_fail (GTK_IS_LIST_BOX (box));
+  g_return_if_fail (GTK_IS_LIST_BOX_ROW (row));
+  g_return_if_fail (gtk_widget_get_parent (GTK_WIDGET (row)) == GTK_WIDGET (box));
+
+  if (priv->sort_func == NULL)
+    return;
+
+  row_priv = ROW_PRIV (row);
+  prev_next = gtk_list_box_get_next_visible (box, row_priv->iter);
+
+  g_sequence_sort_changed (row_priv->iter, (GCompareDataFunc)do_sort, box);
+
+  row_node = gtk_widget_get_css_node (GTK_WIDGET (row));
+  if (!g_sequence_iter_is_begin (row_priv->iter))
+    {
+      GtkWidget *previous;
+
+      previous = g_sequence_get (g_sequence_iter_prev (row_priv->iter));
+      prev_node = gtk_widget_get_css_node (previous);
+    }
+  gtk_css_node_insert_after (gtk_css_node_get_parent (row_node), row_node, prev_node);
+
+  if (gtk_widget_get_visible (GTK_WIDGET (box)))
+    {
+      gtk_list_box_update_header (box, row_priv->iter);
+      gtk_list_box_update_header (box,
+                                  gtk_list_box_get_next_visible (box, row_priv->iter));
+      gtk_list_box_update_header (box, prev_next);
+    }
+
+  gtk_widget_queue_resize (GTK_WIDGET (box));
+}
+
 static void
 gtk_list_box_do_reseparate (GtkListBox *box)
 {
@@ -2526,6 +2662,14 @@ gtk_list_box_get_preferred_height_for_width (GtkWidget *widget,
       minimum_height += row_min;
     }
 
+  if (BOX_PRIV (widget)->model_windowed)
+    {
+      gint lead, tail;
+
+      gtk_list_box_get_windowed_padding (GTK_LIST_BOX (widget), &lead, &tail);
+      minimum_height += lead + tail;
+    }
+
   /* We always allocate the minimum height, since handling expanding rows is way too costly,
    * and unlikely to be used, as lists are generally put inside a scrolling window anyway.
    */
@@ -2601,6 +2745,7 @@ gtk_list_box_size_allocate (GtkWidget     *widget,
   GdkWindow *window;
   GSequenceIter *iter;
   int child_min;
+  int rows_start_y = 0;
 
   child_allocation.x = 0;
   child_allocation.y = 0;
@@ -2636,6 +2781,15 @@ gtk_list_box_size_allocate (GtkWidget     *widget,
       child_allocation.y += child_min;
     }
 
+  if (priv->model_windowed)
+    {
+      gint lead, tail;
+
+      gtk_list_box_get_windowed_padding (GTK_LIST_BOX (widget), &lead, &tail);
+      child_allocation.y += lead;
+      rows_start_y = child_allocation.y;
+    }
+
   for (iter = g_sequence_get_begin_iter (priv->children);
        !g_sequence_iter_is_end (iter);
        iter = g_sequence_iter_next (iter))
@@ -2668,6 +2822,16 @@ gtk_list_box_size_allocate (GtkWidget     *widget,
       gtk_widget_size_allocate (GTK_WIDGET (row), &child_allocation);
       child_allocation.y += child_min;
     }
+
+  if (priv->model_windowed && priv->window_n_rows > 0)
+    {
+      /* Refine the per-row estimate from what we actually allocated and
+       * let the window grow if it turned out too small for the viewport.
+       */
+      priv->estimated_row_height =
+        (gdouble) (child_allocation.y - rows_start_y) / priv->window_n_rows;
+      gtk_list_box_queue_window_update (GTK_LIST_BOX (widget));
+    }
 }
 
 /**
@@ -3705,6 +3869,29 @@ gtk_list_box_bound_model_changed (GListModel *list,
   GtkListBoxPrivate *priv = BOX_PRIV (user_data);
   gint i;
 
+  if (priv->model_windowed)
+    {
+      if (position < priv->window_start + priv->window_n_rows &&
+          position + removed > priv->window_start)
+        {
+          /* The change intersects the materialized window; drop the
+           * window into the recycle pool and rebuild it from scratch.
+           */
+          while (priv->window_n_rows > 0)
+            gtk_list_box_recycle_windowed_row (box, priv->window_n_rows - 1);
+        }
+      else if (position + removed <= priv->window_start)
+        {
+          priv->window_start += added;
+          priv->window_start -= removed;
+        }
+
+      /* The lead/tail padding changed even if no materialized row did */
+      gtk_widget_queue_resize (GTK_WIDGET (box));
+      gtk_list_box_queue_window_update (box);
+      return;
+    }
+
   while (removed--)
     {
       GtkListBoxRow *row;
@@ -3739,6 +3926,250 @@ gtk_list_box_bound_model_changed (GListModel *list,
     }
 }
 
+static void
+gtk_list_box_get_windowed_padding (GtkListBox *box,
+                                   gint       *lead,
+                                   gint       *tail)
+{
+  GtkListBoxPrivate *priv = BOX_PRIV (box);
+  guint n_items, after;
+
+  *lead = 0;
+  *tail = 0;
+
+  if (!priv->model_windowed || priv->bound_model == NULL)
+    return;
+
+  n_items = g_list_model_get_n_items (priv->bound_model);
+  after = n_items - MIN (n_items, priv->window_start + priv->window_n_rows);
+
+  *lead = (gint) (priv->window_start * priv->estimated_row_height + 0.5);
+  *tail = (gint) (after * priv->estimated_row_height + 0.5);
+}
+
+static void
+gtk_list_box_bind_windowed_row (GtkListBox *box,
+                                guint       model_index,
+                                gint        list_position)
+{
+  GtkListBoxPrivate *priv = BOX_PRIV (box);
+  gpointer item;
+  GtkWidget *row;
+
+  item = g_list_model_get_item (priv->bound_model, model_index);
+
+  row = g_queue_pop_head (&priv->recycle_pool);
+  if (row != NULL)
+    {
+      gtk_list_box_insert (box, row, list_position);
+      g_object_unref (row);
+    }
+  else
+    {
+      GtkWidget *widget;
+
+      widget = priv->create_widget_func (item, priv->create_widget_func_data);
+
+      /* See gtk_list_box_bound_model_changed() for the floating
+       * reference dance.
+       */
+      if (g_object_is_floating (widget))
+        g_object_ref_sink (widget);
+
+      gtk_widget_show (widget);
+      gtk_list_box_insert (box, widget, list_position);
+
+      /* Bind and recycle the actual row, which may be an implicitly
+       * created wrapper around what create_widget_func returned.
+       */
+      if (GTK_IS_LIST_BOX_ROW (widget))
+        row = widget;
+      else
+        row = gtk_widget_get_parent (widget);
+
+      g_object_unref (widget);
+    }
+
+  priv->bind_widget_func (GTK_LIST_BOX_ROW (row), item, model_index,
+                          priv->create_widget_func_data);
+
+  g_object_unref (item);
+}
+
+static void
+gtk_list_box_recycle_windowed_row (GtkListBox *box,
+                                   gint        list_position)
+{
+  GtkListBoxPrivate *priv = BOX_PRIV (box);
+  GtkListBoxRow *row;
+
+  row = gtk_list_box_get_row_at_index (box, list_position);
+
+  if (priv->unbind_widget_func)
+    priv->unbind_widget_func (GTK_WIDGET (row), priv->create_widget_func_data);
+
+  g_object_ref (row);
+  gtk_container_remove (GTK_CONTAINER (box), GTK_WIDGET (row));
+  g_queue_push_head (&priv->recycle_pool, row);
+
+  priv->window_n_rows--;
+}
+
+static void
+gtk_list_box_set_model_window (GtkListBox *box,
+                               guint       start,
+                               guint       end)
+{
+  GtkListBoxPrivate *priv = BOX_PRIV (box);
+
+  if (start == priv->window_start &&
+      end == priv->window_start + priv->window_n_rows)
+    return;
+
+  while (priv->window_n_rows > 0 && priv->window_start < start)
+    {
+      gtk_list_box_recycle_windowed_row (box, 0);
+      priv->window_start++;
+    }
+
+  while (priv->window_n_rows > 0 &&
+         priv->window_start + priv->window_n_rows > end)
+    gtk_list_box_recycle_windowed_row (box, priv->window_n_rows - 1);
+
+  if (priv->window_n_rows == 0)
+    priv->window_start = start;
+
+  while (priv->window_start > start)
+    {
+      priv->window_start--;
+      gtk_list_box_bind_windowed_row (box, priv->window_start, 0);
+      priv->window_n_rows++;
+    }
+
+  while (priv->window_start + priv->window_n_rows < end)
+    {
+      gtk_list_box_bind_windowed_row (box,
+                                      priv->window_start + priv->window_n_rows,
+                                      priv->window_n_rows);
+      priv->window_n_rows++;
+    }
+}
+
+static void
+gtk_list_box_update_model_window (GtkListBox *box)
+{
+  GtkListBoxPrivate *priv = BOX_PRIV (box);
+  guint n_items, start, end;
+
+  if (!priv->model_windowed || priv->bound_model == NULL)
+    return;
+
+  n_items = g_list_model_get_n_items (priv->bound_model);
+
+  if (priv->adjustment == NULL)
+    {
+      /* No viewport to clip against, so materialize everything; the
+       * adjustment appears as soon as the box is put in a scrollable.
+       */
+      start = 0;
+      end = n_items;
+    }
+  else if (priv->estimated_row_height <= 0)
+    {
+      /* Bootstrap: materialize enough rows to get a height estimate
+       * from the first allocation, which then resizes the window.
+       */
+      start = 0;
+      end = MIN (n_items, MAX (priv->window_margin, 16));
+    }
+  else
+    {
+      gdouble value, page;
+
+      value = MAX (gtk_adjustment_get_value (priv->adjustment), 0);
+      page = gtk_adjustment_get_page_size (priv->adjustment);
+
+      start = (guint) (value / priv->estimated_row_height);
+      end = (guint) ceil ((value + page) / priv->estimated_row_height) + 1;
+
+      start -= MIN (start, priv->window_margin);
+      end = MIN (end + priv->window_margin, n_items);
+      start = MIN (start, end);
+    }
+
+  gtk_list_box_set_model_window (box, start, end);
+}
+
+static gboolean
+gtk_list_box_window_update_idle (gpointer user_data)
+{
+  GtkListBox *box = user_data;
+
+  BOX_PRIV (box)->window_update_id = 0;
+  gtk_list_box_update_model_window (box);
+
+  return G_SOURCE_REMOVE;
+}
+
+static void
+gtk_list_box_queue_window_update (GtkListBox *box)
+{
+  GtkListBoxPrivate *priv = BOX_PRIV (box);
+
+  if (priv->window_update_id != 0)
+    return;
+
+  /* Reconciling the window adds and removes children, which must not
+   * happen from within layout, where the adjustment usually changes;
+   * run between layout and the upcoming paint instead.
+   */
+  priv->window_update_id = gdk_threads_add_idle_full (G_PRIORITY_HIGH_IDLE + 15,
+                                                      gtk_list_box_window_update_idle,
+                                                      box, NULL);
+  g_source_set_name_by_id (priv->window_update_id, "[gtk+] gtk_list_box_window_update_idle");
+}
+
+static void
+gtk_list_box_adjustment_window_changed (GtkAdjustment *adjustment,
+                                        GtkListBox    *box)
+{
+  gtk_list_box_queue_window_update (box);
+}
+
+static void
+gtk_list_box_teardown_model_window (GtkListBox *box)
+{
+  GtkListBoxPrivate *priv = BOX_PRIV (box);
+  GtkWidget *row;
+
+  if (!priv->model_windowed)
+    return;
+
+  if (priv->window_update_id != 0)
+    {
+      g_source_remove (priv->window_update_id);
+      priv->window_update_id = 0;
+    }
+
+  if (priv->adjustment)
+    g_signal_handlers_disconnect_by_func (priv->adjustment,
+                                          gtk_list_box_adjustment_window_changed, box);
+
+  while ((row = g_queue_pop_head (&priv->recycle_pool)) != NULL)
+    {
+      gtk_widget_destroy (row);
+      g_object_unref (row);
+    }
+
+  priv->model_windowed = FALSE;
+  priv->bind_widget_func = NULL;
+  priv->unbind_widget_func = NULL;
+  priv->window_margin = 0;
+  priv->window_start = 0;
+  priv->window_n_rows = 0;
+  priv->estimated_row_height = 0;
+}
+
 static void
 gtk_list_box_check_model_compat (GtkListBox *box)
 {
@@ -3799,6 +4230,8 @@ gtk_list_box_bind_model (GtkListBox                 *box,
       g_clear_object (&priv->bound_model);
     }
 
+  gtk_list_box_teardown_model_window (box);
+
   gtk_list_box_forall (GTK_CONTAINER (box), FALSE, (GtkCallback) gtk_widget_destroy, NULL);
 
   if (model == NULL)
@@ -3814,3 +4247,86 @@ gtk_list_box_bind_model (GtkListBox                 *box,
   g_signal_connect (priv->bound_model, "items-changed", G_CALLBACK (gtk_list_box_bound_model_changed), box);
   gtk_list_box_bound_model_changed (model, 0, 0, g_list_model_get_n_items (model), box);
 }
+
+/**
+ * gtk_list_box_bind_model_windowed:
+ * @box: a #GtkListBox
+ * @model: (nullable): the #GListModel to be bound to @box
+ * @margin: number of extra rows to materialize above and below the viewport
+ * @create_widget_func: a function that creates row widgets
+ * @bind_widget_func: a function that binds a row widget to an item
+ * @unbind_widget_func: (nullable): a function called before a row is recycled
+ * @user_data: user data passed to the functions
+ * @user_data_free_func: function for freeing @user_data
+ *
+ * Binds @model to @box like gtk_list_box_bind_model(), but only
+ * materializes row widgets for the items that are visible in the
+ * scrolled viewport, plus @margin rows of lookahead on either side.
+ * Rows scrolled out of that window are unbound and kept in a pool,
+ * and reused for items scrolling in, so the number of live widgets
+ * stays proportional to the viewport rather than to the model.
+ *
+ * @create_widget_func is only called when the pool is empty.
+ * @bind_widget_func is called every time a row starts representing an
+ * item; it receives the #GtkListBoxRow in the list, which wraps the
+ * widget returned by @create_widget_func unless that was itself a row.
+ * @unbind_widget_func, if given, is called before a row is recycled.
+ *
+ * The height of unmaterialized items is estimated from the rows that
+ * are materialized, so the scrollbar position is approximate when row
+ * heights vary. Row indexes as used by gtk_list_box_get_row_at_index()
+ * count materialized rows only. Windowing requires the viewport
+ * adjustment that @box picks up from an enclosing #GtkScrolledWindow;
+ * without one, all items are materialized.
+ *
+ * Since: 3.18
+ */
+void
+gtk_list_box_bind_model_windowed (GtkListBox                 *box,
+                                  GListModel                 *model,
+                                  guint                       margin,
+                                  GtkListBoxCreateWidgetFunc  create_widget_func,
+                                  GtkListBoxBindWidgetFunc    bind_widget_func,
+                                  GtkListBoxUnbindWidgetFunc  unbind_widget_func,
+                                  gpointer                    user_data,
+                                  GDestroyNotify              user_data_free_func)
+{
+  GtkListBoxPrivate *priv = BOX_PRIV (box);
+
+  g_return_if_fail (GTK_IS_LIST_BOX (box));
+  g_return_if_fail (model == NULL || G_IS_LIST_MODEL (model));
+  g_return_if_fail (model == NULL || create_widget_func != NULL);
+  g_return_if_fail (model == NULL || bind_widget_func != NULL);
+
+  gtk_list_box_bind_model (box, NULL, NULL, NULL, NULL);
+
+  if (model == NULL)
+    {
+      if (user_data_free_func)
+        user_data_free_func (user_data);
+      return;
+    }
+
+  priv->bound_model = g_object_ref (model);
+  priv->create_widget_func = create_widget_func;
+  priv->create_widget_func_data = user_data;
+  priv->create_widget_func_data_destroy = user_data_free_func;
+  priv->bind_widget_func = bind_widget_func;
+  priv->unbind_widget_func = unbind_widget_func;
+  priv->model_windowed = TRUE;
+  priv->window_margin = margin;
+
+  gtk_list_box_check_model_compat (box);
+
+  g_signal_connect (priv->bound_model, "items-changed", G_CALLBACK (gtk_list_box_bound_model_changed), box);
+
+  if (priv->adjustment)
+    {
+      g_signal_connect (priv->adjustment, "value-changed",
+                        G_CALLBACK (gtk_list_box_adjustment_window_changed), box);
+      g_signal_connect (priv->adjustment, "changed",
+                        G_CALLBACK (gtk_list_box_adjustment_window_changed), box);
+    }
+
+  gtk_list_box_update_model_window (box);
+}
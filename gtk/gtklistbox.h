@@ -189,6 +189,39 @@ typedef void (*GtkListBoxUpdateHeaderFunc) (GtkListBoxRow *row,
 typedef GtkWidget * (*GtkListBoxCreateWidgetFunc) (gpointer item,
                                                    gpointer user_data);
 
+/**
+ * GtkListBoxBindWidgetFunc:
+ * @row: the #GtkListBoxRow to bind
+ * @item: (type GObject): the item from the model that @row should represent
+ * @position: the position of @item in the model
+ * @user_data: (closure): user data
+ *
+ * Called for list boxes that are bound to a #GListModel with
+ * gtk_list_box_bind_model_windowed() whenever a row starts
+ * representing an item, either right after it was created or when
+ * it is reused for an item scrolling into the materialized window.
+ *
+ * Since: 3.18
+ */
+typedef void (*GtkListBoxBindWidgetFunc) (GtkListBoxRow *row,
+                                          gpointer       item,
+                                          guint          position,
+                                          gpointer       user_data);
+
+/**
+ * GtkListBoxUnbindWidgetFunc:
+ * @row: the #GtkListBoxRow being recycled
+ * @user_data: (closure): user data
+ *
+ * Called for list boxes that are bound to a #GListModel with
+ * gtk_list_box_bind_model_windowed() when a row stops representing
+ * its item and is moved to the recycle pool.
+ *
+ * Since: 3.18
+ */
+typedef void (*GtkListBoxUnbindWidgetFunc) (GtkWidget *row,
+                                            gpointer   user_data);
+
 GDK_AVAILABLE_IN_3_10
 GType      gtk_list_box_row_get_type      (void) G_GNUC_CONST;
 GDK_AVAILABLE_IN_3_10
@@ -285,6 +318,12 @@ GDK_AVAILABLE_IN_3_10
 void           gtk_list_box_invalidate_filter            (GtkListBox                    *box);
 GDK_AVAILABLE_IN_3_10
 void           gtk_list_box_invalidate_sort              (GtkListBox                    *box);
+GDK_AVAILABLE_IN_3_18
+void           gtk_list_box_invalidate_filter_for_row    (GtkListBox                    *box,
+                                                          GtkListBoxRow                 *row);
+GDK_AVAILABLE_IN_3_18
+void           gtk_list_box_invalidate_sort_for_row      (GtkListBox                    *box,
+                                                          GtkListBoxRow                 *row);
 GDK_AVAILABLE_IN_3_10
 void           gtk_list_box_invalidate_headers           (GtkListBox                    *box);
 GDK_AVAILABLE_IN_3_10
@@ -312,6 +351,15 @@ void           gtk_list_box_bind_model                   (GtkListBox
                                                           GtkListBoxCreateWidgetFunc    create_widget_func,
                                                           gpointer                      user_data,
                                                           GDestroyNotify                user_data_free_func);
+GDK_AVAILABLE_IN_3_18
+void           gtk_list_box_bind_model_windowed          (GtkListBox                   *box,
+                                                          GListModel                   *model,
+                                                          guint                         margin,
+                                                          GtkListBoxCreateWidgetFunc    create_widget_func,
+                                                          GtkListBoxBindWidgetFunc      bind_widget_func,
+                                                          GtkListBoxUnbindWidgetFunc    unbind_widget_func,
+                                                          gpointer                      user_data,
+                                                          GDestroyNotify                user_data_free_func);
 
 G_END_DECLS
 
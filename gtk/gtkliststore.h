@@ -122,6 +122,13 @@ void          gtk_list_store_insert_with_valuesv (GtkListStore *list_store,
 						  gint         *columns,
 						  GValue       *values,
 						  gint          n_values);
+GDK_AVAILABLE_IN_3_18
+void          gtk_list_store_insert_batch        (GtkListStore *list_store,
+						  gint          position,
+						  gint         *columns,
+						  gint          n_columns,
+						  GValue       *values,
+						  gint          n_rows);
 GDK_AVAILABLE_IN_ALL
 void          gtk_list_store_prepend          (GtkListStore *list_store,
 					       GtkTreeIter  *iter);
@@ -124,6 +124,8 @@
 #include "gtkrecentmanager.h"
 #include "gtkselectionprivate.h"
 #include "gtksettingsprivate.h"
+#include "gtktraceprivate.h"
+#include "gtklayoutstatsprivate.h"
 #include "gtktooltipprivate.h"
 #include "gtkversion.h"
 #include "gtkwidgetprivate.h"
@@ -153,6 +155,24 @@ static gint pre_initialized = FALSE;
 static gint gtk_initialized = FALSE;
 static GList *current_events = NULL;
 
+/* Single-slot cache for the grab-target resolution in
+ * gtk_main_do_event(); motion floods redo identical ancestor and
+ * popover walks for every event otherwise. The grab widget in the key
+ * is looked up freshly per event, so only hierarchy and popover
+ * relationship changes invalidate the slot, via
+ * _gtk_main_invalidate_event_target_cache().
+ */
+typedef struct {
+  gboolean   valid;
+  GtkWidget *event_widget;
+  GtkWidget *grab_widget;
+  gboolean   sensitive;
+  gboolean   is_scroll;
+  gboolean   event_widget_wins;
+} EventTargetCache;
+
+static EventTargetCache event_target_cache = { FALSE, };
+
 static GSList *main_loops = NULL;      /* stack of currently executing main loops */
 
 static GSList *key_snoopers = NULL;
@@ -181,6 +201,7 @@ static const GDebugKey gtk_debug_keys[] = {
   {"interactive", GTK_DEBUG_INTERACTIVE},
   {"touchscreen", GTK_DEBUG_TOUCHSCREEN},
   {"actions", GTK_DEBUG_ACTIONS},
+  {"paint-cost", GTK_DEBUG_PAINT_COST},
 };
 #endif /* G_ENABLE_DEBUG */
 
@@ -640,10 +661,15 @@ do_pre_parse_initialization (int    *argc,
 
   pre_initialized = TRUE;
 
+  _gtk_trace_init ();
+  _gtk_layout_stats_init ();
+
   if (_gtk_module_has_mixed_deps (NULL))
     g_error ("GTK+ 2.x symbols detected. Using GTK+ 2.x and GTK+ 3 in the same process is not supported");
 
+  _gtk_trace_begin ("gdk pre-parse", NULL);
   GDK_PRIVATE_CALL (gdk_pre_parse) ();
+  _gtk_trace_end ("gdk pre-parse");
   gdk_event_handler_set ((GdkEventFunc)gtk_main_do_event, NULL, NULL);
 
 #ifdef G_ENABLE_DEBUG
@@ -727,6 +753,7 @@ do_post_parse_initialization (int    *argc,
 
   gtk_initialized = TRUE;
 
+  _gtk_trace_begin ("load modules", NULL);
   if (gtk_modules_string)
     {
       _gtk_modules_init (argc, argv, gtk_modules_string->str);
@@ -736,6 +763,7 @@ do_post_parse_initialization (int    *argc,
     {
       _gtk_modules_init (argc, argv, NULL);
     }
+  _gtk_trace_end ("load modules");
 
   g_signal_connect (gdk_display_manager_get (), "notify::default-display",
                     G_CALLBACK (default_display_notify_cb),
@@ -1549,6 +1577,12 @@ check_event_in_child_popover (GtkWidget *event_widget,
   return (popover_parent == grab_widget || gtk_widget_is_ancestor (popover_parent, grab_widget));
 }
 
+void
+_gtk_main_invalidate_event_target_cache (void)
+{
+  event_target_cache.valid = FALSE;
+}
+
 /**
  * gtk_main_do_event:
  * @event: An event to process (normally passed by GDK)
@@ -1684,19 +1718,45 @@ gtk_main_do_event (GdkEvent *event)
   /* If the grab widget is an ancestor of the event widget
    * then we send the event to the original event widget.
    * This is the key to implementing modality.
+   *
+   * Popovers are not really a "child" of their "parent" in the
+   * widget/window hierarchy sense, but we want to interact with
+   * popovers spawn by widgets within grab_widget, so they get the
+   * event unaffected by the grab as well.
+   *
+   * The outcome only changes with the widgets involved, the hierarchy
+   * and the popover relationships, so it is served from a single-slot
+   * cache while events flood in on an unchanged target.
    */
-  if (!grab_widget ||
-      ((gtk_widget_is_sensitive (event_widget) || event->type == GDK_SCROLL) &&
-       gtk_widget_is_ancestor (event_widget, grab_widget)))
-    grab_widget = event_widget;
-
-  /* popovers are not really a "child" of their "parent" in the widget/window
-   * hierarchy sense, we however want to interact with popovers spawn by widgets
-   * within grab_widget. If this is the case, we let the event go through
-   * unaffected by the grab.
-   */
-  if (check_event_in_child_popover (event_widget, grab_widget))
-    grab_widget = event_widget;
+  if (grab_widget == NULL)
+    {
+      grab_widget = event_widget;
+    }
+  else
+    {
+      gboolean sensitive = gtk_widget_is_sensitive (event_widget);
+      gboolean is_scroll = event->type == GDK_SCROLL;
+
+      if (!event_target_cache.valid ||
+          event_target_cache.event_widget != event_widget ||
+          event_target_cache.grab_widget != grab_widget ||
+          event_target_cache.sensitive != sensitive ||
+          event_target_cache.is_scroll != is_scroll)
+        {
+          event_target_cache.event_widget = event_widget;
+          event_target_cache.grab_widget = grab_widget;
+          event_target_cache.sensitive = sensitive;
+          event_target_cache.is_scroll = is_scroll;
+          event_target_cache.event_widget_wins =
+            ((sensitive || is_scroll) &&
+             gtk_widget_is_ancestor (event_widget, grab_widget)) ||
+            check_event_in_child_popover (event_widget, grab_widget);
+          event_target_cache.valid = TRUE;
+        }
+
+      if (event_target_cache.event_widget_wins)
+        grab_widget = event_widget;
+    }
 
   /* If the widget receiving events is actually blocked by another
    * device GTK+ grab
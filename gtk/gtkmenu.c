@@ -315,6 +315,7 @@ menu_queue_resize (GtkMenu *menu)
   GtkMenuPrivate *priv = menu->priv;
 
   priv->have_layout = FALSE;
+  priv->memo_for_width = -1;
   gtk_widget_queue_resize (GTK_WIDGET (menu));
 }
 
@@ -1087,6 +1088,8 @@ gtk_menu_init (GtkMenu *menu)
 
   menu->priv = priv;
 
+  priv->memo_for_width = -1;
+
   priv->toplevel = g_object_connect (g_object_new (GTK_TYPE_WINDOW,
                                                    "type", GTK_WINDOW_POPUP,
                                                    "child", menu,
@@ -1150,6 +1153,9 @@ gtk_menu_destroy (GtkWidget *widget)
 
   g_clear_pointer (&priv->heights, g_free);
 
+  g_clear_pointer (&priv->memo_heights, g_free);
+  priv->memo_for_width = -1;
+
   g_clear_pointer (&priv->title, g_free);
 
   if (priv->position_func_data_destroy)
@@ -2791,6 +2797,12 @@ calculate_line_heights (GtkMenu *menu,
       nat_heights[t] = MAX (nat_heights[t], part);
     }
 
+  /* Refresh the memo for the allocate this request leads up to */
+  g_free (priv->memo_heights);
+  priv->memo_heights = g_memdup (min_heights, n_heights * sizeof (guint));
+  priv->memo_heights_length = n_heights;
+  priv->memo_for_width = for_width;
+
   if (ret_min_heights)
     *ret_min_heights = min_heights;
   else
@@ -2832,10 +2844,22 @@ gtk_menu_size_allocate (GtkWidget     *widget,
   border_width = gtk_container_get_border_width (GTK_CONTAINER (menu));
 
   g_free (priv->heights);
-  priv->heights_length = calculate_line_heights (menu,
-                                                 allocation->width,
-                                                 &priv->heights,
-                                                 NULL);
+  if (priv->memo_for_width == allocation->width)
+    {
+      /* Reuse the line heights the size request leading up to this
+       * allocation just measured; anything that changes them queues a
+       * resize, which invalidates the memo and runs a fresh request
+       * before the next allocate.
+       */
+      priv->heights = g_memdup (priv->memo_heights,
+                                priv->memo_heights_length * sizeof (guint));
+      priv->heights_length = priv->memo_heights_length;
+    }
+  else
+    priv->heights_length = calculate_line_heights (menu,
+                                                   allocation->width,
+                                                   &priv->heights,
+                                                   NULL);
 
   /* refresh our cached height request */
   priv->requested_height = (2 * border_width) + padding.top + padding.bottom;
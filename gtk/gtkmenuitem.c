@@ -40,6 +40,7 @@
 #include "deprecated/gtkactivatable.h"
 #include "gtkwidgetprivate.h"
 #include "gtkintl.h"
+#include "gtkpango.h"
 #include "gtksettings.h"
 #include "gtktypebuiltins.h"
 #include "a11y/gtkmenuitemaccessible.h"
@@ -787,9 +788,7 @@ get_arrow_size (GtkWidget *widget,
 
   context = gtk_widget_get_pango_context (child);
 
-  metrics = pango_context_get_metrics (context,
-                                       pango_context_get_font_description (context),
-                                       pango_context_get_language (context));
+  metrics = _gtk_pango_get_metrics (context);
 
   *size = (PANGO_PIXELS (pango_font_metrics_get_ascent (metrics) +
                          pango_font_metrics_get_descent (metrics)));
@@ -829,9 +828,7 @@ get_minimum_width (GtkWidget *widget)
 
   context = gtk_widget_get_pango_context (widget);
 
-  metrics = pango_context_get_metrics (context,
-                                       pango_context_get_font_description (context),
-                                       pango_context_get_language (context));
+  metrics = _gtk_pango_get_metrics (context);
 
   width = pango_font_metrics_get_approximate_char_width (metrics);
 
@@ -100,6 +100,14 @@ struct _GtkMenuPrivate
   gint heights_length;
   gint requested_height;
 
+  /* Memoized line heights from the last size request, reused by
+   * size_allocate so popping up a large menu walks the items once
+   * instead of twice; memo_for_width is -1 when nothing is memoized.
+   */
+  guint *memo_heights;
+  gint memo_heights_length;
+  gint memo_for_width;
+
   gboolean initially_pushed_in;
   gint monitor_num;
 
@@ -34,6 +34,7 @@
 #include "gtkstack.h"
 #include "gtkpopover.h"
 #include "gtkintl.h"
+#include "gtkpango.h"
 
 /**
  * SECTION:gtkmodelbutton
@@ -687,9 +688,7 @@ gtk_model_button_size_allocate (GtkWidget     *widget,
     }
 
   pango_context = gtk_widget_get_pango_context (widget);
-  metrics = pango_context_get_metrics (pango_context,
-                                       pango_context_get_font_description (pango_context),
-                                       pango_context_get_language (pango_context));
+  metrics = _gtk_pango_get_metrics (pango_context);
   GTK_BUTTON (button)->priv->baseline_align =
     (double)pango_font_metrics_get_ascent (metrics) /
     (pango_font_metrics_get_ascent (metrics) + pango_font_metrics_get_descent (metrics));
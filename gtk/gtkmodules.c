@@ -174,13 +174,31 @@ gchar *
 _gtk_find_module (const gchar *name,
 		  const gchar *type)
 {
+  static GHashTable *module_path_cache = NULL;
   gchar **paths;
   gchar **path;
   gchar *module_name = NULL;
+  gchar *cache_key;
 
   if (g_path_is_absolute (name))
     return g_strdup (name);
 
+  /* Resolving a module means stat()ing every directory in the module
+   * path, and the same modules get looked up repeatedly, e.g. one
+   * immodule per loaded im context. Remember where we found them.
+   */
+  cache_key = g_strconcat (type, "/", name, NULL);
+  if (module_path_cache)
+    {
+      const gchar *cached = g_hash_table_lookup (module_path_cache, cache_key);
+
+      if (cached)
+        {
+          g_free (cache_key);
+          return g_strdup (cached);
+        }
+    }
+
   paths = _gtk_get_module_path (type);
   for (path = paths; *path; path++)
     {
@@ -205,6 +223,16 @@ _gtk_find_module (const gchar *name,
 
  found:
   g_strfreev (paths);
+
+  if (module_name)
+    {
+      if (module_path_cache == NULL)
+        module_path_cache = g_hash_table_new (g_str_hash, g_str_equal);
+      g_hash_table_insert (module_path_cache, cache_key, g_strdup (module_name));
+    }
+  else
+    g_free (cache_key);
+
   return module_name;
 }
 
@@ -245,6 +273,38 @@ cmp_module (GtkModuleInfo *info,
   return info->module != module;
 }
 
+static gboolean
+module_is_disabled (const gchar *name,
+                    gboolean     verbose)
+{
+  static gchar **disabled_modules = NULL;
+  static gboolean env_checked = FALSE;
+  gint i;
+
+  if (!env_checked)
+    {
+      const gchar *disable = g_getenv ("GTK_MODULES_DISABLE");
+
+      if (disable && disable[0])
+        disabled_modules = g_strsplit (disable, G_SEARCHPATH_SEPARATOR_S, -1);
+      env_checked = TRUE;
+    }
+
+  if (disabled_modules == NULL)
+    return FALSE;
+
+  for (i = 0; disabled_modules[i]; i++)
+    if (g_str_equal (name, disabled_modules[i]))
+      {
+        if (verbose)
+          g_message ("Not loading module \"%s\": disabled through GTK_MODULES_DISABLE.", name);
+
+        return TRUE;
+      }
+
+  return FALSE;
+}
+
 static gboolean
 module_is_blacklisted (const gchar *name,
                        gboolean     verbose)
@@ -288,6 +348,14 @@ load_module (GSList      *module_list,
           info = NULL;
 	}
 
+      if (!success && module_is_disabled (name, TRUE))
+        {
+          /* Disabled modules are skipped before dlopening them; that
+           * is the whole point of the variable.
+           */
+          return module_list;
+        }
+
       if (!success)
 	{
 	  module = find_module (name);
@@ -2067,6 +2067,9 @@ gtk_notebook_get_preferred_tabs_size (GtkNotebook    *notebook,
   gint initial_gap;
   gint scroll_arrow_hlength;
   gint scroll_arrow_vlength;
+  guint padding_keys[8];
+  GtkBorder paddings[8];
+  gint n_paddings = 0;
 
   priv = notebook->priv;
   widget = GTK_WIDGET (notebook);
@@ -2089,6 +2092,9 @@ gtk_notebook_get_preferred_tabs_size (GtkNotebook    *notebook,
         {
           GtkBorder tab_padding;
           GtkStateFlags state;
+          GtkRegionFlags tab_flags;
+          guint key;
+          gint j;
 
           vis_pages++;
 
@@ -2098,11 +2104,43 @@ gtk_notebook_get_preferred_tabs_size (GtkNotebook    *notebook,
           gtk_widget_get_preferred_size (page->tab_label,
                                          &child_requisition, NULL);
 
-          /* Get border/padding for tab */
-          gtk_style_context_save (context);
-          state = notebook_tab_prepare_style_context (notebook, page, context, TRUE);
-          gtk_style_context_get_padding (context, state, &tab_padding);
-          gtk_style_context_restore (context);
+          /* Get border/padding for tab. Resolving the style is costly
+           * and the region flags walk in _gtk_notebook_get_tab_flags()
+           * is O(n) per tab, so tabs whose style inputs are identical
+           * share one lookup; vis_pages counts visible tabs exactly
+           * like the flags walk does.
+           */
+          tab_flags = (vis_pages % 2 == 0) ? GTK_REGION_EVEN : GTK_REGION_ODD;
+          if (vis_pages == 1)
+            tab_flags |= GTK_REGION_FIRST;
+          if (children->next == NULL)
+            tab_flags |= GTK_REGION_LAST;
+
+          key = tab_flags |
+                ((page == priv->cur_page) ? 1 << 16 : 0) |
+                ((page == priv->prelight_tab) ? 1 << 17 : 0) |
+                (page->reorderable ? 1 << 18 : 0);
+
+          for (j = 0; j < n_paddings; j++)
+            if (padding_keys[j] == key)
+              break;
+
+          if (j < n_paddings)
+            tab_padding = paddings[j];
+          else
+            {
+              gtk_style_context_save (context);
+              state = notebook_tab_prepare_style_context (notebook, page, context, TRUE);
+              gtk_style_context_get_padding (context, state, &tab_padding);
+              gtk_style_context_restore (context);
+
+              if (n_paddings < G_N_ELEMENTS (paddings))
+                {
+                  padding_keys[n_paddings] = key;
+                  paddings[n_paddings] = tab_padding;
+                  n_paddings++;
+                }
+            }
 
           page->requisition.width = child_requisition.width +
             tab_padding.left + tab_padding.right;
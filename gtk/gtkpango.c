@@ -1321,3 +1321,122 @@ _gtk_pango_attr_list_merge (PangoAttrList *into,
 
   return into;
 }
+
+typedef struct {
+  PangoFontMap *font_map;
+  PangoFontDescription *desc;
+  PangoLanguage *language;
+  cairo_font_options_t *options;
+  double resolution;
+} MetricsCacheKey;
+
+/* Resolving metrics for a font description means loading a fontset
+ * and iterating its fonts, and every widget redoes it from its own
+ * PangoContext. Keep the cache small; in practice an application only
+ * ever uses a handful of distinct fonts.
+ */
+#define METRICS_CACHE_MAX_SIZE 64
+
+static guint
+metrics_cache_key_hash (gconstpointer data)
+{
+  const MetricsCacheKey *key = data;
+  guint hash;
+
+  hash = pango_font_description_hash (key->desc) ^
+         g_direct_hash (key->language) ^
+         g_direct_hash (key->font_map) ^
+         (guint) (key->resolution * 10);
+  if (key->options)
+    hash ^= (guint) cairo_font_options_hash (key->options);
+
+  return hash;
+}
+
+static gboolean
+metrics_cache_key_equal (gconstpointer a,
+                         gconstpointer b)
+{
+  const MetricsCacheKey *key_a = a;
+  const MetricsCacheKey *key_b = b;
+
+  if (key_a->font_map != key_b->font_map ||
+      key_a->language != key_b->language ||
+      key_a->resolution != key_b->resolution ||
+      !pango_font_description_equal (key_a->desc, key_b->desc))
+    return FALSE;
+
+  if (key_a->options == key_b->options)
+    return TRUE;
+
+  return key_a->options && key_b->options &&
+         cairo_font_options_equal (key_a->options, key_b->options);
+}
+
+static void
+metrics_cache_key_free (gpointer data)
+{
+  MetricsCacheKey *key = data;
+
+  g_object_unref (key->font_map);
+  pango_font_description_free (key->desc);
+  if (key->options)
+    cairo_font_options_destroy (key->options);
+  g_slice_free (MetricsCacheKey, key);
+}
+
+/*
+ * _gtk_pango_get_metrics:
+ * @context: a #PangoContext
+ *
+ * Gets the metrics for the current font description and language
+ * of @context, like pango_context_get_metrics(), but shares the
+ * result between all contexts that resolve to the same font.
+ *
+ * May only be called from the main thread.
+ *
+ * Returns: a #PangoFontMetrics; free with pango_font_metrics_unref()
+ */
+PangoFontMetrics *
+_gtk_pango_get_metrics (PangoContext *context)
+{
+  static GHashTable *metrics_cache = NULL;
+  MetricsCacheKey key;
+  PangoFontMetrics *metrics;
+
+  key.font_map = pango_context_get_font_map (context);
+  key.desc = (PangoFontDescription *) pango_context_get_font_description (context);
+  key.language = pango_context_get_language (context);
+  key.options = (cairo_font_options_t *) pango_cairo_context_get_font_options (context);
+  key.resolution = pango_cairo_context_get_resolution (context);
+
+  if (metrics_cache == NULL)
+    metrics_cache = g_hash_table_new_full (metrics_cache_key_hash,
+                                           metrics_cache_key_equal,
+                                           metrics_cache_key_free,
+                                           (GDestroyNotify) pango_font_metrics_unref);
+
+  metrics = g_hash_table_lookup (metrics_cache, &key);
+  if (metrics == NULL)
+    {
+      MetricsCacheKey *stored;
+
+      if (g_hash_table_size (metrics_cache) >= METRICS_CACHE_MAX_SIZE)
+        g_hash_table_remove_all (metrics_cache);
+
+      metrics = pango_context_get_metrics (context,
+                                           key.desc,
+                                           key.language);
+
+      stored = g_slice_new (MetricsCacheKey);
+      stored->font_map = g_object_ref (key.font_map);
+      stored->desc = pango_font_description_copy (key.desc);
+      stored->language = key.language;
+      stored->options = key.options ? cairo_font_options_copy (key.options) : NULL;
+      stored->resolution = key.resolution;
+
+      g_hash_table_insert (metrics_cache, stored, metrics);
+    }
+
+  return pango_font_metrics_ref (metrics);
+}
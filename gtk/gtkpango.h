@@ -34,6 +34,8 @@ G_BEGIN_DECLS
 void             _gtk_pango_fill_layout            (cairo_t         *cr,
                                                     PangoLayout     *layout);
 
+PangoFontMetrics *_gtk_pango_get_metrics           (PangoContext    *context);
+
 
 AtkAttributeSet *_gtk_pango_get_default_attributes (AtkAttributeSet *attributes,
                                                     PangoLayout     *layout);
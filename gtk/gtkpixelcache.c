@@ -17,42 +17,84 @@
 
 #include "config.h"
 
+#include <epoxy/gl.h>
+
 #include "gtkdebug.h"
 #include "gtkpixelcacheprivate.h"
 
 #define BLOW_CACHE_TIMEOUT_SEC 20
 
-/* The extra size of the offscreen surface we allocate
+/* The cache is kept as a grid of canvas-aligned tiles. Scrolling in
+ * any direction just shifts the cached range over the grid: tiles
+ * still in range keep their content, tiles that fall out are dropped,
+ * and only tiles that come into range have to be painted. Since tile
+ * positions are fixed in canvas coordinates there is never a need to
+ * copy retained pixels around, so the cost of a scroll step is
+ * proportional to the newly exposed area, no matter the direction.
+ */
+#define TILE_SIZE 256
+
+/* The extra size of the tile range we cache beyond the viewport
    to make scrolling more efficient */
 #define DEFAULT_EXTRA_SIZE 64
 
-/* When resizing viewport we allow this extra
-   size to avoid constantly reallocating when resizing */
-#define ALLOW_SMALLER_SIZE 32
-#define ALLOW_LARGER_SIZE 32
+typedef struct {
+  /* Created lazily; a tile without a surface is painted in full
+     the first time it is needed */
+  cairo_surface_t *surface;
+
+  /* In tile-local coordinates; NULL when the tile is clean */
+  cairo_region_t *dirty;
+
+  /* GL texture with the tile pixels, when the cache is GL-backed */
+  guint texture;
+} GtkPixelCacheTile;
 
 struct _GtkPixelCache {
-  cairo_surface_t *surface;
   cairo_content_t content;
 
-  /* Valid if surface != NULL */
-  int surface_x;
-  int surface_y;
-  int surface_w;
-  int surface_h;
+  /* The cached range of the canvas in whole tiles;
+   * tiles[row * tiles_w + col] covers canvas coordinates
+   * ((tile_x + col) * TILE_SIZE, (tile_y + row) * TILE_SIZE).
+   * NULL when nothing is cached.
+   */
+  GtkPixelCacheTile *tiles;
+  int tile_x;
+  int tile_y;
+  int tiles_w;
+  int tiles_h;
+
+  /* Valid if tiles != NULL */
+  cairo_content_t tiles_content;
   double surface_scale;
 
-  /* may be null if not dirty */
-  cairo_region_t *surface_dirty;
-
   guint timeout_tag;
 
   guint extra_width;
   guint extra_height;
 
+  /* Set while an idle repaint of stale tiles is pending */
+  guint idle_tag;
+  GdkWindow *idle_window;
+  GtkPixelCacheDrawFunc idle_draw;
+  gpointer idle_user_data;
+  cairo_rectangle_int_t idle_view_rect;
+  cairo_rectangle_int_t idle_canvas_rect;
+
+  /* Set when GTK_PIXEL_CACHE_GL is enabled and a context could be
+   * created; tiles are then mirrored into GL textures and composited
+   * on the GPU via gdk_cairo_draw_from_gl ().
+   */
+  GdkGLContext *gl_context;
+
   guint always_cache : 1;
+  guint deferred_repaint : 1;
+  guint gl_failed : 1;
 };
 
+static void gtk_pixel_cache_drop_tiles         (GtkPixelCache *cache);
+static void gtk_pixel_cache_cancel_idle_repaint (GtkPixelCache *cache);
+
 GtkPixelCache *
 _gtk_pixel_cache_new ()
 {
@@ -72,21 +114,21 @@ _gtk_pixel_cache_free (GtkPixelCache *cache)
     return;
 
   if (cache->timeout_tag ||
-      cache->surface ||
-      cache->surface_dirty)
+      cache->idle_tag ||
+      cache->tiles)
     {
-      g_warning ("pixel cache freed that wasn't unmapped: tag %u surface %p sirty %p",
-                 cache->timeout_tag, cache->surface, cache->surface_dirty);
+      g_warning ("pixel cache freed that wasn't unmapped: tag %u tiles %p",
+                 cache->timeout_tag, cache->tiles);
     }
 
   if (cache->timeout_tag)
     g_source_remove (cache->timeout_tag);
 
-  if (cache->surface != NULL)
-    cairo_surface_destroy (cache->surface);
+  gtk_pixel_cache_cancel_idle_repaint (cache);
 
-  if (cache->surface_dirty != NULL)
-    cairo_region_destroy (cache->surface_dirty);
+  gtk_pixel_cache_drop_tiles (cache);
+
+  g_clear_object (&cache->gl_context);
 
   g_free (cache);
 }
@@ -125,64 +167,269 @@ void
 _gtk_pixel_cache_invalidate (GtkPixelCache  *cache,
                              cairo_region_t *region)
 {
-  cairo_rectangle_int_t r;
-  cairo_region_t *free_region = NULL;
+  cairo_rectangle_int_t extents;
+  cairo_rectangle_int_t tile_rect;
+  int col, row;
 
-  if (cache->surface == NULL ||
+  if (cache->tiles == NULL ||
       (region != NULL && cairo_region_is_empty (region)))
     return;
 
-  if (region == NULL)
+  if (region != NULL)
+    cairo_region_get_extents (region, &extents);
+
+  for (row = 0; row < cache->tiles_h; row++)
+    for (col = 0; col < cache->tiles_w; col++)
+      {
+        GtkPixelCacheTile *tile = &cache->tiles[row * cache->tiles_w + col];
+        cairo_region_t *tile_dirty;
+
+        /* Tiles without a surface are painted in full anyway */
+        if (tile->surface == NULL)
+          continue;
+
+        tile_rect.x = (cache->tile_x + col) * TILE_SIZE;
+        tile_rect.y = (cache->tile_y + row) * TILE_SIZE;
+        tile_rect.width = TILE_SIZE;
+        tile_rect.height = TILE_SIZE;
+
+        if (region == NULL)
+          {
+            if (tile->dirty)
+              cairo_region_destroy (tile->dirty);
+            tile_rect.x = 0;
+            tile_rect.y = 0;
+            tile->dirty = cairo_region_create_rectangle (&tile_rect);
+            continue;
+          }
+
+        if (extents.x >= tile_rect.x + TILE_SIZE ||
+            extents.x + extents.width <= tile_rect.x ||
+            extents.y >= tile_rect.y + TILE_SIZE ||
+            extents.y + extents.height <= tile_rect.y)
+          continue;
+
+        tile_dirty = cairo_region_copy (region);
+        cairo_region_translate (tile_dirty, -tile_rect.x, -tile_rect.y);
+        tile_rect.x = 0;
+        tile_rect.y = 0;
+        cairo_region_intersect_rectangle (tile_dirty, &tile_rect);
+
+        if (cairo_region_is_empty (tile_dirty))
+          cairo_region_destroy (tile_dirty);
+        else if (tile->dirty == NULL)
+          tile->dirty = tile_dirty;
+        else
+          {
+            cairo_region_union (tile->dirty, tile_dirty);
+            cairo_region_destroy (tile_dirty);
+          }
+      }
+}
+
+/* Backing the tiles with GL textures moves scroll composition onto
+ * the GPU, which pays off on large high-resolution displays where CPU
+ * blits saturate memory bandwidth.  It also forces the whole toplevel
+ * into GL composition (creating the window's paint context does
+ * that), which can regress other setups, so it is strictly opt-in.
+ */
+static gboolean
+gtk_pixel_cache_use_gl (GtkPixelCache *cache,
+                        GdkWindow     *window)
+{
+  static gint enabled = -1;
+
+  if (enabled == -1)
+    enabled = g_getenv ("GTK_PIXEL_CACHE_GL") != NULL;
+
+  if (!enabled)
+    return FALSE;
+
+  if (cache->gl_context == NULL && !cache->gl_failed)
     {
-      r.x = cache->surface_x;
-      r.y = cache->surface_y;
-      r.width = cache->surface_w;
-      r.height = cache->surface_h;
+      cache->gl_context = gdk_window_create_gl_context (window, NULL);
 
-      free_region = region =
-        cairo_region_create_rectangle (&r);
+      if (cache->gl_context == NULL ||
+          !gdk_gl_context_realize (cache->gl_context, NULL))
+        {
+          g_clear_object (&cache->gl_context);
+          cache->gl_failed = TRUE;
+        }
     }
 
-  if (cache->surface_dirty == NULL)
+  return cache->gl_context != NULL;
+}
+
+static void
+gtk_pixel_cache_upload_tile (GtkPixelCache     *cache,
+                             GtkPixelCacheTile *tile)
+{
+  cairo_surface_t *flipped;
+  cairo_t *flip_cr;
+  double sx, sy;
+  int width, height;
+
+  width = cairo_image_surface_get_width (tile->surface);
+  height = cairo_image_surface_get_height (tile->surface);
+
+  /* The textured-quad path in gdk_cairo_draw_from_gl () addresses
+   * textures bottom-up like GL-rendered content, so flip the
+   * cairo-rendered tile on upload.
+   */
+  flipped = cairo_image_surface_create (CAIRO_FORMAT_ARGB32, width, height);
+  cairo_surface_get_device_scale (tile->surface, &sx, &sy);
+  cairo_surface_set_device_scale (flipped, sx, sy);
+
+  flip_cr = cairo_create (flipped);
+  cairo_scale (flip_cr, 1.0, -1.0);
+  cairo_translate (flip_cr, 0, -TILE_SIZE);
+  cairo_set_source_surface (flip_cr, tile->surface, 0, 0);
+  cairo_set_operator (flip_cr, CAIRO_OPERATOR_SOURCE);
+  cairo_paint (flip_cr);
+  cairo_destroy (flip_cr);
+  cairo_surface_flush (flipped);
+
+  gdk_gl_context_make_current (cache->gl_context);
+
+  if (tile->texture == 0)
     {
-      cache->surface_dirty = cairo_region_copy (region);
-      cairo_region_translate (cache->surface_dirty,
-                              -cache->surface_x,
-                              -cache->surface_y);
+      glGenTextures (1, &tile->texture);
+      glBindTexture (GL_TEXTURE_2D, tile->texture);
+      glTexParameteri (GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+      glTexParameteri (GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+      glTexParameteri (GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+      glTexParameteri (GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
     }
   else
+    glBindTexture (GL_TEXTURE_2D, tile->texture);
+
+  glPixelStorei (GL_UNPACK_ROW_LENGTH,
+                 cairo_image_surface_get_stride (flipped) / 4);
+  glTexImage2D (GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0,
+                GL_BGRA, GL_UNSIGNED_INT_8_8_8_8_REV,
+                cairo_image_surface_get_data (flipped));
+  glPixelStorei (GL_UNPACK_ROW_LENGTH, 0);
+
+  /* make the upload visible to the shared paint context */
+  glFlush ();
+
+  cairo_surface_destroy (flipped);
+}
+
+static void
+gtk_pixel_cache_tile_clear (GtkPixelCache     *cache,
+                            GtkPixelCacheTile *tile)
+{
+  if (tile->surface)
+    cairo_surface_destroy (tile->surface);
+  if (tile->dirty)
+    cairo_region_destroy (tile->dirty);
+  if (tile->texture)
     {
-      cairo_region_translate (region,
-                              -cache->surface_x,
-                              -cache->surface_y);
-      cairo_region_union (cache->surface_dirty, region);
-      cairo_region_translate (region,
-                              cache->surface_x,
-                              cache->surface_y);
+      gdk_gl_context_make_current (cache->gl_context);
+      glDeleteTextures (1, &tile->texture);
     }
 
-  if (free_region)
-    cairo_region_destroy (free_region);
+  tile->surface = NULL;
+  tile->dirty = NULL;
+  tile->texture = 0;
+}
+
+static void
+gtk_pixel_cache_drop_tiles (GtkPixelCache *cache)
+{
+  int i;
+
+  if (cache->tiles == NULL)
+    return;
+
+  for (i = 0; i < cache->tiles_w * cache->tiles_h; i++)
+    gtk_pixel_cache_tile_clear (cache, &cache->tiles[i]);
+
+  g_free (cache->tiles);
+  cache->tiles = NULL;
+  cache->tiles_w = 0;
+  cache->tiles_h = 0;
+}
+
+static int
+tile_index_floor (int coord)
+{
+  int tile = coord / TILE_SIZE;
+
+  if (coord < 0 && coord % TILE_SIZE)
+    tile--;
+
+  return tile;
+}
+
+static int
+tile_index_ceil (int coord)
+{
+  int tile = coord / TILE_SIZE;
 
-  r.x = 0;
-  r.y = 0;
-  r.width = cache->surface_w;
-  r.height = cache->surface_h;
+  if (coord > 0 && coord % TILE_SIZE)
+    tile++;
+
+  return tile;
+}
+
+/* Moves the cached range over the tile grid; tiles covering both the
+ * old and the new range keep their pixels, tiles that fall out of
+ * range are destroyed and newly covered positions start out empty.
+ */
+static void
+gtk_pixel_cache_set_tile_range (GtkPixelCache *cache,
+                                int            tile_x,
+                                int            tile_y,
+                                int            tiles_w,
+                                int            tiles_h)
+{
+  GtkPixelCacheTile *tiles;
+  int col, row;
+
+  if (cache->tiles != NULL &&
+      tile_x == cache->tile_x &&
+      tile_y == cache->tile_y &&
+      tiles_w == cache->tiles_w &&
+      tiles_h == cache->tiles_h)
+    return;
 
-  cairo_region_intersect_rectangle (cache->surface_dirty, &r);
+  tiles = g_new0 (GtkPixelCacheTile, tiles_w * tiles_h);
+
+  for (row = 0; row < cache->tiles_h; row++)
+    for (col = 0; col < cache->tiles_w; col++)
+      {
+        GtkPixelCacheTile *tile = &cache->tiles[row * cache->tiles_w + col];
+        int new_col = cache->tile_x + col - tile_x;
+        int new_row = cache->tile_y + row - tile_y;
+
+        if (new_col >= 0 && new_col < tiles_w &&
+            new_row >= 0 && new_row < tiles_h)
+          tiles[new_row * tiles_w + new_col] = *tile;
+        else
+          gtk_pixel_cache_tile_clear (cache, tile);
+      }
+
+  g_free (cache->tiles);
+  cache->tiles = tiles;
+  cache->tile_x = tile_x;
+  cache->tile_y = tile_y;
+  cache->tiles_w = tiles_w;
+  cache->tiles_h = tiles_h;
 }
 
 static void
-_gtk_pixel_cache_create_surface_if_needed (GtkPixelCache         *cache,
-                                           GdkWindow             *window,
-                                           cairo_rectangle_int_t *view_rect,
-                                           cairo_rectangle_int_t *canvas_rect)
+gtk_pixel_cache_update_tiles (GtkPixelCache         *cache,
+                              GdkWindow             *window,
+                              cairo_rectangle_int_t *view_rect,
+                              cairo_rectangle_int_t *canvas_rect)
 {
-  cairo_rectangle_int_t rect;
-  int surface_w, surface_h;
   cairo_content_t content;
   cairo_pattern_t *bg;
   double red, green, blue, alpha;
+  double scale;
+  int x0, y0, x1, y1;
 
 #ifdef G_ENABLE_DEBUG
   if (gtk_get_debug_flags () & GTK_DEBUG_NO_PIXEL_CACHE)
@@ -201,190 +448,234 @@ _gtk_pixel_cache_create_surface_if_needed (GtkPixelCache         *cache,
         content = CAIRO_CONTENT_COLOR;
     }
 
-  surface_w = view_rect->width;
-  if (canvas_rect->width > surface_w)
-    surface_w = MIN (surface_w + cache->extra_width, canvas_rect->width);
-
-  surface_h = view_rect->height;
-  if (canvas_rect->height > surface_h)
-    surface_h = MIN (surface_h + cache->extra_height, canvas_rect->height);
-
-  /* If current surface can't fit view_rect or is too large, kill it */
-  if (cache->surface != NULL &&
-      (cairo_surface_get_content (cache->surface) != content ||
-       cache->surface_w < MAX(view_rect->width, surface_w - ALLOW_SMALLER_SIZE) ||
-       cache->surface_w > surface_w + ALLOW_LARGER_SIZE ||
-       cache->surface_h < MAX(view_rect->height, surface_h - ALLOW_SMALLER_SIZE) ||
-       cache->surface_h > surface_h + ALLOW_LARGER_SIZE ||
-       cache->surface_scale != gdk_window_get_scale_factor (window)))
-    {
-      cairo_surface_destroy (cache->surface);
-      cache->surface = NULL;
-      if (cache->surface_dirty)
-        cairo_region_destroy (cache->surface_dirty);
-      cache->surface_dirty = NULL;
-    }
+  /* GL-backed tiles are composited as textures; keep an alpha
+   * channel so the upload doesn't pick up undefined bytes.
+   */
+  if (gtk_pixel_cache_use_gl (cache, window))
+    content = CAIRO_CONTENT_COLOR_ALPHA;
+
+  scale = gdk_window_get_scale_factor (window);
 
-  /* Don't allocate a surface if view >= canvas, as we won't
+  /* If the current tiles don't match the content or scale, kill them */
+  if (cache->tiles != NULL &&
+      (cache->tiles_content != content ||
+       cache->surface_scale != scale))
+    gtk_pixel_cache_drop_tiles (cache);
+
+  /* Don't start caching if view >= canvas, as we won't
    * be scrolling then anyway, unless the widget requested it.
    */
-  if (cache->surface == NULL &&
-      (cache->always_cache ||
-       (view_rect->width < canvas_rect->width ||
-        view_rect->height < canvas_rect->height)))
-    {
-      cache->surface_x = -canvas_rect->x;
-      cache->surface_y = -canvas_rect->y;
-      cache->surface_w = surface_w;
-      cache->surface_h = surface_h;
-      cache->surface_scale = gdk_window_get_scale_factor (window);
-
-      cache->surface =
-        gdk_window_create_similar_surface (window, content,
-                                           surface_w, surface_h);
-      rect.x = 0;
-      rect.y = 0;
-      rect.width = surface_w;
-      rect.height = surface_h;
-      cache->surface_dirty =
-        cairo_region_create_rectangle (&rect);
-    }
+  if (cache->tiles == NULL &&
+      !cache->always_cache &&
+      view_rect->width >= canvas_rect->width &&
+      view_rect->height >= canvas_rect->height)
+    return;
+
+  /* Cache the viewport plus the extra margin, with the margin (but
+   * never the viewport itself) clamped to the canvas.
+   */
+  x0 = MIN (-canvas_rect->x,
+            MAX (-canvas_rect->x - (int) cache->extra_width, 0));
+  y0 = MIN (-canvas_rect->y,
+            MAX (-canvas_rect->y - (int) cache->extra_height, 0));
+  x1 = MAX (-canvas_rect->x + view_rect->width,
+            MIN (-canvas_rect->x + view_rect->width + (int) cache->extra_width,
+                 canvas_rect->width));
+  y1 = MAX (-canvas_rect->y + view_rect->height,
+            MIN (-canvas_rect->y + view_rect->height + (int) cache->extra_height,
+                 canvas_rect->height));
+
+  gtk_pixel_cache_set_tile_range (cache,
+                                  tile_index_floor (x0),
+                                  tile_index_floor (y0),
+                                  MAX (tile_index_ceil (x1) - tile_index_floor (x0), 1),
+                                  MAX (tile_index_ceil (y1) - tile_index_floor (y0), 1));
+
+  cache->tiles_content = content;
+  cache->surface_scale = scale;
 }
 
-static void
-_gtk_pixel_cache_set_position (GtkPixelCache         *cache,
-                               cairo_rectangle_int_t *view_rect,
-                               cairo_rectangle_int_t *canvas_rect)
+/* Repaints dirty tiles; with @defer set, tiles that already have
+ * content keep displaying it and their dirt is left in place for a
+ * later pass, so only newly exposed tiles are painted under the
+ * frame. Returns whether dirty tiles remain.
+ */
+static gboolean
+gtk_pixel_cache_repaint (GtkPixelCache         *cache,
+                         GdkWindow             *window,
+                         GtkPixelCacheDrawFunc  draw,
+                         cairo_rectangle_int_t *view_rect,
+                         cairo_rectangle_int_t *canvas_rect,
+                         gpointer               user_data,
+                         gboolean               defer)
 {
-  cairo_rectangle_int_t r, view_pos;
-  cairo_region_t *copy_region;
-  int new_surf_x, new_surf_y;
-  cairo_t *backing_cr;
+  gboolean deferred = FALSE;
+  int col, row;
+
+  if (cache->tiles == NULL)
+    return FALSE;
+
+  for (row = 0; row < cache->tiles_h; row++)
+    for (col = 0; col < cache->tiles_w; col++)
+      {
+        GtkPixelCacheTile *tile = &cache->tiles[row * cache->tiles_w + col];
+        cairo_region_t *dirty;
+        cairo_t *backing_cr;
+        int tile_canvas_x, tile_canvas_y;
+
+        if (tile->surface == NULL)
+          {
+            cairo_rectangle_int_t r = { 0, 0, TILE_SIZE, TILE_SIZE };
+
+            if (cache->gl_context != NULL)
+              {
+                /* An image surface, so the texture upload reads
+                 * straight from memory instead of a server round trip
+                 */
+                int scale = gdk_window_get_scale_factor (window);
+
+                tile->surface =
+                  gdk_window_create_similar_image_surface (window,
+                                                           CAIRO_FORMAT_ARGB32,
+                                                           TILE_SIZE * scale,
+                                                           TILE_SIZE * scale,
+                                                           scale);
+              }
+            else
+              tile->surface =
+                gdk_window_create_similar_surface (window, cache->tiles_content,
+                                                   TILE_SIZE, TILE_SIZE);
+            if (tile->dirty)
+              cairo_region_destroy (tile->dirty);
+            tile->dirty = cairo_region_create_rectangle (&r);
+          }
+
+        if (defer && tile->dirty != NULL)
+          {
+            /* The stale content is still presentable; leave the dirt
+             * for the idle pass instead of blowing the frame budget.
+             */
+            deferred = TRUE;
+            continue;
+          }
+
+        dirty = tile->dirty;
+        tile->dirty = NULL;
+
+        if (dirty == NULL)
+          continue;
+
+        if (cairo_region_is_empty (dirty))
+          {
+            cairo_region_destroy (dirty);
+            continue;
+          }
+
+        tile_canvas_x = (cache->tile_x + col) * TILE_SIZE;
+        tile_canvas_y = (cache->tile_y + row) * TILE_SIZE;
+
+        backing_cr = cairo_create (tile->surface);
+        gdk_cairo_region (backing_cr, dirty);
+        cairo_clip (backing_cr);
+        cairo_translate (backing_cr,
+                         -tile_canvas_x - canvas_rect->x - view_rect->x,
+                         -tile_canvas_y - canvas_rect->y - view_rect->y);
+
+        cairo_save (backing_cr);
+        cairo_set_source_rgba (backing_cr,
+                               0.0, 0, 0, 0.0);
+        cairo_set_operator (backing_cr, CAIRO_OPERATOR_SOURCE);
+        cairo_paint (backing_cr);
+        cairo_restore (backing_cr);
+
+        cairo_save (backing_cr);
+        draw (backing_cr, user_data);
+        cairo_restore (backing_cr);
 
-  if (cache->surface == NULL)
-    return;
+#ifdef G_ENABLE_DEBUG
+        if (gtk_get_debug_flags () & GTK_DEBUG_PIXEL_CACHE)
+          {
+            GdkRGBA colors[] = {
+              { 1, 0, 0, 0.08},
+              { 0, 1, 0, 0.08},
+              { 0, 0, 1, 0.08},
+              { 1, 0, 1, 0.08},
+              { 1, 1, 0, 0.08},
+              { 0, 1, 1, 0.08},
+            };
+            static int current_color = 0;
+
+            gdk_cairo_set_source_rgba (backing_cr, &colors[(current_color++) % G_N_ELEMENTS (colors)]);
+            cairo_paint (backing_cr);
+          }
+#endif
 
-  /* Position of view inside canvas */
-  view_pos.x = -canvas_rect->x;
-  view_pos.y = -canvas_rect->y;
-  view_pos.width = view_rect->width;
-  view_pos.height = view_rect->height;
-
-  /* Reposition so all is visible */
-  if (view_pos.x < cache->surface_x ||
-      view_pos.x + view_pos.width > cache->surface_x + cache->surface_w ||
-      view_pos.y < cache->surface_y ||
-      view_pos.y + view_pos.height > cache->surface_y + cache->surface_h)
-    {
-      new_surf_x = cache->surface_x;
-      if (view_pos.x < cache->surface_x)
-        new_surf_x = MAX (view_pos.x + view_pos.width - cache->surface_w, 0);
-      else if (view_pos.x + view_pos.width >
-               cache->surface_x + cache->surface_w)
-        new_surf_x = MIN (view_pos.x, canvas_rect->width - cache->surface_w);
-
-      new_surf_y = cache->surface_y;
-      if (view_pos.y < cache->surface_y)
-        new_surf_y = MAX (view_pos.y + view_pos.height - cache->surface_h, 0);
-      else if (view_pos.y + view_pos.height >
-               cache->surface_y + cache->surface_h)
-        new_surf_y = MIN (view_pos.y, canvas_rect->height - cache->surface_h);
-
-      r.x = 0;
-      r.y = 0;
-      r.width = cache->surface_w;
-      r.height = cache->surface_h;
-      copy_region = cairo_region_create_rectangle (&r);
-
-      if (cache->surface_dirty)
-        {
-          cairo_region_subtract (copy_region, cache->surface_dirty);
-          cairo_region_destroy (cache->surface_dirty);
-          cache->surface_dirty = NULL;
-        }
+        cairo_destroy (backing_cr);
+        cairo_region_destroy (dirty);
 
-      cairo_region_translate (copy_region,
-                              cache->surface_x - new_surf_x,
-                              cache->surface_y - new_surf_y);
-      cairo_region_intersect_rectangle (copy_region, &r);
-
-      backing_cr = cairo_create (cache->surface);
-      gdk_cairo_region (backing_cr, copy_region);
-      cairo_set_operator (backing_cr, CAIRO_OPERATOR_SOURCE);
-      cairo_clip (backing_cr);
-      cairo_push_group (backing_cr);
-      cairo_set_source_surface (backing_cr, cache->surface,
-                                cache->surface_x - new_surf_x,
-                                cache->surface_y - new_surf_y);
-      cairo_paint (backing_cr);
-      cairo_pop_group_to_source (backing_cr);
-      cairo_paint (backing_cr);
-      cairo_destroy (backing_cr);
-
-      cache->surface_x = new_surf_x;
-      cache->surface_y = new_surf_y;
-
-      cairo_region_xor_rectangle (copy_region, &r);
-      cache->surface_dirty = copy_region;
-    }
+        if (cache->gl_context != NULL)
+          gtk_pixel_cache_upload_tile (cache, tile);
+      }
+
+  return deferred;
 }
 
 static void
-_gtk_pixel_cache_repaint (GtkPixelCache         *cache,
-                          GtkPixelCacheDrawFunc  draw,
-                          cairo_rectangle_int_t *view_rect,
-                          cairo_rectangle_int_t *canvas_rect,
-                          gpointer               user_data)
+gtk_pixel_cache_cancel_idle_repaint (GtkPixelCache *cache)
 {
-  cairo_t *backing_cr;
-  cairo_region_t *region_dirty = cache->surface_dirty;
-  cache->surface_dirty = NULL;
+  if (cache->idle_tag == 0)
+    return;
 
-  if (cache->surface &&
-      region_dirty &&
-      !cairo_region_is_empty (region_dirty))
-    {
-      backing_cr = cairo_create (cache->surface);
-      gdk_cairo_region (backing_cr, region_dirty);
-      cairo_clip (backing_cr);
-      cairo_translate (backing_cr,
-                       -cache->surface_x - canvas_rect->x - view_rect->x,
-                       -cache->surface_y - canvas_rect->y - view_rect->y);
-
-      cairo_save (backing_cr);
-      cairo_set_source_rgba (backing_cr,
-                             0.0, 0, 0, 0.0);
-      cairo_set_operator (backing_cr, CAIRO_OPERATOR_SOURCE);
-      cairo_paint (backing_cr);
-      cairo_restore (backing_cr);
-
-      cairo_save (backing_cr);
-      draw (backing_cr, user_data);
-      cairo_restore (backing_cr);
+  g_source_remove (cache->idle_tag);
+  cache->idle_tag = 0;
+  g_object_unref (cache->idle_window);
+  cache->idle_window = NULL;
+}
 
-#ifdef G_ENABLE_DEBUG
-      if (gtk_get_debug_flags () & GTK_DEBUG_PIXEL_CACHE)
-        {
-          GdkRGBA colors[] = {
-            { 1, 0, 0, 0.08},
-            { 0, 1, 0, 0.08},
-            { 0, 0, 1, 0.08},
-            { 1, 0, 1, 0.08},
-            { 1, 1, 0, 0.08},
-            { 0, 1, 1, 0.08},
-          };
-          static int current_color = 0;
-
-          gdk_cairo_set_source_rgba (backing_cr, &colors[(current_color++) % G_N_ELEMENTS (colors)]);
-          cairo_paint (backing_cr);
-        }
-#endif
+static gboolean
+repaint_tiles_idle_cb (gpointer user_data)
+{
+  GtkPixelCache *cache = user_data;
+  GdkWindow *window = cache->idle_window;
 
-      cairo_destroy (backing_cr);
-    }
+  cache->idle_tag = 0;
+  cache->idle_window = NULL;
+
+  gtk_pixel_cache_repaint (cache, window, cache->idle_draw,
+                           &cache->idle_view_rect, &cache->idle_canvas_rect,
+                           cache->idle_user_data, FALSE);
+
+  /* Expose the freshened tiles on the next frame */
+  gdk_window_invalidate_rect (window, &cache->idle_view_rect, FALSE);
 
-  if (region_dirty)
-    cairo_region_destroy (region_dirty);
+  g_object_unref (window);
+
+  return G_SOURCE_REMOVE;
+}
+
+static void
+gtk_pixel_cache_queue_idle_repaint (GtkPixelCache         *cache,
+                                    GdkWindow             *window,
+                                    GtkPixelCacheDrawFunc  draw,
+                                    cairo_rectangle_int_t *view_rect,
+                                    cairo_rectangle_int_t *canvas_rect,
+                                    gpointer               user_data)
+{
+  gtk_pixel_cache_cancel_idle_repaint (cache);
+
+  cache->idle_window = g_object_ref (window);
+  cache->idle_draw = draw;
+  cache->idle_user_data = user_data;
+  cache->idle_view_rect = *view_rect;
+  cache->idle_canvas_rect = *canvas_rect;
+
+  /* Just below the redraw priority, so the pending frame gets
+   * presented before we go back to painting tiles.
+   */
+  cache->idle_tag = gdk_threads_add_idle_full (GDK_PRIORITY_REDRAW + 5,
+                                               repaint_tiles_idle_cb,
+                                               cache, NULL);
+  g_source_set_name_by_id (cache->idle_tag, "[gtk+] repaint_tiles_idle_cb");
 }
 
 static void
@@ -396,14 +687,8 @@ gtk_pixel_cache_blow_cache (GtkPixelCache *cache)
       cache->timeout_tag = 0;
     }
 
-  if (cache->surface)
-    {
-      cairo_surface_destroy (cache->surface);
-      cache->surface = NULL;
-      if (cache->surface_dirty)
-        cairo_region_destroy (cache->surface_dirty);
-      cache->surface_dirty = NULL;
-    }
+  gtk_pixel_cache_cancel_idle_repaint (cache);
+  gtk_pixel_cache_drop_tiles (cache);
 }
 
 static gboolean
@@ -448,22 +733,50 @@ _gtk_pixel_cache_draw (GtkPixelCache         *cache,
                                               blow_cache_cb, cache);
   g_source_set_name_by_id (cache->timeout_tag, "[gtk+] blow_cache_cb");
 
-  _gtk_pixel_cache_create_surface_if_needed (cache, window,
-                                             view_rect, canvas_rect);
-  _gtk_pixel_cache_set_position (cache, view_rect, canvas_rect);
-  _gtk_pixel_cache_repaint (cache, draw, view_rect, canvas_rect, user_data);
+  gtk_pixel_cache_update_tiles (cache, window, view_rect, canvas_rect);
 
-  if (cache->surface && context_is_unscaled (cr) &&
-      /* Don't use backing surface if rendering elsewhere */
-      cairo_surface_get_type (cache->surface) == cairo_surface_get_type (cairo_get_target (cr)))
+  if (gtk_pixel_cache_repaint (cache, window, draw, view_rect, canvas_rect,
+                               user_data, cache->deferred_repaint))
+    gtk_pixel_cache_queue_idle_repaint (cache, window, draw,
+                                        view_rect, canvas_rect, user_data);
+
+  if (cache->tiles && context_is_unscaled (cr) &&
+      /* Don't use backing tiles if rendering elsewhere */
+      (cache->gl_context != NULL ||
+       cairo_surface_get_type (cache->tiles[0].surface) == cairo_surface_get_type (cairo_get_target (cr))))
     {
+      int scale = cache->surface_scale;
+      int col, row;
+
       cairo_save (cr);
-      cairo_set_source_surface (cr, cache->surface,
-                                cache->surface_x + view_rect->x + canvas_rect->x,
-                                cache->surface_y + view_rect->y + canvas_rect->y);
       cairo_rectangle (cr, view_rect->x, view_rect->y,
                        view_rect->width, view_rect->height);
-      cairo_fill (cr);
+      cairo_clip (cr);
+
+      for (row = 0; row < cache->tiles_h; row++)
+        for (col = 0; col < cache->tiles_w; col++)
+          {
+            GtkPixelCacheTile *tile = &cache->tiles[row * cache->tiles_w + col];
+            int dest_x = (cache->tile_x + col) * TILE_SIZE + view_rect->x + canvas_rect->x;
+            int dest_y = (cache->tile_y + row) * TILE_SIZE + view_rect->y + canvas_rect->y;
+
+            if (tile->texture != 0)
+              {
+                cairo_save (cr);
+                cairo_translate (cr, dest_x, dest_y);
+                gdk_cairo_draw_from_gl (cr, window,
+                                        tile->texture, GL_TEXTURE, scale,
+                                        0, 0,
+                                        TILE_SIZE * scale, TILE_SIZE * scale);
+                cairo_restore (cr);
+                continue;
+              }
+
+            cairo_set_source_surface (cr, tile->surface, dest_x, dest_y);
+            cairo_rectangle (cr, dest_x, dest_y, TILE_SIZE, TILE_SIZE);
+            cairo_fill (cr);
+          }
+
       cairo_restore (cr);
     }
   else
@@ -500,3 +813,22 @@ _gtk_pixel_cache_set_always_cache (GtkPixelCache *cache,
 {
   cache->always_cache = !!always_cache;
 }
+
+gboolean
+_gtk_pixel_cache_get_deferred_repaint (GtkPixelCache *cache)
+{
+  return cache->deferred_repaint;
+}
+
+/* With deferred repaint enabled, tiles invalidated while they still
+ * have presentable content are not repainted under the frame paint;
+ * the stale pixels keep showing and the tiles are refreshed from an
+ * idle, which trades momentary staleness for a bounded frame cost.
+ * Newly exposed tiles are always painted synchronously.
+ */
+void
+_gtk_pixel_cache_set_deferred_repaint (GtkPixelCache *cache,
+                                       gboolean       deferred_repaint)
+{
+  cache->deferred_repaint = !!deferred_repaint;
+}
@@ -54,6 +54,9 @@ void           _gtk_pixel_cache_set_content      (GtkPixelCache         *cache,
 gboolean       _gtk_pixel_cache_get_always_cache (GtkPixelCache         *cache);
 void           _gtk_pixel_cache_set_always_cache (GtkPixelCache         *cache,
                                                   gboolean               always_cache);
+gboolean       _gtk_pixel_cache_get_deferred_repaint (GtkPixelCache     *cache);
+void           _gtk_pixel_cache_set_deferred_repaint (GtkPixelCache     *cache,
+                                                      gboolean           deferred_repaint);
 
 
 G_END_DECLS
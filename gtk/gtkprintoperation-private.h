@@ -84,6 +84,18 @@ struct _GtkPrintOperationPrivate
 
   GMainLoop *rloop; /* recursive mainloop */
 
+  /* Pipelined rendering (GtkPrintOperation:render-ahead). While
+   * render_thread runs, it owns render_target_cr and the surface
+   * beneath it; the main thread records pages into recording
+   * surfaces and feeds them through render_queue.
+   */
+  gint render_ahead;
+  guint pipeline_checked : 1;
+  guint page_recorded    : 1;
+  GThread *render_thread;
+  GAsyncQueue *render_queue;
+  cairo_t *render_target_cr;
+
   void (*start_page) (GtkPrintOperation *operation,
 		      GtkPrintContext   *print_context,
 		      GtkPageSetup      *page_setup);
@@ -24,6 +24,9 @@
 #include <string.h>
 
 #include <cairo-pdf.h>
+#ifdef CAIRO_HAS_PS_SURFACE
+#include <cairo-ps.h>
+#endif
 
 #include "gtkprintoperation-private.h"
 #include "gtkmarshalers.h"
@@ -141,7 +144,8 @@ enum
   PROP_EMBED_PAGE_SETUP,
   PROP_HAS_SELECTION,
   PROP_SUPPORT_SELECTION,
-  PROP_N_PAGES_TO_PRINT
+  PROP_N_PAGES_TO_PRINT,
+  PROP_RENDER_AHEAD
 };
 
 static guint signals[LAST_SIGNAL] = { 0 };
@@ -153,6 +157,8 @@ static GtkPageSetup *create_page_setup       (GtkPrintOperation             *op)
 static void          common_render_page      (GtkPrintOperation             *op,
 					      gint                           page_nr);
 static void          increment_page_sequence (PrintPagesData *data);
+static void          print_pipeline_push     (GtkPrintOperation *op);
+static void          print_pipeline_shutdown (GtkPrintOperation *op);
 static void          prepare_data            (PrintPagesData *data);
 static void          clamp_page_ranges       (PrintPagesData *data);
 
@@ -186,6 +192,8 @@ gtk_print_operation_finalize (GObject *object)
   GtkPrintOperation *print_operation = GTK_PRINT_OPERATION (object);
   GtkPrintOperationPrivate *priv = print_operation->priv;
 
+  print_pipeline_shutdown (print_operation);
+
   if (priv->free_platform_data &&
       priv->platform_data)
     {
@@ -243,6 +251,7 @@ gtk_print_operation_init (GtkPrintOperation *operation)
   priv->support_selection = FALSE;
   priv->has_selection = FALSE;
   priv->embed_page_setup = FALSE;
+  priv->render_ahead = 0;
 
   priv->page_drawing_state = GTK_PAGE_DRAWING_STATE_READY;
 
@@ -425,6 +434,9 @@ gtk_print_operation_set_property (GObject      *object,
     case PROP_SUPPORT_SELECTION:
       gtk_print_operation_set_support_selection (op, g_value_get_boolean (value));
       break;
+    case PROP_RENDER_AHEAD:
+      gtk_print_operation_set_render_ahead (op, g_value_get_int (value));
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -496,6 +508,9 @@ gtk_print_operation_get_property (GObject    *object,
     case PROP_N_PAGES_TO_PRINT:
       g_value_set_int (value, priv->nr_of_pages_to_print);
       break;
+    case PROP_RENDER_AHEAD:
+      g_value_set_int (value, priv->render_ahead);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -1449,6 +1464,26 @@ gtk_print_operation_class_init (GtkPrintOperationClass *class)
 						     G_MAXINT,
 						     -1,
 						     GTK_PARAM_READABLE|G_PARAM_EXPLICIT_NOTIFY));
+
+  /**
+   * GtkPrintOperation:render-ahead:
+   *
+   * The number of pages that may be rendered ahead of the printer
+   * output, or 0 to render each page directly into the print surface.
+   *
+   * See gtk_print_operation_set_render_ahead().
+   *
+   * Since: 3.18
+   */
+  g_object_class_install_property (gobject_class,
+				   PROP_RENDER_AHEAD,
+				   g_param_spec_int ("render-ahead",
+						     P_("Render Ahead"),
+						     P_("The number of pages to render ahead of the printer output"),
+						     0,
+						     G_MAXINT,
+						     0,
+						     GTK_PARAM_READWRITE|G_PARAM_EXPLICIT_NOTIFY));
 }
 
 /**
@@ -2405,6 +2440,61 @@ gtk_print_operation_set_defer_drawing (GtkPrintOperation *op)
   priv->page_drawing_state = GTK_PAGE_DRAWING_STATE_DEFERRED_DRAWING;
 }
 
+/**
+ * gtk_print_operation_set_render_ahead:
+ * @op: a #GtkPrintOperation
+ * @n_pages: the number of pages to render ahead, or 0 to disable
+ *
+ * Sets the number of pages that may be rendered ahead of the printer
+ * output.
+ *
+ * When @n_pages is greater than 0 and the operation prints to a PDF
+ * or PostScript surface with a number-up of 1, each
+ * #GtkPrintOperation::draw-page emission renders into a recording
+ * surface and a worker thread replays finished pages into the print
+ * surface. Application drawing then overlaps output serialization
+ * instead of alternating with it, which keeps the main loop available
+ * for long documents. For other targets pages are rendered directly,
+ * as if render ahead were 0.
+ *
+ * Since: 3.18
+ */
+void
+gtk_print_operation_set_render_ahead (GtkPrintOperation *op,
+                                      gint               n_pages)
+{
+  GtkPrintOperationPrivate *priv;
+
+  g_return_if_fail (GTK_IS_PRINT_OPERATION (op));
+  g_return_if_fail (n_pages >= 0);
+
+  priv = op->priv;
+
+  if (priv->render_ahead != n_pages)
+    {
+      priv->render_ahead = n_pages;
+      g_object_notify (G_OBJECT (op), "render-ahead");
+    }
+}
+
+/**
+ * gtk_print_operation_get_render_ahead:
+ * @op: a #GtkPrintOperation
+ *
+ * Gets the value of #GtkPrintOperation:render-ahead.
+ *
+ * Returns: the number of pages rendered ahead of the printer output
+ *
+ * Since: 3.18
+ */
+gint
+gtk_print_operation_get_render_ahead (GtkPrintOperation *op)
+{
+  g_return_val_if_fail (GTK_IS_PRINT_OPERATION (op), 0);
+
+  return op->priv->render_ahead;
+}
+
 /**
  * gtk_print_operation_set_embed_page_setup:
  * @op: a #GtkPrintOperation
@@ -2478,15 +2568,189 @@ gtk_print_operation_draw_page_finish (GtkPrintOperation *op)
 
   cr = gtk_print_context_get_cairo_context (print_context);
 
-  priv->end_page (op, print_context);
-  
-  cairo_restore (cr);
+  if (priv->page_recorded)
+    {
+      cairo_restore (cr);
+
+      print_pipeline_push (op);
+    }
+  else
+    {
+      priv->end_page (op, print_context);
+
+      cairo_restore (cr);
+    }
 
   g_object_unref (page_setup);
 
   priv->page_drawing_state = GTK_PAGE_DRAWING_STATE_READY;
 }
 
+typedef struct
+{
+  cairo_surface_t *recording;
+  gdouble width;
+  gdouble height;
+  GtkPageOrientation orientation;
+} PipelinePageJob;
+
+/* Queued after the last page to tell the render thread to exit */
+static PipelinePageJob pipeline_job_done;
+
+/* Replays recorded pages into the target surface. While the thread
+ * runs it is the only user of render_target_cr and the surface below
+ * it; everything else it reads from the job or from fields that stay
+ * constant for the duration of the print run.
+ */
+static gpointer
+print_pipeline_thread (gpointer data)
+{
+  GtkPrintOperationPrivate *priv = data;
+  cairo_surface_t *target = cairo_get_target (priv->render_target_cr);
+  cairo_surface_type_t type = cairo_surface_get_type (target);
+  PipelinePageJob *job;
+
+  while ((job = g_async_queue_pop (priv->render_queue)) != &pipeline_job_done)
+    {
+      if (type == CAIRO_SURFACE_TYPE_PDF)
+        cairo_pdf_surface_set_size (target, job->width, job->height);
+#ifdef CAIRO_HAS_PS_SURFACE
+      else if (type == CAIRO_SURFACE_TYPE_PS)
+        {
+          cairo_ps_surface_set_size (target, job->width, job->height);
+          cairo_ps_surface_dsc_begin_page_setup (target);
+          switch (job->orientation)
+            {
+              case GTK_PAGE_ORIENTATION_PORTRAIT:
+              case GTK_PAGE_ORIENTATION_REVERSE_PORTRAIT:
+                cairo_ps_surface_dsc_comment (target, "%%PageOrientation: Portrait");
+                break;
+
+              case GTK_PAGE_ORIENTATION_LANDSCAPE:
+              case GTK_PAGE_ORIENTATION_REVERSE_LANDSCAPE:
+                cairo_ps_surface_dsc_comment (target, "%%PageOrientation: Landscape");
+                break;
+            }
+        }
+#endif
+
+      cairo_save (priv->render_target_cr);
+      cairo_set_source_surface (priv->render_target_cr, job->recording, 0, 0);
+      cairo_paint (priv->render_target_cr);
+      cairo_restore (priv->render_target_cr);
+      cairo_show_page (priv->render_target_cr);
+
+      cairo_surface_destroy (job->recording);
+      g_slice_free (PipelinePageJob, job);
+    }
+
+  return NULL;
+}
+
+/* Starts the render thread on first use, if render-ahead is set and
+ * the target can be replayed off the main thread. Previews and
+ * number-up printing keep the direct path: their start_page/end_page
+ * handlers do more than size the surface and show the page.
+ */
+static gboolean
+print_pipeline_start (GtkPrintOperation *op)
+{
+  GtkPrintOperationPrivate *priv = op->priv;
+  cairo_surface_type_t type;
+  cairo_t *cr;
+
+  if (priv->render_thread)
+    return TRUE;
+
+  if (priv->pipeline_checked)
+    return FALSE;
+
+  priv->pipeline_checked = TRUE;
+
+  if (priv->render_ahead <= 0 ||
+      priv->manual_number_up > 1 ||
+      priv->action == GTK_PRINT_OPERATION_ACTION_PREVIEW)
+    return FALSE;
+
+  cr = gtk_print_context_get_cairo_context (priv->print_context);
+  if (cr == NULL)
+    return FALSE;
+
+  type = cairo_surface_get_type (cairo_get_target (cr));
+  if (type != CAIRO_SURFACE_TYPE_PDF
+#ifdef CAIRO_HAS_PS_SURFACE
+      && type != CAIRO_SURFACE_TYPE_PS
+#endif
+     )
+    return FALSE;
+
+  priv->render_target_cr = cairo_reference (cr);
+  priv->render_queue = g_async_queue_new ();
+  priv->render_thread = g_thread_new ("gtk-print-pipeline",
+                                      print_pipeline_thread, priv);
+
+  return TRUE;
+}
+
+/* Hands the recorded page over to the render thread, sized the same
+ * way unix_start_page() and pdf_start_page() would size the surface.
+ */
+static void
+print_pipeline_push (GtkPrintOperation *op)
+{
+  GtkPrintOperationPrivate *priv = op->priv;
+  GtkPageSetup *page_setup;
+  GtkPaperSize *paper_size;
+  PipelinePageJob *job;
+  cairo_t *cr;
+
+  page_setup = gtk_print_context_get_page_setup (priv->print_context);
+  cr = gtk_print_context_get_cairo_context (priv->print_context);
+
+  job = g_slice_new (PipelinePageJob);
+  job->recording = cairo_surface_reference (cairo_get_target (cr));
+  job->orientation = gtk_page_setup_get_orientation (page_setup);
+
+  if (!priv->manual_orientation &&
+      cairo_surface_get_type (cairo_get_target (priv->render_target_cr)) == CAIRO_SURFACE_TYPE_PDF)
+    {
+      job->width = gtk_page_setup_get_paper_width (page_setup, GTK_UNIT_POINTS);
+      job->height = gtk_page_setup_get_paper_height (page_setup, GTK_UNIT_POINTS);
+    }
+  else
+    {
+      paper_size = gtk_page_setup_get_paper_size (page_setup);
+      job->width = gtk_paper_size_get_width (paper_size, GTK_UNIT_POINTS);
+      job->height = gtk_paper_size_get_height (paper_size, GTK_UNIT_POINTS);
+    }
+
+  g_async_queue_push (priv->render_queue, job);
+
+  priv->page_recorded = FALSE;
+}
+
+/* Waits for the render thread to finish the queued pages and drops the
+ * pipeline state. Must run before end_run() finishes the surface.
+ */
+static void
+print_pipeline_shutdown (GtkPrintOperation *op)
+{
+  GtkPrintOperationPrivate *priv = op->priv;
+
+  if (priv->render_thread == NULL)
+    return;
+
+  g_async_queue_push (priv->render_queue, &pipeline_job_done);
+  g_thread_join (priv->render_thread);
+  priv->render_thread = NULL;
+
+  g_async_queue_unref (priv->render_queue);
+  priv->render_queue = NULL;
+
+  cairo_destroy (priv->render_target_cr);
+  priv->render_target_cr = NULL;
+}
+
 static void
 common_render_page (GtkPrintOperation *op,
 		    gint               page_nr)
@@ -2504,8 +2768,31 @@ common_render_page (GtkPrintOperation *op,
 		 print_context, page_nr, page_setup);
   
   _gtk_print_context_set_page_setup (print_context, page_setup);
-  
-  priv->start_page (op, print_context, page_setup);
+
+  priv->page_recorded = FALSE;
+
+  if (print_pipeline_start (op))
+    {
+      cairo_rectangle_t extents;
+      cairo_surface_t *recording;
+      cairo_t *record_cr;
+
+      extents.x = 0;
+      extents.y = 0;
+      extents.width = gtk_page_setup_get_paper_width (page_setup, GTK_UNIT_POINTS);
+      extents.height = gtk_page_setup_get_paper_height (page_setup, GTK_UNIT_POINTS);
+
+      recording = cairo_recording_surface_create (CAIRO_CONTENT_COLOR_ALPHA, &extents);
+      record_cr = cairo_create (recording);
+      cairo_surface_destroy (recording);
+
+      gtk_print_context_set_cairo_context (print_context, record_cr, 72, 72);
+      cairo_destroy (record_cr);
+
+      priv->page_recorded = TRUE;
+    }
+  else
+    priv->start_page (op, print_context, page_setup);
   
   cr = gtk_print_context_get_cairo_context (print_context);
   
@@ -2909,6 +3196,14 @@ print_pages_idle (gpointer user_data)
           goto out;
         }
 
+      /* When the render thread falls behind the render-ahead limit,
+       * leave the idle installed and let it drain; we only run again
+       * once the main loop is otherwise idle.
+       */
+      if (priv->render_thread &&
+          g_async_queue_length (priv->render_queue) >= priv->render_ahead)
+        goto out;
+
       increment_page_sequence (data);
 
       if (!data->done)
@@ -2928,6 +3223,7 @@ print_pages_idle (gpointer user_data)
 
       if (done && !data->is_preview)
         {
+          print_pipeline_shutdown (data->op);
           g_signal_emit (data->op, signals[END_PRINT], 0, priv->print_context);
           priv->end_run (data->op, priv->is_sync, priv->cancelled);
         }
@@ -3059,6 +3355,11 @@ print_pages (GtkPrintOperation       *op,
       priv->end_page = preview_end_page;
       priv->end_run = preview_end_run;
 
+      /* Previews render through the preview context and must not be
+       * pipelined; the render pass reuses this operation.
+       */
+      priv->pipeline_checked = TRUE;
+
       priv->print_pages = gtk_print_settings_get_print_pages (priv->print_settings);
       priv->page_ranges = gtk_print_settings_get_page_ranges (priv->print_settings,
 							      &priv->num_page_ranges);
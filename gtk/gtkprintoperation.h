@@ -290,6 +290,11 @@ GDK_AVAILABLE_IN_ALL
 void                    gtk_print_operation_draw_page_finish       (GtkPrintOperation  *op);
 GDK_AVAILABLE_IN_ALL
 void                    gtk_print_operation_set_defer_drawing      (GtkPrintOperation  *op);
+GDK_AVAILABLE_IN_3_18
+void                    gtk_print_operation_set_render_ahead       (GtkPrintOperation  *op,
+                                                                    gint                n_pages);
+GDK_AVAILABLE_IN_3_18
+gint                    gtk_print_operation_get_render_ahead       (GtkPrintOperation  *op);
 GDK_AVAILABLE_IN_ALL
 void                    gtk_print_operation_set_support_selection  (GtkPrintOperation  *op,
                                                                     gboolean            support_selection);
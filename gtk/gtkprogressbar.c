@@ -31,6 +31,7 @@
 #include "gtkwidgetprivate.h"
 #include "gtkprivate.h"
 #include "gtkintl.h"
+#include "gtkpango.h"
 
 #include "a11y/gtkprogressbaraccessible.h"
 
@@ -68,6 +69,11 @@
 #define MIN_VERTICAL_BAR_WIDTH     7
 #define MIN_VERTICAL_BAR_HEIGHT    80
 
+/* Extra pixels invalidated around the fill's moving edge, covering the
+ * frame and rounded corners the theme draws there.
+ */
+#define FILL_REDRAW_SLACK          16
+
 
 struct _GtkProgressBarPrivate
 {
@@ -506,9 +512,7 @@ gtk_progress_bar_get_preferred_width (GtkWidget *widget,
 
           /* The minimum size for ellipsized text is ~ 3 chars */
           context = pango_layout_get_context (layout);
-          metrics = pango_context_get_metrics (context,
-                                               pango_context_get_font_description (context),
-                                               pango_context_get_language (context));
+          metrics = _gtk_pango_get_metrics (context);
 
           char_width = pango_font_metrics_get_approximate_char_width (metrics);
           pango_font_metrics_unref (metrics);
@@ -1087,6 +1091,94 @@ gtk_progress_bar_draw (GtkWidget *widget,
   return FALSE;
 }
 
+/* Invalidate only the span of the trough whose filled state differs
+ * between the old and the new fraction. This assumes the fill's
+ * rendering away from its moving edge does not depend on its length,
+ * which holds for the stock themes; the corner classes swapped in at
+ * fraction 1.0 and the overlaid text make those cases repaint fully.
+ */
+static void
+gtk_progress_bar_queue_fraction_redraw (GtkProgressBar *pbar,
+                                        gdouble         old_fraction)
+{
+  GtkWidget *widget = GTK_WIDGET (pbar);
+  GtkProgressBarPrivate *priv = pbar->priv;
+  GtkStyleContext *context;
+  GtkStateFlags state;
+  GtkBorder padding;
+  GtkAllocation allocation;
+  GtkOrientation orientation;
+  gboolean inverted;
+  gint space, lo, hi;
+
+  if (!gtk_widget_is_drawable (widget))
+    return;
+
+  if (old_fraction == priv->fraction)
+    return;
+
+  if (priv->activity_mode ||
+      priv->show_text ||
+      old_fraction == 1.0 ||
+      priv->fraction == 1.0)
+    {
+      gtk_widget_queue_draw (widget);
+      return;
+    }
+
+  context = gtk_widget_get_style_context (widget);
+  state = gtk_widget_get_state_flags (widget);
+  gtk_style_context_get_padding (context, state, &padding);
+
+  orientation = priv->orientation;
+  inverted = priv->inverted;
+  if (gtk_widget_get_direction (widget) == GTK_TEXT_DIR_RTL &&
+      orientation == GTK_ORIENTATION_HORIZONTAL)
+    inverted = !inverted;
+
+  gtk_widget_get_allocation (widget, &allocation);
+
+  if (orientation == GTK_ORIENTATION_HORIZONTAL)
+    space = allocation.width - padding.left - padding.right;
+  else
+    space = allocation.height - padding.top - padding.bottom;
+
+  if (space <= 0)
+    return;
+
+  lo = (gint) (space * MIN (old_fraction, priv->fraction)) - FILL_REDRAW_SLACK;
+  hi = (gint) (space * MAX (old_fraction, priv->fraction)) + FILL_REDRAW_SLACK;
+  lo = MAX (lo, 0);
+  hi = MIN (hi, space);
+
+  if (orientation == GTK_ORIENTATION_HORIZONTAL)
+    {
+      gint x;
+
+      if (!inverted)
+        x = padding.left + lo;
+      else
+        x = allocation.width - padding.right - hi;
+
+      gtk_widget_queue_draw_area (widget,
+                                  allocation.x + x, allocation.y,
+                                  hi - lo, allocation.height);
+    }
+  else
+    {
+      gint y;
+
+      if (!inverted)
+        y = padding.top + lo;
+      else
+        y = allocation.height - padding.bottom - hi;
+
+      gtk_widget_queue_draw_area (widget,
+                                  allocation.x, allocation.y + y,
+                                  allocation.width, hi - lo);
+    }
+}
+
 static void
 gtk_progress_bar_set_activity_mode (GtkProgressBar *pbar,
                                     gboolean        activity_mode)
@@ -1122,14 +1214,16 @@ gtk_progress_bar_set_fraction (GtkProgressBar *pbar,
                                gdouble         fraction)
 {
   GtkProgressBarPrivate* priv;
+  gdouble old_fraction;
 
   g_return_if_fail (GTK_IS_PROGRESS_BAR (pbar));
 
   priv = pbar->priv;
 
+  old_fraction = priv->fraction;
   priv->fraction = CLAMP (fraction, 0.0, 1.0);
   gtk_progress_bar_set_activity_mode (pbar, FALSE);
-  gtk_widget_queue_draw (GTK_WIDGET (pbar));
+  gtk_progress_bar_queue_fraction_redraw (pbar, old_fraction);
 
   g_object_notify_by_pspec (G_OBJECT (pbar), progress_props[PROP_FRACTION]);
 }
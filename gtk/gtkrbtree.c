@@ -35,6 +35,8 @@ static inline void _fixup_validation              (GtkRBTree  *tree,
 						   GtkRBNode  *node);
 static inline void _fixup_total_count             (GtkRBTree  *tree,
 						   GtkRBNode  *node);
+static inline void _fixup_augment                 (GtkRBTree  *tree,
+						   GtkRBNode  *node);
 #ifdef G_ENABLE_DEBUG  
 static void        _gtk_rbtree_test               (const gchar *where,
                                                    GtkRBTree  *tree);
@@ -67,6 +69,8 @@ _gtk_rbnode_new (GtkRBTree *tree,
   node->count = 1;
   node->children = NULL;
   node->offset = height;
+  node->augment = 0;
+  node->augment_agg = 0;
   return node;
 }
 
@@ -132,6 +136,8 @@ _gtk_rbnode_rotate_left (GtkRBTree *tree,
   _fixup_validation (tree, right);
   _fixup_total_count (tree, node);
   _fixup_total_count (tree, right);
+  _fixup_augment (tree, node);
+  _fixup_augment (tree, right);
 }
 
 static void
@@ -182,6 +188,8 @@ _gtk_rbnode_rotate_right (GtkRBTree *tree,
   _fixup_validation (tree, left);
   _fixup_total_count (tree, node);
   _fixup_total_count (tree, left);
+  _fixup_augment (tree, node);
+  _fixup_augment (tree, left);
 }
 
 static void
@@ -332,6 +340,7 @@ _gtk_rbtree_new (void)
   retval = g_new (GtkRBTree, 1);
   retval->parent_tree = NULL;
   retval->parent_node = NULL;
+  retval->augment_func = NULL;
 
   retval->root = (GtkRBNode *) &nil;
 
@@ -374,6 +383,7 @@ gtk_rbnode_adjust (GtkRBTree *tree,
   while (tree && node && !_gtk_rbtree_is_nil (node))
     {
       _fixup_validation (tree, node);
+      _fixup_augment (tree, node);
       node->offset += offset_diff;
       node->count += count_diff;
       node->total_count += total_count_diff;
@@ -596,6 +606,47 @@ _gtk_rbtree_node_set_height (GtkRBTree *tree,
 #endif
 }
 
+static void
+augment_fixup_helper (GtkRBTree *tree,
+		      GtkRBNode *node,
+		      gpointer   data)
+{
+  _fixup_augment (tree, node);
+}
+
+void
+_gtk_rbtree_set_augment_func (GtkRBTree            *tree,
+			      GtkRBTreeAugmentFunc  func)
+{
+  tree->augment_func = func;
+
+  if (func && !_gtk_rbtree_is_nil (tree->root))
+    _gtk_rbtree_traverse (tree, tree->root, G_POST_ORDER,
+			  augment_fixup_helper, NULL);
+}
+
+void
+_gtk_rbtree_node_set_augment (GtkRBTree *tree,
+			      GtkRBNode *node,
+			      guint      augment)
+{
+  if (node->augment == augment)
+    return;
+
+  node->augment = augment;
+
+  while (tree && node && !_gtk_rbtree_is_nil (node))
+    {
+      _fixup_augment (tree, node);
+      node = node->parent;
+      if (_gtk_rbtree_is_nil (node))
+	{
+	  node = tree->parent_node;
+	  tree = tree->parent_tree;
+	}
+    }
+}
+
 void
 _gtk_rbtree_node_mark_invalid (GtkRBTree *tree,
 			       GtkRBNode *node)
@@ -752,7 +803,11 @@ _gtk_rbtree_set_fixed_height (GtkRBTree *tree,
 
   do
     {
-      if (GTK_RBNODE_FLAG_SET (node, GTK_RBNODE_INVALID))
+      /* When marking valid, rows that are only column-invalid must be
+       * picked up too; their geometry is just as fixed.
+       */
+      if (GTK_RBNODE_FLAG_SET (node, GTK_RBNODE_INVALID) ||
+	  (mark_valid && GTK_RBNODE_FLAG_SET (node, GTK_RBNODE_COLUMN_INVALID)))
         {
 	  _gtk_rbtree_node_set_height (tree, node, height);
 	  if (mark_valid)
@@ -783,6 +838,7 @@ reorder_fixup (GtkRBTree *tree,
   node->count = 1 + node->left->count + node->right->count;
   _fixup_validation (tree, node);
   _fixup_total_count (tree, node);
+  _fixup_augment (tree, node);
 }
 
 static void
@@ -1474,6 +1530,22 @@ void _fixup_total_count (GtkRBTree *tree,
     node->left->total_count + node->right->total_count;
 }
 
+static inline
+void _fixup_augment (GtkRBTree *tree,
+		     GtkRBNode *node)
+{
+  GtkRBTreeAugmentFunc func = tree->augment_func;
+
+  if (func == NULL)
+    return;
+
+  node->augment_agg =
+    func (func (node->left->augment_agg,
+		node->right->augment_agg),
+	  func (node->children != NULL ? node->children->root->augment_agg : 0,
+		node->augment));
+}
+
 #ifdef G_ENABLE_DEBUG
 static guint
 get_total_count (GtkRBNode *node)
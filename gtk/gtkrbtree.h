@@ -52,11 +52,19 @@ typedef void (*GtkRBTreeTraverseFunc) (GtkRBTree  *tree,
                                        GtkRBNode  *node,
                                        gpointer  data);
 
+/* Combines two subtree aggregates, or an aggregate and a node's own
+ * augment value, into one. Must be associative and commutative and
+ * treat 0 as the identity: MAX for maxima, addition for sums; store
+ * G_MAXUINT - value to aggregate a minimum.
+ */
+typedef guint (*GtkRBTreeAugmentFunc) (guint a, guint b);
+
 struct _GtkRBTree
 {
   GtkRBNode *root;
   GtkRBTree *parent_tree;
   GtkRBNode *parent_node;
+  GtkRBTreeAugmentFunc augment_func;
 };
 
 struct _GtkRBNode
@@ -85,6 +93,13 @@ struct _GtkRBNode
    */
   gint offset;
 
+  /* caller-defined per-row value; augment_agg is it aggregated with
+   * augment_func over node->left, node->right and ->children, so the
+   * aggregate of any range can be read off O(log n) nodes.
+   */
+  guint augment;
+  guint augment_agg;
+
   /* Child trees */
   GtkRBTree *children;
 };
@@ -102,6 +117,11 @@ GtkRBTree *_gtk_rbtree_new              (void);
 void       _gtk_rbtree_free             (GtkRBTree              *tree);
 void       _gtk_rbtree_remove           (GtkRBTree              *tree);
 void       _gtk_rbtree_destroy          (GtkRBTree              *tree);
+void       _gtk_rbtree_set_augment_func (GtkRBTree              *tree,
+					 GtkRBTreeAugmentFunc    func);
+void       _gtk_rbtree_node_set_augment (GtkRBTree              *tree,
+					 GtkRBNode              *node,
+					 guint                   augment);
 GtkRBNode *_gtk_rbtree_insert_before    (GtkRBTree              *tree,
 					 GtkRBNode              *node,
 					 gint                    height,
@@ -167,8 +167,11 @@ static void     set_recent_manager (GtkRecentChooserMenu *menu,
 
 static void     item_activate_cb   (GtkWidget        *widget,
 			            gpointer          user_data);
-static void     manager_changed_cb (GtkRecentManager *manager,
-				    gpointer          user_data);
+static void     manager_items_changed_cb (GtkRecentManager  *manager,
+				          gchar            **added,
+				          gchar            **removed,
+				          gchar            **updated,
+				          gpointer           user_data);
 
 static void gtk_recent_chooser_activatable_iface_init (GtkActivatableIface  *iface);
 static void gtk_recent_chooser_update                 (GtkActivatable       *activatable,
@@ -1122,12 +1125,145 @@ item_activate_cb (GtkWidget *widget,
   _gtk_recent_chooser_item_activated (chooser);
 }
 
-/* we force a redraw if the manager changes when we are showing */
+/* removes just the menu items whose URI is in @uris, and shows the
+ * placeholder again if none of our items is left
+ */
 static void
-manager_changed_cb (GtkRecentManager *manager,
-		    gpointer          user_data)
+gtk_recent_chooser_menu_remove_uris (GtkRecentChooserMenu  *menu,
+                                     gchar                **uris)
+{
+  GtkRecentChooserMenuPrivate *priv = menu->priv;
+  GList *children, *l;
+  gint n_left = 0;
+
+  children = gtk_container_get_children (GTK_CONTAINER (menu));
+  for (l = children; l != NULL; l = l->next)
+    {
+      GtkWidget *menu_item = GTK_WIDGET (l->data);
+      GtkRecentInfo *info;
+      gboolean has_mark;
+      gint i;
+
+      has_mark =
+        GPOINTER_TO_INT (g_object_get_data (G_OBJECT (menu_item), "gtk-recent-menu-mark"));
+      if (!has_mark)
+        continue;
+
+      info = g_object_get_data (G_OBJECT (menu_item), "gtk-recent-info");
+      if (info == NULL)
+        continue;
+
+      for (i = 0; uris[i] != NULL; i++)
+        {
+          if (strcmp (gtk_recent_info_get_uri (info), uris[i]) == 0)
+            break;
+        }
+
+      if (uris[i] != NULL)
+        {
+          g_object_set_data_full (G_OBJECT (menu_item), "gtk-recent-info",
+                                  NULL, NULL);
+          gtk_container_remove (GTK_CONTAINER (menu), menu_item);
+        }
+      else
+        n_left += 1;
+    }
+
+  g_list_free (children);
+
+  /* recalculate the position of the first recent item */
+  priv->first_recent_item_pos = -1;
+
+  if (n_left == 0)
+    gtk_widget_show (priv->placeholder);
+}
+
+/* if the only updated item is the one we already display first, we can
+ * refresh its meta-data in place instead of rebuilding the whole menu
+ */
+static gboolean
+gtk_recent_chooser_menu_refresh_first_item (GtkRecentChooserMenu  *menu,
+                                            gchar                **updated)
+{
+  GtkRecentChooserMenuPrivate *priv = menu->priv;
+  GtkWidget *menu_item = NULL;
+  GtkRecentInfo *info = NULL;
+  GtkRecentInfo *fresh_info;
+  GList *children, *l;
+
+  if (updated[0] == NULL || updated[1] != NULL)
+    return FALSE;
+
+  children = gtk_container_get_children (GTK_CONTAINER (menu));
+  for (l = children; l != NULL; l = l->next)
+    {
+      gboolean has_mark;
+
+      has_mark =
+        GPOINTER_TO_INT (g_object_get_data (G_OBJECT (l->data), "gtk-recent-menu-mark"));
+      if (has_mark)
+        {
+          menu_item = GTK_WIDGET (l->data);
+          info = g_object_get_data (G_OBJECT (menu_item), "gtk-recent-info");
+          break;
+        }
+    }
+  g_list_free (children);
+
+  if (info == NULL ||
+      strcmp (gtk_recent_info_get_uri (info), updated[0]) != 0)
+    return FALSE;
+
+  fresh_info = gtk_recent_manager_lookup_item (priv->manager, updated[0], NULL);
+  if (fresh_info != NULL)
+    {
+      g_object_set_data_full (G_OBJECT (menu_item), "gtk-recent-info",
+                              fresh_info,
+                              (GDestroyNotify) gtk_recent_info_unref);
+      gtk_recent_chooser_menu_add_tip (menu, fresh_info, menu_item);
+    }
+
+  return TRUE;
+}
+
+/* we update the menu from the difference reported by the manager when
+ * we are showing; additions change the numbering and the sort order,
+ * so they still go through a full (idle batched) populate run, but
+ * removals are applied in place and meta-data churn on the item we
+ * already show first - an application re-registering its current
+ * document - leaves the menu alone
+ */
+static void
+manager_items_changed_cb (GtkRecentManager  *manager,
+		          gchar            **added,
+		          gchar            **removed,
+		          gchar            **updated,
+		          gpointer           user_data)
 {
   GtkRecentChooserMenu *menu = GTK_RECENT_CHOOSER_MENU (user_data);
+  GtkRecentChooserMenuPrivate *priv = menu->priv;
+
+  if (added != NULL && added[0] == NULL)
+    added = NULL;
+  if (removed != NULL && removed[0] == NULL)
+    removed = NULL;
+  if (updated != NULL && updated[0] == NULL)
+    updated = NULL;
+
+  if (added == NULL && updated == NULL)
+    {
+      /* a repopulate already in flight will pick up the removals */
+      if (removed != NULL && priv->populate_id == 0)
+        gtk_recent_chooser_menu_remove_uris (menu, removed);
+
+      return;
+    }
+
+  if (added == NULL && removed == NULL &&
+      priv->populate_id == 0 &&
+      !priv->show_numbers &&
+      gtk_recent_chooser_menu_refresh_first_item (menu, updated))
+    return;
 
   gtk_recent_chooser_menu_populate (menu);
 }
@@ -1161,8 +1297,8 @@ set_recent_manager (GtkRecentChooserMenu *menu,
     priv->manager = gtk_recent_manager_get_default ();
   
   if (priv->manager)
-    priv->manager_changed_id = g_signal_connect (priv->manager, "changed",
-                                                 G_CALLBACK (manager_changed_cb),
+    priv->manager_changed_id = g_signal_connect (priv->manager, "items-changed",
+                                                 G_CALLBACK (manager_items_changed_cb),
                                                  menu);
 }
 
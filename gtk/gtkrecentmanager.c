@@ -110,6 +110,23 @@
 /* the file where we store the recently used items */
 #define GTK_RECENTLY_USED_FILE  "recently-used.xbel"
 
+/* a binary, mmap()able rendition of the bookmark file, kept alongside
+ * it, so that the XML only needs to be parsed when the cache is stale
+ */
+#define GTK_RECENTLY_USED_CACHE_SUFFIX  ".cache"
+
+#define RECENT_CACHE_FORMAT_VERSION 1
+
+/* uri, title, description, mime type, is-private,
+ * added, modified, visited,
+ * applications (name, exec, count, stamp), groups
+ */
+#define RECENT_CACHE_APP_TYPE   "(ssux)"
+#define RECENT_CACHE_ENTRY_TYPE "(ssssbxxxa" RECENT_CACHE_APP_TYPE "as)"
+
+/* version, bookmark file mtime, bookmark file size, entries */
+#define RECENT_CACHE_TYPE       "(uxta" RECENT_CACHE_ENTRY_TYPE ")"
+
 /* return all items by default */
 #define DEFAULT_LIMIT   -1
 
@@ -176,6 +193,12 @@ struct _GtkRecentManagerPrivate
 
   guint changed_timeout;
   guint changed_age;
+
+  /* snapshot of the items we last saw, used to compute the
+   * difference reported by the ::items-changed signal; maps
+   * the URI to its modification time
+   */
+  GHashTable *item_stamps;
 };
 
 enum
@@ -218,13 +241,19 @@ static void     build_recent_items_list                (GtkRecentManager  *manag
 static void     purge_recent_items_list                (GtkRecentManager  *manager,
                                                         GError           **error);
 
+static GBookmarkFile *recent_items_cache_load          (GtkRecentManager  *manager);
+static void           recent_items_cache_save          (GtkRecentManager  *manager);
+
 static RecentAppInfo *recent_app_info_new  (const gchar   *app_name);
 static void           recent_app_info_free (RecentAppInfo *app_info);
 
 static GtkRecentInfo *gtk_recent_info_new  (const gchar   *uri);
 static void           gtk_recent_info_free (GtkRecentInfo *recent_info);
 
+static void     gtk_recent_manager_emit_items_changed  (GtkRecentManager  *manager);
+
 static guint signal_changed = 0;
+static guint signal_items_changed = 0;
 
 static GtkRecentManager *recent_manager_singleton = NULL;
 
@@ -331,6 +360,33 @@ gtk_recent_manager_class_init (GtkRecentManagerClass *klass)
                   g_cclosure_marshal_VOID__VOID,
                   G_TYPE_NONE, 0);
 
+  /**
+   * GtkRecentManager::items-changed:
+   * @recent_manager: the recent manager
+   * @added: (array zero-terminated=1) (element-type utf8): the URIs of
+   *   the items that were added to the list
+   * @removed: (array zero-terminated=1) (element-type utf8): the URIs of
+   *   the items that were removed from the list
+   * @updated: (array zero-terminated=1) (element-type utf8): the URIs of
+   *   the items whose meta-data was modified
+   *
+   * Emitted along with #GtkRecentManager::changed, carrying the
+   * difference with respect to the previous contents of the list.
+   * Unlike #GtkRecentManager::changed, this signal is not emitted
+   * when the list is rewritten without any effective change, so it
+   * can be used to update a view of the list incrementally.
+   *
+   * Since: 3.18
+   */
+  signal_items_changed =
+    g_signal_new (I_("items-changed"),
+                  G_TYPE_FROM_CLASS (klass),
+                  G_SIGNAL_RUN_FIRST,
+                  0, NULL, NULL,
+                  _gtk_marshal_VOID__BOXED_BOXED_BOXED,
+                  G_TYPE_NONE, 3,
+                  G_TYPE_STRV, G_TYPE_STRV, G_TYPE_STRV);
+
   klass->changed = gtk_recent_manager_real_changed;
 }
 
@@ -401,6 +457,9 @@ gtk_recent_manager_finalize (GObject *object)
 
   g_free (priv->filename);
 
+  if (priv->item_stamps != NULL)
+    g_hash_table_destroy (priv->item_stamps);
+
   if (priv->recent_items != NULL)
     g_bookmark_file_free (priv->recent_items);
 
@@ -446,6 +505,93 @@ gtk_recent_manager_enabled_changed (GtkRecentManager *manager)
   gtk_recent_manager_changed (manager);
 }
 
+/* compares the current contents of the bookmark container with the
+ * snapshot taken the last time around, and emits ::items-changed
+ * carrying the difference; the first invocation just primes the
+ * snapshot without emitting anything.
+ */
+static void
+gtk_recent_manager_emit_items_changed (GtkRecentManager *manager)
+{
+  GtkRecentManagerPrivate *priv = manager->priv;
+  GHashTable *stamps;
+  GPtrArray *added, *removed, *updated;
+  GHashTableIter iter;
+  gpointer key;
+  gchar **uris = NULL;
+  gsize n_uris, i;
+  gboolean first_time;
+
+  first_time = priv->item_stamps == NULL;
+
+  stamps = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, g_free);
+
+  added = g_ptr_array_new_with_free_func (g_free);
+  removed = g_ptr_array_new_with_free_func (g_free);
+  updated = g_ptr_array_new_with_free_func (g_free);
+
+  if (priv->recent_items != NULL)
+    uris = g_bookmark_file_get_uris (priv->recent_items, &n_uris);
+
+  if (uris != NULL)
+    {
+      for (i = 0; i < n_uris; i++)
+        {
+          const gchar *uri = uris[i];
+          time_t modified, *old_stamp;
+
+          modified = g_bookmark_file_get_modified (priv->recent_items, uri, NULL);
+          g_hash_table_insert (stamps,
+                               g_strdup (uri),
+                               g_memdup (&modified, sizeof (time_t)));
+
+          old_stamp = first_time ? NULL : g_hash_table_lookup (priv->item_stamps, uri);
+          if (old_stamp == NULL)
+            {
+              if (!first_time)
+                g_ptr_array_add (added, g_strdup (uri));
+            }
+          else
+            {
+              if (*old_stamp != modified)
+                g_ptr_array_add (updated, g_strdup (uri));
+
+              g_hash_table_remove (priv->item_stamps, uri);
+            }
+        }
+
+      g_strfreev (uris);
+    }
+
+  if (!first_time)
+    {
+      /* whatever survived the pass above is gone from the list */
+      g_hash_table_iter_init (&iter, priv->item_stamps);
+      while (g_hash_table_iter_next (&iter, &key, NULL))
+        g_ptr_array_add (removed, g_strdup (key));
+
+      g_hash_table_destroy (priv->item_stamps);
+    }
+
+  priv->item_stamps = stamps;
+
+  if (added->len > 0 || removed->len > 0 || updated->len > 0)
+    {
+      g_ptr_array_add (added, NULL);
+      g_ptr_array_add (removed, NULL);
+      g_ptr_array_add (updated, NULL);
+
+      g_signal_emit (manager, signal_items_changed, 0,
+                     added->pdata,
+                     removed->pdata,
+                     updated->pdata);
+    }
+
+  g_ptr_array_unref (added);
+  g_ptr_array_unref (removed);
+  g_ptr_array_unref (updated);
+}
+
 static void
 gtk_recent_manager_real_changed (GtkRecentManager *manager)
 {
@@ -513,10 +659,14 @@ gtk_recent_manager_real_changed (GtkRecentManager *manager)
                                 priv->filename,
                                 g_strerror (errno));
             }
+
+          recent_items_cache_save (manager);
         }
 
       /* mark us as clean */
       priv->is_dirty = FALSE;
+
+      gtk_recent_manager_emit_items_changed (manager);
     }
   else
     {
@@ -647,6 +797,240 @@ gtk_recent_manager_set_filename (GtkRecentManager *manager,
   build_recent_items_list (manager);
 }
 
+static gboolean
+recent_items_cache_stat (const gchar *filename,
+                         gint64      *mtime,
+                         guint64     *size)
+{
+  GStatBuf stat_buf;
+
+  if (g_stat (filename, &stat_buf) < 0)
+    return FALSE;
+
+  *mtime = (gint64) stat_buf.st_mtime;
+  *size = (guint64) stat_buf.st_size;
+
+  return TRUE;
+}
+
+/* tries to rebuild the bookmark container from the binary cache kept
+ * alongside the storage file; the cache records the modification time
+ * and size of the storage file it was generated from, so a write from
+ * an application not maintaining the cache simply makes us fall back
+ * to parsing the XML. the cache is mapped rather than read, and the
+ * serialized GVariant data is only validated as it is traversed.
+ */
+static GBookmarkFile *
+recent_items_cache_load (GtkRecentManager *manager)
+{
+  GtkRecentManagerPrivate *priv = manager->priv;
+  GBookmarkFile *bookmarks;
+  GMappedFile *mapped;
+  GVariant *variant;
+  GVariantIter *entries, *apps, *groups;
+  gchar *cache_filename;
+  guint version;
+  gint64 cache_mtime, mtime;
+  guint64 cache_size, size;
+  const gchar *uri, *title, *description, *mime_type;
+  gboolean is_private;
+  gint64 added, modified, visited;
+
+  if (!recent_items_cache_stat (priv->filename, &mtime, &size))
+    return NULL;
+
+  cache_filename = g_strconcat (priv->filename, GTK_RECENTLY_USED_CACHE_SUFFIX, NULL);
+  mapped = g_mapped_file_new (cache_filename, FALSE, NULL);
+  g_free (cache_filename);
+
+  if (mapped == NULL)
+    return NULL;
+
+  variant = g_variant_new_from_data (G_VARIANT_TYPE (RECENT_CACHE_TYPE),
+                                     g_mapped_file_get_contents (mapped),
+                                     g_mapped_file_get_length (mapped),
+                                     FALSE,
+                                     (GDestroyNotify) g_mapped_file_unref,
+                                     mapped);
+  g_variant_ref_sink (variant);
+
+  g_variant_get_child (variant, 0, "u", &version);
+  g_variant_get_child (variant, 1, "x", &cache_mtime);
+  g_variant_get_child (variant, 2, "t", &cache_size);
+
+  if (version != RECENT_CACHE_FORMAT_VERSION ||
+      cache_mtime != mtime ||
+      cache_size != size)
+    {
+      g_variant_unref (variant);
+      return NULL;
+    }
+
+  bookmarks = g_bookmark_file_new ();
+
+  g_variant_get_child (variant, 3, "a" RECENT_CACHE_ENTRY_TYPE, &entries);
+  while (g_variant_iter_loop (entries, "(&s&s&s&sbxxxa" RECENT_CACHE_APP_TYPE "as)",
+                              &uri, &title, &description, &mime_type, &is_private,
+                              &added, &modified, &visited,
+                              &apps, &groups))
+    {
+      const gchar *app_name, *app_exec, *group;
+      guint count;
+      gint64 stamp;
+
+      g_bookmark_file_set_mime_type (bookmarks, uri, mime_type);
+
+      if (*title != '\0')
+        g_bookmark_file_set_title (bookmarks, uri, title);
+
+      if (*description != '\0')
+        g_bookmark_file_set_description (bookmarks, uri, description);
+
+      g_bookmark_file_set_is_private (bookmarks, uri, is_private);
+
+      while (g_variant_iter_loop (groups, "&s", &group))
+        g_bookmark_file_add_group (bookmarks, uri, group);
+
+      while (g_variant_iter_loop (apps, "(&s&sux)", &app_name, &app_exec, &count, &stamp))
+        {
+          g_bookmark_file_add_application (bookmarks, uri, app_name, app_exec);
+
+          if (count > 0)
+            g_bookmark_file_set_app_info (bookmarks, uri, app_name,
+                                          app_exec, count, (time_t) stamp,
+                                          NULL);
+        }
+
+      /* set the timestamps last, as registering applications and
+       * groups bumps the modification and visited times
+       */
+      g_bookmark_file_set_added (bookmarks, uri, (time_t) added);
+      g_bookmark_file_set_modified (bookmarks, uri, (time_t) modified);
+      g_bookmark_file_set_visited (bookmarks, uri, (time_t) visited);
+    }
+
+  g_variant_iter_free (entries);
+  g_variant_unref (variant);
+
+  return bookmarks;
+}
+
+/* regenerates the binary cache from the bookmark container after the
+ * storage file has been written; every reader notified by the file
+ * monitor will then pick up the change without reparsing the XML.
+ */
+static void
+recent_items_cache_save (GtkRecentManager *manager)
+{
+  GtkRecentManagerPrivate *priv = manager->priv;
+  GVariantBuilder builder;
+  GVariant *variant;
+  gchar *cache_filename;
+  gchar **uris;
+  gsize n_uris, i;
+  gint64 mtime;
+  guint64 size;
+  GError *write_error = NULL;
+
+  cache_filename = g_strconcat (priv->filename, GTK_RECENTLY_USED_CACHE_SUFFIX, NULL);
+
+  if (!recent_items_cache_stat (priv->filename, &mtime, &size))
+    {
+      g_unlink (cache_filename);
+      g_free (cache_filename);
+      return;
+    }
+
+  g_variant_builder_init (&builder, G_VARIANT_TYPE ("a" RECENT_CACHE_ENTRY_TYPE));
+
+  uris = g_bookmark_file_get_uris (priv->recent_items, &n_uris);
+  for (i = 0; i < n_uris; i++)
+    {
+      const gchar *uri = uris[i];
+      GVariantBuilder apps_builder, groups_builder;
+      gchar *title, *description, *mime_type;
+      gchar **apps, **groups;
+      gsize apps_len, groups_len, j;
+
+      title = g_bookmark_file_get_title (priv->recent_items, uri, NULL);
+      description = g_bookmark_file_get_description (priv->recent_items, uri, NULL);
+      mime_type = g_bookmark_file_get_mime_type (priv->recent_items, uri, NULL);
+
+      g_variant_builder_init (&apps_builder, G_VARIANT_TYPE ("a" RECENT_CACHE_APP_TYPE));
+      apps = g_bookmark_file_get_applications (priv->recent_items, uri, &apps_len, NULL);
+      for (j = 0; j < apps_len; j++)
+        {
+          gchar *app_exec;
+          guint count;
+          time_t stamp;
+
+          if (!g_bookmark_file_get_app_info (priv->recent_items, uri, apps[j],
+                                             &app_exec, &count, &stamp,
+                                             NULL))
+            continue;
+
+          g_variant_builder_add (&apps_builder, RECENT_CACHE_APP_TYPE,
+                                 apps[j], app_exec, count, (gint64) stamp);
+          g_free (app_exec);
+        }
+      g_strfreev (apps);
+
+      g_variant_builder_init (&groups_builder, G_VARIANT_TYPE ("as"));
+      groups = g_bookmark_file_get_groups (priv->recent_items, uri, &groups_len, NULL);
+      for (j = 0; j < groups_len; j++)
+        g_variant_builder_add (&groups_builder, "s", groups[j]);
+      g_strfreev (groups);
+
+      g_variant_builder_add (&builder, RECENT_CACHE_ENTRY_TYPE,
+                             uri,
+                             title != NULL ? title : "",
+                             description != NULL ? description : "",
+                             mime_type != NULL ? mime_type : "",
+                             g_bookmark_file_get_is_private (priv->recent_items, uri, NULL),
+                             (gint64) g_bookmark_file_get_added (priv->recent_items, uri, NULL),
+                             (gint64) g_bookmark_file_get_modified (priv->recent_items, uri, NULL),
+                             (gint64) g_bookmark_file_get_visited (priv->recent_items, uri, NULL),
+                             &apps_builder,
+                             &groups_builder);
+
+      g_free (title);
+      g_free (description);
+      g_free (mime_type);
+    }
+  g_strfreev (uris);
+
+  variant = g_variant_new ("(uxt@a" RECENT_CACHE_ENTRY_TYPE ")",
+                           RECENT_CACHE_FORMAT_VERSION,
+                           mtime,
+                           size,
+                           g_variant_builder_end (&builder));
+  g_variant_ref_sink (variant);
+
+  if (!g_file_set_contents (cache_filename,
+                            g_variant_get_data (variant),
+                            g_variant_get_size (variant),
+                            &write_error))
+    {
+      filename_warning ("Attempting to store the recently used resources "
+                        "cache at `%s', but failed: %s",
+                        cache_filename,
+                        write_error->message);
+      g_error_free (write_error);
+
+      /* never leave a stale cache behind */
+      g_unlink (cache_filename);
+    }
+  else if (g_chmod (cache_filename, 0600) < 0)
+    {
+      filename_warning ("Attempting to set the permissions of `%s', but failed: %s",
+                        cache_filename,
+                        g_strerror (errno));
+    }
+
+  g_variant_unref (variant);
+  g_free (cache_filename);
+}
+
 /* reads the recently used resources file and builds the items list.
  * we keep the items list inside the parser object, and build the
  * RecentInfo object only on user’s demand to avoid useless replication.
@@ -667,6 +1051,28 @@ build_recent_items_list (GtkRecentManager *manager)
 
   if (priv->filename != NULL)
     {
+      GBookmarkFile *cached;
+
+      /* a fresh binary cache spares us the XML parse entirely */
+      cached = recent_items_cache_load (manager);
+      if (cached != NULL)
+        {
+          g_bookmark_file_free (priv->recent_items);
+          priv->recent_items = cached;
+
+          size = g_bookmark_file_get_size (priv->recent_items);
+          if (priv->size != size)
+            {
+              priv->size = size;
+
+              g_object_notify (G_OBJECT (manager), "size");
+            }
+
+          priv->is_dirty = FALSE;
+          gtk_recent_manager_emit_items_changed (manager);
+          return;
+        }
+
       /* the file exists, and it's valid (we hope); if not, destroy the container
        * object and hope for a better result when the next "changed" signal is
        * fired.
@@ -705,6 +1111,8 @@ build_recent_items_list (GtkRecentManager *manager)
     }
 
   priv->is_dirty = FALSE;
+
+  gtk_recent_manager_emit_items_changed (manager);
 }
 
 
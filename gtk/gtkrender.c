@@ -485,14 +485,16 @@ gtk_do_render_layout (GtkStyleContext *context,
                       PangoLayout     *layout)
 {
   const GdkRGBA *fg_color;
+  GtkCssValue *shadows;
 
   cairo_save (cr);
   fg_color = _gtk_css_rgba_value_get_rgba (_gtk_style_context_peek_property (context, GTK_CSS_PROPERTY_COLOR));
 
   prepare_context_for_layout (cr, x, y, layout);
 
-  _gtk_css_shadows_value_paint_layout (_gtk_style_context_peek_property (context, GTK_CSS_PROPERTY_TEXT_SHADOW),
-                                       cr, layout);
+  shadows = _gtk_style_context_peek_property (context, GTK_CSS_PROPERTY_TEXT_SHADOW);
+  if (!_gtk_css_shadows_value_is_none (shadows))
+    _gtk_css_shadows_value_paint_layout (shadows, cr, layout);
 
   gdk_cairo_set_source_rgba (cr, fg_color);
   pango_cairo_show_layout (cr, layout);
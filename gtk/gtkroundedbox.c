@@ -257,33 +257,35 @@ _cairo_ellipsis_negative (cairo_t *cr,
   cairo_set_matrix (cr, &save);
 }
 
-void
-_gtk_rounded_box_path (const GtkRoundedBox *box,
-                       cairo_t             *cr)
+static void
+gtk_rounded_box_path_at (const GtkRoundedBox *box,
+                         cairo_t             *cr,
+                         double               x,
+                         double               y)
 {
   cairo_new_sub_path (cr);
 
   _cairo_ellipsis (cr,
-                   box->box.x + box->corner[GTK_CSS_TOP_LEFT].horizontal,
-                   box->box.y + box->corner[GTK_CSS_TOP_LEFT].vertical,
+                   x + box->corner[GTK_CSS_TOP_LEFT].horizontal,
+                   y + box->corner[GTK_CSS_TOP_LEFT].vertical,
                    box->corner[GTK_CSS_TOP_LEFT].horizontal,
                    box->corner[GTK_CSS_TOP_LEFT].vertical,
                    G_PI, 3 * G_PI_2);
   _cairo_ellipsis (cr, 
-                   box->box.x + box->box.width - box->corner[GTK_CSS_TOP_RIGHT].horizontal,
-                   box->box.y + box->corner[GTK_CSS_TOP_RIGHT].vertical,
+                   x + box->box.width - box->corner[GTK_CSS_TOP_RIGHT].horizontal,
+                   y + box->corner[GTK_CSS_TOP_RIGHT].vertical,
                    box->corner[GTK_CSS_TOP_RIGHT].horizontal,
                    box->corner[GTK_CSS_TOP_RIGHT].vertical,
                    - G_PI_2, 0);
   _cairo_ellipsis (cr,
-                   box->box.x + box->box.width - box->corner[GTK_CSS_BOTTOM_RIGHT].horizontal,
-                   box->box.y + box->box.height - box->corner[GTK_CSS_BOTTOM_RIGHT].vertical,
+                   x + box->box.width - box->corner[GTK_CSS_BOTTOM_RIGHT].horizontal,
+                   y + box->box.height - box->corner[GTK_CSS_BOTTOM_RIGHT].vertical,
                    box->corner[GTK_CSS_BOTTOM_RIGHT].horizontal,
                    box->corner[GTK_CSS_BOTTOM_RIGHT].vertical,
                    0, G_PI_2);
   _cairo_ellipsis (cr,
-                   box->box.x + box->corner[GTK_CSS_BOTTOM_LEFT].horizontal,
-                   box->box.y + box->box.height - box->corner[GTK_CSS_BOTTOM_LEFT].vertical,
+                   x + box->corner[GTK_CSS_BOTTOM_LEFT].horizontal,
+                   y + box->box.height - box->corner[GTK_CSS_BOTTOM_LEFT].vertical,
                    box->corner[GTK_CSS_BOTTOM_LEFT].horizontal,
                    box->corner[GTK_CSS_BOTTOM_LEFT].vertical,
                    G_PI_2, G_PI);
@@ -291,6 +293,108 @@ _gtk_rounded_box_path (const GtkRoundedBox *box,
   cairo_close_path (cr);
 }
 
+/* With a uniform corner style, every card and button on screen builds
+ * the same rounded-rect path on each draw, differing only in position.
+ * Cache recently built paths keyed by size and corner radii, recorded
+ * at the origin, and append them under a translation instead of
+ * redoing the arc construction.
+ */
+#define PATH_CACHE_SIZE 16
+
+typedef struct {
+  double              width;
+  double              height;
+  GtkRoundedBoxCorner corner[4];
+} PathCacheKey;
+
+typedef struct {
+  PathCacheKey  key;
+  cairo_path_t *path;
+} PathCacheEntry;
+
+static PathCacheEntry path_cache[PATH_CACHE_SIZE];
+static guint path_cache_next;
+
+static cairo_t *
+get_path_cache_cr (void)
+{
+  static cairo_t *path_cr = NULL;
+
+  if (path_cr == NULL)
+    {
+      cairo_surface_t *dummy;
+
+      dummy = cairo_image_surface_create (CAIRO_FORMAT_A8, 1, 1);
+      path_cr = cairo_create (dummy);
+      cairo_surface_destroy (dummy);
+    }
+
+  cairo_new_path (path_cr);
+
+  return path_cr;
+}
+
+static cairo_path_t *
+gtk_rounded_box_lookup_path (const GtkRoundedBox *box)
+{
+  PathCacheKey key = { 0, };
+  PathCacheEntry *entry;
+  cairo_path_t *path;
+  cairo_t *path_cr;
+  guint i;
+
+  key.width = box->box.width;
+  key.height = box->box.height;
+  for (i = 0; i < 4; i++)
+    key.corner[i] = box->corner[i];
+
+  for (i = 0; i < PATH_CACHE_SIZE; i++)
+    {
+      if (path_cache[i].path != NULL &&
+          memcmp (&path_cache[i].key, &key, sizeof (PathCacheKey)) == 0)
+        return path_cache[i].path;
+    }
+
+  path_cr = get_path_cache_cr ();
+  gtk_rounded_box_path_at (box, path_cr, 0, 0);
+  path = cairo_copy_path (path_cr);
+
+  if (path->status != CAIRO_STATUS_SUCCESS)
+    {
+      cairo_path_destroy (path);
+      return NULL;
+    }
+
+  entry = &path_cache[path_cache_next];
+  path_cache_next = (path_cache_next + 1) % PATH_CACHE_SIZE;
+
+  if (entry->path)
+    cairo_path_destroy (entry->path);
+  entry->key = key;
+  entry->path = path;
+
+  return path;
+}
+
+void
+_gtk_rounded_box_path (const GtkRoundedBox *box,
+                       cairo_t             *cr)
+{
+  cairo_path_t *path;
+
+  path = gtk_rounded_box_lookup_path (box);
+  if (path == NULL)
+    {
+      gtk_rounded_box_path_at (box, cr, box->box.x, box->box.y);
+      return;
+    }
+
+  cairo_save (cr);
+  cairo_translate (cr, box->box.x, box->box.y);
+  cairo_append_path (cr, path);
+  cairo_restore (cr);
+}
+
 double
 _gtk_rounded_box_guess_length (const GtkRoundedBox *box,
                                GtkCssSide           side)
@@ -42,6 +42,7 @@
 #include "gtkwidgetprivate.h"
 #include "gtkwindow.h"
 #include "gtkkineticscrolling.h"
+#include "gtkscrolledwindowprivate.h"
 #include "a11y/gtkscrolledwindowaccessible.h"
 
 #include <math.h>
@@ -148,6 +149,10 @@
 /* Kinetic scrolling */
 #define MAX_OVERSHOOT_DISTANCE 100
 #define DECELERATION_FRICTION 4
+
+/* How far ahead of a fling we try to have content rendered, in
+   seconds of travel at the current kinetic velocity */
+#define PRERENDER_LOOKAHEAD_TIME 0.2
 #define OVERSHOOT_FRICTION 20
 #define SCROLL_CAPTURE_THRESHOLD_MS 150
 
@@ -236,6 +241,12 @@ struct _GtkScrolledWindowPrivate
   gdouble                x_velocity;
   gdouble                y_velocity;
 
+  /* Current kinetic velocities while decelerating, for prerendering */
+  gdouble                deceleration_x_velocity;
+  gdouble                deceleration_y_velocity;
+
+  guint                  prerender_margin;
+
   gdouble                unclamped_hadj_value;
   gdouble                unclamped_vadj_value;
 };
@@ -261,7 +272,8 @@ enum {
   PROP_MIN_CONTENT_WIDTH,
   PROP_MIN_CONTENT_HEIGHT,
   PROP_KINETIC_SCROLLING,
-  PROP_OVERLAY_SCROLLING
+  PROP_OVERLAY_SCROLLING,
+  PROP_PRERENDER_MARGIN
 };
 
 /* Signals */
@@ -610,6 +622,26 @@ gtk_scrolled_window_class_init (GtkScrolledWindowClass *class)
                                                          TRUE,
                                                          GTK_PARAM_READWRITE|G_PARAM_EXPLICIT_NOTIFY));
 
+  /**
+   * GtkScrolledWindow:prerender-margin:
+   *
+   * How many extra pixels of content the child may render ahead of a
+   * kinetic scroll. The margin actually used grows with the current
+   * fling velocity in the direction of travel, up to this value, so
+   * fast flings stop exposing unrendered content without paying for
+   * the extra rendering while the view is at rest. A value of 0
+   * disables prerendering beyond the child's own defaults.
+   *
+   * Since: 3.18
+   */
+  g_object_class_install_property (gobject_class,
+                                   PROP_PRERENDER_MARGIN,
+                                   g_param_spec_uint ("prerender-margin",
+                                                      P_("Prerender Margin"),
+                                                      P_("Extra pixels rendered ahead of a kinetic scroll"),
+                                                      0, G_MAXUINT, 0,
+                                                      GTK_PARAM_READWRITE|G_PARAM_EXPLICIT_NOTIFY));
+
   /**
    * GtkScrolledWindow::scroll-child:
    * @scrolled_window: a #GtkScrolledWindow
@@ -2023,6 +2055,10 @@ gtk_scrolled_window_set_property (GObject      *object,
       gtk_scrolled_window_set_overlay_scrolling (scrolled_window,
                                                  g_value_get_boolean (value));
       break;
+    case PROP_PRERENDER_MARGIN:
+      gtk_scrolled_window_set_prerender_margin (scrolled_window,
+                                                g_value_get_uint (value));
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -2075,6 +2111,9 @@ gtk_scrolled_window_get_property (GObject    *object,
     case PROP_OVERLAY_SCROLLING:
       g_value_set_boolean (value, priv->overlay_scrolling);
       break;
+    case PROP_PRERENDER_MARGIN:
+      g_value_set_uint (value, priv->prerender_margin);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -3304,6 +3343,11 @@ scrolled_window_deceleration_cb (GtkWidget         *widget,
   else if (data->vscrolling)
     g_clear_pointer (&data->vscrolling, (GDestroyNotify) gtk_kinetic_scrolling_free);
 
+  priv->deceleration_x_velocity = data->hscrolling ?
+    gtk_kinetic_scrolling_get_velocity (data->hscrolling) : 0;
+  priv->deceleration_y_velocity = data->vscrolling ?
+    gtk_kinetic_scrolling_get_velocity (data->vscrolling) : 0;
+
   if (!data->hscrolling && !data->vscrolling)
     {
       gtk_scrolled_window_cancel_deceleration (scrolled_window);
@@ -3326,6 +3370,9 @@ gtk_scrolled_window_cancel_deceleration (GtkScrolledWindow *scrolled_window)
                                        priv->deceleration_id);
       priv->deceleration_id = 0;
     }
+
+  priv->deceleration_x_velocity = 0;
+  priv->deceleration_y_velocity = 0;
 }
 
 static void
@@ -4472,3 +4519,81 @@ gtk_scrolled_window_get_overlay_scrolling (GtkScrolledWindow *scrolled_window)
 
   return scrolled_window->priv->overlay_scrolling;
 }
+
+/**
+ * gtk_scrolled_window_set_prerender_margin:
+ * @scrolled_window: a #GtkScrolledWindow
+ * @prerender_margin: maximum extra pixels to render ahead of a fling
+ *
+ * Sets the maximum number of extra pixels of content the child may
+ * render ahead of a kinetic scroll; see
+ * #GtkScrolledWindow:prerender-margin.
+ *
+ * Since: 3.18
+ */
+void
+gtk_scrolled_window_set_prerender_margin (GtkScrolledWindow *scrolled_window,
+                                          guint              prerender_margin)
+{
+  GtkScrolledWindowPrivate *priv;
+
+  g_return_if_fail (GTK_IS_SCROLLED_WINDOW (scrolled_window));
+
+  priv = scrolled_window->priv;
+
+  if (priv->prerender_margin != prerender_margin)
+    {
+      priv->prerender_margin = prerender_margin;
+
+      g_object_notify (G_OBJECT (scrolled_window), "prerender-margin");
+    }
+}
+
+/**
+ * gtk_scrolled_window_get_prerender_margin:
+ * @scrolled_window: a #GtkScrolledWindow
+ *
+ * Returns the maximum pre-render margin; see
+ * gtk_scrolled_window_set_prerender_margin().
+ *
+ * Returns: the maximum pre-render margin, in pixels
+ *
+ * Since: 3.18
+ */
+guint
+gtk_scrolled_window_get_prerender_margin (GtkScrolledWindow *scrolled_window)
+{
+  g_return_val_if_fail (GTK_IS_SCROLLED_WINDOW (scrolled_window), 0);
+
+  return scrolled_window->priv->prerender_margin;
+}
+
+/*
+ * _gtk_scrolled_window_get_prerender_extra:
+ * @scrolled_window: a #GtkScrolledWindow
+ * @extra_width: (out): extra cache width, 0 for the child's default
+ * @extra_height: (out): extra cache height, 0 for the child's default
+ *
+ * Returns the cache margin the child should use right now: the
+ * distance a fling travels in %PRERENDER_LOOKAHEAD_TIME at the
+ * current kinetic velocity, capped at the prerender-margin property.
+ * While the view is at rest both values are 0.
+ */
+void
+_gtk_scrolled_window_get_prerender_extra (GtkScrolledWindow *scrolled_window,
+                                          guint             *extra_width,
+                                          guint             *extra_height)
+{
+  GtkScrolledWindowPrivate *priv = scrolled_window->priv;
+
+  *extra_width = 0;
+  *extra_height = 0;
+
+  if (priv->prerender_margin == 0)
+    return;
+
+  *extra_width = MIN (fabs (priv->deceleration_x_velocity) * PRERENDER_LOOKAHEAD_TIME,
+                      priv->prerender_margin);
+  *extra_height = MIN (fabs (priv->deceleration_y_velocity) * PRERENDER_LOOKAHEAD_TIME,
+                       priv->prerender_margin);
+}
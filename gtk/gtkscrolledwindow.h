@@ -214,6 +214,12 @@ void           gtk_scrolled_window_set_overlay_scrolling  (GtkScrolledWindow *sc
 GDK_AVAILABLE_IN_3_16
 gboolean       gtk_scrolled_window_get_overlay_scrolling (GtkScrolledWindow   *scrolled_window);
 
+GDK_AVAILABLE_IN_3_18
+void           gtk_scrolled_window_set_prerender_margin (GtkScrolledWindow *scrolled_window,
+                                                         guint              prerender_margin);
+GDK_AVAILABLE_IN_3_18
+guint          gtk_scrolled_window_get_prerender_margin (GtkScrolledWindow *scrolled_window);
+
 
 G_END_DECLS
 
@@ -0,0 +1,31 @@
+/* GTK - The GIMP Toolkit
+ * Copyright (C) 2015 Red Hat, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __GTK_SCROLLED_WINDOW_PRIVATE_H__
+#define __GTK_SCROLLED_WINDOW_PRIVATE_H__
+
+#include "gtkscrolledwindow.h"
+
+G_BEGIN_DECLS
+
+void _gtk_scrolled_window_get_prerender_extra (GtkScrolledWindow *scrolled_window,
+                                               guint             *extra_width,
+                                               guint             *extra_height);
+
+G_END_DECLS
+
+#endif /* __GTK_SCROLLED_WINDOW_PRIVATE_H__ */
@@ -33,13 +33,32 @@
 
 #define BATCH_SIZE 500
 
+/* Workers pull directories from a shared queue, so deep subtrees get
+ * spread across however many threads are idle.
+ */
+#define MAX_SEARCH_THREADS 8
+
+/* The search stops early once this many hits were delivered; no view
+ * can usefully present more, and it bounds searches over huge trees.
+ */
+#define MAX_SEARCH_HITS 10000
+
 typedef struct
 {
   GtkSearchEngineSimple *engine;
   GCancellable *cancellable;
 
+  GMutex lock;
+  GCond cond;
+
+  /* All following fields are protected by the lock */
   GQueue *directories;
 
+  gint n_workers;
+  gint n_busy;
+  gint n_hits;
+  gboolean limit_reached;
+
   gint n_processed_files;
   GList *hits;
 
@@ -94,7 +113,12 @@ queue_if_local (SearchThreadData *data,
 {
   if (!_gtk_file_consider_as_remote (file) &&
       !g_file_has_uri_scheme (file, "recent"))
-    g_queue_push_tail (data->directories, g_object_ref (file));
+    {
+      g_mutex_lock (&data->lock);
+      g_queue_push_tail (data->directories, g_object_ref (file));
+      g_cond_signal (&data->cond);
+      g_mutex_unlock (&data->lock);
+    }
 }
 
 static SearchThreadData *
@@ -106,6 +130,8 @@ search_thread_data_new (GtkSearchEngineSimple *engine,
   data = g_new0 (SearchThreadData, 1);
 
   data->engine = g_object_ref (engine);
+  g_mutex_init (&data->lock);
+  g_cond_init (&data->cond);
   data->directories = g_queue_new ();
   data->query = g_object_ref (query);
   data->recursive = _gtk_search_engine_get_recursive (GTK_SEARCH_ENGINE (engine));
@@ -121,6 +147,8 @@ search_thread_data_free (SearchThreadData *data)
 {
   g_queue_foreach (data->directories, (GFunc)g_object_unref, NULL);
   g_queue_free (data->directories);
+  g_mutex_clear (&data->lock);
+  g_cond_clear (&data->cond);
   g_object_unref (data->cancellable);
   g_object_unref (data->query);
   g_object_unref (data->engine);
@@ -164,6 +192,7 @@ search_thread_add_hits_idle (gpointer user_data)
   return FALSE;
 }
 
+/* Called with the lock held */
 static void
 send_batch (SearchThreadData *data)
 {
@@ -205,6 +234,32 @@ is_indexed (GtkSearchEngineSimple *engine,
   return FALSE;
 }
 
+static void
+search_thread_merge_results (SearchThreadData *data,
+                             GList           **local_hits,
+                             gint             *local_n_hits,
+                             gint             *local_n_processed)
+{
+  g_mutex_lock (&data->lock);
+
+  if (*local_hits)
+    data->hits = g_list_concat (*local_hits, data->hits);
+  data->n_hits += *local_n_hits;
+  data->n_processed_files += *local_n_processed;
+
+  if (!data->limit_reached && data->n_hits >= MAX_SEARCH_HITS)
+    data->limit_reached = TRUE;
+
+  if (data->n_processed_files > BATCH_SIZE || data->limit_reached)
+    send_batch (data);
+
+  g_mutex_unlock (&data->lock);
+
+  *local_hits = NULL;
+  *local_n_hits = 0;
+  *local_n_processed = 0;
+}
+
 static void
 visit_directory (GFile *dir, SearchThreadData *data)
 {
@@ -212,6 +267,9 @@ visit_directory (GFile *dir, SearchThreadData *data)
   GFileInfo *info;
   GFile *child;
   const gchar *display_name;
+  GList *hits = NULL;
+  gint n_hits = 0;
+  gint n_processed = 0;
 
   enumerator = g_file_enumerate_children (dir,
                                           G_FILE_ATTRIBUTE_STANDARD_NAME ","
@@ -237,6 +295,10 @@ visit_directory (GFile *dir, SearchThreadData *data)
       if (info == NULL)
         break;
 
+      /* Unlocked read; the merge below is the authoritative check */
+      if (data->limit_reached)
+        break;
+
       display_name = g_file_info_get_display_name (info);
       if (display_name == NULL)
         continue;
@@ -251,12 +313,13 @@ visit_directory (GFile *dir, SearchThreadData *data)
           hit = g_new (GtkSearchHit, 1);
           hit->file = g_object_ref (child);
           hit->info = g_object_ref (info);
-          data->hits = g_list_prepend (data->hits, hit);
+          hits = g_list_prepend (hits, hit);
+          n_hits++;
         }
 
-      data->n_processed_files++;
-      if (data->n_processed_files > BATCH_SIZE)
-        send_batch (data);
+      n_processed++;
+      if (n_processed > BATCH_SIZE)
+        search_thread_merge_results (data, &hits, &n_hits, &n_processed);
 
       if (data->recursive &&
           g_file_info_get_file_type (info) == G_FILE_TYPE_DIRECTORY &&
@@ -264,6 +327,8 @@ visit_directory (GFile *dir, SearchThreadData *data)
         queue_if_local (data, child);
     }
 
+  search_thread_merge_results (data, &hits, &n_hits, &n_processed);
+
   g_object_unref (enumerator);
 }
 
@@ -272,22 +337,57 @@ search_thread_func (gpointer user_data)
 {
   SearchThreadData *data;
   GFile *dir;
+  gboolean last;
   guint id;
 
   data = user_data;
 
+  g_mutex_lock (&data->lock);
+
   while (!g_cancellable_is_cancelled (data->cancellable) &&
-         (dir = g_queue_pop_head (data->directories)) != NULL)
+         !data->limit_reached)
     {
-      visit_directory (dir, data);
-      g_object_unref (dir);
+      dir = g_queue_pop_head (data->directories);
+
+      if (dir != NULL)
+        {
+          data->n_busy++;
+          g_mutex_unlock (&data->lock);
+
+          visit_directory (dir, data);
+          g_object_unref (dir);
+
+          g_mutex_lock (&data->lock);
+          data->n_busy--;
+
+          /* Wake idle workers so they can notice the search is over */
+          if (data->n_busy == 0 && g_queue_is_empty (data->directories))
+            g_cond_broadcast (&data->cond);
+        }
+      else
+        {
+          if (data->n_busy == 0)
+            break;
+
+          /* Other workers may still queue subdirectories */
+          g_cond_wait (&data->cond, &data->lock);
+        }
     }
 
-  if (!g_cancellable_is_cancelled (data->cancellable))
+  data->n_workers--;
+  last = data->n_workers == 0;
+  g_cond_broadcast (&data->cond);
+
+  if (last && !g_cancellable_is_cancelled (data->cancellable))
     send_batch (data);
 
-  id = gdk_threads_add_idle (search_thread_done_idle, data);
-  g_source_set_name_by_id (id, "[gtk+] search_thread_done_idle");
+  g_mutex_unlock (&data->lock);
+
+  if (last)
+    {
+      id = gdk_threads_add_idle (search_thread_done_idle, data);
+      g_source_set_name_by_id (id, "[gtk+] search_thread_done_idle");
+    }
 
   return NULL;
 }
@@ -297,6 +397,7 @@ gtk_search_engine_simple_start (GtkSearchEngine *engine)
 {
   GtkSearchEngineSimple *simple;
   SearchThreadData *data;
+  gint i;
 
   simple = GTK_SEARCH_ENGINE_SIMPLE (engine);
 
@@ -308,7 +409,9 @@ gtk_search_engine_simple_start (GtkSearchEngine *engine)
 
   data = search_thread_data_new (simple, simple->query);
 
-  g_thread_unref (g_thread_new ("file-search", search_thread_func, data));
+  data->n_workers = CLAMP (g_get_num_processors (), 1, MAX_SEARCH_THREADS);
+  for (i = 0; i < data->n_workers; i++)
+    g_thread_unref (g_thread_new ("file-search", search_thread_func, data));
 
   simple->active_search = data;
 }
@@ -104,12 +104,14 @@
 
 #undef DEBUG_SELECTION
 
-/* Maximum size of a sent chunk, in bytes. Also the default size of
+/* Maximum size of a sent chunk, in bytes, bounded by the maximum
+   request size of the display. Bigger chunks mean fewer round trips
+   for large INCR transfers. Also the default size of
    our buffers */
 #ifdef GDK_WINDOWING_X11
 #define GTK_SELECTION_MAX_SIZE(display)                                 \
   GDK_IS_X11_DISPLAY (display) ?                                        \
-  MIN(262144,                                                           \
+  MIN(4194304,                                                           \
       XExtendedMaxRequestSize (GDK_DISPLAY_XDISPLAY (display)) == 0     \
        ? XMaxRequestSize (GDK_DISPLAY_XDISPLAY (display)) - 100         \
        : XExtendedMaxRequestSize (GDK_DISPLAY_XDISPLAY (display)) - 100)\
@@ -180,6 +182,8 @@ struct _GtkRetrievalInfo
   guchar   *buffer;		/* Buffer in which to accumulate results */
   gint	   offset;		/* Current offset in buffer, -1 indicates
 				   not yet started */
+  gint	   buffer_size;		/* Allocated size of buffer, so it can be
+				   grown geometrically during INCR */
   guint32 notify_time;		/* Timestamp from SelectionNotify */
 };
 
@@ -235,6 +239,7 @@ gtk_target_list_new (const GtkTargetEntry *targets,
   GtkTargetList *result = g_slice_new (GtkTargetList);
   result->list = NULL;
   result->ref_count = 1;
+  result->index = NULL;
 
   if (targets)
     gtk_target_list_add_table (result, targets, ntargets);
@@ -286,6 +291,7 @@ gtk_target_list_unref (GtkTargetList *list)
 	}
       
       g_list_free (list->list);
+      g_clear_pointer (&list->index, g_hash_table_unref);
       g_slice_free (GtkTargetList, list);
     }
 }
@@ -315,6 +321,7 @@ gtk_target_list_add (GtkTargetList *list,
   pair->info = info;
 
   list->list = g_list_append (list->list, pair);
+  g_clear_pointer (&list->index, g_hash_table_unref);
 }
 
 static GdkAtom utf8_atom;
@@ -525,6 +532,8 @@ gtk_target_list_add_table (GtkTargetList        *list,
       
       list->list = g_list_prepend (list->list, pair);
     }
+
+  g_clear_pointer (&list->index, g_hash_table_unref);
 }
 
 /**
@@ -553,6 +562,7 @@ gtk_target_list_remove (GtkTargetList *list,
 
 	  list->list = g_list_remove_link (list->list, tmp_list);
 	  g_list_free_1 (tmp_list);
+	  g_clear_pointer (&list->index, g_hash_table_unref);
 
 	  return;
 	}
@@ -561,6 +571,29 @@ gtk_target_list_remove (GtkTargetList *list,
     }
 }
 
+/* Builds the atom-keyed index over list->list; on duplicate targets
+ * the first entry wins, matching the former linear search. The index
+ * is dropped whenever the list is modified.
+ */
+static void
+gtk_target_list_ensure_index (GtkTargetList *list)
+{
+  GList *tmp_list;
+
+  if (list->index)
+    return;
+
+  list->index = g_hash_table_new (NULL, NULL);
+
+  for (tmp_list = list->list; tmp_list; tmp_list = tmp_list->next)
+    {
+      GtkTargetPair *pair = tmp_list->data;
+
+      if (!g_hash_table_contains (list->index, pair->target))
+        g_hash_table_insert (list->index, pair->target, pair);
+    }
+}
+
 /**
  * gtk_target_list_find:
  * @list: a #GtkTargetList
@@ -577,27 +610,20 @@ gtk_target_list_find (GtkTargetList *list,
 		      GdkAtom        target,
 		      guint         *info)
 {
-  GList *tmp_list;
+  GtkTargetPair *pair;
 
   g_return_val_if_fail (list != NULL, FALSE);
 
-  tmp_list = list->list;
-  while (tmp_list)
-    {
-      GtkTargetPair *pair = tmp_list->data;
+  gtk_target_list_ensure_index (list);
+  pair = g_hash_table_lookup (list->index, target);
 
-      if (pair->target == target)
-	{
-          if (info)
-            *info = pair->info;
-
-	  return TRUE;
-	}
+  if (pair == NULL)
+    return FALSE;
 
-      tmp_list = tmp_list->next;
-    }
+  if (info)
+    *info = pair->info;
 
-  return FALSE;
+  return TRUE;
 }
 
 /**
@@ -1115,6 +1141,7 @@ gtk_selection_convert (GtkWidget *widget,
   info->idle_time = 0;
   info->buffer = NULL;
   info->offset = -1;
+  info->buffer_size = 0;
   
   /* Check if this process has current owner. If so, call handler
      procedure directly to avoid deadlocks with INCR. */
@@ -1363,6 +1390,52 @@ gtk_selection_data_set (GtkSelectionData *selection_data,
   selection_data->length = length;
 }
 
+/**
+ * gtk_selection_data_set_stream:
+ * @selection_data: a pointer to a #GtkSelectionData-struct.
+ * @type: the type of selection data
+ * @format: format (number of bits in a unit)
+ * @length: total length of the data, in bytes
+ * @stream_func: (scope notified): callback producing the data in chunks
+ * @user_data: user data to pass to @stream_func
+ * @destroy: (allow-none): called to free @user_data when the transfer
+ *     finishes or is abandoned
+ *
+ * Arranges for the contents of a selection to be produced in chunks
+ * by @stream_func instead of being copied into @selection_data up
+ * front. The data is always sent incrementally, so only one chunk
+ * is held in memory at a time; @stream_func is called with growing
+ * offsets until it returns 0. Should only be called from a selection
+ * handler callback.
+ *
+ * Since: 3.18
+ **/
+void
+gtk_selection_data_set_stream (GtkSelectionData       *selection_data,
+                               GdkAtom                 type,
+                               gint                    format,
+                               gsize                   length,
+                               GtkSelectionStreamFunc  stream_func,
+                               gpointer                user_data,
+                               GDestroyNotify          destroy)
+{
+  g_return_if_fail (selection_data != NULL);
+  g_return_if_fail (stream_func != NULL);
+
+  if (selection_data->stream_destroy)
+    selection_data->stream_destroy (selection_data->stream_data);
+
+  g_free (selection_data->data);
+
+  selection_data->type = type;
+  selection_data->format = format;
+  selection_data->data = NULL;
+  selection_data->length = length;
+  selection_data->stream_func = stream_func;
+  selection_data->stream_data = user_data;
+  selection_data->stream_destroy = destroy;
+}
+
 static gboolean
 selection_set_string (GtkSelectionData *selection_data,
 		      const gchar      *str,
@@ -2444,6 +2517,9 @@ _gtk_selection_request (GtkWidget *widget,
       data.data = NULL;
       data.length = -1;
       data.display = gtk_widget_get_display (widget);
+      data.stream_func = NULL;
+      data.stream_data = NULL;
+      data.stream_destroy = NULL;
       
 #ifdef DEBUG_SELECTION
       g_message ("Selection %ld, target %ld (%s) requested by 0x%x (property = %ld)",
@@ -2464,9 +2540,10 @@ _gtk_selection_request (GtkWidget *widget,
       
       items = data.length / gtk_selection_bytes_per_item (data.format);
       
-      if (data.length > selection_max_size)
+      if (data.stream_func != NULL || data.length > selection_max_size)
 	{
-	  /* Sending via INCR */
+	  /* Sending via INCR; streamed conversions always go this way,
+	     so no more than one chunk is in memory at a time */
 #ifdef DEBUG_SELECTION
 	  g_message ("Target larger (%d) than max. request size (%ld), sending incrementally\n",
 		     data.length, selection_max_size);
@@ -2570,6 +2647,20 @@ _gtk_selection_request (GtkWidget *widget,
   return TRUE;
 }
 
+/* Releases the stream provider of a conversion, if any. Called when
+ * the transfer for the conversion finishes or is abandoned.
+ */
+static void
+gtk_selection_conversion_clear_stream (GtkIncrConversion *conversion)
+{
+  if (conversion->data.stream_destroy)
+    conversion->data.stream_destroy (conversion->data.stream_data);
+
+  conversion->data.stream_func = NULL;
+  conversion->data.stream_data = NULL;
+  conversion->data.stream_destroy = NULL;
+}
+
 /*************************************************************
  * _gtk_selection_incr_event:
  *     Called whenever an PropertyNotify event occurs for an 
@@ -2627,6 +2718,7 @@ _gtk_selection_incr_event (GdkWindow	   *window,
 	  info->conversions[i].offset != -1)
 	{
 	  int bytes_per_item;
+	  guchar *stream_buffer = NULL;
 	  
 	  info->idle_time = 0;
 	  
@@ -2636,6 +2728,29 @@ _gtk_selection_incr_event (GdkWindow	   *window,
 	      num_bytes = 0;
 	      buffer = NULL;
 	    }
+	  else if (info->conversions[i].data.stream_func)
+	    {
+	      gssize n_read;
+
+	      stream_buffer = g_malloc (selection_max_size);
+	      n_read = info->conversions[i].data.stream_func (&info->conversions[i].data,
+							      stream_buffer,
+							      selection_max_size,
+							      info->conversions[i].offset,
+							      info->conversions[i].data.stream_data);
+
+	      if (n_read > 0)
+		{
+		  num_bytes = n_read;
+		  buffer = stream_buffer;
+		  info->conversions[i].offset += n_read;
+		}
+	      else
+		{
+		  num_bytes = 0;
+		  buffer = NULL;
+		}
+	    }
 	  else
 	    {
 	      num_bytes = info->conversions[i].data.length -
@@ -2665,6 +2780,8 @@ _gtk_selection_incr_event (GdkWindow	   *window,
 			       buffer,
 			       num_bytes / bytes_per_item);
 	  
+	  g_free (stream_buffer);
+	  
 	  if (info->conversions[i].offset == -2)
 	    {
 	      g_free (info->conversions[i].data.data);
@@ -2675,6 +2792,7 @@ _gtk_selection_incr_event (GdkWindow	   *window,
 	    {
 	      info->num_incrs--;
 	      info->conversions[i].offset = -1;
+	      gtk_selection_conversion_clear_stream (&info->conversions[i]);
 	    }
 	}
     }
@@ -2705,6 +2823,7 @@ gtk_selection_incr_timeout (GtkIncrInfo *info)
 {
   GList *tmp_list;
   gboolean retval;
+  gint i;
 
   /* Determine if retrieval has finished by checking if it still in
      list of pending retrievals */
@@ -2726,6 +2845,9 @@ gtk_selection_incr_timeout (GtkIncrInfo *info)
 	  g_list_free (tmp_list);
 	}
       
+      for (i = 0; i < info->num_conversions; i++)
+	gtk_selection_conversion_clear_stream (&info->conversions[i]);
+
       g_free (info->conversions);
       /* FIXME: we should check if requestor window is still in use,
 	 and if not, remove it? */
@@ -2813,6 +2935,23 @@ _gtk_selection_notify (GtkWidget	 *widget,
       info->notify_time = event->time;
       info->idle_time = 0;
       info->offset = 0;		/* Mark as OK to proceed */
+
+      /* The INCR property carries a lower bound on the size of the
+       * selection; use it to size the receive buffer up front so most
+       * transfers never need to reallocate.
+       */
+      if (format == 32 && length >= (gint) sizeof (glong))
+	{
+	  glong lower_bound = * (glong *) buffer;
+
+	  if (lower_bound > 0 && lower_bound < G_MAXINT - 1)
+	    {
+	      info->buffer = g_malloc (lower_bound + 1);
+	      info->buffer[0] = '\0';
+	      info->buffer_size = lower_bound + 1;
+	    }
+	}
+
       gdk_window_set_events (window,
                              gdk_window_get_events (window)
 			     | GDK_PROPERTY_CHANGE_MASK);
@@ -2898,10 +3037,9 @@ _gtk_selection_property_notify (GtkWidget	*widget,
 				       &type, &format);
   gdk_property_delete (window, event->atom);
 
-  /* We could do a lot better efficiency-wise by paying attention to
-     what length was sent in the initial INCR transaction, instead of
-     doing memory allocation at every step. But its only guaranteed to
-     be a _lower bound_ (pretty useless!) */
+  /* The buffer is usually preallocated from the lower bound sent in
+     the initial INCR transaction; since that's only a lower bound, it
+     is grown geometrically when more data arrives than announced. */
   
   if (length == 0 || type == GDK_NONE)		/* final zero length portion */
     {
@@ -2924,6 +3062,7 @@ _gtk_selection_property_notify (GtkWidget	*widget,
 #endif
 	  info->buffer = new_buffer;
 	  info->offset = length;
+	  info->buffer_size = length + 1;
 	}
       else
 	{
@@ -2933,7 +3072,11 @@ _gtk_selection_property_notify (GtkWidget	*widget,
 		     length,info->offset);
 #endif
 	  /* We copy length+1 bytes to preserve guaranteed null termination */
-	  info->buffer = g_realloc (info->buffer, info->offset+length+1);
+	  if (info->offset + length + 1 > info->buffer_size)
+	    {
+	      info->buffer_size = MAX (info->buffer_size * 2, info->offset + length + 1);
+	      info->buffer = g_realloc (info->buffer, info->buffer_size);
+	    }
 	  memcpy (info->buffer + info->offset, new_buffer, length+1);
 	  info->offset += length;
 	  g_free (new_buffer);
@@ -3177,6 +3320,11 @@ gtk_selection_data_copy (const GtkSelectionData *data)
   new_data = g_slice_new (GtkSelectionData);
   *new_data = *data;
 
+  /* The stream provider stays with the original */
+  new_data->stream_func = NULL;
+  new_data->stream_data = NULL;
+  new_data->stream_destroy = NULL;
+
   if (data->data)
     {
       new_data->data = g_malloc (data->length + 1);
@@ -3198,6 +3346,9 @@ gtk_selection_data_free (GtkSelectionData *data)
 {
   g_return_if_fail (data != NULL);
   
+  if (data->stream_destroy)
+    data->stream_destroy (data->stream_data);
+
   g_free (data->data);
   
   g_slice_free (GtkSelectionData, data);
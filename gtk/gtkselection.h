@@ -194,6 +194,40 @@ void     gtk_selection_data_set      (GtkSelectionData     *selection_data,
                                       gint                  format,
                                       const guchar         *data,
                                       gint                  length);
+
+/**
+ * GtkSelectionStreamFunc:
+ * @selection_data: the #GtkSelectionData being transferred
+ * @buffer: buffer to fill with data
+ * @count: maximum number of bytes to write to @buffer
+ * @offset: offset into the selection contents, in bytes
+ * @user_data: user data passed to gtk_selection_data_set_stream()
+ *
+ * Produces one chunk of streamed selection contents. The callback
+ * is invoked from the main loop, possibly long after the selection
+ * handler returned; it may hand the production of the chunk off to
+ * a worker thread, as long as @buffer is filled by the time it
+ * returns.
+ *
+ * Returns: the number of bytes written to @buffer, or 0 when the
+ *     end of the data has been reached
+ *
+ * Since: 3.18
+ */
+typedef gssize (* GtkSelectionStreamFunc) (GtkSelectionData *selection_data,
+                                           guchar           *buffer,
+                                           gsize             count,
+                                           gsize             offset,
+                                           gpointer          user_data);
+
+GDK_AVAILABLE_IN_3_18
+void     gtk_selection_data_set_stream (GtkSelectionData       *selection_data,
+                                        GdkAtom                 type,
+                                        gint                    format,
+                                        gsize                   length,
+                                        GtkSelectionStreamFunc  stream_func,
+                                        gpointer                user_data,
+                                        GDestroyNotify          destroy);
 GDK_AVAILABLE_IN_ALL
 gboolean gtk_selection_data_set_text (GtkSelectionData     *selection_data,
                                       const gchar          *str,
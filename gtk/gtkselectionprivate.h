@@ -45,6 +45,12 @@ struct _GtkSelectionData
   guchar       *data;
   gint          length;
   GdkDisplay   *display;
+
+  /* Set instead of data for streamed transfers; see
+   * gtk_selection_data_set_stream() */
+  GtkSelectionStreamFunc stream_func;
+  gpointer      stream_data;
+  GDestroyNotify stream_destroy;
 };
 
 struct _GtkTargetList
@@ -52,6 +58,7 @@ struct _GtkTargetList
   /*< private >*/
   GList *list;
   guint ref_count;
+  GHashTable *index; /* atom -> GtkTargetPair, built lazily */
  };
 
 gboolean _gtk_selection_clear           (GtkWidget         *widget,
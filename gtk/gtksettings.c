@@ -26,6 +26,8 @@
 #include "gtkmodulesprivate.h"
 #include "gtksettingsprivate.h"
 #include "gtkintl.h"
+#include "gtkmain.h"
+#include "gtktraceprivate.h"
 #include "gtkwidget.h"
 #include "gtkprivate.h"
 #include "gtkcssproviderprivate.h"
@@ -127,6 +129,9 @@ struct _GtkSettingsPrivate
   GSList *style_cascades;
   GtkCssProvider *theme_provider;
   GtkCssProvider *key_theme_provider;
+
+  guint reset_widgets_idle;
+  guint pending_invalidate_style : 1;
 };
 
 struct _GtkSettingsValuePrivate
@@ -1733,10 +1738,19 @@ gtk_settings_style_provider_get_settings (GtkStyleProviderPrivate *provider)
   return GTK_SETTINGS (provider);
 }
 
+static gboolean
+gtk_settings_style_provider_references_class (GtkStyleProviderPrivate *provider,
+                                              GQuark                   class_quark)
+{
+  /* The settings style is the same for every node, no matter its classes */
+  return FALSE;
+}
+
 static void
 gtk_settings_provider_private_init (GtkStyleProviderPrivateInterface *iface)
 {
   iface->get_settings = gtk_settings_style_provider_get_settings;
+  iface->references_class = gtk_settings_style_provider_references_class;
 }
 
 static void
@@ -1754,6 +1768,9 @@ gtk_settings_finalize (GObject *object)
 
   g_datalist_clear (&priv->queued_settings);
 
+  if (priv->reset_widgets_idle)
+    g_source_remove (priv->reset_widgets_idle);
+
   settings_update_provider (priv->screen, &priv->theme_provider, NULL);
   settings_update_provider (priv->screen, &priv->key_theme_provider, NULL);
   g_slist_free_full (priv->style_cascades, g_object_unref);
@@ -1852,6 +1869,7 @@ gtk_settings_get_for_screen (GdkScreen *screen)
   settings = g_object_get_data (G_OBJECT (screen), "gtk-settings");
   if (!settings)
     {
+      _gtk_trace_begin ("settings init", NULL);
 #ifdef GDK_WINDOWING_QUARTZ
       if (GDK_IS_QUARTZ_SCREEN (screen))
         {
@@ -1883,6 +1901,7 @@ gtk_settings_get_for_screen (GdkScreen *screen)
       settings_update_cursor_theme (settings);
       settings_update_resolution (settings);
       settings_update_font_options (settings);
+      _gtk_trace_end ("settings init");
     }
 
   return settings;
@@ -2006,6 +2025,46 @@ settings_invalidate_style (GtkSettings *settings)
   _gtk_style_provider_private_changed (GTK_STYLE_PROVIDER_PRIVATE (settings));
 }
 
+static gboolean
+settings_apply_queued_resets (gpointer data)
+{
+  GtkSettings *settings = data;
+  GtkSettingsPrivate *priv = settings->priv;
+
+  priv->reset_widgets_idle = 0;
+
+  if (priv->pending_invalidate_style)
+    {
+      priv->pending_invalidate_style = FALSE;
+      settings_invalidate_style (settings);
+    }
+
+  gtk_style_context_reset_widgets (priv->screen);
+
+  return G_SOURCE_REMOVE;
+}
+
+/* A settings daemon restart can fire dozens of property notifications
+ * back-to-back; resetting every widget once per property would redo
+ * the same work over and over. Instead the reset is deferred to an
+ * idle that runs before resize and redraw processing, so one batch of
+ * changes pays for a single reset.
+ */
+static void
+settings_queue_reset_widgets (GtkSettings *settings)
+{
+  GtkSettingsPrivate *priv = settings->priv;
+
+  if (priv->reset_widgets_idle != 0)
+    return;
+
+  priv->reset_widgets_idle =
+    gdk_threads_add_idle_full (GTK_PRIORITY_RESIZE - 1,
+                               settings_apply_queued_resets,
+                               settings, NULL);
+  g_source_set_name_by_id (priv->reset_widgets_idle, "[gtk+] settings_apply_queued_resets");
+}
+
 static void
 gtk_settings_notify (GObject    *object,
                      GParamSpec *pspec)
@@ -2027,8 +2086,8 @@ gtk_settings_notify (GObject    *object,
       settings_update_double_click (settings);
       break;
     case PROP_FONT_NAME:
-      settings_invalidate_style (settings);
-      gtk_style_context_reset_widgets (priv->screen);
+      priv->pending_invalidate_style = TRUE;
+      settings_queue_reset_widgets (settings);
       break;
     case PROP_KEY_THEME_NAME:
       settings_update_key_theme (settings);
@@ -2043,21 +2102,21 @@ gtk_settings_notify (GObject    *object,
        * widgets with gtk_widget_style_set(), and also causes more
        * recomputation than necessary.
        */
-      gtk_style_context_reset_widgets (priv->screen);
+      settings_queue_reset_widgets (settings);
       break;
     case PROP_XFT_ANTIALIAS:
     case PROP_XFT_HINTING:
     case PROP_XFT_HINTSTYLE:
     case PROP_XFT_RGBA:
       settings_update_font_options (settings);
-      gtk_style_context_reset_widgets (priv->screen);
+      settings_queue_reset_widgets (settings);
       break;
     case PROP_FONTCONFIG_TIMESTAMP:
       if (settings_update_fontconfig (settings))
-        gtk_style_context_reset_widgets (priv->screen);
+        settings_queue_reset_widgets (settings);
       break;
     case PROP_ENABLE_ANIMATIONS:
-      gtk_style_context_reset_widgets (priv->screen);
+      settings_queue_reset_widgets (settings);
       break;
     case PROP_CURSOR_THEME_NAME:
     case PROP_CURSOR_THEME_SIZE:
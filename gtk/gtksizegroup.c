@@ -29,6 +29,7 @@
 #include "gtksizerequestcacheprivate.h"
 #include "gtkwidgetprivate.h"
 #include "gtkcontainerprivate.h"
+#include "gtklayoutstatsprivate.h"
 
 
 /**
@@ -640,6 +641,8 @@ void
 _gtk_size_group_queue_resize (GtkWidget           *widget,
 			      GtkQueueResizeFlags  flags)
 {
+  _gtk_layout_stats_count_queue_resize (widget);
+
   queue_resize_on_widget (widget, TRUE, flags);
 }
 
@@ -29,6 +29,7 @@
 #include "gtksizegroup-private.h"
 #include "gtksizerequestcacheprivate.h"
 #include "gtkwidgetprivate.h"
+#include "gtklayoutstatsprivate.h"
 #include "deprecated/gtkstyle.h"
 
 
@@ -36,6 +37,8 @@
 static GQuark recursion_check_quark = 0;
 #endif /* G_DISABLE_CHECKS */
 
+static GQuark baseline_support_quark = 0;
+
 static void
 push_recursion_check (GtkWidget       *widget,
                       GtkOrientation   orientation,
@@ -94,7 +97,7 @@ get_vfunc_name (GtkOrientation orientation,
 }
 
 static gboolean
-widget_class_has_baseline_support (GtkWidgetClass *widget_class)
+widget_class_compute_baseline_support (GtkWidgetClass *widget_class)
 {
   GtkWidgetClass *parent_class;
 
@@ -123,6 +126,30 @@ widget_class_has_baseline_support (GtkWidgetClass *widget_class)
   return TRUE;
 }
 
+/* Whether a class supports baselines never changes at runtime, but
+ * computing it walks the class hierarchy and we ask for every single
+ * height request of every single widget, so cache the answer on the
+ * type.
+ */
+static gboolean
+widget_class_has_baseline_support (GtkWidgetClass *widget_class)
+{
+  GType type = G_TYPE_FROM_CLASS (widget_class);
+  gpointer cached;
+
+  if (baseline_support_quark == 0)
+    baseline_support_quark = g_quark_from_static_string ("gtk-size-request-has-baseline-support");
+
+  cached = g_type_get_qdata (type, baseline_support_quark);
+  if (cached == NULL)
+    {
+      cached = GINT_TO_POINTER (widget_class_compute_baseline_support (widget_class) ? 1 : 2);
+      g_type_set_qdata (type, baseline_support_quark, cached);
+    }
+
+  return GPOINTER_TO_INT (cached) == 1;
+}
+
 gboolean
 _gtk_widget_has_baseline_support (GtkWidget *widget)
 {
@@ -168,6 +195,8 @@ gtk_widget_query_size_for_orientation (GtkWidget        *widget,
     {
       gint adjusted_min, adjusted_natural, adjusted_for_size = for_size;
 
+      _gtk_layout_stats_count_measure (widget);
+
       G_GNUC_BEGIN_IGNORE_DEPRECATIONS;
       gtk_widget_ensure_style (widget);
       G_GNUC_END_IGNORE_DEPRECATIONS;
@@ -65,8 +65,19 @@ _gtk_size_request_cache_free (SizeRequestCache *cache)
 void
 _gtk_size_request_cache_clear (SizeRequestCache *cache)
 {
-  _gtk_size_request_cache_free (cache);
-  _gtk_size_request_cache_init (cache);
+  /* Clearing happens on every queue_resize and typically hits whole
+   * branches of the widget tree at once, with a re-measurement
+   * following right away. Only the bookkeeping is reset here; the
+   * allocated entries stay around to be refilled, which spares a
+   * free/alloc cycle per widget and per resize.
+   */
+  cache->flags[GTK_ORIENTATION_HORIZONTAL].n_cached_requests = 0;
+  cache->flags[GTK_ORIENTATION_HORIZONTAL].last_cached_request = 0;
+  cache->flags[GTK_ORIENTATION_HORIZONTAL].cached_size_valid = FALSE;
+  cache->flags[GTK_ORIENTATION_VERTICAL].n_cached_requests = 0;
+  cache->flags[GTK_ORIENTATION_VERTICAL].last_cached_request = 0;
+  cache->flags[GTK_ORIENTATION_VERTICAL].cached_size_valid = FALSE;
+  cache->request_mode_valid = FALSE;
 }
 
 void
@@ -34,9 +34,11 @@ G_BEGIN_DECLS
  * (or width-for-height) as can be rational
  * for a said widget to have, if a label can
  * only wrap to 3 lines, only 3 caches will
- * ever be allocated for it.
+ * ever be allocated for it. Layouts that
+ * probe many trade-offs, like flowing boxes,
+ * use more of them.
  */
-#define GTK_SIZE_REQUEST_CACHED_SIZES   (5)
+#define GTK_SIZE_REQUEST_CACHED_SIZES   (9)
 
 typedef struct {
   gint minimum_size;
@@ -74,8 +76,8 @@ typedef struct {
   GtkSizeRequestMode request_mode   : 3;
   guint       request_mode_valid    : 1;
   struct {
-    guint       n_cached_requests   : 3;
-    guint       last_cached_request : 3;
+    guint       n_cached_requests   : 4;
+    guint       last_cached_request : 4;
     guint       cached_size_valid   : 1;
   }           flags[2];
 } SizeRequestCache;
@@ -980,6 +980,39 @@ effective_transition_type (GtkStack               *stack,
   return transition_type;
 }
 
+static void
+gtk_stack_snapshot_last_visible (GtkStack *stack)
+{
+  GtkStackPrivate *priv = gtk_stack_get_instance_private (stack);
+  GtkWidget *widget = GTK_WIDGET (stack);
+  cairo_t *pattern_cr;
+
+  if (priv->last_visible_surface != NULL ||
+      priv->last_visible_child == NULL ||
+      !gtk_widget_get_realized (widget))
+    return;
+
+  gtk_widget_get_allocation (priv->last_visible_child->widget,
+                             &priv->last_visible_surface_allocation);
+  priv->last_visible_surface =
+    gdk_window_create_similar_surface (gtk_widget_get_window (widget),
+                                       CAIRO_CONTENT_COLOR_ALPHA,
+                                       priv->last_visible_surface_allocation.width,
+                                       priv->last_visible_surface_allocation.height);
+  pattern_cr = cairo_create (priv->last_visible_surface);
+  /* We don't use propagate_draw here, because we don't want to apply
+   * the bin_window offset
+   */
+  gtk_widget_draw (priv->last_visible_child->widget, pattern_cr);
+  cairo_destroy (pattern_cr);
+
+  /* The snapshot now stands in for the page for the rest of the
+   * transition, so drop the child out of layout; otherwise every
+   * animation frame of an interpolated transition re-allocates it.
+   */
+  gtk_widget_set_child_visible (priv->last_visible_child->widget, FALSE);
+}
+
 static void
 gtk_stack_start_transition (GtkStack               *stack,
                             GtkStackTransitionType  transition_type,
@@ -1003,6 +1036,7 @@ gtk_stack_start_transition (GtkStack               *stack,
       priv->start_time = gdk_frame_clock_get_frame_time (gtk_widget_get_frame_clock (widget));
       priv->end_time = priv->start_time + (transition_duration * 1000);
       priv->active_transition_type = effective_transition_type (stack, transition_type);
+      gtk_stack_snapshot_last_visible (stack);
       gtk_stack_schedule_ticks (stack);
     }
   else
@@ -2078,7 +2112,6 @@ gtk_stack_draw (GtkWidget *widget,
 {
   GtkStack *stack = GTK_STACK (widget);
   GtkStackPrivate *priv = gtk_stack_get_instance_private (stack);
-  cairo_t *pattern_cr;
 
   if (gtk_cairo_should_draw_window (cr, priv->view_window))
     {
@@ -2096,23 +2129,7 @@ gtk_stack_draw (GtkWidget *widget,
     {
       if (priv->transition_pos < 1.0)
         {
-          if (priv->last_visible_surface == NULL &&
-              priv->last_visible_child != NULL)
-            {
-              gtk_widget_get_allocation (priv->last_visible_child->widget,
-                                         &priv->last_visible_surface_allocation);
-              priv->last_visible_surface =
-                gdk_window_create_similar_surface (gtk_widget_get_window (widget),
-                                                   CAIRO_CONTENT_COLOR_ALPHA,
-                                                   priv->last_visible_surface_allocation.width,
-                                                   priv->last_visible_surface_allocation.height);
-              pattern_cr = cairo_create (priv->last_visible_surface);
-              /* We don't use propagate_draw here, because we don't want to apply
-               * the bin_window offset
-               */
-              gtk_widget_draw (priv->last_visible_child->widget, pattern_cr);
-              cairo_destroy (pattern_cr);
-            }
+          gtk_stack_snapshot_last_visible (stack);
 
           switch (priv->active_transition_type)
             {
@@ -2169,7 +2186,7 @@ gtk_stack_size_allocate (GtkWidget     *widget,
   child_allocation.height = allocation->height;
 
 
-  if (priv->last_visible_child)
+  if (priv->last_visible_child && priv->last_visible_surface == NULL)
     gtk_widget_size_allocate (priv->last_visible_child->widget, &child_allocation);
 
   if (priv->visible_child)
@@ -237,6 +237,30 @@ gtk_style_cascade_lookup (GtkStyleProviderPrivate *provider,
     }
 }
 
+static gboolean
+gtk_style_cascade_references_class (GtkStyleProviderPrivate *provider,
+                                    GQuark                   class_quark)
+{
+  GtkStyleCascade *cascade = GTK_STYLE_CASCADE (provider);
+  GtkStyleCascadeIter iter;
+  GtkStyleProvider *item;
+
+  for (item = gtk_style_cascade_iter_init (cascade, &iter);
+       item;
+       item = gtk_style_cascade_iter_next (cascade, &iter))
+    {
+      /* Can't know what non-private providers look at */
+      if (!GTK_IS_STYLE_PROVIDER_PRIVATE (item))
+        return TRUE;
+
+      if (_gtk_style_provider_private_references_class (GTK_STYLE_PROVIDER_PRIVATE (item),
+                                                        class_quark))
+        return TRUE;
+    }
+
+  return FALSE;
+}
+
 static void
 gtk_style_cascade_provider_private_iface_init (GtkStyleProviderPrivateInterface *iface)
 {
@@ -245,6 +269,7 @@ gtk_style_cascade_provider_private_iface_init (GtkStyleProviderPrivateInterface
   iface->get_scale = gtk_style_cascade_get_scale;
   iface->get_keyframes = gtk_style_cascade_get_keyframes;
   iface->lookup = gtk_style_cascade_lookup;
+  iface->references_class = gtk_style_cascade_references_class;
 }
 
 G_DEFINE_TYPE_EXTENDED (GtkStyleCascade, _gtk_style_cascade, G_TYPE_OBJECT, 0,
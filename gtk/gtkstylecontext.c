@@ -148,6 +148,8 @@ struct _GtkStyleContextPrivate
   GtkStyleContext *parent;
   GtkCssNode *cssnode;
   GSList *saved_nodes;
+  /* recycled transient nodes for the save/restore fast path */
+  GtkCssNode *transient_pool[4];
   GArray *property_cache;
 
   GdkFrameClock *frame_clock;
@@ -274,6 +276,53 @@ gtk_style_context_clear_property_cache (GtkStyleContext *context)
   g_array_set_size (priv->property_cache, 0);
 }
 
+/* Cell renderers save and restore around every cell they draw, which
+ * made the transient node allocation in gtk_style_context_save() a top
+ * allocator during treeview paint.  Keep a few popped transient nodes
+ * parked on the context and recycle them on the next save.
+ */
+static GtkCssNode *
+gtk_style_context_acquire_transient_node (GtkStyleContext *context)
+{
+  GtkStyleContextPrivate *priv = context->priv;
+  guint i;
+
+  for (i = 0; i < G_N_ELEMENTS (priv->transient_pool); i++)
+    {
+      if (priv->transient_pool[i])
+        {
+          GtkCssNode *node = priv->transient_pool[i];
+
+          priv->transient_pool[i] = NULL;
+          return gtk_css_transient_node_reuse (node, priv->cssnode);
+        }
+    }
+
+  return gtk_css_transient_node_new (priv->cssnode);
+}
+
+static gboolean
+gtk_style_context_release_transient_node (GtkStyleContext *context,
+                                          GtkCssNode      *node)
+{
+  GtkStyleContextPrivate *priv = context->priv;
+  guint i;
+
+  if (!GTK_IS_CSS_TRANSIENT_NODE (node))
+    return FALSE;
+
+  for (i = 0; i < G_N_ELEMENTS (priv->transient_pool); i++)
+    {
+      if (priv->transient_pool[i] == NULL)
+        {
+          priv->transient_pool[i] = node;
+          return TRUE;
+        }
+    }
+
+  return FALSE;
+}
+
 static void
 gtk_style_context_pop_style_node (GtkStyleContext *context)
 {
@@ -283,7 +332,8 @@ gtk_style_context_pop_style_node (GtkStyleContext *context)
 
   if (GTK_IS_CSS_TRANSIENT_NODE (priv->cssnode))
     gtk_css_node_set_parent (priv->cssnode, NULL);
-  g_object_unref (priv->cssnode);
+  if (!gtk_style_context_release_transient_node (context, priv->cssnode))
+    g_object_unref (priv->cssnode);
   priv->cssnode = priv->saved_nodes->data;
   priv->saved_nodes = g_slist_remove (priv->saved_nodes, priv->cssnode);
 }
@@ -364,12 +414,15 @@ gtk_style_context_finalize (GObject *object)
 {
   GtkStyleContextPrivate *priv;
   GtkStyleContext *style_context;
+  guint i;
 
   style_context = GTK_STYLE_CONTEXT (object);
   priv = style_context->priv;
 
   while (priv->saved_nodes)
     gtk_style_context_pop_style_node (style_context);
+  for (i = 0; i < G_N_ELEMENTS (priv->transient_pool); i++)
+    g_clear_object (&priv->transient_pool[i]);
   if (GTK_IS_CSS_PATH_NODE (priv->cssnode))
     gtk_css_path_node_unset_context (GTK_CSS_PATH_NODE (priv->cssnode));
 
@@ -1231,7 +1284,7 @@ gtk_style_context_save (GtkStyleContext *context)
   if (!gtk_style_context_is_saved (context))
     gtk_style_context_lookup_style (context);
 
-  cssnode = gtk_css_transient_node_new (priv->cssnode);
+  cssnode = gtk_style_context_acquire_transient_node (context);
   gtk_css_node_set_parent (cssnode, gtk_style_context_get_root (context));
 
   priv->saved_nodes = g_slist_prepend (priv->saved_nodes, priv->cssnode);
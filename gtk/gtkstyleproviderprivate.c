@@ -104,6 +104,26 @@ _gtk_style_provider_private_lookup (GtkStyleProviderPrivate *provider,
   iface->lookup (provider, matcher, lookup, out_change);
 }
 
+/* Returns whether any rule in @provider cares about the style class
+ * @class_quark. Providers that cannot answer precisely must return
+ * %TRUE, as a %FALSE result allows skipping invalidation when the
+ * class is toggled on a node. */
+gboolean
+_gtk_style_provider_private_references_class (GtkStyleProviderPrivate *provider,
+                                              GQuark                   class_quark)
+{
+  GtkStyleProviderPrivateInterface *iface;
+
+  g_return_val_if_fail (GTK_IS_STYLE_PROVIDER_PRIVATE (provider), TRUE);
+
+  iface = GTK_STYLE_PROVIDER_PRIVATE_GET_INTERFACE (provider);
+
+  if (!iface->references_class)
+    return TRUE;
+
+  return iface->references_class (provider, class_quark);
+}
+
 void
 _gtk_style_provider_private_changed (GtkStyleProviderPrivate *provider)
 {
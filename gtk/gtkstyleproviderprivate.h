@@ -49,6 +49,8 @@ struct _GtkStyleProviderPrivateInterface
                                                  const GtkCssMatcher     *matcher,
                                                  GtkCssLookup            *lookup,
                                                  GtkCssChange            *out_change);
+  gboolean              (* references_class)    (GtkStyleProviderPrivate *provider,
+                                                 GQuark                   class_quark);
 
   /* signal */
   void                  (* changed)             (GtkStyleProviderPrivate *provider);
@@ -66,6 +68,9 @@ void                    _gtk_style_provider_private_lookup       (GtkStyleProvid
                                                                   const GtkCssMatcher     *matcher,
                                                                   GtkCssLookup            *lookup,
                                                                   GtkCssChange            *out_change);
+gboolean                _gtk_style_provider_private_references_class
+                                                                 (GtkStyleProviderPrivate *provider,
+                                                                  GQuark                   class_quark);
 
 void                    _gtk_style_provider_private_changed      (GtkStyleProviderPrivate *provider);
 
@@ -1116,6 +1116,7 @@ _gtk_text_btree_insert (GtkTextIter *iter,
   int char_count_delta;                /* change to number of chars */
   GtkTextBTree *tree;
   gint start_byte_index;
+  gint end_byte_index;
   GtkTextLine *start_line;
 
   g_return_if_fail (text != NULL);
@@ -1153,6 +1154,7 @@ _gtk_text_btree_insert (GtkTextIter *iter,
   sol = 0;
   line_count_delta = 0;
   char_count_delta = 0;
+  end_byte_index = start_byte_index;
   while (eol < len)
     {
       sol = eol;
@@ -1177,6 +1179,8 @@ _gtk_text_btree_insert (GtkTextIter *iter,
       g_assert (g_utf8_validate (&text[sol], chunk_len, NULL));
       seg = _gtk_char_segment_new (&text[sol], chunk_len);
 
+      end_byte_index += chunk_len;
+
       char_count_delta += seg->char_count;
 
       if (cur_seg == NULL)
@@ -1211,6 +1215,7 @@ _gtk_text_btree_insert (GtkTextIter *iter,
       line = newline;
       cur_seg = NULL;
       line_count_delta++;
+      end_byte_index = 0;
     }
 
   /*
@@ -1237,12 +1242,16 @@ _gtk_text_btree_insert (GtkTextIter *iter,
                                       &start,
                                       start_line,
                                       start_byte_index);
-    end = start;
 
-    /* We could almost certainly be more efficient here
-       by saving the information from the insertion loop
-       above. FIXME */
-    gtk_text_iter_forward_chars (&end, char_count_delta);
+    /* The insertion loop tracked the line and byte index where the
+     * inserted text ends, so the end iter can be made directly instead
+     * of stepping forward char_count_delta characters -- for a bulk
+     * load that walk was quadratic in the size of the file.
+     */
+    _gtk_text_btree_get_iter_at_line (tree,
+                                      &end,
+                                      line,
+                                      end_byte_index);
 
     DV (g_print ("invalidating due to inserting some text (%s)\n", G_STRLOC));
     _gtk_text_btree_invalidate_region (tree, &start, &end, FALSE);
@@ -1758,6 +1767,48 @@ queue_tag_redisplay (GtkTextBTree      *tree,
   /* We don't need to do anything if the tag doesn't affect display */
 }
 
+/* Clips [start,end] to the sub-range in which applying or removing
+ * @tag will actually change the tag state, so that re-applying a tag
+ * over a mostly-unchanged region (a highlighter re-tagging a whole
+ * file, say) doesn't invalidate every line in the range. Returns
+ * FALSE if the operation changes nothing at all.
+ */
+static gboolean
+tag_changed_region (const GtkTextIter *start,
+                    const GtkTextIter *end,
+                    GtkTextTag        *tag,
+                    gboolean           add,
+                    GtkTextIter       *changed_start,
+                    GtkTextIter       *changed_end)
+{
+  GtkTextIter tmp;
+
+  add = add != FALSE;
+
+  *changed_start = *start;
+  *changed_end = *end;
+
+  /* If the state at the start is already what we want, nothing
+   * changes before the first toggle.
+   */
+  if ((gtk_text_iter_has_tag (changed_start, tag) != FALSE) == add)
+    {
+      if (!gtk_text_iter_forward_to_tag_toggle (changed_start, tag) ||
+          gtk_text_iter_compare (changed_start, end) >= 0)
+        return FALSE;
+    }
+
+  /* Likewise, if the state just before the end is already right,
+   * nothing changes after the last toggle.
+   */
+  tmp = *end;
+  if (gtk_text_iter_backward_char (&tmp) &&
+      (gtk_text_iter_has_tag (&tmp, tag) != FALSE) == add)
+    gtk_text_iter_backward_to_tag_toggle (changed_end, tag);
+
+  return TRUE;
+}
+
 void
 _gtk_text_btree_tag (const GtkTextIter *start_orig,
                      const GtkTextIter *end_orig,
@@ -1771,6 +1822,7 @@ _gtk_text_btree_tag (const GtkTextIter *start_orig,
   GtkTextLine *end_line;
   GtkTextIter iter;
   GtkTextIter start, end;
+  GtkTextIter changed_start, changed_end;
   GtkTextBTree *tree;
   IterStack *stack;
   GtkTextTagInfo *info;
@@ -1800,7 +1852,9 @@ _gtk_text_btree_tag (const GtkTextIter *start_orig,
 
   tree = _gtk_text_iter_get_btree (&start);
 
-  queue_tag_redisplay (tree, tag, &start, &end);
+  if (tag_changed_region (&start, &end, tag, add,
+                          &changed_start, &changed_end))
+    queue_tag_redisplay (tree, tag, &changed_start, &changed_end);
 
   info = gtk_text_btree_get_tag_info (tree, tag);
 
@@ -2218,6 +2272,15 @@ _gtk_text_btree_get_tags (const GtkTextIter *iter,
   line = _gtk_text_iter_get_text_line (iter);
   byte_index = gtk_text_iter_get_line_index (iter);
 
+  /* If no tag has ever been applied to this tree there is nothing to
+   * count; skip the sibling walks entirely.
+   */
+  if (_gtk_text_iter_get_btree (iter)->tag_infos == NULL)
+    {
+      *num_tags = 0;
+      return NULL;
+    }
+
   tagInfo.numTags = 0;
   tagInfo.arraySize = NUM_TAG_INFOS;
   tagInfo.tags = g_new (GtkTextTag*, NUM_TAG_INFOS);
@@ -2485,6 +2548,10 @@ _gtk_text_btree_char_is_invisible (const GtkTextIter *iter)
   tree = _gtk_text_iter_get_btree (iter);
   byte_index = gtk_text_iter_get_line_index (iter);
 
+  /* tagCnts/tags below are indexed by tag priority, which requires
+   * the dense numbering */
+  _gtk_text_tag_table_ensure_priorities (tree->table);
+
   numTags = gtk_text_tag_table_get_size (tree->table);
 
   /* almost always avoid malloc, so stay out of system calls */
@@ -3602,6 +3669,7 @@ _gtk_text_line_data_new (GtkTextLayout *layout,
   line_data->width = 0;
   line_data->height = 0;
   line_data->valid = FALSE;
+  line_data->single_line = FALSE;
 
   return line_data;
 }
@@ -221,7 +221,9 @@ struct _GtkTextLineData {
   GtkTextLineData *next;
   gint height;
   signed int width : 24;
-  guint valid : 8;		/* Actually a boolean */
+  guint valid : 4;		/* Actually a boolean */
+  guint single_line : 4;	/* Actually a boolean: the paragraph
+				 * wrapped to a single display line */
 };
 
 /*
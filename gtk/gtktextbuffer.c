@@ -77,6 +77,18 @@ struct _GtkTextBufferPrivate
   /* Whether the buffer has been modified since last save */
   guint modified : 1;
   guint has_selection : 1;
+
+  /* Set during gtk_text_buffer_apply_edits() to coalesce the
+   * ::changed emissions of the individual edits into one */
+  guint in_batch_edit : 1;
+  guint batch_changed_pending : 1;
+
+  /* Undo journal; see gtk_text_buffer_set_enable_undo() */
+  GQueue *undo_actions;
+  GQueue *redo_actions;
+  guint undo_group;
+  guint enable_undo : 1;
+  guint in_undo_redo : 1;
 };
 
 typedef struct _ClipboardRequest ClipboardRequest;
@@ -158,6 +170,7 @@ static void update_selection_clipboards           (GtkTextBuffer *buffer);
 static GtkTextBuffer *create_clipboard_contents_buffer (GtkTextBuffer *buffer);
 
 static void gtk_text_buffer_free_target_lists     (GtkTextBuffer *buffer);
+static void gtk_text_buffer_clear_undo_queue      (GQueue        *queue);
 
 static void gtk_text_buffer_set_property (GObject         *object,
 				          guint            prop_id,
@@ -631,6 +644,8 @@ gtk_text_buffer_init (GtkTextBuffer *buffer)
   buffer->priv = gtk_text_buffer_get_instance_private (buffer);
   buffer->priv->clipboard_contents_buffers = NULL;
   buffer->priv->tag_table = NULL;
+  buffer->priv->undo_actions = g_queue_new ();
+  buffer->priv->redo_actions = g_queue_new ();
 
   /* allow copying of arbiatray stuff in the internal rich text format */
   gtk_text_buffer_register_serialize_tagset (buffer, NULL);
@@ -804,6 +819,11 @@ gtk_text_buffer_finalize (GObject *object)
 
   priv->log_attr_cache = NULL;
 
+  gtk_text_buffer_clear_undo_queue (priv->undo_actions);
+  gtk_text_buffer_clear_undo_queue (priv->redo_actions);
+  g_queue_free (priv->undo_actions);
+  g_queue_free (priv->redo_actions);
+
   gtk_text_buffer_free_target_lists (buffer);
 
   G_OBJECT_CLASS (gtk_text_buffer_parent_class)->finalize (object);
@@ -882,18 +902,117 @@ gtk_text_buffer_set_text (GtkTextBuffer *buffer,
  * Insertion
  */
 
+/* Undo journal. Each recorded action stores the character offsets and
+ * a copy of the text involved; actions recorded inside one user action
+ * share a group and are undone together. The journal is capped, with
+ * the oldest groups dropped first.
+ */
+
+#define MAX_UNDO_ACTIONS 1000
+
+typedef struct _GtkTextBufferUndoAction GtkTextBufferUndoAction;
+
+struct _GtkTextBufferUndoAction
+{
+  guint is_insert : 1;
+  guint group;
+  gint start;
+  gint end;
+  gchar *text;
+};
+
+static void
+gtk_text_buffer_undo_action_free (GtkTextBufferUndoAction *action)
+{
+  g_free (action->text);
+  g_slice_free (GtkTextBufferUndoAction, action);
+}
+
+static void
+gtk_text_buffer_clear_undo_queue (GQueue *queue)
+{
+  while (queue->head != NULL)
+    gtk_text_buffer_undo_action_free (g_queue_pop_head (queue));
+}
+
+static void
+gtk_text_buffer_record_edit (GtkTextBuffer *buffer,
+                             gboolean       is_insert,
+                             gint           start,
+                             gint           end,
+                             gchar         *text)
+{
+  GtkTextBufferPrivate *priv = buffer->priv;
+  GtkTextBufferUndoAction *action;
+
+  action = g_slice_new (GtkTextBufferUndoAction);
+  action->is_insert = is_insert;
+  action->start = start;
+  action->end = end;
+  action->text = text;
+
+  if (priv->user_action_count > 0)
+    action->group = priv->undo_group;
+  else
+    action->group = ++priv->undo_group;
+
+  g_queue_push_head (priv->undo_actions, action);
+
+  /* A fresh edit makes the redo journal meaningless */
+  gtk_text_buffer_clear_undo_queue (priv->redo_actions);
+
+  while (priv->undo_actions->length > MAX_UNDO_ACTIONS)
+    gtk_text_buffer_undo_action_free (g_queue_pop_tail (priv->undo_actions));
+}
+
+static void
+gtk_text_buffer_apply_undo_action (GtkTextBuffer           *buffer,
+                                   GtkTextBufferUndoAction *action,
+                                   gboolean                 invert)
+{
+  if (action->is_insert != invert)
+    {
+      GtkTextIter iter;
+
+      gtk_text_buffer_get_iter_at_offset (buffer, &iter, action->start);
+      gtk_text_buffer_insert (buffer, &iter, action->text, -1);
+    }
+  else
+    {
+      GtkTextIter start, end;
+
+      gtk_text_buffer_get_iter_at_offset (buffer, &start, action->start);
+      gtk_text_buffer_get_iter_at_offset (buffer, &end, action->end);
+      gtk_text_buffer_delete (buffer, &start, &end);
+    }
+}
+
 static void
 gtk_text_buffer_real_insert_text (GtkTextBuffer *buffer,
                                   GtkTextIter   *iter,
                                   const gchar   *text,
                                   gint           len)
 {
+  gint undo_start = 0;
+
   g_return_if_fail (GTK_IS_TEXT_BUFFER (buffer));
   g_return_if_fail (iter != NULL);
-  
+
+  if (buffer->priv->enable_undo && !buffer->priv->in_undo_redo)
+    undo_start = gtk_text_iter_get_offset (iter);
+
   _gtk_text_btree_insert (iter, text, len);
 
-  g_signal_emit (buffer, signals[CHANGED], 0);
+  if (buffer->priv->enable_undo && !buffer->priv->in_undo_redo)
+    gtk_text_buffer_record_edit (buffer, TRUE,
+                                 undo_start,
+                                 gtk_text_iter_get_offset (iter),
+                                 g_strndup (text, len < 0 ? strlen (text) : len));
+
+  if (buffer->priv->in_batch_edit)
+    buffer->priv->batch_changed_pending = TRUE;
+  else
+    g_signal_emit (buffer, signals[CHANGED], 0);
   g_object_notify_by_pspec (G_OBJECT (buffer), text_buffer_props[PROP_CURSOR_POSITION]);
 }
 
@@ -1606,6 +1725,15 @@ gtk_text_buffer_real_delete_range (GtkTextBuffer *buffer,
   g_return_if_fail (start != NULL);
   g_return_if_fail (end != NULL);
 
+  if (buffer->priv->enable_undo && !buffer->priv->in_undo_redo)
+    {
+      gtk_text_iter_order (start, end);
+      gtk_text_buffer_record_edit (buffer, FALSE,
+                                   gtk_text_iter_get_offset (start),
+                                   gtk_text_iter_get_offset (end),
+                                   gtk_text_iter_get_slice (start, end));
+    }
+
   _gtk_text_btree_delete (start, end);
 
   /* may have deleted the selection... */
@@ -1618,7 +1746,10 @@ gtk_text_buffer_real_delete_range (GtkTextBuffer *buffer,
       g_object_notify_by_pspec (G_OBJECT (buffer), text_buffer_props[PROP_HAS_SELECTION]);
     }
 
-  g_signal_emit (buffer, signals[CHANGED], 0);
+  if (buffer->priv->in_batch_edit)
+    buffer->priv->batch_changed_pending = TRUE;
+  else
+    g_signal_emit (buffer, signals[CHANGED], 0);
   g_object_notify_by_pspec (G_OBJECT (buffer), text_buffer_props[PROP_CURSOR_POSITION]);
 }
 
@@ -3849,6 +3980,213 @@ gtk_text_buffer_delete_selection (GtkTextBuffer *buffer,
     }
 }
 
+/**
+ * gtk_text_buffer_apply_edits:
+ * @buffer: a #GtkTextBuffer
+ * @edits: (array length=n_edits): the edits to apply, in order
+ * @n_edits: the length of @edits
+ *
+ * Applies a sequence of insertions and deletions to @buffer in one
+ * go. An edit with a non-%NULL #GtkTextBufferEdit.text inserts that
+ * text at #GtkTextBufferEdit.start; otherwise the characters between
+ * #GtkTextBufferEdit.start and #GtkTextBufferEdit.end are deleted.
+ * Offsets are character offsets into the buffer as it stands when the
+ * edit in question is applied.
+ *
+ * The #GtkTextBuffer::insert-text and #GtkTextBuffer::delete-range
+ * signals are emitted for each edit as usual, but
+ * #GtkTextBuffer::changed is emitted only once at the end, and the
+ * whole batch forms a single user action. This makes applying many
+ * small edits -- streaming appends, search-and-replace over a large
+ * buffer -- much cheaper for listeners that revalidate on ::changed.
+ *
+ * Since: 3.18
+ */
+void
+gtk_text_buffer_apply_edits (GtkTextBuffer           *buffer,
+                             const GtkTextBufferEdit *edits,
+                             gint                     n_edits)
+{
+  gint i;
+
+  g_return_if_fail (GTK_IS_TEXT_BUFFER (buffer));
+  g_return_if_fail (edits != NULL || n_edits == 0);
+
+  gtk_text_buffer_begin_user_action (buffer);
+
+  buffer->priv->in_batch_edit = TRUE;
+  buffer->priv->batch_changed_pending = FALSE;
+
+  for (i = 0; i < n_edits; i++)
+    {
+      const GtkTextBufferEdit *edit = &edits[i];
+
+      if (edit->text != NULL)
+        {
+          GtkTextIter iter;
+
+          gtk_text_buffer_get_iter_at_offset (buffer, &iter, edit->start);
+          gtk_text_buffer_insert (buffer, &iter, edit->text, edit->length);
+        }
+      else
+        {
+          GtkTextIter start, end;
+
+          gtk_text_buffer_get_iter_at_offset (buffer, &start, edit->start);
+          gtk_text_buffer_get_iter_at_offset (buffer, &end, edit->end);
+          gtk_text_buffer_delete (buffer, &start, &end);
+        }
+    }
+
+  buffer->priv->in_batch_edit = FALSE;
+
+  if (buffer->priv->batch_changed_pending)
+    {
+      buffer->priv->batch_changed_pending = FALSE;
+      g_signal_emit (buffer, signals[CHANGED], 0);
+    }
+
+  gtk_text_buffer_end_user_action (buffer);
+}
+
+/**
+ * gtk_text_buffer_set_enable_undo:
+ * @buffer: a #GtkTextBuffer
+ * @enable_undo: %TRUE to keep an undo journal
+ *
+ * Enables or disables the buffer's built-in undo journal. While
+ * enabled, every insertion and deletion is recorded (edits inside one
+ * user action form a single undo step) and can be reverted with
+ * gtk_text_buffer_undo() and reapplied with gtk_text_buffer_redo().
+ * The journal stores plain text only: tags and pixbufs are not
+ * restored by an undo. Disabling the journal discards it.
+ *
+ * Since: 3.18
+ */
+void
+gtk_text_buffer_set_enable_undo (GtkTextBuffer *buffer,
+                                 gboolean       enable_undo)
+{
+  g_return_if_fail (GTK_IS_TEXT_BUFFER (buffer));
+
+  enable_undo = enable_undo != FALSE;
+
+  if (buffer->priv->enable_undo == enable_undo)
+    return;
+
+  buffer->priv->enable_undo = enable_undo;
+
+  if (!enable_undo)
+    {
+      gtk_text_buffer_clear_undo_queue (buffer->priv->undo_actions);
+      gtk_text_buffer_clear_undo_queue (buffer->priv->redo_actions);
+    }
+}
+
+/**
+ * gtk_text_buffer_get_enable_undo:
+ * @buffer: a #GtkTextBuffer
+ *
+ * Returns whether the buffer keeps an undo journal. See
+ * gtk_text_buffer_set_enable_undo().
+ *
+ * Returns: %TRUE if undo is enabled
+ *
+ * Since: 3.18
+ */
+gboolean
+gtk_text_buffer_get_enable_undo (GtkTextBuffer *buffer)
+{
+  g_return_val_if_fail (GTK_IS_TEXT_BUFFER (buffer), FALSE);
+
+  return buffer->priv->enable_undo;
+}
+
+/**
+ * gtk_text_buffer_undo:
+ * @buffer: a #GtkTextBuffer
+ *
+ * Reverts the most recent undo step recorded in the buffer's undo
+ * journal, if any. See gtk_text_buffer_set_enable_undo().
+ *
+ * Returns: %TRUE if an undo step was applied
+ *
+ * Since: 3.18
+ */
+gboolean
+gtk_text_buffer_undo (GtkTextBuffer *buffer)
+{
+  GtkTextBufferPrivate *priv;
+  GtkTextBufferUndoAction *action;
+  guint group;
+
+  g_return_val_if_fail (GTK_IS_TEXT_BUFFER (buffer), FALSE);
+
+  priv = buffer->priv;
+
+  if (priv->undo_actions->head == NULL)
+    return FALSE;
+
+  group = ((GtkTextBufferUndoAction *)priv->undo_actions->head->data)->group;
+
+  priv->in_undo_redo = TRUE;
+
+  while (priv->undo_actions->head != NULL &&
+         ((GtkTextBufferUndoAction *)priv->undo_actions->head->data)->group == group)
+    {
+      action = g_queue_pop_head (priv->undo_actions);
+      gtk_text_buffer_apply_undo_action (buffer, action, TRUE);
+      g_queue_push_head (priv->redo_actions, action);
+    }
+
+  priv->in_undo_redo = FALSE;
+
+  return TRUE;
+}
+
+/**
+ * gtk_text_buffer_redo:
+ * @buffer: a #GtkTextBuffer
+ *
+ * Reapplies the most recently undone undo step, if any. The redo
+ * journal is discarded as soon as a new edit is made. See
+ * gtk_text_buffer_set_enable_undo().
+ *
+ * Returns: %TRUE if a redo step was applied
+ *
+ * Since: 3.18
+ */
+gboolean
+gtk_text_buffer_redo (GtkTextBuffer *buffer)
+{
+  GtkTextBufferPrivate *priv;
+  GtkTextBufferUndoAction *action;
+  guint group;
+
+  g_return_val_if_fail (GTK_IS_TEXT_BUFFER (buffer), FALSE);
+
+  priv = buffer->priv;
+
+  if (priv->redo_actions->head == NULL)
+    return FALSE;
+
+  group = ((GtkTextBufferUndoAction *)priv->redo_actions->head->data)->group;
+
+  priv->in_undo_redo = TRUE;
+
+  while (priv->redo_actions->head != NULL &&
+         ((GtkTextBufferUndoAction *)priv->redo_actions->head->data)->group == group)
+    {
+      action = g_queue_pop_head (priv->redo_actions);
+      gtk_text_buffer_apply_undo_action (buffer, action, FALSE);
+      g_queue_push_head (priv->undo_actions, action);
+    }
+
+  priv->in_undo_redo = FALSE;
+
+  return TRUE;
+}
+
 /**
  * gtk_text_buffer_backspace:
  * @buffer: a #GtkTextBuffer
@@ -4100,6 +4438,9 @@ gtk_text_buffer_begin_user_action (GtkTextBuffer *buffer)
   
   if (buffer->priv->user_action_count == 1)
     {
+      /* Edits within this user action form one undo group */
+      buffer->priv->undo_group++;
+
       /* Outermost nested user action begin emits the signal */
       g_signal_emit (buffer, signals[BEGIN_USER_ACTION], 0);
     }
@@ -4251,7 +4592,12 @@ gtk_text_buffer_get_paste_target_list (GtkTextBuffer *buffer)
  * Logical attribute cache
  */
 
-#define ATTR_CACHE_SIZE 2
+/* Sized so that word/sentence motion and double-click selection that
+ * hop across a screenful of lines stay inside the cache; entries are
+ * keyed by line number, so any buffer edit still clears the lot (line
+ * numbers shift and there is no per-line stamp to compare against).
+ */
+#define ATTR_CACHE_SIZE 16
 
 typedef struct _CacheEntry CacheEntry;
 struct _CacheEntry
@@ -258,6 +258,44 @@ gboolean gtk_text_buffer_backspace          (GtkTextBuffer *buffer,
 					     gboolean       interactive,
 					     gboolean       default_editable);
 
+/**
+ * GtkTextBufferEdit:
+ * @start: character offset at which the edit applies
+ * @end: for a deletion, the character offset just past the deleted
+ *     range; unused for insertions
+ * @text: the text to insert, or %NULL for a deletion
+ * @length: the byte length of @text, or -1 if @text is nul-terminated
+ *
+ * A single edit for gtk_text_buffer_apply_edits().
+ *
+ * Since: 3.18
+ */
+typedef struct _GtkTextBufferEdit GtkTextBufferEdit;
+
+struct _GtkTextBufferEdit
+{
+  gint         start;
+  gint         end;
+  const gchar *text;
+  gint         length;
+};
+
+GDK_AVAILABLE_IN_3_18
+void     gtk_text_buffer_apply_edits        (GtkTextBuffer           *buffer,
+					     const GtkTextBufferEdit *edits,
+					     gint                     n_edits);
+
+/* Undo journal */
+GDK_AVAILABLE_IN_3_18
+void     gtk_text_buffer_set_enable_undo    (GtkTextBuffer *buffer,
+					     gboolean       enable_undo);
+GDK_AVAILABLE_IN_3_18
+gboolean gtk_text_buffer_get_enable_undo    (GtkTextBuffer *buffer);
+GDK_AVAILABLE_IN_3_18
+gboolean gtk_text_buffer_undo               (GtkTextBuffer *buffer);
+GDK_AVAILABLE_IN_3_18
+gboolean gtk_text_buffer_redo               (GtkTextBuffer *buffer);
+
 /* Obtain strings from the buffer */
 GDK_AVAILABLE_IN_ALL
 gchar          *gtk_text_buffer_get_text            (GtkTextBuffer     *buffer,
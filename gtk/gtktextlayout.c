@@ -127,6 +127,7 @@ static void gtk_text_layout_emit_changed           (GtkTextLayout     *layout,
 						    gint               new_height);
 
 static void gtk_text_layout_invalidate_all (GtkTextLayout *layout);
+static void gtk_text_layout_invalidate_wrapped (GtkTextLayout *layout);
 
 static PangoAttribute *gtk_text_attr_appearance_new (const GtkTextAppearance *appearance);
 
@@ -170,12 +171,56 @@ enum {
 
 #define PIXEL_BOUND(d) (((d) + PANGO_SCALE - 1) / PANGO_SCALE)
 
+/* Capacity of the line display cache; roughly a viewport worth
+ * of lines, so reverse scrolling stays inside the cache. */
+#define DISPLAY_CACHE_SIZE 32
+
 static guint signals[LAST_SIGNAL] = { 0 };
 
 PangoAttrType gtk_text_attr_appearance_type = 0;
 
 G_DEFINE_TYPE_WITH_PRIVATE (GtkTextLayout, gtk_text_layout, G_TYPE_OBJECT)
 
+static GtkTextLineDisplay *
+gtk_text_layout_display_cache_find (GtkTextLayout *layout,
+                                    GtkTextLine   *line)
+{
+  GList *l;
+
+  if (layout->display_cache == NULL)
+    return NULL;
+
+  for (l = layout->display_cache->head; l != NULL; l = l->next)
+    {
+      GtkTextLineDisplay *display = l->data;
+
+      if (display->line == line)
+        return display;
+    }
+
+  return NULL;
+}
+
+static void
+gtk_text_layout_display_cache_remove (GtkTextLayout      *layout,
+                                      GtkTextLineDisplay *display)
+{
+  g_queue_remove (layout->display_cache, display);
+  display->cached = FALSE;
+  gtk_text_layout_free_line_display (layout, display);
+}
+
+static void
+gtk_text_layout_display_cache_clear (GtkTextLayout *layout)
+{
+  if (layout->display_cache == NULL)
+    return;
+
+  while (layout->display_cache->head != NULL)
+    gtk_text_layout_display_cache_remove (layout,
+                                          layout->display_cache->head->data);
+}
+
 static void
 gtk_text_layout_dispose (GObject *object)
 {
@@ -194,11 +239,11 @@ gtk_text_layout_dispose (GObject *object)
   g_clear_object (&layout->ltr_context);
   g_clear_object (&layout->rtl_context);
 
-  if (layout->one_display_cache)
+  if (layout->display_cache != NULL)
     {
-      GtkTextLineDisplay *tmp_display = layout->one_display_cache;
-      layout->one_display_cache = NULL;
-      gtk_text_layout_free_line_display (layout, tmp_display);
+      gtk_text_layout_display_cache_clear (layout);
+      g_queue_free (layout->display_cache);
+      layout->display_cache = NULL;
     }
 
   if (layout->preedit_attrs != NULL)
@@ -278,6 +323,7 @@ static void
 gtk_text_layout_init (GtkTextLayout *text_layout)
 {
   text_layout->cursor_visible = TRUE;
+  text_layout->display_cache = g_queue_new ();
 }
 
 GtkTextLayout*
@@ -491,6 +537,8 @@ gtk_text_layout_get_buffer (GtkTextLayout *layout)
 void
 gtk_text_layout_set_screen_width (GtkTextLayout *layout, gint width)
 {
+  gint old_width;
+
   g_return_if_fail (GTK_IS_TEXT_LAYOUT (layout));
   g_return_if_fail (width >= 0);
   g_return_if_fail (layout->wrap_loop_count == 0);
@@ -498,10 +546,28 @@ gtk_text_layout_set_screen_width (GtkTextLayout *layout, gint width)
   if (layout->screen_width == width)
     return;
 
+  old_width = layout->screen_width;
   layout->screen_width = width;
 
-  DV (g_print ("invalidating all due to new screen width (%s)\n", G_STRLOC));
-  gtk_text_layout_invalidate_all (layout);
+  /* A paragraph that wrapped to a single display line lays out
+   * identically under any larger width, so growing the width only
+   * needs the wrapped paragraphs redone. Shrinking can introduce new
+   * wraps anywhere, so everything goes.
+   */
+  if (old_width > 0 && width >= old_width)
+    {
+      DV (g_print ("invalidating wrapped lines due to wider screen (%s)\n", G_STRLOC));
+      /* Cached displays embed the old width (alignment, total_width),
+       * so they all go even though the line sizes stay valid.
+       */
+      gtk_text_layout_display_cache_clear (layout);
+      gtk_text_layout_invalidate_wrapped (layout);
+    }
+  else
+    {
+      DV (g_print ("invalidating all due to new screen width (%s)\n", G_STRLOC));
+      gtk_text_layout_invalidate_all (layout);
+    }
 }
 
 /**
@@ -636,18 +702,22 @@ text_layout_changed (GtkTextLayout *layout,
                      gint           new_height,
                      gboolean       cursors_only)
 {
-  /* Check if the range intersects our cached line display,
-   * and invalidate the cached line if so.
+  GList *l, *next;
+
+  /* Check if the range intersects any cached line display,
+   * and invalidate those lines if so.
    */
-  if (layout->one_display_cache)
+  for (l = layout->display_cache->head; l != NULL; l = next)
     {
-      GtkTextLine *line = layout->one_display_cache->line;
+      GtkTextLineDisplay *display = l->data;
       gint cache_y = _gtk_text_btree_find_line_top (_gtk_text_buffer_get_btree (layout->buffer),
-						    line, layout);
-      gint cache_height = layout->one_display_cache->height;
+						    display->line, layout);
+      gint cache_height = display->height;
+
+      next = l->next;
 
       if (cache_y + cache_height > y && cache_y < y + old_height)
-	gtk_text_layout_invalidate_cache (layout, line, cursors_only);
+	gtk_text_layout_invalidate_cache (layout, display->line, cursors_only);
     }
 
   gtk_text_layout_emit_changed (layout, y, old_height, new_height);
@@ -814,15 +884,54 @@ gtk_text_layout_invalidate_all (GtkTextLayout *layout)
   gtk_text_layout_invalidate (layout, &start, &end);
 }
 
+static void
+gtk_text_layout_invalidate_wrapped (GtkTextLayout *layout)
+{
+  GtkTextIter start;
+  GtkTextIter end;
+  GtkTextLine *line;
+  GtkTextLine *last_line;
+
+  if (layout->buffer == NULL)
+    return;
+
+  gtk_text_buffer_get_bounds (layout->buffer, &start, &end);
+
+  last_line = _gtk_text_iter_get_text_line (&end);
+  line = _gtk_text_iter_get_text_line (&start);
+
+  while (TRUE)
+    {
+      GtkTextLineData *line_data = _gtk_text_line_get_data (line, layout);
+
+      if (line_data == NULL || !line_data->valid || !line_data->single_line)
+        {
+          gtk_text_layout_invalidate_cache (layout, line, FALSE);
+
+          if (line_data)
+            _gtk_text_line_invalidate_wrap (line, line_data);
+        }
+
+      if (line == last_line)
+        break;
+
+      line = _gtk_text_line_next_excluding_last (line);
+    }
+
+  gtk_text_layout_invalidated (layout);
+}
+
 static void
 gtk_text_layout_invalidate_cache (GtkTextLayout *layout,
                                   GtkTextLine   *line,
 				  gboolean       cursors_only)
 {
-  if (layout->one_display_cache && line == layout->one_display_cache->line)
-    {
-      GtkTextLineDisplay *display = layout->one_display_cache;
+  GtkTextLineDisplay *display;
+
+  display = gtk_text_layout_display_cache_find (layout, line);
 
+  if (display != NULL)
+    {
       if (cursors_only)
 	{
           if (display->cursors)
@@ -833,8 +942,7 @@ gtk_text_layout_invalidate_cache (GtkTextLayout *layout,
 	}
       else
 	{
-	  layout->one_display_cache = NULL;
-	  gtk_text_layout_free_line_display (layout, display);
+	  gtk_text_layout_display_cache_remove (layout, display);
 	}
     }
 }
@@ -927,13 +1035,15 @@ gtk_text_layout_real_invalidate_cursors (GtkTextLayout     *layout,
 					 const GtkTextIter *start,
 					 const GtkTextIter *end)
 {
-  /* Check if the range intersects our cached line display,
-   * and invalidate the cached line if so.
+  GList *l;
+
+  /* Check if the range intersects any cached line display,
+   * and invalidate the cursors of those lines if so.
    */
-  if (layout->one_display_cache)
+  for (l = layout->display_cache->head; l != NULL; l = l->next)
     {
       GtkTextIter line_start, line_end;
-      GtkTextLine *line = layout->one_display_cache->line;
+      GtkTextLine *line = ((GtkTextLineDisplay *)l->data)->line;
 
       gtk_text_layout_get_iter_at_line (layout, &line_start, line, 0);
 
@@ -1165,6 +1275,8 @@ gtk_text_layout_real_wrap (GtkTextLayout   *layout,
   line_data->width = display->width;
   line_data->height = display->height;
   line_data->valid = TRUE;
+  line_data->single_line = display->layout != NULL &&
+    pango_layout_get_line_count (display->layout) == 1;
   gtk_text_layout_free_line_display (layout, display);
 
   return line_data;
@@ -2250,21 +2362,20 @@ gtk_text_layout_get_line_display (GtkTextLayout *layout,
   
   g_return_val_if_fail (line != NULL, NULL);
 
-  if (layout->one_display_cache)
+  display = gtk_text_layout_display_cache_find (layout, line);
+  if (display != NULL)
     {
-      if (line == layout->one_display_cache->line &&
-          (size_only || !layout->one_display_cache->size_only))
+      if (size_only || !display->size_only)
 	{
 	  if (!size_only)
-            update_text_display_cursors (layout, line, layout->one_display_cache);
-	  return layout->one_display_cache;
+            update_text_display_cursors (layout, line, display);
+	  /* Keep the MRU order */
+	  g_queue_remove (layout->display_cache, display);
+	  g_queue_push_head (layout->display_cache, display);
+	  return display;
 	}
-      else
-        {
-          GtkTextLineDisplay *tmp_display = layout->one_display_cache;
-          layout->one_display_cache = NULL;
-          gtk_text_layout_free_line_display (layout, tmp_display);
-        }
+
+      gtk_text_layout_display_cache_remove (layout, display);
     }
 
   DV (g_print ("creating one line display cache (%s)\n", G_STRLOC));
@@ -2592,7 +2703,11 @@ gtk_text_layout_get_line_display (GtkTextLayout *layout,
   if (tags != NULL)
     g_ptr_array_free (tags, TRUE);
 
-  layout->one_display_cache = display;
+  display->cached = TRUE;
+  g_queue_push_head (layout->display_cache, display);
+  while (layout->display_cache->length > DISPLAY_CACHE_SIZE)
+    gtk_text_layout_display_cache_remove (layout,
+                                          g_queue_peek_tail (layout->display_cache));
 
   if (saw_widget)
     allocate_child_widgets (layout, display);
@@ -2604,7 +2719,7 @@ void
 gtk_text_layout_free_line_display (GtkTextLayout      *layout,
                                    GtkTextLineDisplay *display)
 {
-  if (display != layout->one_display_cache)
+  if (!display->cached)
     {
       if (display->layout)
         g_object_unref (display->layout);
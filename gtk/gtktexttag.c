@@ -2202,6 +2202,9 @@ gtk_text_tag_get_priority (GtkTextTag *tag)
 {
   g_return_val_if_fail (GTK_IS_TEXT_TAG (tag), 0);
 
+  if (tag->priv->table != NULL)
+    _gtk_text_tag_table_ensure_priorities (tag->priv->table);
+
   return tag->priv->priority;
 }
 
@@ -2237,6 +2240,9 @@ gtk_text_tag_set_priority (GtkTextTag *tag,
   g_return_if_fail (priority >= 0);
   g_return_if_fail (priority < gtk_text_tag_table_get_size (priv->table));
 
+  /* The shifting below assumes a dense 0..size-1 numbering */
+  _gtk_text_tag_table_ensure_priorities (priv->table);
+
   if (priority == priv->priority)
     return;
 
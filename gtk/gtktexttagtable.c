@@ -68,6 +68,13 @@ struct _GtkTextTagTablePrivate
   GSList     *buffers;
 
   gint anon_count;
+
+  /* Next priority to hand out on add; runs ahead of the table size
+   * once tags have been removed, leaving gaps in the numbering until
+   * _gtk_text_tag_table_ensure_priorities() compacts it.
+   */
+  gint next_priority;
+  guint priorities_valid : 1;
 };
 
 enum {
@@ -155,6 +162,7 @@ gtk_text_tag_table_init (GtkTextTagTable *table)
 {
   table->priv = gtk_text_tag_table_get_instance_private (table);
   table->priv->hash = g_hash_table_new (g_str_hash, g_str_equal);
+  table->priv->priorities_valid = TRUE;
 }
 
 /**
@@ -273,10 +281,14 @@ gtk_text_tag_table_add (GtkTextTagTable *table,
 
   /* We get the highest tag priority, as the most-recently-added
      tag. Note that we do NOT use gtk_text_tag_set_priority,
-     as it assumes the tag is already in the table. */
+     as it assumes the tag is already in the table. The counter
+     runs ahead of the table size once tags have been removed;
+     priorities are compacted back to 0..size-1 lazily. */
   size = gtk_text_tag_table_get_size (table);
   g_assert (size > 0);
-  tag->priv->priority = size - 1;
+  tag->priv->priority = priv->next_priority++;
+  if (priv->next_priority != size)
+    priv->priorities_valid = FALSE;
 
   g_signal_emit (table, signals[TAG_ADDED], 0, tag);
   return TRUE;
@@ -335,10 +347,12 @@ gtk_text_tag_table_remove (GtkTextTagTable *table,
     _gtk_text_buffer_notify_will_remove_tag (GTK_TEXT_BUFFER (l->data),
                                              tag);
 
-  /* Set ourselves to the highest priority; this means
-     when we're removed, there won't be any gaps in the
-     priorities of the tags in the table. */
-  gtk_text_tag_set_priority (tag, gtk_text_tag_table_get_size (table) - 1);
+  /* Removal leaves a gap in the priority numbering; rather than
+     renumbering every remaining tag here (which makes removing n tags
+     quadratic), mark the priorities stale and let
+     _gtk_text_tag_table_ensure_priorities() compact them when a dense
+     numbering is actually needed. */
+  priv->priorities_valid = FALSE;
 
   tag->priv->table = NULL;
 
@@ -431,6 +445,47 @@ gtk_text_tag_table_get_size (GtkTextTagTable *table)
   return g_hash_table_size (priv->hash) + priv->anon_count;
 }
 
+static void
+ensure_foreach (GtkTextTag *tag, gpointer data)
+{
+  GPtrArray *array = data;
+
+  g_ptr_array_add (array, tag);
+}
+
+/*
+ * Compacts tag priorities back to the dense 0..size-1 numbering that
+ * the public API and the btree's priority-indexed arrays rely on,
+ * preserving the relative order of the tags. Removing a tag only
+ * marks the numbering stale, so creating and destroying many tags
+ * stays O(1) per tag and the renumbering cost is paid here, at most
+ * once per batch of removals.
+ */
+void
+_gtk_text_tag_table_ensure_priorities (GtkTextTagTable *table)
+{
+  GtkTextTagTablePrivate *priv = table->priv;
+  GPtrArray *array;
+  guint i;
+
+  if (priv->priorities_valid)
+    return;
+
+  array = g_ptr_array_new ();
+  gtk_text_tag_table_foreach (table, ensure_foreach, array);
+
+  if (array->len > 0)
+    _gtk_text_tag_array_sort ((GtkTextTag **)array->pdata, array->len);
+
+  for (i = 0; i < array->len; i++)
+    GTK_TEXT_TAG (g_ptr_array_index (array, i))->priv->priority = i;
+
+  priv->next_priority = array->len;
+  priv->priorities_valid = TRUE;
+
+  g_ptr_array_free (array, TRUE);
+}
+
 void
 _gtk_text_tag_table_add_buffer (GtkTextTagTable *table,
                                 gpointer         buffer)
@@ -97,6 +97,7 @@ gint             gtk_text_tag_table_get_size (GtkTextTagTable        *table);
 /* INTERNAL private stuff - not even exported from the library on
  * many platforms
  */
+void _gtk_text_tag_table_ensure_priorities (GtkTextTagTable *table);
 void _gtk_text_tag_table_add_buffer    (GtkTextTagTable *table,
                                         gpointer         buffer);
 void _gtk_text_tag_table_remove_buffer (GtkTextTagTable *table,
@@ -4389,10 +4389,21 @@ incremental_validate_callback (gpointer data)
 {
   GtkTextView *text_view = data;
   gboolean result = TRUE;
+  GTimer *timer;
 
   DV(g_print(G_STRLOC"\n"));
-  
-  gtk_text_layout_validate (text_view->priv->layout, 2000);
+
+  /* Validate in small chunks against a time budget instead of one
+   * fixed pixel count: a 2000-pixel bite of complex text can blow the
+   * frame budget, while on cheap text it stops far short of what a
+   * frame could afford.
+   */
+  timer = g_timer_new ();
+  do
+    gtk_text_layout_validate (text_view->priv->layout, 500);
+  while (!gtk_text_layout_is_valid (text_view->priv->layout) &&
+         g_timer_elapsed (timer, NULL) < 0.002);
+  g_timer_destroy (timer);
 
   gtk_text_view_update_adjustments (text_view);
   
@@ -42,6 +42,7 @@
 #include "gtkcssnodeprivate.h"
 #include "gtkimage.h"
 #include "gtkintl.h"
+#include "gtkpango.h"
 #include "gtklabel.h"
 #include "gtkmain.h"
 #include "gtkmarshalers.h"
@@ -3255,9 +3256,7 @@ calculate_max_homogeneous_pixels (GtkWidget *widget)
   
   context = gtk_widget_get_pango_context (widget);
 
-  metrics = pango_context_get_metrics (context,
-                                       pango_context_get_font_description (context),
-				       pango_context_get_language (context));
+  metrics = _gtk_pango_get_metrics (context);
   char_width = pango_font_metrics_get_approximate_char_width (metrics);
   pango_font_metrics_unref (metrics);
   
@@ -124,10 +124,13 @@ struct _GtkTooltip
 
   GdkRectangle tip_area;
 
+  gint64 last_query_time;
+
   guint browse_mode_enabled : 1;
   guint keyboard_mode_enabled : 1;
   guint tip_area_set : 1;
   guint custom_was_reset : 1;
+  guint query_cache_invalid : 1;
 };
 
 struct _GtkTooltipClass
@@ -542,6 +545,7 @@ gtk_tooltip_trigger_tooltip_query (GdkDisplay *display)
   GdkWindow *window;
   GdkEvent event;
   GdkDevice *device;
+  GtkTooltip *tooltip;
 
   /* Trigger logic as if the mouse moved */
   device = gdk_device_manager_get_client_pointer (gdk_display_get_device_manager (display));
@@ -549,6 +553,12 @@ gtk_tooltip_trigger_tooltip_query (GdkDisplay *display)
   if (!window)
     return;
 
+  /* The tooltip contents may have changed; bypass the query cache */
+  tooltip = g_object_get_data (G_OBJECT (display),
+                               "gdk-display-current-tooltip");
+  if (tooltip)
+    tooltip->query_cache_invalid = TRUE;
+
   event.type = GDK_MOTION_NOTIFY;
   event.motion.window = window;
   event.motion.x = x;
@@ -933,6 +943,9 @@ gtk_tooltip_run_requery (GtkWidget  **widget,
   gboolean has_tooltip = FALSE;
   gboolean return_value = FALSE;
 
+  tooltip->last_query_time = g_get_monotonic_time ();
+  tooltip->query_cache_invalid = FALSE;
+
   gtk_tooltip_reset (tooltip);
 
   do
@@ -1516,6 +1529,38 @@ _gtk_tooltip_hide (GtkWidget *widget)
     gtk_tooltip_hide_tooltip (tooltip);
 }
 
+/* Returns %TRUE when the result of the last query-tooltip run is
+ * still valid for the given position, so the machinery can be
+ * skipped for this motion event. The tooltip must be visible over
+ * the same widget; if the last query pinned a context rectangle
+ * with gtk_tooltip_set_tip_area(), results stay valid while the
+ * pointer remains inside it, otherwise requeries are merely
+ * throttled to roughly one per frame.
+ */
+static gboolean
+gtk_tooltip_query_is_cached (GtkTooltip *tooltip,
+                             GtkWidget  *widget,
+                             gint        x,
+                             gint        y)
+{
+  if (tooltip->query_cache_invalid)
+    return FALSE;
+
+  if (!GTK_TOOLTIP_VISIBLE (tooltip))
+    return FALSE;
+
+  if (widget != tooltip->tooltip_widget)
+    return FALSE;
+
+  if (tooltip->tip_area_set)
+    return (x > tooltip->tip_area.x &&
+            x < tooltip->tip_area.x + tooltip->tip_area.width &&
+            y > tooltip->tip_area.y &&
+            y < tooltip->tip_area.y + tooltip->tip_area.height);
+
+  return g_get_monotonic_time () - tooltip->last_query_time < G_USEC_PER_SEC / 60;
+}
+
 static gboolean
 tooltips_enabled (GdkEvent *event)
 {
@@ -1627,6 +1672,14 @@ _gtk_tooltip_handle_event (GdkEvent *event)
 	    tip_area_set = current_tooltip->tip_area_set;
 	    tip_area = current_tooltip->tip_area;
 
+	    if (event->type == GDK_MOTION_NOTIFY &&
+		gtk_tooltip_query_is_cached (current_tooltip,
+					     has_tooltip_widget, x, y))
+	      {
+		gtk_tooltip_start_delay (display);
+		break;
+	      }
+
 	    return_value = gtk_tooltip_run_requery (&has_tooltip_widget,
 						    current_tooltip,
 						    &x, &y);
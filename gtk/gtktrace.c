@@ -0,0 +1,158 @@
+/* GTK - The GIMP Toolkit
+ * Copyright (C) 2015 Red Hat, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/* Lightweight startup tracing.
+ *
+ * When the GTK_TRACE_FILE environment variable names a writable file,
+ * the probes scattered over the startup path (module loading, settings
+ * creation, CSS parsing, icon cache opening) append events to it in
+ * the Trace Event JSON format, which chrome://tracing can display
+ * directly. When the variable is unset every probe is a cheap branch,
+ * so the probes can stay in production builds.
+ */
+
+#include "config.h"
+
+#include "gtktraceprivate.h"
+
+#include <stdio.h>
+
+#ifdef G_OS_WIN32
+#include <process.h>
+#define trace_getpid() _getpid ()
+#else
+#include <unistd.h>
+#define trace_getpid() getpid ()
+#endif
+
+static FILE *trace_file = NULL;
+
+void
+_gtk_trace_init (void)
+{
+  static gboolean initialized = FALSE;
+  const gchar *path;
+
+  if (initialized)
+    return;
+
+  initialized = TRUE;
+
+  path = g_getenv ("GTK_TRACE_FILE");
+  if (path == NULL || path[0] == '\0')
+    return;
+
+  trace_file = fopen (path, "w");
+  if (trace_file == NULL)
+    {
+      g_warning ("Failed to open trace file '%s'", path);
+      return;
+    }
+
+  /* The trace viewer accepts an array that is never closed, which
+   * saves us an exit handler and keeps the file usable after a crash.
+   */
+  fputs ("[\n", trace_file);
+}
+
+gboolean
+_gtk_trace_is_enabled (void)
+{
+  return trace_file != NULL;
+}
+
+static void
+trace_append_escaped (GString     *string,
+                      const gchar *text)
+{
+  const gchar *p;
+
+  for (p = text; *p; p++)
+    {
+      if (*p == '"' || *p == '\\')
+        g_string_append_c (string, '\\');
+      if ((guchar) *p < 0x20)
+        g_string_append_printf (string, "\\u%04x", *p);
+      else
+        g_string_append_c (string, *p);
+    }
+}
+
+static void
+trace_event (const gchar *phase,
+             const gchar *name,
+             const gchar *detail)
+{
+  GString *event;
+
+  event = g_string_new (NULL);
+  g_string_append_printf (event,
+                          "{\"cat\":\"gtk\",\"ph\":\"%s\",\"ts\":%" G_GINT64_FORMAT
+                          ",\"pid\":%d,\"tid\":0,\"name\":\"",
+                          phase,
+                          g_get_monotonic_time (),
+                          (int) trace_getpid ());
+  trace_append_escaped (event, name);
+  g_string_append_c (event, '"');
+
+  if (detail)
+    {
+      g_string_append (event, ",\"args\":{\"detail\":\"");
+      trace_append_escaped (event, detail);
+      g_string_append (event, "\"}");
+    }
+
+  g_string_append (event, "},\n");
+
+  fputs (event->str, trace_file);
+  fflush (trace_file);
+
+  g_string_free (event, TRUE);
+}
+
+/*
+ * _gtk_trace_begin:
+ * @name: name of the span, shown in the trace viewer
+ * @detail: (allow-none): extra information, e.g. a file name
+ *
+ * Opens a duration span in the trace. Must be paired with a
+ * _gtk_trace_end() with the same @name; spans may nest.
+ */
+void
+_gtk_trace_begin (const gchar *name,
+                  const gchar *detail)
+{
+  if (trace_file == NULL)
+    return;
+
+  trace_event ("B", name, detail);
+}
+
+/*
+ * _gtk_trace_end:
+ * @name: name passed to the matching _gtk_trace_begin()
+ *
+ * Closes the innermost open span with @name.
+ */
+void
+_gtk_trace_end (const gchar *name)
+{
+  if (trace_file == NULL)
+    return;
+
+  trace_event ("E", name, NULL);
+}
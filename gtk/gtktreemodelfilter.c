@@ -4269,6 +4269,72 @@ gtk_tree_model_filter_refilter (GtkTreeModelFilter *filter)
                           filter);
 }
 
+static gboolean
+gtk_tree_model_filter_refilter_visible_helper (GtkTreeModel *model,
+                                               GtkTreePath  *path,
+                                               GtkTreeIter  *iter,
+                                               gpointer      data)
+{
+  GList **rows = data;
+  GtkTreePath *child_path;
+
+  child_path =
+    gtk_tree_model_filter_convert_path_to_child_path (GTK_TREE_MODEL_FILTER (model),
+                                                      path);
+  if (child_path)
+    *rows = g_list_prepend (*rows, child_path);
+
+  return FALSE;
+}
+
+/**
+ * gtk_tree_model_filter_refilter_visible:
+ * @filter: A #GtkTreeModelFilter.
+ *
+ * Re-evaluates visibility for the currently visible rows only, leaving
+ * hidden rows hidden. This is only correct when the filter condition
+ * has become more restrictive since the last (re)filter — for example
+ * when the user extends a search string — but in that case it avoids
+ * visiting the typically much larger set of rows that are already
+ * filtered out. In all other cases, use
+ * gtk_tree_model_filter_refilter().
+ *
+ * Since: 3.18
+ */
+void
+gtk_tree_model_filter_refilter_visible (GtkTreeModelFilter *filter)
+{
+  GList *rows = NULL;
+  GList *l;
+
+  g_return_if_fail (GTK_IS_TREE_MODEL_FILTER (filter));
+
+  /* Collect the child paths up front: re-evaluating a row may remove
+   * it from the filter model, which would upset a traversal of the
+   * filter model itself. The child model does not change underneath
+   * us, so the collected paths stay valid.
+   */
+  gtk_tree_model_foreach (GTK_TREE_MODEL (filter),
+                          gtk_tree_model_filter_refilter_visible_helper,
+                          &rows);
+  rows = g_list_reverse (rows);
+
+  for (l = rows; l; l = l->next)
+    {
+      GtkTreePath *child_path = l->data;
+      GtkTreeIter child_iter;
+
+      if (gtk_tree_model_get_iter (filter->priv->child_model,
+                                   &child_iter, child_path))
+        gtk_tree_model_filter_row_changed (filter->priv->child_model,
+                                           child_path, &child_iter, filter);
+
+      gtk_tree_path_free (child_path);
+    }
+
+  g_list_free (rows);
+}
+
 /**
  * gtk_tree_model_filter_clear_cache:
  * @filter: A #GtkTreeModelFilter.
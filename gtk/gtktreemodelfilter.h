@@ -148,6 +148,8 @@ GtkTreePath  *gtk_tree_model_filter_convert_path_to_child_path (GtkTreeModelFilt
 /* extras */
 GDK_AVAILABLE_IN_ALL
 void          gtk_tree_model_filter_refilter                   (GtkTreeModelFilter           *filter);
+GDK_AVAILABLE_IN_3_18
+void          gtk_tree_model_filter_refilter_visible           (GtkTreeModelFilter           *filter);
 GDK_AVAILABLE_IN_ALL
 void          gtk_tree_model_filter_clear_cache                (GtkTreeModelFilter           *filter);
 
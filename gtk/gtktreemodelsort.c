@@ -267,6 +267,7 @@ struct _GtkTreeModelSortPrivate
   GList *sort_list;
   gint sort_column_id;
   GtkSortType order;
+  gboolean reverse_pending;
 
   /* default sort */
   GtkTreeIterCompareFunc default_sort_func;
@@ -1712,12 +1713,24 @@ gtk_tree_model_sort_set_sort_column_id (GtkTreeSortable *sortable,
         }
     }
 
+  /* Toggling the order on the current sort column simply reverses the
+   * existing order of every level; the resort below can then do a cheap
+   * index comparison instead of re-running the sort function over the
+   * whole model.
+   */
+  if (priv->sort_column_id == sort_column_id &&
+      sort_column_id != GTK_TREE_SORTABLE_UNSORTED_SORT_COLUMN_ID &&
+      priv->order != order)
+    priv->reverse_pending = TRUE;
+
   priv->sort_column_id = sort_column_id;
   priv->order = order;
 
   gtk_tree_sortable_sort_column_changed (sortable);
 
   gtk_tree_model_sort_sort (tree_model_sort);
+
+  priv->reverse_pending = FALSE;
 }
 
 static void
@@ -1862,6 +1875,26 @@ gtk_tree_model_sort_compare_func (gconstpointer a,
   return retval;
 }
 
+static gint
+gtk_tree_model_sort_reverse_compare_func (gconstpointer a,
+					  gconstpointer b,
+					  gpointer      user_data)
+{
+  const SortElt *sa = (SortElt *)a;
+  const SortElt *sb = (SortElt *)b;
+
+  /* old_index holds the position the elt had before this sort; sorting
+   * on it in descending order reverses the level without calling into
+   * the user sort function at all.
+   */
+  if (sa->old_index < sb->old_index)
+    return 1;
+  else if (sa->old_index > sb->old_index)
+    return -1;
+
+  return 0;
+}
+
 static gint
 gtk_tree_model_sort_offset_compare_func (gconstpointer a,
 					 gconstpointer b,
@@ -1937,7 +1970,10 @@ gtk_tree_model_sort_sort_level (GtkTreeModelSort *tree_model_sort,
 
   fill_sort_data (&data, tree_model_sort, level);
 
-  if (data.sort_func == NO_SORT_FUNC)
+  if (priv->reverse_pending)
+    g_sequence_sort (level->seq, gtk_tree_model_sort_reverse_compare_func,
+                     NULL);
+  else if (data.sort_func == NO_SORT_FUNC)
     g_sequence_sort (level->seq, gtk_tree_model_sort_offset_compare_func,
                      &data);
   else
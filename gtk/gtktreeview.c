@@ -225,6 +225,7 @@ typedef enum {
 #define GTK_TREE_VIEW_PRIORITY_SCROLL_SYNC (GTK_TREE_VIEW_PRIORITY_VALIDATE + 2)
 /* 3/5 of gdkframeclockidle.c's FRAME_INTERVAL (16667 microsecs) */
 #define GTK_TREE_VIEW_TIME_MS_PER_IDLE 10
+#define GTK_TREE_VIEW_TIME_MS_PER_FRAME 1
 #define SCROLL_EDGE_SIZE 15
 #define GTK_TREE_VIEW_SEARCH_DIALOG_TIMEOUT 5000
 #define AUTO_EXPAND_TIMEOUT 500
@@ -2823,6 +2824,12 @@ gtk_tree_view_size_allocate (GtkWidget     *widget,
   gint old_width;
   double page_size;
 
+  /* Prerender half a page above and below the viewport, like the text
+   * view does, so that small scroll steps stay pure blits.
+   */
+  _gtk_pixel_cache_set_extra_size (tree_view->priv->pixel_cache, 64,
+                                   allocation->height / 2);
+
   gtk_widget_get_allocation (widget, &widget_allocation);
   old_width = widget_allocation.width;
   if (allocation->width != widget_allocation.width)
@@ -6242,6 +6249,20 @@ validate_row (GtkTreeView *tree_view,
       ! GTK_RBNODE_FLAG_SET (node, GTK_RBNODE_COLUMN_INVALID))
     return FALSE;
 
+  /* With an established fixed height there is nothing to measure: all
+   * columns are fixed-width by the mode's contract and every row gets
+   * the same height, so validation degenerates to arithmetic.
+   */
+  if (tree_view->priv->fixed_height_mode &&
+      tree_view->priv->fixed_height >= 0)
+    {
+      retval = gtk_tree_view_get_row_height (tree_view, node)
+               != tree_view->priv->fixed_height;
+      _gtk_rbtree_node_set_height (tree, node, tree_view->priv->fixed_height);
+      _gtk_rbtree_node_mark_valid (tree, node);
+      return retval;
+    }
+
   is_separator = row_is_separator (tree_view, iter, NULL);
 
   gtk_widget_style_get (GTK_WIDGET (tree_view),
@@ -6776,6 +6797,7 @@ do_validate_rows (GtkTreeView *tree_view, gboolean queue_resize)
   GtkTreePath *path = NULL;
   GtkTreeIter iter;
   GTimer *timer;
+  gdouble budget;
   gint i = 0;
 
   gint y = -1;
@@ -6795,10 +6817,31 @@ do_validate_rows (GtkTreeView *tree_view, gboolean queue_resize)
     {
       if (tree_view->priv->fixed_height < 0)
         initialize_fixed_height_mode (tree_view);
+      else
+        /* Column changes re-flag rows as dirty, but with constant row
+         * geometry revalidation is pure arithmetic.
+         */
+        _gtk_rbtree_set_fixed_height (tree_view->priv->tree,
+                                      tree_view->priv->fixed_height, TRUE);
 
       return FALSE;
     }
 
+  /* Keep each validation slice within a frame's budget while the
+   * widget is on screen. The idle runs below redraw priority, but a
+   * slice that starts between two frames and runs for the full idle
+   * budget still pushes the next frame out, which is what makes
+   * scrollbars stutter while a large model is measured. Rows in and
+   * around the viewport are handled separately by
+   * validate_visible_area() on every frame, so the background scan
+   * can afford to go slowly. Unmapped widgets take bigger slices to
+   * finish sooner.
+   */
+  if (gtk_widget_get_mapped (GTK_WIDGET (tree_view)))
+    budget = GTK_TREE_VIEW_TIME_MS_PER_FRAME / 1000.;
+  else
+    budget = GTK_TREE_VIEW_TIME_MS_PER_IDLE / 1000.;
+
   timer = g_timer_new ();
   g_timer_start (timer);
 
@@ -6889,7 +6932,7 @@ do_validate_rows (GtkTreeView *tree_view, gboolean queue_resize)
 
       i++;
     }
-  while (g_timer_elapsed (timer, NULL) < GTK_TREE_VIEW_TIME_MS_PER_IDLE / 1000.);
+  while (g_timer_elapsed (timer, NULL) < budget);
 
   if (!tree_view->priv->fixed_height_check)
    {
@@ -14784,6 +14827,215 @@ G_GNUC_END_IGNORE_DEPRECATIONS
   return surface;
 }
 
+/* Renders a single row at the current origin of @cr, mirroring the
+ * cell setup done in gtk_tree_view_bin_draw() and
+ * gtk_tree_view_create_row_drag_icon() but without touching any
+ * window.
+ */
+static void
+gtk_tree_view_render_row (GtkTreeView *tree_view,
+                          cairo_t     *cr,
+                          GtkRBTree   *tree,
+                          GtkRBNode   *node,
+                          GtkTreeIter *iter,
+                          gint         depth)
+{
+  GtkWidget *widget = GTK_WIDGET (tree_view);
+  GtkStyleContext *context;
+  GdkRectangle background_area;
+  GList *list;
+  gint cell_offset = 0;
+  gint width;
+  gboolean is_separator;
+  gboolean rtl, allow_rules;
+
+  context = gtk_widget_get_style_context (widget);
+
+  gtk_style_context_save (context);
+G_GNUC_BEGIN_IGNORE_DEPRECATIONS
+  gtk_style_context_add_region (context, GTK_STYLE_REGION_COLUMN, 0);
+G_GNUC_END_IGNORE_DEPRECATIONS
+
+  gtk_widget_style_get (widget,
+			"allow-rules", &allow_rules,
+			NULL);
+
+  if (allow_rules && tree_view->priv->has_rules)
+    {
+      GtkRegionFlags row_flags;
+
+      if ((_gtk_rbtree_node_get_index (tree, node) % 2))
+        row_flags = GTK_REGION_ODD;
+      else
+        row_flags = GTK_REGION_EVEN;
+
+G_GNUC_BEGIN_IGNORE_DEPRECATIONS
+      gtk_style_context_add_region (context, GTK_STYLE_REGION_ROW, row_flags);
+G_GNUC_END_IGNORE_DEPRECATIONS
+    }
+
+  is_separator = row_is_separator (tree_view, iter, NULL);
+
+  width = tree_view->priv->width;
+
+  background_area.y = 0;
+  background_area.height = gtk_tree_view_get_row_height (tree_view, node);
+
+  gtk_render_background (context, cr, 0, 0,
+                         width, background_area.height);
+
+  rtl = gtk_widget_get_direction (widget) == GTK_TEXT_DIR_RTL;
+
+  for (list = (rtl ? g_list_last (tree_view->priv->columns) : g_list_first (tree_view->priv->columns));
+      list;
+      list = (rtl ? list->prev : list->next))
+    {
+      GtkTreeViewColumn *column = list->data;
+      GdkRectangle cell_area;
+      gint vertical_separator;
+
+      if (!gtk_tree_view_column_get_visible (column))
+        continue;
+
+      gtk_tree_view_column_cell_set_cell_data (column, tree_view->priv->model, iter,
+					       GTK_RBNODE_FLAG_SET (node, GTK_RBNODE_IS_PARENT),
+					       node->children?TRUE:FALSE);
+
+      background_area.x = cell_offset;
+      background_area.width = gtk_tree_view_column_get_width (column);
+
+      gtk_widget_style_get (widget,
+			    "vertical-separator", &vertical_separator,
+			    NULL);
+
+      cell_area = background_area;
+
+      cell_area.y += vertical_separator / 2;
+      cell_area.height -= vertical_separator;
+
+      if (gtk_tree_view_is_expander_column (tree_view, column))
+        {
+	  if (!rtl)
+	    cell_area.x += (depth - 1) * tree_view->priv->level_indentation;
+	  cell_area.width -= (depth - 1) * tree_view->priv->level_indentation;
+
+          if (gtk_tree_view_draw_expanders (tree_view))
+	    {
+              int expander_size = gtk_tree_view_get_expander_size (tree_view);
+	      if (!rtl)
+		cell_area.x += depth * expander_size;
+	      cell_area.width -= depth * expander_size;
+	    }
+        }
+
+      if (gtk_tree_view_column_cell_is_visible (column))
+	{
+	  if (is_separator)
+            {
+              gtk_style_context_save (context);
+              gtk_style_context_add_class (context, GTK_STYLE_CLASS_SEPARATOR);
+
+              gtk_render_line (context, cr,
+                               cell_area.x,
+                               cell_area.y + cell_area.height / 2,
+                               cell_area.x + cell_area.width,
+                               cell_area.y + cell_area.height / 2);
+
+              gtk_style_context_restore (context);
+            }
+	  else
+            {
+              _gtk_tree_view_column_cell_render (column,
+                                                 cr,
+                                                 &background_area,
+                                                 &cell_area,
+                                                 0, FALSE);
+            }
+	}
+      cell_offset += gtk_tree_view_column_get_width (column);
+    }
+
+  gtk_style_context_restore (context);
+}
+
+/**
+ * gtk_tree_view_render_row_range:
+ * @tree_view: a #GtkTreeView
+ * @cr: the cairo context to render to
+ * @start_path: path of the first row to render
+ * @end_path: (allow-none): path of the last row to render, or %NULL
+ *     to render through the last row of the model
+ *
+ * Renders the given range of rows to @cr, one below the other starting
+ * at the current origin, without requiring the rows to be scrolled on
+ * screen. Rows inside collapsed parents are skipped, just as they are
+ * when drawing the widget. Rows that have not been validated yet are
+ * validated on the fly, so arbitrary ranges of a large model can be
+ * exported to a PDF or print surface without going through the
+ * viewport.
+ *
+ * The tree view must be realized, since the rendering uses the
+ * widget's style and column widths.
+ *
+ * Since: 3.18
+ **/
+void
+gtk_tree_view_render_row_range (GtkTreeView *tree_view,
+                                cairo_t     *cr,
+                                GtkTreePath *start_path,
+                                GtkTreePath *end_path)
+{
+  GtkRBTree *tree, *end_tree = NULL;
+  GtkRBNode *node, *end_node = NULL;
+  gint y = 0;
+
+  g_return_if_fail (GTK_IS_TREE_VIEW (tree_view));
+  g_return_if_fail (cr != NULL);
+  g_return_if_fail (start_path != NULL);
+  g_return_if_fail (tree_view->priv->model != NULL);
+  g_return_if_fail (gtk_widget_get_realized (GTK_WIDGET (tree_view)));
+
+  _gtk_tree_view_find_node (tree_view, start_path, &tree, &node);
+  if (tree == NULL)
+    return;
+
+  if (end_path)
+    _gtk_tree_view_find_node (tree_view, end_path, &end_tree, &end_node);
+
+  while (node != NULL)
+    {
+      GtkTreePath *path;
+      GtkTreeIter iter;
+
+      path = _gtk_tree_path_new_from_rbtree (tree, node);
+
+      if (!gtk_tree_model_get_iter (tree_view->priv->model, &iter, path))
+        {
+          gtk_tree_path_free (path);
+          break;
+        }
+
+      if (GTK_RBNODE_FLAG_SET (node, GTK_RBNODE_INVALID) ||
+          GTK_RBNODE_FLAG_SET (node, GTK_RBNODE_COLUMN_INVALID))
+        validate_row (tree_view, tree, node, &iter, path);
+
+      cairo_save (cr);
+      cairo_translate (cr, 0, y);
+      gtk_tree_view_render_row (tree_view, cr, tree, node, &iter,
+                                gtk_tree_path_get_depth (path));
+      cairo_restore (cr);
+
+      y += gtk_tree_view_get_row_height (tree_view, node);
+
+      gtk_tree_path_free (path);
+
+      if (tree == end_tree && node == end_node)
+        break;
+
+      _gtk_rbtree_next_full (tree, node, &tree, &node);
+    }
+}
+
 
 /**
  * gtk_tree_view_set_destroy_count_func:
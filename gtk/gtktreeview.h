@@ -430,6 +430,11 @@ gboolean               gtk_tree_view_get_dest_row_at_pos           (GtkTreeView
 								    gint                       drag_y,
 								    GtkTreePath              **path,
 								    GtkTreeViewDropPosition   *pos);
+GDK_AVAILABLE_IN_3_18
+void                   gtk_tree_view_render_row_range              (GtkTreeView               *tree_view,
+								    cairo_t                   *cr,
+								    GtkTreePath               *start_path,
+								    GtkTreePath               *end_path);
 GDK_AVAILABLE_IN_ALL
 cairo_surface_t       *gtk_tree_view_create_row_drag_icon          (GtkTreeView               *tree_view,
 								    GtkTreePath               *path);
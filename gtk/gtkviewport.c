@@ -26,12 +26,15 @@
 
 #include "gtkviewport.h"
 
+#include <math.h>
+
 #include "gtkadjustment.h"
 #include "gtkintl.h"
 #include "gtkmarshalers.h"
 #include "gtkpixelcacheprivate.h"
 #include "gtkprivate.h"
 #include "gtkscrollable.h"
+#include "gtkscrolledwindowprivate.h"
 #include "gtkrender.h"
 #include "gtktypebuiltins.h"
 #include "gtkwidgetprivate.h"
@@ -851,6 +854,7 @@ gtk_viewport_draw (GtkWidget *widget,
   GtkViewport *viewport = GTK_VIEWPORT (widget);
   GtkViewportPrivate *priv = viewport->priv;
   GtkStyleContext *context;
+  GtkWidget *parent;
 
   context = gtk_widget_get_style_context (widget);
 
@@ -877,6 +881,21 @@ gtk_viewport_draw (GtkWidget *widget,
       canvas_rect.width = gdk_window_get_width (priv->bin_window);
       canvas_rect.height = gdk_window_get_height (priv->bin_window);
 
+      /* When flinging inside a scrolled window, cache ahead of the
+       * scroll so fast flings don't expose unrendered content;
+       * (0, 0) falls back to the default margin.
+       */
+      parent = gtk_widget_get_parent (widget);
+      if (GTK_IS_SCROLLED_WINDOW (parent))
+        {
+          guint extra_width, extra_height;
+
+          _gtk_scrolled_window_get_prerender_extra (GTK_SCROLLED_WINDOW (parent),
+                                                    &extra_width, &extra_height);
+          _gtk_pixel_cache_set_extra_size (priv->pixel_cache,
+                                           extra_width, extra_height);
+        }
+
       _gtk_pixel_cache_draw (priv->pixel_cache, cr, priv->bin_window,
 			     &view_rect, &canvas_rect,
 			     draw_bin, widget);
@@ -988,8 +1007,14 @@ gtk_viewport_adjustment_value_changed (GtkAdjustment *adjustment,
       gint new_x, new_y;
 
       gdk_window_get_position (priv->bin_window, &old_x, &old_y);
-      new_x = - gtk_adjustment_get_value (hadjustment);
-      new_y = - gtk_adjustment_get_value (vadjustment);
+
+      /* The adjustments carry sub-pixel positions (e.g. from kinetic
+       * deceleration); snap to the nearest pixel only here, at the
+       * window move, rather than letting the double-to-int conversion
+       * truncate.
+       */
+      new_x = - round (gtk_adjustment_get_value (hadjustment));
+      new_y = - round (gtk_adjustment_get_value (vadjustment));
 
       if (new_x != old_x || new_y != old_y)
 	gdk_window_move (priv->bin_window, new_x, new_y);
@@ -45,6 +45,7 @@
 #include "gtkselectionprivate.h"
 #include "gtksettingsprivate.h"
 #include "gtksizegroup-private.h"
+#include "gtklayoutstatsprivate.h"
 #include "gtkwidget.h"
 #include "gtkwidgetprivate.h"
 #include "gtkwindowprivate.h"
@@ -4584,6 +4585,8 @@ gtk_widget_unparent (GtkWidget *widget)
   old_parent = priv->parent;
   priv->parent = NULL;
 
+  _gtk_main_invalidate_event_target_cache ();
+
   /* parent may no longer expand if the removed
    * child was expand=TRUE and could therefore
    * be forcing it to.
@@ -5871,6 +5874,24 @@ gtk_widget_size_allocate_with_baseline (GtkWidget     *widget,
        !_gtk_widget_has_baseline_support (widget)))
     baseline = -1;
 
+  /* A child that has not queued a resize and is handed the same
+   * allocation as last time has nothing to do: its measured sizes,
+   * margins and alignment can only change together with a
+   * queue_resize, which sets alloc_needed. Skipping here spares the
+   * adjustment machinery and the measurement below, so a container
+   * pass only descends into the children that actually changed.
+   */
+  if (!priv->alloc_needed &&
+      baseline == priv->allocated_size_baseline &&
+      priv->allocated_size.x == allocation->x &&
+      priv->allocated_size.y == allocation->y &&
+      priv->allocated_size.width == allocation->width &&
+      priv->allocated_size.height == allocation->height)
+    goto out;
+
+  priv->allocated_size = *allocation;
+  priv->allocated_size_baseline = baseline;
+
   alloc_needed = priv->alloc_needed;
   /* Preserve request/allocate ordering */
   priv->alloc_needed = FALSE;
@@ -5969,6 +5990,9 @@ gtk_widget_size_allocate_with_baseline (GtkWidget     *widget,
     goto out;
 
   priv->allocated_baseline = baseline;
+
+  _gtk_layout_stats_count_allocate (widget);
+
   g_signal_emit (widget, widget_signals[SIZE_ALLOCATE], 0, &real_allocation);
 
   /* Size allocation is god... after consulting god, no further requests or allocations are needed */
@@ -9407,6 +9431,8 @@ gtk_widget_set_parent (GtkWidget *widget,
 
   priv->parent = parent;
 
+  _gtk_main_invalidate_event_target_cache ();
+
   parent_flags = gtk_widget_get_state_flags (parent);
 
   /* Merge both old state and current parent state,
@@ -16404,12 +16430,34 @@ _gtk_widget_create_path (GtkWidget *widget)
 GtkWidgetPath *
 gtk_widget_get_path (GtkWidget *widget)
 {
+  GtkWidgetPrivate *priv;
+
   g_return_val_if_fail (GTK_IS_WIDGET (widget), NULL);
 
-  if (!widget->priv->path)
-    widget->priv->path = _gtk_widget_create_path (widget);
+  priv = widget->priv;
 
-  return widget->priv->path;
+  /* A widget's cached path embeds the paths of all its ancestors, so
+   * it is only current as long as the parent's path is.  Bring the
+   * parent's path up to date first, then compare the serial it had
+   * when our path was built; when nothing changed up the chain this
+   * is one cached lookup and one comparison per ancestor.
+   */
+  if (priv->path && priv->parent)
+    {
+      gtk_widget_get_path (priv->parent);
+
+      if (priv->parent_path_serial != priv->parent->priv->path_serial)
+        gtk_widget_clear_path (widget);
+    }
+
+  if (!priv->path)
+    {
+      priv->path = _gtk_widget_create_path (widget);
+      if (priv->parent)
+        priv->parent_path_serial = priv->parent->priv->path_serial;
+    }
+
+  return priv->path;
 }
 
 void
@@ -16419,6 +16467,7 @@ gtk_widget_clear_path (GtkWidget *widget)
     {
       gtk_widget_path_free (widget->priv->path);
       widget->priv->path = NULL;
+      widget->priv->path_serial++;
     }
 }
 
@@ -16884,6 +16933,11 @@ gtk_widget_init_template (GtkWidget *widget)
  * This should be called at class initialization time to specify
  * the GtkBuilder XML to be used to extend a widget.
  *
+ * Since 3.18, @template_bytes may also hold a compiled template as
+ * produced by `gtk-builder-tool compile`. Precompiling templates at
+ * build time avoids parsing XML when the first instance of the class
+ * is created.
+ *
  * For convenience, gtk_widget_class_set_template_from_resource() is also provided.
  *
  * Note that any class that installs templates must call gtk_widget_init_template()
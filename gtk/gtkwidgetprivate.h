@@ -111,14 +111,23 @@ struct _GtkWidgetPrivate
   GtkCssNode *cssnode;
   GtkStyleContext *context;
 
-  /* Widget's path for styling */
+  /* Widget's path for styling, with generation counters to detect
+   * when an ancestor's cached path has been rebuilt under us */
   GtkWidgetPath *path;
+  guint path_serial;
+  guint parent_path_serial;
 
   /* The widget's allocated size */
   GtkAllocation allocation;
   gint allocated_baseline;
   GtkAllocation clip;
 
+  /* The allocation the parent handed in, before adjustments; used to
+   * skip re-allocation when the parent hands in the same one again.
+   */
+  GtkAllocation allocated_size;
+  gint allocated_size_baseline;
+
   /* The widget's requested sizes */
   SizeRequestCache requests;
 
@@ -464,12 +464,32 @@ follow_links (const gchar *path)
   return path2;
 }
 
+/* Parses the nominal icon size from a theme subdirectory name such
+ * as "16x16/apps", so that scalable images can be rasterized at the
+ * size the directory advertises. Returns -1 if the directory has no
+ * size in its name (e.g. "scalable").
+ */
+static gint
+theme_dir_size (const gchar *subdir)
+{
+  gint width, height;
+
+  if (subdir != NULL &&
+      sscanf (subdir, "%dx%d", &width, &height) == 2 &&
+      width == height && width > 0)
+    return width;
+
+  return -1;
+}
+
 static void
 maybe_cache_image_data (Image       *image,
-			const gchar *path)
+			const gchar *path,
+			gint         size)
 {
   if (!index_only && !image->image_data &&
-      (g_str_has_suffix (path, ".png") || g_str_has_suffix (path, ".xpm")))
+      (g_str_has_suffix (path, ".png") || g_str_has_suffix (path, ".xpm") ||
+       g_str_has_suffix (path, ".svg")))
     {
       GdkPixbuf *pixbuf;
       ImageData *idata;
@@ -510,7 +530,14 @@ maybe_cache_image_data (Image       *image,
 
       if (!idata->has_pixdata)
 	{
-	  pixbuf = gdk_pixbuf_new_from_file (path, NULL);
+	  /* Rasterize scalable images at the directory's nominal size,
+	   * so that processes mapping the cache share the pixel data
+	   * instead of each decoding the image themselves.
+	   */
+	  if (g_str_has_suffix (path, ".svg") && size > 0)
+	    pixbuf = gdk_pixbuf_new_from_file_at_size (path, size, size, NULL);
+	  else
+	    pixbuf = gdk_pixbuf_new_from_file (path, NULL);
 
 	  if (pixbuf)
 	    {
@@ -686,7 +713,7 @@ scan_directory (const gchar *base_path,
 
 	  image->flags |= flags;
 
-	  maybe_cache_image_data (image, path);
+	  maybe_cache_image_data (image, path, theme_dir_size (subdir));
           maybe_cache_icon_data (image, path);
 
 	  g_free (basename);
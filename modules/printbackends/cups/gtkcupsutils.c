@@ -124,6 +124,74 @@ gtk_cups_result_set_error (GtkCupsResult    *result,
   va_end (args);
 }
 
+/* Pool of idle connections to recently used servers, so back-to-back
+ * requests - the print dialog polls continuously - reuse one
+ * keep-alive connection instead of reconnecting every time. Requests
+ * are dispatched from the main loop only, so no locking is needed.
+ */
+#define GTK_CUPS_CONNECTION_POOL_SIZE 4
+/* cupsd drops keep-alive connections after 30 seconds by default;
+ * don't hand out connections approaching that age.
+ */
+#define GTK_CUPS_CONNECTION_POOL_MAX_IDLE (25 * G_USEC_PER_SEC)
+
+typedef struct
+{
+  http_t *http;
+  gchar *server;
+  gint64 parked;
+} GtkCupsPooledConnection;
+
+static GSList *connection_pool = NULL;
+
+static http_t *
+connection_pool_take (const gchar *server)
+{
+  gint64 now = g_get_monotonic_time ();
+  http_t *http = NULL;
+  GSList *list, *next;
+
+  for (list = connection_pool; list != NULL; list = next)
+    {
+      GtkCupsPooledConnection *conn = list->data;
+
+      next = list->next;
+
+      if (now - conn->parked > GTK_CUPS_CONNECTION_POOL_MAX_IDLE)
+        httpClose (conn->http);
+      else if (http == NULL && strcmp (conn->server, server) == 0)
+        http = conn->http;
+      else
+        continue;
+
+      connection_pool = g_slist_delete_link (connection_pool, list);
+      g_free (conn->server);
+      g_free (conn);
+    }
+
+  return http;
+}
+
+static void
+connection_pool_park (http_t      *http,
+                      const gchar *server)
+{
+  GtkCupsPooledConnection *conn;
+
+  if (g_slist_length (connection_pool) >= GTK_CUPS_CONNECTION_POOL_SIZE)
+    {
+      httpClose (http);
+      return;
+    }
+
+  conn = g_new (GtkCupsPooledConnection, 1);
+  conn->http = http;
+  conn->server = g_strdup (server);
+  conn->parked = g_get_monotonic_time ();
+
+  connection_pool = g_slist_prepend (connection_pool, conn);
+}
+
 GtkCupsRequest *
 gtk_cups_request_new_with_username (http_t             *connection,
                                     GtkCupsRequestType  req_type, 
@@ -168,14 +236,18 @@ gtk_cups_request_new_with_username (http_t             *connection,
     }
   else
     {
-      request->http = NULL;
-      request->http = httpConnectEncrypt (request->server, 
-                                          ippPort (), 
-                                          cupsEncryption ());
+      request->http = connection_pool_take (request->server);
+
+      if (request->http == NULL)
+        {
+          request->http = httpConnectEncrypt (request->server, 
+                                              ippPort (), 
+                                              cupsEncryption ());
+
+          if (request->http)
+            httpBlocking (request->http, 0);
+        }
 
-      if (request->http)
-        httpBlocking (request->http, 0);
-        
       request->own_http = TRUE;
     }
 
@@ -250,7 +322,16 @@ gtk_cups_request_free (GtkCupsRequest *request)
   if (request->own_http)
     {
       if (request->http)
-        httpClose (request->http);
+        {
+          /* Only connections that completed a whole transaction are
+           * safe to reuse; anything else may have data in flight.
+           */
+          if (request->state == GTK_CUPS_REQUEST_DONE &&
+              !gtk_cups_result_is_error (request->result))
+            connection_pool_park (request->http, request->server);
+          else
+            httpClose (request->http);
+        }
     }
   
   if (request->ipp_request)
@@ -71,6 +71,12 @@ typedef struct _GtkPrintBackendCupsClass GtkPrintBackendCupsClass;
 #define _CUPS_MAX_ATTEMPTS 10
 #define _CUPS_MAX_CHUNK_SIZE 8192
 
+/* Steady-state printer list poll: start fast, back off exponentially
+ * while nothing changes, snap back on any change.
+ */
+#define _CUPS_POLL_INTERVAL_MIN 200
+#define _CUPS_POLL_INTERVAL_MAX 3200
+
 #ifdef HAVE_CUPS_API_1_6
 #define AVAHI_IF_UNSPEC -1
 #define AVAHI_PROTO_INET 0
@@ -133,6 +139,7 @@ struct _GtkPrintBackendCups
   guint list_printers_poll;
   guint list_printers_pending : 1;
   gint  list_printers_attempts;
+  guint list_printers_interval;
   guint got_default_printer   : 1;
   guint default_printer_poll;
   GtkCupsConnectionTest *cups_connection_test;
@@ -202,6 +209,7 @@ static void                 cups_begin_polling_info                (GtkPrintBack
 								    GtkPrintJob                       *job,
 								    int                                job_id);
 static gboolean             cups_job_info_poll_timeout             (gpointer                           user_data);
+static gboolean             cups_request_printer_list              (GtkPrintBackendCups               *cups_backend);
 static void                 gtk_print_backend_cups_print_stream    (GtkPrintBackend                   *backend,
 								    GtkPrintJob                       *job,
 								    GIOChannel                        *data_io,
@@ -818,6 +826,7 @@ gtk_print_backend_cups_init (GtkPrintBackendCups *backend_cups)
   backend_cups->got_default_printer = FALSE;
   backend_cups->list_printers_pending = FALSE;
   backend_cups->list_printers_attempts = 0;
+  backend_cups->list_printers_interval = _CUPS_POLL_INTERVAL_MIN;
   backend_cups->reading_ppds = 0;
 
   backend_cups->requests = NULL;
@@ -3316,6 +3325,29 @@ avahi_request_printer_list (GtkPrintBackendCups *cups_backend)
 }
 #endif
 
+static void
+cups_printer_list_set_poll_interval (GtkPrintBackendCups *cups_backend,
+                                     guint                interval)
+{
+  if (interval == cups_backend->list_printers_interval)
+    return;
+
+  cups_backend->list_printers_interval = interval;
+
+  /* Only re-arm the steady-state poll; during startup the attempt
+   * counter drives the schedule.
+   */
+  if (cups_backend->list_printers_poll > 0 &&
+      cups_backend->list_printers_attempts == -1)
+    {
+      g_source_remove (cups_backend->list_printers_poll);
+      cups_backend->list_printers_poll = gdk_threads_add_timeout (interval,
+                                           (GSourceFunc) cups_request_printer_list,
+                                           cups_backend);
+      g_source_set_name_by_id (cups_backend->list_printers_poll, "[gtk+] cups_request_printer_list");
+    }
+}
+
 static void
 cups_request_printer_list_cb (GtkPrintBackendCups *cups_backend,
                               GtkCupsResult       *result,
@@ -3325,6 +3357,7 @@ cups_request_printer_list_cb (GtkPrintBackendCups *cups_backend,
   ipp_attribute_t *attr;
   ipp_t *response;
   gboolean list_has_changed;
+  gboolean any_status_changed;
   GList *removed_printer_checklist;
   gchar *remote_default_printer = NULL;
   GList *iter;
@@ -3332,6 +3365,7 @@ cups_request_printer_list_cb (GtkPrintBackendCups *cups_backend,
   gdk_threads_enter ();
 
   list_has_changed = FALSE;
+  any_status_changed = FALSE;
 
   GTK_NOTE (PRINTING,
             g_print ("CUPS Backend: %s\n", G_STRFUNC));
@@ -3496,6 +3530,8 @@ cups_request_printer_list_cb (GtkPrintBackendCups *cups_backend,
 
       set_printer_icon_name_from_info (printer, info);
 
+      any_status_changed |= status_changed;
+
       if (status_changed)
         g_signal_emit_by_name (GTK_PRINT_BACKEND (backend),
                                "printer-status-changed", printer);
@@ -3530,6 +3566,13 @@ done:
   if (list_has_changed)
     g_signal_emit_by_name (backend, "printer-list-changed");
 
+  if (list_has_changed || any_status_changed)
+    cups_printer_list_set_poll_interval (cups_backend, _CUPS_POLL_INTERVAL_MIN);
+  else
+    cups_printer_list_set_poll_interval (cups_backend,
+                                         MIN (2 * cups_backend->list_printers_interval,
+                                              _CUPS_POLL_INTERVAL_MAX));
+
   gtk_print_backend_set_list_done (backend);
 
   if (!cups_backend->got_default_printer && remote_default_printer != NULL)
@@ -3581,7 +3624,7 @@ cups_request_printer_list (GtkPrintBackendCups *cups_backend)
       cups_backend->list_printers_attempts = -1;
       if (cups_backend->list_printers_poll > 0)
         g_source_remove (cups_backend->list_printers_poll);
-      cups_backend->list_printers_poll = gdk_threads_add_timeout (200,
+      cups_backend->list_printers_poll = gdk_threads_add_timeout (cups_backend->list_printers_interval,
                                            (GSourceFunc) cups_request_printer_list,
                                            cups_backend);
       g_source_set_name_by_id (cups_backend->list_printers_poll, "[gtk+] cups_request_printer_list");
@@ -331,6 +331,57 @@ _cairo_write (void                *closure,
 }
 
 
+static const cairo_user_data_key_t direct_io_key;
+
+static void
+direct_io_destroy (gpointer data)
+{
+  GIOChannel *io = (GIOChannel *)data;
+
+  g_io_channel_shutdown (io, FALSE, NULL);
+  g_io_channel_unref (io);
+}
+
+/* Tries to open the destination file for writing right away, so the
+ * surface streams into it as pages are rendered instead of spooling
+ * everything to a temp file first and copying it over afterwards.
+ * Returns NULL when the destination is not a plain local file; the
+ * spool-and-copy path handles those.
+ */
+static GIOChannel *
+open_direct_io (GtkPrintSettings *settings)
+{
+  GIOChannel *io = NULL;
+  gchar *uri, *path;
+
+  uri = output_file_from_settings (settings, NULL);
+  if (uri == NULL)
+    return NULL;
+
+  path = g_filename_from_uri (uri, NULL, NULL);
+  g_free (uri);
+  if (path == NULL)
+    return NULL;
+
+  io = g_io_channel_new_file (path, "w", NULL);
+  g_free (path);
+  if (io == NULL)
+    return NULL;
+
+  if (g_io_channel_set_encoding (io, NULL, NULL) != G_IO_STATUS_NORMAL)
+    {
+      g_io_channel_unref (io);
+      return NULL;
+    }
+
+  /* Writes must reach the file before the job completion callback
+   * runs, which happens before the surface is destroyed.
+   */
+  g_io_channel_set_buffered (io, FALSE);
+
+  return io;
+}
+
 static cairo_surface_t *
 file_printer_create_cairo_surface (GtkPrinter       *printer,
 				   GtkPrintSettings *settings,
@@ -341,10 +392,15 @@ file_printer_create_cairo_surface (GtkPrinter       *printer,
   cairo_surface_t *surface;
   OutputFormat format;
   const cairo_svg_version_t *versions;
+  GIOChannel *direct_io;
   int num_versions = 0;
 
   format = format_from_settings (settings);
 
+  direct_io = open_direct_io (settings);
+  if (direct_io != NULL)
+    cache_io = direct_io;
+
   switch (format)
     {
       default:
@@ -366,6 +422,17 @@ file_printer_create_cairo_surface (GtkPrinter       *printer,
                                          2.0 * gtk_print_settings_get_printer_lpi (settings),
                                          2.0 * gtk_print_settings_get_printer_lpi (settings));
 
+  if (direct_io != NULL)
+    {
+      /* The channel lives as long as the surface; print_stream sees
+       * the marker on the settings and skips the spool copy.
+       */
+      cairo_surface_set_user_data (surface, &direct_io_key,
+				   direct_io, direct_io_destroy);
+      g_object_set_data (G_OBJECT (settings), "gtk-file-backend-direct-io",
+			 GINT_TO_POINTER (TRUE));
+    }
+
   return surface;
 }
 
@@ -501,6 +568,16 @@ gtk_print_backend_file_print_stream (GtkPrintBackend        *print_backend,
   ps->backend = print_backend;
 
   internal_error = NULL;
+
+  /* When the surface streamed straight into the destination file,
+   * the spool channel holds nothing worth copying.
+   */
+  if (g_object_get_data (G_OBJECT (settings), "gtk-file-backend-direct-io"))
+    {
+      file_print_cb_locked (GTK_PRINT_BACKEND_FILE (print_backend), NULL, ps);
+      return;
+    }
+
   uri = output_file_from_settings (settings, NULL);
 
   if (uri == NULL)
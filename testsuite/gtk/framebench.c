@@ -0,0 +1,321 @@
+/* framebench.c: frame-time benchmark over common interaction scenarios
+ * Copyright (C) 2015 Red Hat, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/* This is not a pass/fail test but a measurement harness: it builds a
+ * widget tree resembling the widget-factory demo, drives a handful of
+ * scenarios (scrolling, notebook flips, window resizes, theme switches)
+ * from the frame clock and reports frame-time percentiles per scenario,
+ * so frame-budget regressions between releases show up as numbers
+ * instead of anecdotes.
+ */
+
+#include <gtk/gtk.h>
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define WARMUP_FRAMES   30
+#define SCENARIO_FRAMES 240
+
+typedef struct {
+  const char *name;
+  void (* step) (guint frame);
+} Scenario;
+
+static GtkWidget *window;
+static GtkWidget *notebook;
+static GtkAdjustment *scroll_adjustment;
+
+static gint64 frame_times[SCENARIO_FRAMES];
+static guint n_frame_times;
+static gint64 last_frame_time;
+static guint current_scenario;
+static guint current_frame;
+
+/* scenarios {{{1 */
+
+static void
+scenario_scroll (guint frame)
+{
+  gdouble upper, page, value;
+
+  upper = gtk_adjustment_get_upper (scroll_adjustment);
+  page = gtk_adjustment_get_page_size (scroll_adjustment);
+  value = fmod (frame * 25.0, MAX (upper - page, 1.0));
+
+  gtk_adjustment_set_value (scroll_adjustment, value);
+}
+
+static void
+scenario_notebook (guint frame)
+{
+  gint n_pages;
+
+  if (frame % 5 != 0)
+    return;
+
+  n_pages = gtk_notebook_get_n_pages (GTK_NOTEBOOK (notebook));
+  gtk_notebook_set_current_page (GTK_NOTEBOOK (notebook),
+                                 (frame / 5) % n_pages);
+}
+
+static void
+scenario_resize (guint frame)
+{
+  gint delta = ABS ((gint) (frame % 120) - 60);
+
+  gtk_window_resize (GTK_WINDOW (window), 640 + 2 * delta, 480 + delta);
+}
+
+static void
+scenario_theme (guint frame)
+{
+  if (frame % 30 != 0)
+    return;
+
+  g_object_set (gtk_settings_get_default (),
+                "gtk-application-prefer-dark-theme", (frame / 30) % 2 == 1,
+                NULL);
+}
+
+static const Scenario scenarios[] = {
+  { "scroll",   scenario_scroll },
+  { "notebook", scenario_notebook },
+  { "resize",   scenario_resize },
+  { "theme",    scenario_theme }
+};
+
+/* measurement {{{1 */
+
+static int
+compare_frame_times (gconstpointer a,
+                     gconstpointer b)
+{
+  const gint64 *ta = a;
+  const gint64 *tb = b;
+
+  if (*ta < *tb)
+    return -1;
+  else if (*ta > *tb)
+    return 1;
+  return 0;
+}
+
+static gdouble
+percentile_ms (guint p)
+{
+  guint idx = MIN (n_frame_times * p / 100, n_frame_times - 1);
+
+  return frame_times[idx] / 1000.0;
+}
+
+static void
+report_scenario (const Scenario *scenario)
+{
+  if (n_frame_times == 0)
+    return;
+
+  qsort (frame_times, n_frame_times, sizeof (gint64), compare_frame_times);
+
+  g_print ("%-10s frames %3u  p50 %6.2f ms  p90 %6.2f ms  p99 %6.2f ms\n",
+           scenario->name, n_frame_times,
+           percentile_ms (50), percentile_ms (90), percentile_ms (99));
+}
+
+static gboolean
+tick_callback (GtkWidget     *widget,
+               GdkFrameClock *frame_clock,
+               gpointer       user_data)
+{
+  gint64 frame_time = gdk_frame_clock_get_frame_time (frame_clock);
+
+  if (current_frame >= WARMUP_FRAMES &&
+      last_frame_time != 0 &&
+      n_frame_times < SCENARIO_FRAMES)
+    frame_times[n_frame_times++] = frame_time - last_frame_time;
+
+  last_frame_time = frame_time;
+
+  scenarios[current_scenario].step (current_frame);
+  current_frame++;
+
+  if (current_frame >= WARMUP_FRAMES + SCENARIO_FRAMES)
+    {
+      report_scenario (&scenarios[current_scenario]);
+
+      current_scenario++;
+      current_frame = 0;
+      n_frame_times = 0;
+      last_frame_time = 0;
+
+      if (current_scenario >= G_N_ELEMENTS (scenarios))
+        {
+          gtk_main_quit ();
+          return G_SOURCE_REMOVE;
+        }
+    }
+
+  gtk_widget_queue_draw (widget);
+
+  return G_SOURCE_CONTINUE;
+}
+
+/* widget tree {{{1 */
+
+static GtkWidget *
+create_controls_page (void)
+{
+  GtkWidget *grid;
+  guint i;
+
+  grid = gtk_grid_new ();
+  g_object_set (grid,
+                "margin", 10,
+                "row-spacing", 6,
+                "column-spacing", 6,
+                NULL);
+
+  for (i = 0; i < 12; i++)
+    {
+      GtkWidget *widget;
+
+      switch (i % 6)
+        {
+        case 0:
+          widget = gtk_button_new_with_label ("Button");
+          break;
+        case 1:
+          widget = gtk_check_button_new_with_label ("Check Button");
+          break;
+        case 2:
+          widget = gtk_entry_new ();
+          gtk_entry_set_text (GTK_ENTRY (widget), "entry");
+          break;
+        case 3:
+          widget = gtk_spin_button_new_with_range (0, 100, 1);
+          break;
+        case 4:
+          widget = gtk_switch_new ();
+          break;
+        default:
+          widget = gtk_scale_new_with_range (GTK_ORIENTATION_HORIZONTAL,
+                                             0, 100, 1);
+          gtk_widget_set_hexpand (widget, TRUE);
+          break;
+        }
+
+      gtk_grid_attach (GTK_GRID (grid), widget, i % 3, i / 3, 1, 1);
+    }
+
+  return grid;
+}
+
+static GtkWidget *
+create_list_page (void)
+{
+  GtkWidget *scrolled;
+  GtkWidget *list;
+  guint i;
+
+  list = gtk_list_box_new ();
+
+  for (i = 0; i < 200; i++)
+    {
+      gchar *text = g_strdup_printf ("List row %u", i);
+
+      gtk_container_add (GTK_CONTAINER (list),
+                         gtk_label_new (text));
+      g_free (text);
+    }
+
+  scrolled = gtk_scrolled_window_new (NULL, NULL);
+  gtk_container_add (GTK_CONTAINER (scrolled), list);
+
+  scroll_adjustment =
+    gtk_scrolled_window_get_vadjustment (GTK_SCROLLED_WINDOW (scrolled));
+
+  return scrolled;
+}
+
+static GtkWidget *
+create_text_page (void)
+{
+  GtkWidget *scrolled;
+  GtkWidget *view;
+  GtkTextBuffer *buffer;
+  GString *string;
+  guint i;
+
+  string = g_string_new (NULL);
+  for (i = 0; i < 100; i++)
+    g_string_append (string, "The quick brown fox jumps over the lazy dog.\n");
+
+  view = gtk_text_view_new ();
+  buffer = gtk_text_view_get_buffer (GTK_TEXT_VIEW (view));
+  gtk_text_buffer_set_text (buffer, string->str, -1);
+  g_string_free (string, TRUE);
+
+  scrolled = gtk_scrolled_window_new (NULL, NULL);
+  gtk_container_add (GTK_CONTAINER (scrolled), view);
+
+  return scrolled;
+}
+
+static void
+create_window (void)
+{
+  GtkWidget *header;
+
+  window = gtk_window_new (GTK_WINDOW_TOPLEVEL);
+  gtk_window_set_default_size (GTK_WINDOW (window), 640, 480);
+
+  header = gtk_header_bar_new ();
+  gtk_header_bar_set_title (GTK_HEADER_BAR (header), "Frame Bench");
+  gtk_header_bar_set_show_close_button (GTK_HEADER_BAR (header), TRUE);
+  gtk_window_set_titlebar (GTK_WINDOW (window), header);
+
+  notebook = gtk_notebook_new ();
+  gtk_notebook_append_page (GTK_NOTEBOOK (notebook),
+                            create_controls_page (),
+                            gtk_label_new ("Controls"));
+  gtk_notebook_append_page (GTK_NOTEBOOK (notebook),
+                            create_list_page (),
+                            gtk_label_new ("List"));
+  gtk_notebook_append_page (GTK_NOTEBOOK (notebook),
+                            create_text_page (),
+                            gtk_label_new ("Text"));
+
+  gtk_container_add (GTK_CONTAINER (window), notebook);
+}
+
+/* main {{{1 */
+
+int
+main (int argc, char *argv[])
+{
+  gtk_init (&argc, &argv);
+
+  create_window ();
+  gtk_widget_show_all (window);
+
+  gtk_widget_add_tick_callback (window, tick_callback, NULL, NULL);
+
+  gtk_main ();
+
+  return 0;
+}
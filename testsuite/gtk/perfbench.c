@@ -0,0 +1,243 @@
+/* perfbench.c: microbenchmarks for style matching, size requests and models
+ * Copyright (C) 2015 Red Hat, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/* Microbenchmarks for a few hot paths: selector matching (driven
+ * through style lookups on a widget tree under a large provider, which
+ * bottoms out in the css selector tree walk), size requests over a deep
+ * hierarchy, and list store insertion.  Iteration counts are fixed so
+ * runs are comparable, and results are printed as JSON for tracking
+ * over time.
+ */
+
+#include <gtk/gtk.h>
+
+#define CSS_MATCH_ITERATIONS   100
+#define SIZE_REQUEST_ITERATIONS 1000
+#define LIST_STORE_ROWS        100000
+
+#define N_SELECTORS   300
+#define N_STYLE_WIDGETS 100
+#define SIZE_DEPTH    50
+
+static gboolean first_result = TRUE;
+
+static void
+report (const char *name,
+        guint       iterations,
+        gint64      elapsed)
+{
+  g_print ("%s\n  { \"benchmark\": \"%s\", \"iterations\": %u, "
+           "\"total_ms\": %.3f, \"per_iteration_us\": %.3f }",
+           first_result ? "[" : ",",
+           name, iterations,
+           elapsed / 1000.0,
+           (gdouble) elapsed / iterations);
+
+  first_result = FALSE;
+}
+
+/* css matching {{{1 */
+
+static void
+add_bench_provider (void)
+{
+  GtkCssProvider *provider;
+  GString *css;
+  guint i;
+
+  css = g_string_new (NULL);
+  for (i = 0; i < N_SELECTORS; i++)
+    g_string_append_printf (css,
+                            ".depth%u > box .leaf%u { margin: 1px; }\n"
+                            "box.toggled .leaf%u { padding: 1px; }\n",
+                            i % 10, i, i);
+
+  provider = gtk_css_provider_new ();
+  gtk_css_provider_load_from_data (provider, css->str, -1, NULL);
+  gtk_style_context_add_provider_for_screen (gdk_screen_get_default (),
+                                             GTK_STYLE_PROVIDER (provider),
+                                             GTK_STYLE_PROVIDER_PRIORITY_APPLICATION);
+
+  g_string_free (css, TRUE);
+  g_object_unref (provider);
+}
+
+static void
+bench_css_match (void)
+{
+  GtkWidget *root, *parent;
+  GPtrArray *widgets;
+  gint64 start;
+  guint i, iter;
+
+  add_bench_provider ();
+
+  widgets = g_ptr_array_new ();
+  root = gtk_box_new (GTK_ORIENTATION_VERTICAL, 0);
+  parent = root;
+
+  for (i = 0; i < N_STYLE_WIDGETS; i++)
+    {
+      GtkWidget *child;
+      gchar *name;
+
+      if (i % 10 == 0)
+        {
+          child = gtk_box_new (GTK_ORIENTATION_VERTICAL, 0);
+          name = g_strdup_printf ("depth%u", i / 10);
+          gtk_style_context_add_class (gtk_widget_get_style_context (child),
+                                       name);
+          gtk_container_add (GTK_CONTAINER (parent), child);
+          parent = child;
+        }
+      else
+        {
+          child = gtk_label_new ("leaf");
+          name = g_strdup_printf ("leaf%u", i);
+          gtk_style_context_add_class (gtk_widget_get_style_context (child),
+                                       name);
+          gtk_container_add (GTK_CONTAINER (parent), child);
+        }
+
+      g_free (name);
+      g_ptr_array_add (widgets, child);
+    }
+
+  start = g_get_monotonic_time ();
+
+  for (iter = 0; iter < CSS_MATCH_ITERATIONS; iter++)
+    {
+      GtkStyleContext *context = gtk_widget_get_style_context (root);
+
+      /* invalidate the whole tree, then force every node to
+       * recompute its style
+       */
+      if (iter % 2 == 0)
+        gtk_style_context_add_class (context, "toggled");
+      else
+        gtk_style_context_remove_class (context, "toggled");
+
+      for (i = 0; i < widgets->len; i++)
+        {
+          GtkWidget *widget = g_ptr_array_index (widgets, i);
+          GdkRGBA color;
+
+          gtk_style_context_get_color (gtk_widget_get_style_context (widget),
+                                       gtk_widget_get_state_flags (widget),
+                                       &color);
+        }
+    }
+
+  report ("css-match", CSS_MATCH_ITERATIONS,
+          g_get_monotonic_time () - start);
+
+  g_ptr_array_free (widgets, TRUE);
+  gtk_widget_destroy (root);
+}
+
+/* size requests {{{1 */
+
+static void
+bench_size_request (void)
+{
+  GtkWidget *root, *parent, *leaf;
+  gint64 start;
+  guint i, iter;
+
+  root = gtk_box_new (GTK_ORIENTATION_HORIZONTAL, 0);
+  parent = root;
+  leaf = NULL;
+
+  for (i = 0; i < SIZE_DEPTH; i++)
+    {
+      GtkWidget *box;
+
+      box = gtk_box_new (i % 2 ? GTK_ORIENTATION_HORIZONTAL
+                               : GTK_ORIENTATION_VERTICAL, 0);
+      leaf = gtk_label_new ("leaf");
+      gtk_container_add (GTK_CONTAINER (box), leaf);
+      gtk_container_add (GTK_CONTAINER (parent), box);
+      parent = box;
+    }
+
+  start = g_get_monotonic_time ();
+
+  for (iter = 0; iter < SIZE_REQUEST_ITERATIONS; iter++)
+    {
+      gint minimum, natural;
+
+      /* defeat the size request cache so every iteration walks
+       * the full hierarchy
+       */
+      gtk_widget_queue_resize (leaf);
+      gtk_widget_get_preferred_width (root, &minimum, &natural);
+      gtk_widget_get_preferred_height_for_width (root, natural,
+                                                 &minimum, &natural);
+    }
+
+  report ("size-request", SIZE_REQUEST_ITERATIONS,
+          g_get_monotonic_time () - start);
+
+  gtk_widget_destroy (root);
+}
+
+/* list store {{{1 */
+
+static void
+bench_list_store (void)
+{
+  GtkListStore *store;
+  gint64 start;
+  guint i;
+
+  store = gtk_list_store_new (4,
+                              G_TYPE_INT,
+                              G_TYPE_STRING,
+                              G_TYPE_BOOLEAN,
+                              G_TYPE_DOUBLE);
+
+  start = g_get_monotonic_time ();
+
+  for (i = 0; i < LIST_STORE_ROWS; i++)
+    gtk_list_store_insert_with_values (store, NULL, -1,
+                                       0, (gint) i,
+                                       1, "a row of moderate length",
+                                       2, i % 2 == 0,
+                                       3, (gdouble) i,
+                                       -1);
+
+  report ("list-store-insert", LIST_STORE_ROWS,
+          g_get_monotonic_time () - start);
+
+  g_object_unref (store);
+}
+
+/* main {{{1 */
+
+int
+main (int argc, char *argv[])
+{
+  gtk_init (&argc, &argv);
+
+  bench_css_match ();
+  bench_size_request ();
+  bench_list_store ();
+
+  g_print ("\n]\n");
+
+  return 0;
+}
@@ -507,6 +507,54 @@ test_reorder (void)
   _gtk_rbtree_free (tree);
 }
 
+static guint
+augment_max (guint a, guint b)
+{
+  return MAX (a, b);
+}
+
+static void
+test_augment (void)
+{
+  GtkRBTree *tree;
+  GtkRBNode *node;
+  guint i;
+
+  tree = _gtk_rbtree_new ();
+  _gtk_rbtree_set_augment_func (tree, augment_max);
+
+  node = NULL;
+  for (i = 1; i <= 100; i++)
+    {
+      node = _gtk_rbtree_insert_after (tree, node, i, TRUE);
+      _gtk_rbtree_node_set_augment (tree, node, i);
+      _gtk_rbtree_test (tree);
+      g_assert (tree->root->augment_agg == i);
+    }
+
+  /* Lowering the maximum must propagate to the root */
+  _gtk_rbtree_node_set_augment (tree, node, 0);
+  g_assert (tree->root->augment_agg == 99);
+  _gtk_rbtree_node_set_augment (tree, node, 100);
+
+  /* Repeatedly remove the rightmost node; it always carries
+   * the current maximum */
+  for (i = 100; i > 1; i--)
+    {
+      g_assert (tree->root->augment_agg == i);
+
+      node = tree->root;
+      while (!_gtk_rbtree_is_nil (node->right))
+        node = node->right;
+
+      _gtk_rbtree_remove_node (tree, node);
+      _gtk_rbtree_test (tree);
+    }
+  g_assert (tree->root->augment_agg == 1);
+
+  _gtk_rbtree_free (tree);
+}
+
 int
 main (int argc, char *argv[])
 {
@@ -520,6 +568,7 @@ main (int argc, char *argv[])
   g_test_add_func ("/rbtree/remove_node", test_remove_node);
   g_test_add_func ("/rbtree/remove_root", test_remove_root);
   g_test_add_func ("/rbtree/reorder", test_reorder);
+  g_test_add_func ("/rbtree/augment", test_augment);
 
   return g_test_run ();
 }
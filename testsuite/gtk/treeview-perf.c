@@ -0,0 +1,263 @@
+/* treeview-perf.c: treeview validation and scrolling benchmark
+ * Copyright (C) 2015 Red Hat, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/* Performance companion to treeview-scrolling.c: generates synthetic
+ * models of configurable row count and height variance, then measures
+ * how long background row validation takes to settle (observed as the
+ * vertical adjustment's upper bound stabilizing) and the frame times
+ * while scrolling through the validated model.  Run by hand to catch
+ * treeview regressions; it is not a pass/fail test.
+ */
+
+#include <gtk/gtk.h>
+
+#include <math.h>
+#include <stdlib.h>
+
+#define SCROLL_FRAMES 240
+#define SETTLE_FRAMES 10
+
+typedef struct {
+  const char *name;
+  guint       rows;
+  gboolean    fixed_height;
+  gboolean    vary_heights;
+} ModelConfig;
+
+static const ModelConfig configs[] = {
+  { "10k-fixed",    10000, TRUE,  FALSE },
+  { "10k-varied",   10000, FALSE, TRUE  },
+  { "100k-fixed",  100000, TRUE,  FALSE },
+  { "100k-varied", 100000, FALSE, TRUE  }
+};
+
+typedef enum {
+  PHASE_VALIDATE,
+  PHASE_SCROLL
+} Phase;
+
+static GtkAdjustment *vadjustment;
+static Phase phase;
+static gint64 validate_start;
+static gint64 validate_elapsed;
+static gdouble last_upper;
+static guint settle_count;
+static gint64 frame_times[SCROLL_FRAMES];
+static guint n_frame_times;
+static gint64 last_frame_time;
+static guint scroll_frame;
+
+static GtkTreeModel *
+create_model (const ModelConfig *config)
+{
+  GtkListStore *store;
+  guint i;
+
+  store = gtk_list_store_new (2, G_TYPE_STRING, G_TYPE_INT);
+
+  for (i = 0; i < config->rows; i++)
+    {
+      gchar *text;
+
+      if (config->vary_heights && i % 7 == 0)
+        text = g_strdup_printf ("Row %u\nwith a second line\nand a third", i);
+      else
+        text = g_strdup_printf ("Row %u", i);
+
+      gtk_list_store_insert_with_values (store, NULL, -1,
+                                         0, text,
+                                         1, (gint) i,
+                                         -1);
+      g_free (text);
+    }
+
+  return GTK_TREE_MODEL (store);
+}
+
+static GtkWidget *
+create_tree_view (const ModelConfig *config)
+{
+  GtkTreeModel *model;
+  GtkWidget *tree_view;
+
+  model = create_model (config);
+  tree_view = gtk_tree_view_new_with_model (model);
+  g_object_unref (model);
+
+  gtk_tree_view_set_fixed_height_mode (GTK_TREE_VIEW (tree_view),
+                                       config->fixed_height);
+
+  gtk_tree_view_insert_column_with_attributes (GTK_TREE_VIEW (tree_view),
+                                               -1, "Text",
+                                               gtk_cell_renderer_text_new (),
+                                               "text", 0,
+                                               NULL);
+  gtk_tree_view_insert_column_with_attributes (GTK_TREE_VIEW (tree_view),
+                                               -1, "Number",
+                                               gtk_cell_renderer_text_new (),
+                                               "text", 1,
+                                               NULL);
+
+  if (config->fixed_height)
+    {
+      GList *columns, *l;
+
+      columns = gtk_tree_view_get_columns (GTK_TREE_VIEW (tree_view));
+      for (l = columns; l; l = l->next)
+        gtk_tree_view_column_set_sizing (l->data,
+                                         GTK_TREE_VIEW_COLUMN_FIXED);
+      g_list_free (columns);
+    }
+
+  return tree_view;
+}
+
+static int
+compare_frame_times (gconstpointer a,
+                     gconstpointer b)
+{
+  const gint64 *ta = a;
+  const gint64 *tb = b;
+
+  if (*ta < *tb)
+    return -1;
+  else if (*ta > *tb)
+    return 1;
+  return 0;
+}
+
+static gdouble
+percentile_ms (guint p)
+{
+  guint idx = MIN (n_frame_times * p / 100, n_frame_times - 1);
+
+  return frame_times[idx] / 1000.0;
+}
+
+static void
+report_config (const ModelConfig *config)
+{
+  qsort (frame_times, n_frame_times, sizeof (gint64), compare_frame_times);
+
+  g_print ("%-12s validate %8.1f ms  "
+           "scroll p50 %6.2f ms  p90 %6.2f ms  p99 %6.2f ms\n",
+           config->name, validate_elapsed / 1000.0,
+           percentile_ms (50), percentile_ms (90), percentile_ms (99));
+}
+
+static gboolean
+tick_callback (GtkWidget     *widget,
+               GdkFrameClock *frame_clock,
+               gpointer       user_data)
+{
+  const ModelConfig *config = user_data;
+  gint64 frame_time = gdk_frame_clock_get_frame_time (frame_clock);
+
+  if (phase == PHASE_VALIDATE)
+    {
+      gdouble upper = gtk_adjustment_get_upper (vadjustment);
+
+      if (validate_start == 0)
+        validate_start = frame_time;
+
+      /* validation runs in an idle; treat a stable upper bound as done */
+      if (upper == last_upper)
+        settle_count++;
+      else
+        settle_count = 0;
+      last_upper = upper;
+
+      if (settle_count >= SETTLE_FRAMES)
+        {
+          validate_elapsed = frame_time - validate_start
+                             - SETTLE_FRAMES * (frame_time - last_frame_time);
+          phase = PHASE_SCROLL;
+        }
+
+      last_frame_time = frame_time;
+      gtk_widget_queue_draw (widget);
+
+      return G_SOURCE_CONTINUE;
+    }
+
+  if (scroll_frame > 0 && n_frame_times < SCROLL_FRAMES)
+    frame_times[n_frame_times++] = frame_time - last_frame_time;
+  last_frame_time = frame_time;
+
+  if (n_frame_times >= SCROLL_FRAMES)
+    {
+      report_config (config);
+      gtk_main_quit ();
+      return G_SOURCE_REMOVE;
+    }
+
+  gtk_adjustment_set_value (vadjustment,
+                            fmod (scroll_frame * 200.0,
+                                  MAX (gtk_adjustment_get_upper (vadjustment) -
+                                       gtk_adjustment_get_page_size (vadjustment),
+                                       1.0)));
+  scroll_frame++;
+
+  return G_SOURCE_CONTINUE;
+}
+
+static void
+run_config (const ModelConfig *config)
+{
+  GtkWidget *window, *scrolled, *tree_view;
+
+  phase = PHASE_VALIDATE;
+  validate_start = 0;
+  validate_elapsed = 0;
+  last_upper = -1;
+  settle_count = 0;
+  n_frame_times = 0;
+  last_frame_time = 0;
+  scroll_frame = 0;
+
+  window = gtk_window_new (GTK_WINDOW_TOPLEVEL);
+  gtk_window_set_default_size (GTK_WINDOW (window), 400, 600);
+
+  scrolled = gtk_scrolled_window_new (NULL, NULL);
+  tree_view = create_tree_view (config);
+  gtk_container_add (GTK_CONTAINER (scrolled), tree_view);
+  gtk_container_add (GTK_CONTAINER (window), scrolled);
+
+  vadjustment =
+    gtk_scrolled_window_get_vadjustment (GTK_SCROLLED_WINDOW (scrolled));
+
+  gtk_widget_show_all (window);
+  gtk_widget_add_tick_callback (window, tick_callback,
+                                (gpointer) config, NULL);
+
+  gtk_main ();
+
+  gtk_widget_destroy (window);
+}
+
+int
+main (int argc, char *argv[])
+{
+  guint i;
+
+  gtk_init (&argc, &argv);
+
+  for (i = 0; i < G_N_ELEMENTS (configs); i++)
+    run_config (&configs[i]);
+
+  return 0;
+}